@@ -108,6 +108,11 @@
  * Jan 28 2020 RK - abort if WAVE>12000 and using Fitz99 color law
  * 
  * Oct 9 2021 DB and DS - update Fitz/Odonell ratio and extend WAVE to 15000
+ *
+ * Oct 2026: optional in-memory cache of NGP/SGP maps (init_MWgaldust_cache)
+ *           so that each lookup is projection + bilinear interpolation
+ *           without file I/O; projection header cards are parsed once.
+ *           New batch API MWgaldust_batch, and lookup counter/timer.
  */
 /**************************************************************************/
 
@@ -119,11 +124,24 @@
 #include <math.h>
 #include <unistd.h> 
 #include <ctype.h>
+#include <sys/time.h>
 
 #include "MWgaldust.h"
 #include "sntools.h"
 //#include "sntools_cosmology.h"
 
+// Oct 2026: in-memory SFD map cache; MAP[0]=NGP, MAP[1]=SGP
+struct {
+  int    OPT ;              // OPT_MWDUST_CACHE_XXX
+  LAMBERT_MAP_DEF MAP[2] ;
+  double NLOOKUP, TLOOKUP ; // number of lookups and wall time (seconds)
+} MWDUST_CACHE ;
+
+void  MWgaldust_filenames(char *pMapName, char *pFileN, char *pFileS);
+float MWgaldust_cache_getval(char *pFileN, char *pFileS, 
+			     float gall, float galb);
+void  MWgaldust_addtime(struct timeval *t0, int NLOOKUP);
+
 
 // #####################################################
 //
@@ -480,7 +498,6 @@ void MWgaldust(
 	       )
 
 {
-   int      imap;
    int      qInterp;
    int      qVerbose;
    int      qNoloop;
@@ -491,38 +508,20 @@ void MWgaldust(
    float *  pGalb = NULL;
    float *  pMapval;
    double dustval;
+   struct timeval t0;
 
    /* Declarations for keyword input values */
    char  *  pMapName;
-   char  *  pIPath     = NULL ;
    char     pDefMap[]  = "Ebv" ;
-   char     pDefPath[200];
 
    /* Declarations for data file names */
    char     pFileN[MAX_FILE_NAME_LEN];
    char     pFileS[MAX_FILE_NAME_LEN];
-   struct   mapParms {
-      char *   pName;
-      char *   pFile1;
-      char *   pFile2;
-   } ppMapAll[] = {
-     { "Ebv" , "SFD_dust_4096_ngp.fits", "SFD_dust_4096_sgp.fits" },
-     { "I100", "SFD_i100_4096_ngp.fits", "SFD_i100_4096_sgp.fits" },
-     { "X"   , "SFD_xmap_ngp.fits"     , "SFD_xmap_sgp.fits"      },
-     { "T"   , "SFD_temp_ngp.fits"     , "SFD_temp_sgp.fits"      },
-     { "mask", "SFD_mask_4096_ngp.fits", "SFD_mask_4096_sgp.fits" }
-   };
 
    double RV[5];
 
-   const int nmap = sizeof(ppMapAll) / sizeof(ppMapAll[0]);
-
    /* Set defaults */
 
-   // xxx old   sprintf(pDefPath, "%s/maps", getenv("DUST_DIR") );
-   sprintf(pDefPath, "%s/MWDUST", getenv("SNDATA_ROOT") );
-   pIPath = pDefPath ;
-
    pMapName = pDefMap;
    qInterp = 1; /* interpolation */
    qVerbose = 0; /* not verbose */
@@ -544,18 +543,26 @@ void MWgaldust(
    pGalb[0] = (float)tmpb;
 
    /* Determine the file names to use */
-   for (imap=0; imap < nmap; imap++) {
-      if (strcmp(pMapName,ppMapAll[imap].pName) == 0) {
-	         sprintf(pFileN, "%s/%s", pIPath, ppMapAll[imap].pFile1);
-	         sprintf(pFileS, "%s/%s", pIPath, ppMapAll[imap].pFile2);
-      }
+   MWgaldust_filenames(pMapName, pFileN, pFileS);
+
+   gettimeofday(&t0, NULL);
+
+   if ( MWDUST_CACHE.OPT != OPT_MWDUST_CACHE_OFF ) {
+      /* Oct 2026: in-memory map */
+      dustval = (double)MWgaldust_cache_getval(pFileN, pFileS, 
+					       pGall[0], pGalb[0]);
+   } else {
+      /* Read values from FITS files in Lambert projection */
+      pMapval = lambert_getval(pFileN, pFileS, nGal, pGall, pGalb,
+       qInterp, qNoloop, qVerbose);
+      dustval = (double) *pMapval;
+      ccvector_free_(pMapval);
    }
 
-   /* Read values from FITS files in Lambert projection */
-   pMapval = lambert_getval(pFileN, pFileS, nGal, pGall, pGalb,
-    qInterp, qNoloop, qVerbose);
+   MWgaldust_addtime(&t0, nGal);
+   ccvector_free_(pGall);
+   ccvector_free_(pGalb);
 
-   dustval = (double) *pMapval;
    galxtinct[0] = RV[0]*dustval;
    galxtinct[1] = RV[1]*dustval;
    galxtinct[2] = RV[2]*dustval;
@@ -566,6 +573,172 @@ void MWgaldust(
 
 }
 
+// ==============================================
+void MWgaldust_filenames(char *pMapName, char *pFileN, char *pFileS) {
+
+  // Created Oct 2026 [code moved from MWgaldust]
+  // Return NGP and SGP file names for map pMapName (e.g., "Ebv")
+
+   int      imap;
+   char     pDefPath[200];
+   struct   mapParms {
+      char *   pName;
+      char *   pFile1;
+      char *   pFile2;
+   } ppMapAll[] = {
+     { "Ebv" , "SFD_dust_4096_ngp.fits", "SFD_dust_4096_sgp.fits" },
+     { "I100", "SFD_i100_4096_ngp.fits", "SFD_i100_4096_sgp.fits" },
+     { "X"   , "SFD_xmap_ngp.fits"     , "SFD_xmap_sgp.fits"      },
+     { "T"   , "SFD_temp_ngp.fits"     , "SFD_temp_sgp.fits"      },
+     { "mask", "SFD_mask_4096_ngp.fits", "SFD_mask_4096_sgp.fits" }
+   };
+
+   const int nmap = sizeof(ppMapAll) / sizeof(ppMapAll[0]);
+
+   // xxx old   sprintf(pDefPath, "%s/maps", getenv("DUST_DIR") );
+   sprintf(pDefPath, "%s/MWDUST", getenv("SNDATA_ROOT") );
+
+   for (imap=0; imap < nmap; imap++) {
+      if (strcmp(pMapName,ppMapAll[imap].pName) == 0) {
+	         sprintf(pFileN, "%s/%s", pDefPath, ppMapAll[imap].pFile1);
+	         sprintf(pFileS, "%s/%s", pDefPath, ppMapAll[imap].pFile2);
+      }
+   }
+
+} // end MWgaldust_filenames
+
+
+// ==============================================
+void init_MWgaldust_cache(int OPT) {
+
+  // Created Oct 2026
+  // Set option to keep SFD E(B-V) maps in memory.
+  //   OPT_MWDUST_CACHE_OFF     : read pixels from FITS file per lookup
+  //   OPT_MWDUST_CACHE_LAZY    : load NGP or SGP map at first lookup
+  //   OPT_MWDUST_CACHE_PRELOAD : load both maps now (e.g., before fork
+  //                              so that memory pages are shared)
+  // Each map is 4096x4096 floats (64 MB).
+
+  char pFileN[MAX_FILE_NAME_LEN], pFileS[MAX_FILE_NAME_LEN];
+  char pMapName[] = "Ebv" ;
+
+  // ---------- BEGIN ----------
+
+  MWDUST_CACHE.OPT = OPT ;
+  if ( OPT != OPT_MWDUST_CACHE_PRELOAD ) { return; }
+
+  MWgaldust_filenames(pMapName, pFileN, pFileS);
+  if ( !MWDUST_CACHE.MAP[0].qLoaded ) 
+    { lambert_load_map(pFileN, &MWDUST_CACHE.MAP[0]); }
+  if ( !MWDUST_CACHE.MAP[1].qLoaded ) 
+    { lambert_load_map(pFileS, &MWDUST_CACHE.MAP[1]); }
+
+  return ;
+
+} // end init_MWgaldust_cache
+
+
+// ==============================================
+float MWgaldust_cache_getval(char *pFileN, char *pFileS, 
+			     float gall, float galb) {
+
+  // Created Oct 2026
+  // Return interpolated map value from in-memory NGP or SGP map;
+  // load map if not already loaded.
+
+  int ins = (galb >= 0.0) ? 0 : 1; /* ==0 for NGP, ==1 for SGP */
+  LAMBERT_MAP_DEF *pMap = &MWDUST_CACHE.MAP[ins];
+
+  // ---------- BEGIN ----------
+
+  if ( !pMap->qLoaded ) {
+    if ( ins == 0 ) 
+      { lambert_load_map(pFileN, pMap); }
+    else
+      { lambert_load_map(pFileS, pMap); }
+  }
+
+  return lambert_map_getval(gall, galb, pMap);
+
+} // end MWgaldust_cache_getval
+
+
+// ==============================================
+void MWgaldust_batch(int NCOORD, double *RA, double *DEC, double *galebmv) {
+
+  // Created Oct 2026
+  // Return SFD E(B-V) for NCOORD sky coordinates (degrees).
+  // With cache, each value is projection + bilinear interpolation 
+  // of in-memory map. Without cache, read the smallest sub-image 
+  // containing all coordinates in each hemisphere (qNoloop=1).
+
+  int      i;
+  double   tmpl, tmpb;
+  float   *pGall, *pGalb, *pMapval;
+  char     pFileN[MAX_FILE_NAME_LEN], pFileS[MAX_FILE_NAME_LEN];
+  char     pMapName[] = "Ebv" ;
+  struct timeval t0;
+
+  // ---------- BEGIN ----------
+
+  if ( NCOORD <= 0 ) { return; }
+
+  MWgaldust_filenames(pMapName, pFileN, pFileS);
+
+  gettimeofday(&t0, NULL);
+
+  pGall = ccvector_build_(NCOORD);
+  pGalb = ccvector_build_(NCOORD);
+  for(i=0; i < NCOORD; i++ ) {
+    slaEqgal(RA[i], DEC[i], &tmpl, &tmpb);
+    pGall[i] = (float)tmpl;
+    pGalb[i] = (float)tmpb;
+  }
+
+  if ( MWDUST_CACHE.OPT != OPT_MWDUST_CACHE_OFF ) {
+    for(i=0; i < NCOORD; i++ ) {
+      galebmv[i] = 
+	(double)MWgaldust_cache_getval(pFileN, pFileS, pGall[i], pGalb[i]);
+    }
+  }
+  else {
+    pMapval = lambert_getval(pFileN, pFileS, NCOORD, pGall, pGalb, 1, 1, 0);
+    for(i=0; i < NCOORD; i++ ) { galebmv[i] = (double)pMapval[i]; }
+    ccvector_free_(pMapval);
+  }
+
+  ccvector_free_(pGall);
+  ccvector_free_(pGalb);
+
+  MWgaldust_addtime(&t0, NCOORD);
+
+  return ;
+
+} // end MWgaldust_batch
+
+
+// ==============================================
+void MWgaldust_addtime(struct timeval *t0, int NLOOKUP) {
+  // Created Oct 2026: increment lookup counter and wall time since *t0
+  struct timeval t1;
+  gettimeofday(&t1, NULL);
+  MWDUST_CACHE.NLOOKUP += (double)NLOOKUP ;
+  MWDUST_CACHE.TLOOKUP += 
+    (double)(t1.tv_sec - t0->tv_sec) + 1.0E-6*(double)(t1.tv_usec-t0->tv_usec);
+} // end MWgaldust_addtime
+
+void get_MWgaldust_stats(double *NLOOKUP, double *TLOOKUP) {
+  // Created Oct 2026: return number of lookups and total time (sec)
+  *NLOOKUP = MWDUST_CACHE.NLOOKUP ;
+  *TLOOKUP = MWDUST_CACHE.TLOOKUP ;
+} 
+
+void add_MWgaldust_stats(double NLOOKUP, double TLOOKUP) {
+  // Created Oct 2026: add stats from another process (e.g., sim worker)
+  MWDUST_CACHE.NLOOKUP += NLOOKUP ;
+  MWDUST_CACHE.TLOOKUP += TLOOKUP ;
+} 
+
 
 
 char Label_lam_nsgp[]  = "LAM_NSGP";
@@ -932,67 +1105,112 @@ void lambert_lb2fpix
    uchar *  pHead,
    float *  pX,     /* X position in pixels from the center */
    float *  pY)     /* Y position in pixels from the center */
+{
+   LAMBERT_PROJ_DEF proj;
+
+   /* Oct 2026: split into header parsing and projection so that 
+    * the in-memory map can parse its header only once. */
+   lambert_read_proj(nHead, pHead, &proj);
+   lambert_proj2fpix(gall, galb, &proj, pX, pY);
+}
+
+/******************************************************************************/
+/* Read projection parameters from FITS header (Oct 2026; code moved
+ * from lambert_lb2fpix).
+ */
+void lambert_read_proj
+  (HSIZE    nHead,
+   uchar *  pHead,
+   LAMBERT_PROJ_DEF * pProj)
 {
    int      q1;
    int      q2;
-   int      nsgp;
-   float    scale;
-   float    crval1;
-   float    crval2;
-   float    crpix1;
-   float    crpix2;
    float    cdelt1;
    float    cdelt2;
-   float    cd1_1;
-   float    cd1_2;
-   float    cd2_1;
-   float    cd2_2;
-   float    lonpole;
-   float    xr;
-   float    yr;
-   float    theta;
-   float    phi;
-   float    Rtheta;
-   float    denom;
-   static double dradeg = 180 / 3.1415926534;
    char  *  pCtype1;
    char  *  pCtype2;
 
    fits_get_card_string_(&pCtype1, label_ctype1, &nHead, &pHead);
    fits_get_card_string_(&pCtype2, label_ctype2, &nHead, &pHead);
-   fits_get_card_rval_(&crval1, label_crval1, &nHead, &pHead);
-   fits_get_card_rval_(&crval2, label_crval2, &nHead, &pHead);
-   fits_get_card_rval_(&crpix1, label_crpix1, &nHead, &pHead);
-   fits_get_card_rval_(&crpix2, label_crpix2, &nHead, &pHead);
+   fits_get_card_rval_(&pProj->crval1, label_crval1, &nHead, &pHead);
+   fits_get_card_rval_(&pProj->crval2, label_crval2, &nHead, &pHead);
+   fits_get_card_rval_(&pProj->crpix1, label_crpix1, &nHead, &pHead);
+   fits_get_card_rval_(&pProj->crpix2, label_crpix2, &nHead, &pHead);
 
    if (strcmp(pCtype1, "LAMBERT--X")  == 0 &&
        strcmp(pCtype2, "LAMBERT--Y")  == 0) {
 
-      fits_get_card_ival_(&nsgp, label_lam_nsgp, &nHead, &pHead);
-      fits_get_card_rval_(&scale, label_lam_scal, &nHead, &pHead);
-
-      lambert_lb2xy(gall, galb, nsgp, scale, &xr, &yr);
-      *pX = xr + crpix1 - crval1 - 1.0;
-      *pY = yr + crpix2 - crval2 - 1.0;
+      pProj->iproj = LAMBERT_PROJ_LAMBERT;
+      fits_get_card_ival_(&pProj->nsgp, label_lam_nsgp, &nHead, &pHead);
+      fits_get_card_rval_(&pProj->scale, label_lam_scal, &nHead, &pHead);
 
    } else if (strcmp(pCtype1, "GLON-ZEA")  == 0 &&
               strcmp(pCtype2, "GLAT-ZEA")  == 0) { 
 
+      pProj->iproj = LAMBERT_PROJ_ZEA;
       q1 = fits_get_card_rval_(&cdelt1, label_cdelt1, &nHead, &pHead);
       q2 = fits_get_card_rval_(&cdelt2, label_cdelt2, &nHead, &pHead);
       if (q1 == TRUE_MWDUST && q2 == TRUE_MWDUST) {
-          cd1_1 = cdelt1;
-          cd1_2 = 0.0;
-          cd2_1 = 0.0;
-          cd2_2 = cdelt2;
+          pProj->cd1_1 = cdelt1;
+          pProj->cd1_2 = 0.0;
+          pProj->cd2_1 = 0.0;
+          pProj->cd2_2 = cdelt2;
        } else {
-         fits_get_card_rval_(&cd1_1, label_cd1_1, &nHead, &pHead);
-         fits_get_card_rval_(&cd1_2, label_cd1_2, &nHead, &pHead);
-         fits_get_card_rval_(&cd2_1, label_cd2_1, &nHead, &pHead);
-         fits_get_card_rval_(&cd2_2, label_cd2_2, &nHead, &pHead);
+         fits_get_card_rval_(&pProj->cd1_1, label_cd1_1, &nHead, &pHead);
+         fits_get_card_rval_(&pProj->cd1_2, label_cd1_2, &nHead, &pHead);
+         fits_get_card_rval_(&pProj->cd2_1, label_cd2_1, &nHead, &pHead);
+         fits_get_card_rval_(&pProj->cd2_2, label_cd2_2, &nHead, &pHead);
       }
-      q1 = fits_get_card_rval_(&lonpole, label_lonpole, &nHead, &pHead);
-      if (q1 == FALSE_MWDUST) lonpole = 180.0; /* default value */
+      q1 = fits_get_card_rval_(&pProj->lonpole, label_lonpole, 
+                               &nHead, &pHead);
+      if (q1 == FALSE_MWDUST) pProj->lonpole = 180.0; /* default value */
+
+   } else {
+
+      pProj->iproj = LAMBERT_PROJ_UNKNOWN;
+
+   }
+
+   ccfree_((void **)&pCtype1);
+   ccfree_((void **)&pCtype2);
+}
+
+/******************************************************************************/
+/* Transform from galactic (l,b) coordinates to fractional (x,y) pixel 
+ * location using projection parameters from lambert_read_proj.
+ * This function returns the ZERO-INDEXED pixel position.
+ */
+void lambert_proj2fpix
+  (float    gall,   /* Galactic longitude */
+   float    galb,   /* Galactic latitude */
+   LAMBERT_PROJ_DEF * pProj,
+   float *  pX,     /* X position in pixels from the center */
+   float *  pY)     /* Y position in pixels from the center */
+{
+   float    crval1 = pProj->crval1;
+   float    crval2 = pProj->crval2;
+   float    crpix1 = pProj->crpix1;
+   float    crpix2 = pProj->crpix2;
+   float    cd1_1  = pProj->cd1_1;
+   float    cd1_2  = pProj->cd1_2;
+   float    cd2_1  = pProj->cd2_1;
+   float    cd2_2  = pProj->cd2_2;
+   float    lonpole = pProj->lonpole;
+   float    xr;
+   float    yr;
+   float    theta;
+   float    phi;
+   float    Rtheta;
+   float    denom;
+   static double dradeg = 180 / 3.1415926534;
+
+   if (pProj->iproj == LAMBERT_PROJ_LAMBERT) {
+
+      lambert_lb2xy(gall, galb, pProj->nsgp, pProj->scale, &xr, &yr);
+      *pX = xr + crpix1 - crval1 - 1.0;
+      *pY = yr + crpix2 - crval2 - 1.0;
+
+   } else if (pProj->iproj == LAMBERT_PROJ_ZEA) {
 
       /* ROTATION */
       /* Equn (4) - degenerate case */
@@ -1032,9 +1250,91 @@ void lambert_lb2fpix
       *pY = -99.0;
 
    }
+}
 
-   ccfree_((void **)&pCtype1);
-   ccfree_((void **)&pCtype2);
+/******************************************************************************/
+/* Read full NGP or SGP image into memory, and parse projection once
+ * (Oct 2026).
+ */
+void lambert_load_map
+  (char  *  pFile,
+   LAMBERT_MAP_DEF * pMap)
+{
+   int      numAxes;
+   DSIZE *  pNaxis;
+   DSIZE    nData;
+   HSIZE    nHead;
+   uchar *  pHead;
+   float *  pData;
+
+   printf("   Load SFD map into memory: %s\n", pFile);
+   fflush(stdout);
+
+   fits_read_file_fits_r4_(pFile, &nHead, &pHead, &nData, &pData);
+   fits_compute_axes_(&nHead, &pHead, &numAxes, &pNaxis);
+
+   pMap->naxis1 = (int)pNaxis[0];
+   pMap->naxis2 = (int)pNaxis[1];
+   pMap->pData  = pData;
+   lambert_read_proj(nHead, pHead, &pMap->proj);
+   sprintf(pMap->pFile, "%s", pFile);
+   pMap->qLoaded = 1;
+
+   fits_free_axes_(&numAxes, &pNaxis);
+   fits_dispose_array_(&pHead);
+}
+
+/******************************************************************************/
+/* Return value interpolated from the 4 nearest pixels of in-memory map 
+ * (Oct 2026). Same pixel and weight logic as lambert_getval with 
+ * qInterp=1, so results are identical to reading pixels from file.
+ */
+float lambert_map_getval
+  (float    gall,
+   float    galb,
+   LAMBERT_MAP_DEF * pMap)
+{
+   int      xPix;
+   int      yPix;
+   int      nx = pMap->naxis1;
+   float    xr;
+   float    yr;
+   float    dx;
+   float    dy;
+   float    pWeight[4];
+   float    mapval;
+   float *  pRow0;
+   float *  pRow1;
+
+   lambert_proj2fpix(gall, galb, &pMap->proj, &xr, &yr);
+
+   xPix = (int)(xr);
+   yPix = (int)(yr);
+   dx = xPix - xr + 1.0;
+   dy = yPix - yr + 1.0;
+
+   /* Force pixel values to fall within the image boundaries */
+   if (xPix < 0) { xPix = 0; dx = 1.0; }
+   if (yPix < 0) { yPix = 0; dy = 1.0; }
+   if (xPix >= pMap->naxis1-1) { xPix = pMap->naxis1-2; dx = 0.0; }
+   if (yPix >= pMap->naxis2-1) { yPix = pMap->naxis2-2; dy = 0.0; }
+
+   /* Create array of weights */
+   pWeight[0] =    dx  *    dy  ;
+   pWeight[1] = (1-dx) *    dy  ;
+   pWeight[2] =    dx  * (1-dy) ;
+   pWeight[3] = (1-dx) * (1-dy) ;
+
+   pRow0 = &pMap->pData[(long)yPix * nx + xPix];
+   pRow1 = pRow0 + nx;
+
+   mapval = 0.0;
+   mapval += pWeight[0] * pRow0[0];
+   mapval += pWeight[1] * pRow0[1];
+   mapval += pWeight[2] * pRow1[0];
+   mapval += pWeight[3] * pRow1[1];
+
+   return mapval;
 }
 
 /******************************************************************************/
@@ -33,6 +33,16 @@ void   modify_MWEBV_SFD  (int OPT, double RA, double DECL,    // (I)
 void   modify_mwebv_sfd__(int *OPT, double *RA, double *DECL,
 			  double *MWEBV, double *MWEBV_ERR) ;
 
+// Oct 2026: in-memory cache of SFD maps, and batch lookup
+#define OPT_MWDUST_CACHE_OFF      0  // read pixels from FITS file per lookup
+#define OPT_MWDUST_CACHE_LAZY     1  // load each map at first lookup
+#define OPT_MWDUST_CACHE_PRELOAD  2  // load NGP+SGP maps at init
+
+void   init_MWgaldust_cache(int OPT);
+void   MWgaldust_batch(int NCOORD, double *RA, double *DEC, double *galebmv);
+void   get_MWgaldust_stats(double *NLOOKUP, double *TLOOKUP);
+void   add_MWgaldust_stats(double NLOOKUP, double TLOOKUP);
+
 // =======================================
 
 #ifndef __INCinterface_h
@@ -722,6 +732,28 @@ int inoutput_close_file
 #ifndef __INCsubs_lambert_h
 #define __INCsubs_lambert_h
 
+/* Projection parameters parsed once from FITS header (Oct 2026) */
+#define LAMBERT_PROJ_UNKNOWN  0
+#define LAMBERT_PROJ_LAMBERT  1
+#define LAMBERT_PROJ_ZEA      2
+
+typedef struct {
+   int      iproj;   /* LAMBERT_PROJ_XXX */
+   int      nsgp;
+   float    scale;
+   float    crval1, crval2, crpix1, crpix2;
+   float    cd1_1, cd1_2, cd2_1, cd2_2, lonpole;
+} LAMBERT_PROJ_DEF;
+
+/* In-memory NGP or SGP map (Oct 2026) */
+typedef struct {
+   int      qLoaded;
+   char     pFile[MAX_FILE_NAME_LEN];
+   int      naxis1, naxis2;
+   float *  pData;   /* full image, x index is fastest */
+   LAMBERT_PROJ_DEF proj;
+} LAMBERT_MAP_DEF;
+
 void DECLARE(fort_lambert_getval)
   (char  *  pFileN,
    char  *  pFileS,
@@ -748,6 +780,23 @@ void lambert_lb2fpix
    uchar *  pHead,
    float *  pX,     /* X position in pixels from the center */
    float *  pY);    /* Y position in pixels from the center */
+void lambert_read_proj
+  (HSIZE    nHead,
+   uchar *  pHead,
+   LAMBERT_PROJ_DEF * pProj);
+void lambert_proj2fpix
+  (float    gall,   /* Galactic longitude */
+   float    galb,   /* Galactic latitude */
+   LAMBERT_PROJ_DEF * pProj,
+   float *  pX,     /* X position in pixels from the center */
+   float *  pY);    /* Y position in pixels from the center */
+void lambert_load_map
+  (char  *  pFile,
+   LAMBERT_MAP_DEF * pMap);
+float lambert_map_getval
+  (float    gall,
+   float    galb,
+   LAMBERT_MAP_DEF * pMap);
 void lambert_lb2pix
   (float    gall,   /* Galactic longitude */
    float    galb,   /* Galactic latitude */
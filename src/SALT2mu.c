@@ -291,6 +291,23 @@ For help, run code with no arguments
 
  Dec 19 2023: begin refactor to integrate new WGT_biasCor_population() function
 
+ Oct 2026: replace pthread_create/join in every fcn call with persistent
+           thread pool (FCN_THREADPOOL) created once in DRIVER_INIT.
+           Events are processed in fixed-size chunks grabbed by each
+           thread; chunk sums are added in chunk order so that chi2 
+           does not depend on nthread. Report wall time per fcn call.
+
+ Oct 2026: use nthread also for biasCor maps: per-event WGT, J1D, muBias
+           and muErr are computed in threads (exec_threads_biasCor),
+           then summed in each cell in event order, so that maps do
+           not depend on nthread. COVINT sums are threaded by IDSAMPLE.
+
+ Oct 2026: new SUBPROCESS_SOCKET=<path> arg: exchange GENPDF maps and
+           output tables with python driver via binary messages on
+           a Unix-domain socket instead of INPFILE/OUTFILE; files are
+           still used if socket connect fails. Print wall time per
+           SUBPROCESS step for each iteration.
+
  ******************************************************/
 
 #include "sntools.h" 
@@ -304,6 +321,7 @@ For help, run code with no arguments
 
 #ifdef USE_THREAD
 #include <pthread.h>
+#include <sys/time.h>
 #endif
 
 // ==============================================
@@ -1286,6 +1304,57 @@ typedef struct {
 
 } thread_chi2sums_def ;
 
+#ifdef USE_THREAD
+// Oct 2026: persistent thread pool for fcn. Chunk size is fixed
+// (not nthread-dependent) so that sum order is the same for any nthread.
+#define NSN_PER_CHUNK_FCN  128
+
+struct {
+  int  NTHREAD_POOL ;   // number of pool threads (caller does work too)
+  pthread_t       thread[MXTHREAD];
+  pthread_mutex_t mutex;
+  pthread_cond_t  cond_work, cond_done;
+
+  int  ICALL ;          // increment on each fcn call to wake pool threads
+  int  STOP ;           // 1 -> pool threads exit
+  int  NCHUNK, NCHUNK_ALLOC ;
+  int  NEXT_CHUNK ;     // next chunk to grab
+  int  NTHREAD_DONE ;   // number of pool threads done with current call
+  thread_chi2sums_def *CHUNK ; // input & chi2 sums per chunk
+
+  // wall-time monitor
+  int    NCALL_TIME ;
+  double TSUM_FCN, TMAX_FCN ;  // seconds
+} FCN_THREADPOOL ;
+
+// Oct 2026: threads for biasCor maps (see exec_threads_biasCor).
+#define TASK_BIASCOR_BINAVG  1  // J1D and WGT_biasCor(1) per event
+#define TASK_BIASCOR_FITPAR  2  // WGT_biasCor(2) per event
+#define TASK_BIASCOR_SIGMU   3  // muDif, muErrsq, pull per event
+#define TASK_BIASCOR_COVINT  4  // COVINT sums per IDSAMPLE
+
+typedef struct {
+  int id_thread, nthread;
+  int TASK, IDSAMPLE ;
+  int ijob_min, ijob_max ;  // range of sparse events (or IDSAMPLEs)
+  int NCUTS, NIDEAL ;       // COVINT counters
+} thread_biasCor_def ;
+
+// Per-event quantities for one IDSAMPLE, indexed by sparse index isp.
+// Each isp is written by one thread, and cell sums are made afterwards
+// in isp order so that biasCor maps do not depend on nthread.
+struct {
+  int    NALLOC ;
+  int    IDSAMPLE_FITPAR ; // IDSAMPLE for which WGT_FITPAR is loaded
+  int    *J1D ;            // biasCor cell
+  double *WGT_BINAVG ;     // WGT_biasCor(1,...)
+  double *WGT_FITPAR ;     // WGT_biasCor(2,...) uses AVG from binavg
+  int    *I1D_SIGMU ;      // MUCOVSCALE cell; -9 -> skip event
+  double *MUDIF, *MUERRSQ, *PULL ;
+  int    NCUTS_COVINT, NIDEAL_COVINT ;
+} EVTSTAGE_BIASCOR ;
+#endif
+
 
 // define fit results
 struct {
@@ -1538,6 +1607,12 @@ void  LOAD_SIGINT_ABGRID(double sigInt, int IDSAMPLE);
 
 void  makeMap_binavg_biasCor(int ISAMPLE);
 void  makeSparseList_biasCor(void);
+void  malloc_EVTSTAGE_biasCor(int NEVT);
+void  exec_threads_biasCor(int TASK, int IDSAMPLE, int NJOB);
+void *thread_biasCor_worker(void *arg);
+void  thread_biasCor_work(thread_biasCor_def *THREAD);
+void  stage_sigmu_biasCor(int IDSAMPLE, int isp);
+void  sum_COVINT_biasCor(int IDSAMPLE, int *NCUTS, int *NIDEAL);
 
 void  calc_zM0_biasCor(void);
 void  calc_zM0_data(void);
@@ -1701,6 +1776,11 @@ void mnpout_(const int* num, char chnam[], double* val, double* error,
 
 
 void *MNCHI2FUN(void *thread);
+void  init_fcn_threadpool(void);
+void  end_fcn_threadpool(void);
+void *fcn_threadpool_worker(void *arg);
+void  fcn_threadpool_work(int id_thread);
+void  print_fcn_timing(FILE *fp);
 
 typedef void (mfcn)( int* npar, double grad[], double* fval,
 	 double xval[], int* iflag, void*);
@@ -1764,9 +1844,22 @@ void SUBPROCESS_STORE_BININFO(int itable, int ivar, char *string);
 void SUBPROCESS_MAP1D_BININFO(int itable);
 void SUBPROCESS_OUTPUT_TABLE_HEADER(int itable);
 
+void SUBPROCESS_SOCKET_OPEN(void);
+void SUBPROCESS_SOCKET_RECV(void *buf, int NBYTE);
+void SUBPROCESS_SOCKET_SEND(void *buf, int NBYTE);
+void SUBPROCESS_SOCKET_READ_GENPDF(int NBYTE);
+void SUBPROCESS_SOCKET_WRITE_OUTPUT(void);
+void SUBPROCESS_MSG_GET(char *BUF, int NBYTE, int *IPTR, void *dest, int n);
+void SUBPROCESS_MSG_PUT(void *src, int n);
+void SUBPROCESS_TIME_STEP(int ISTEP);
+
 #include "sntools_genPDF.h" 
 #include "sntools_genPDF.c"
 
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <errno.h>
+
 #define KEYNAME_SUBPROCESS_STDOUT          "SALT2mu_SUBPROCESS:"
 #define KEYNAME_SUBPROCESS_ITERATION_BEGIN "ITERATION_BEGIN:"
 #define KEYNAME_SUBPROCESS_ITERATION_END   "ITERATION_END:"
@@ -1776,6 +1869,26 @@ void SUBPROCESS_OUTPUT_TABLE_HEADER(int itable);
 #define SUBPROCESS_OPTMASK_WRM0DIF  2 // write M0DIF file for each iteration
 #define SUBPROCESS_OPTMASK_RANSEED  4 // Use different set of randoms for each reweight event
 
+// Oct 2026: binary messages for SUBPROCESS_SOCKET. Each message starts
+// with 4 int: MAGIC, MSGTYPE, ITER, NBYTE(body). See SUBPROCESS_HELP.
+#define MAGIC_SUBPROCESS_MSG         0x53554250  // "SUBP"
+#define MSGTYPE_SUBPROCESS_GENPDF    1  // driver -> SALT2mu: GENPDF maps
+#define MSGTYPE_SUBPROCESS_OUTPUT    2  // SALT2mu -> driver: fit results
+#define MSGTYPE_SUBPROCESS_QUIT      3  // driver -> SALT2mu: exit
+#define NINT_HEADER_SUBPROCESS_MSG   4
+#define MXCHAR_NAME_SUBPROCESS_MSG  40  // fixed length of names in message
+#define MXCHAR_TABLE_SUBPROCESS_MSG 100 // fixed length of table name
+
+// steps timed for each iteration
+#define ISTEP_SUBPROCESS_WAIT   0  // wait for driver to send ITER
+#define ISTEP_SUBPROCESS_READ   1  // read GENPDF maps
+#define ISTEP_SUBPROCESS_REWGT  2  // reweight sim data
+#define ISTEP_SUBPROCESS_FIT    3  // BBC fit
+#define ISTEP_SUBPROCESS_WRITE  4  // load & write output tables
+#define NSTEP_SUBPROCESS        5
+char STEPNAME_SUBPROCESS[NSTEP_SUBPROCESS][8] = 
+  { "wait", "read", "rewgt", "fit", "write" } ;
+
 #define VARNAME_SIM_AV   "SIM_AV"
 #define VARNAME_SIM_RV   "SIM_RV"
 #define VARNAME_SIM_EBV  "SIM_EBV"
@@ -1819,12 +1932,17 @@ struct {
   int    NEVT_SIM_PRESCALE ;   // tune sim prescale to fit this many
   int    INPUT_ISEED;         // random seed
   int    STDOUT_CLOBBER; // default=T ==> rewind FP_STDOUT each iter
+  char  *INPUT_SOCKET ;  // optional Unix-domain socket (Oct 2026)
   
   // variables below are computed/extracted from INPUT_xxx
   char  *INPFILE ; // read PDF map from here
   char  *OUTFILE ; // write info back to python driver
   char  *STDOUT_FILE ; // direct stdout here (used only for visual debug)
   FILE  *FP_INP, *FP_OUT ;
+  int    SOCKET_FD ;    // >=0 -> use socket instead of INPFILE/OUTFILE
+  int    NBYTE_MSG ;    // body size of GENPDF message for this iter
+  char  *MSG_OUT ;      // output message buffer
+  int    NBYTE_MSG_OUT, NBYTE_MSG_OUT_ALLOC ;
   char   VARNAMES_GENPDF[MXVAR_GENPDF][40];
   int   NVAR_GENPDF;
   int   IVAR_TABLE_GENPDF[MXMAP_GENPDF][MXVAR_GENPDF]; // map GENPDF <-> TABLE
@@ -1842,6 +1960,8 @@ struct {
   // variables filled during each subprocess iteration
   int  ITER ;
   bool *KEEP_AFTER_REWGT;
+  double TWALL_LAST ;                    // wall time (sec) at last step
+  double TIME_STEP[NSTEP_SUBPROCESS];    // msec for each step
 
   // define info for each SALT2mu-output table.
   SUBPROCESS_TABLE_DEF OUTPUT_TABLE[MXTABLE_SUBPROCESS] ;
@@ -1891,6 +2011,10 @@ int main(int argc,char* argv[ ]) {
 
   if ( FLAG == FLAG_EXEC_REPEAT ) { goto DRIVER_EXEC; } // e.g., NSPLITRAN
 
+#ifdef USE_THREAD
+  end_fcn_threadpool();
+#endif
+
   fprintf(FP_STDOUT, "\n Done. \n"); fflush(FP_STDOUT);
   
   return(0) ;
@@ -1983,6 +2107,10 @@ void SALT2mu_DRIVER_INIT(int argc, char **argv) {
   SUBPROCESS_INIT();
 #endif
 
+#ifdef USE_THREAD
+  init_fcn_threadpool();
+#endif
+
   t_end_init = time(NULL);
 
   char str_cputime[60];
@@ -3781,13 +3909,20 @@ void printmsg_repeatFit(char *msg) {
 void fcn(int *npar, double grad[], double *fval, double xval[],
 	 int *iflag, void *not_used) {
 
+  // Oct 2026: 
+  //   Refactor to use persistent thread pool (see init_fcn_threadpool).
+  //   Data are split into chunks of NSN_PER_CHUNK_FCN events; the
+  //   caller and pool threads grab chunks until all are done, and
+  //   chunk sums are added in chunk order.
+
   int  NSN_DATA    = INFO_DATA.TABLEVAR.NSN_ALL ;
   int  nthread     = INPUTS.nthread ;
   int  NFITPAR_ALL = FITINP.NFITPAR_ALL ; // Ncospar + Nzbin
-  int  ipar, t, rc, NERR, NSN_per_thread, isn_min, isn_max ;
-
-  pthread_t thread[MXTHREAD];
-  thread_chi2sums_def  thread_chi2sums[MXTHREAD];
+  int  NTHREAD_POOL = FCN_THREADPOOL.NTHREAD_POOL ;
+  int  ipar, ichunk, NCHUNK, isn_min, isn_max, t ;
+  thread_chi2sums_def *CHUNK ;
+  struct timeval tv0, tv1 ;
+  double dt ;
   char fnam[] = "fcn";
 
   // ----------- BEGIN ----------------
@@ -3800,77 +3935,88 @@ void fcn(int *npar, double grad[], double *fval, double xval[],
     if ( isinf(xval[ipar]) ) { *fval = 1.0E14; return; }
   }
 
-  if ( nthread == 1 ) 
-    { NSN_per_thread = NSN_DATA; }
-  else
-    { NSN_per_thread = (int)( (float)NSN_DATA/(float)nthread )  + 1 ; } 
+  gettimeofday(&tv0, NULL);
 
-  // - - - - - - - - - - - - - - - - - - -
-  for ( t = 0; t < nthread; t++ ) {
+  // CC prior map depends only on xval; compute once here instead of
+  // in each MNCHI2FUN call.
+  if ( INFO_CCPRIOR.USE ) 
+    { fcn_ccprior_muzmap(xval, INFO_CCPRIOR.USEH11, &INFO_CCPRIOR.MUZMAP); }
 
-    isn_min = t    * NSN_per_thread;
-    isn_max = (t+1)* NSN_per_thread;
+  // - - - - - - - - - - - - - - - - - - -
+  // prepare chunks
+  NCHUNK = (NSN_DATA + NSN_PER_CHUNK_FCN - 1) / NSN_PER_CHUNK_FCN ;
+  if ( NCHUNK > FCN_THREADPOOL.NCHUNK_ALLOC ) {
+    int MEMCHUNK = NCHUNK * sizeof(thread_chi2sums_def);
+    FCN_THREADPOOL.CHUNK = 
+      (thread_chi2sums_def*) realloc(FCN_THREADPOOL.CHUNK, MEMCHUNK);
+    FCN_THREADPOOL.NCHUNK_ALLOC = NCHUNK ;
+  }
+  CHUNK = FCN_THREADPOOL.CHUNK ;
+
+  for ( ichunk = 0; ichunk < NCHUNK; ichunk++ ) {
+    isn_min = ichunk * NSN_PER_CHUNK_FCN ;
+    isn_max = isn_min + NSN_PER_CHUNK_FCN ;
     if ( isn_max > NSN_DATA ) { isn_max = NSN_DATA; }
 
-    thread_chi2sums[t].nthread   = nthread;
-    thread_chi2sums[t].id_thread = t ;
-    thread_chi2sums[t].isn_min   = isn_min ;
-    thread_chi2sums[t].isn_max   = isn_max ;
-    
+    CHUNK[ichunk].nthread   = nthread;
+    CHUNK[ichunk].id_thread = -9 ; // set by thread that does the work
+    CHUNK[ichunk].isn_min   = isn_min ;
+    CHUNK[ichunk].isn_max   = isn_max ;
 
     // load fcn args to typedef struct
-    thread_chi2sums[t].npar_fcn  = *npar ;
-    thread_chi2sums[t].iflag_fcn = *iflag ;
+    CHUNK[ichunk].npar_fcn  = *npar ;
+    CHUNK[ichunk].iflag_fcn = *iflag ;
     for(ipar=0; ipar < NFITPAR_ALL ; ipar++ ) 
-      { thread_chi2sums[t].xval_fcn[ipar] = xval[ipar];   }
-
-    if ( nthread == 1 )
-      {  MNCHI2FUN(&thread_chi2sums);  } 
-#ifdef USE_THREAD
-    else  { 
-      rc = pthread_create(&thread[t], NULL, MNCHI2FUN, 
-			  &thread_chi2sums[t] ) ; 
-    }
-#endif
-  }  // end t loop over threads
-
-  // - - - - - - - 
-#ifdef USE_THREAD
-  // for threads, wait for them all to finish
-  if ( nthread > 1 ) {
-    NERR = 0 ;
-    for ( t = 0; t < nthread; t++ ) { 
-      rc = pthread_join(thread[t], NULL); 
-      if ( rc != 0 ) {
-	NERR++; 
-	printf(" ERROR: thread return errcode=%d for t=%d\n", rc,t); }
-    }
+      { CHUNK[ichunk].xval_fcn[ipar] = xval[ipar];   }
+  }
 
-    if ( NERR > 0 ) {
-      sprintf(c1err,"%d thread return code errors", NERR);
-      sprintf(c2err,"NCALL_FCN=%d", FITRESULT.NCALL_FCN );
-      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
-    }  
-  } // end ntrhread>1
-#endif
+  // - - - - - - - - - - - - - - - - - - - 
+  // wake pool threads, do work in this thread too, then 
+  // wait for pool threads to finish.
+  pthread_mutex_lock(&FCN_THREADPOOL.mutex);
+  FCN_THREADPOOL.NCHUNK       = NCHUNK ;
+  FCN_THREADPOOL.NEXT_CHUNK   = 0 ;
+  FCN_THREADPOOL.NTHREAD_DONE = 0 ;
+  FCN_THREADPOOL.ICALL++ ;
+  if ( NTHREAD_POOL > 0 ) 
+    { pthread_cond_broadcast(&FCN_THREADPOOL.cond_work); }
+  pthread_mutex_unlock(&FCN_THREADPOOL.mutex);
+
+  fcn_threadpool_work(0);
+
+  pthread_mutex_lock(&FCN_THREADPOOL.mutex);
+  while ( FCN_THREADPOOL.NTHREAD_DONE < NTHREAD_POOL ) 
+    { pthread_cond_wait(&FCN_THREADPOOL.cond_done, &FCN_THREADPOOL.mutex); }
+  pthread_mutex_unlock(&FCN_THREADPOOL.mutex);
 
   // ===============================================
   // ============= WRAP UP =========================
   // ===============================================
 
-  // sum each thread
+  // sum each chunk in fixed order
   int nsnfit = 0, nsnfit_truecc=0;
   double chi2sum_Ia=0.0, chi2sum_tot=0.0, nsnfitIa=0.0, nsnfitcc=0.0 ;
-  //  double alpha, beta, gamma, logmass  ;
-  for ( t = 0; t < nthread; t++ ) { 
-    nsnfit        += thread_chi2sums[t].nsnfit ;
-    nsnfit_truecc += thread_chi2sums[t].nsnfit_truecc ;
-    nsnfitIa      += thread_chi2sums[t].nsnfitIa ;
-    nsnfitcc      += thread_chi2sums[t].nsnfitcc ;
-    chi2sum_Ia    += thread_chi2sums[t].chi2sum_Ia ;
-    chi2sum_tot   += thread_chi2sums[t].chi2sum_tot ;
+  int nsnfit_thread[MXTHREAD];
+  for ( t = 0; t < nthread; t++ ) { nsnfit_thread[t] = 0; }
+
+  for ( ichunk = 0; ichunk < NCHUNK; ichunk++ ) { 
+    nsnfit        += CHUNK[ichunk].nsnfit ;
+    nsnfit_truecc += CHUNK[ichunk].nsnfit_truecc ;
+    nsnfitIa      += CHUNK[ichunk].nsnfitIa ;
+    nsnfitcc      += CHUNK[ichunk].nsnfitcc ;
+    chi2sum_Ia    += CHUNK[ichunk].chi2sum_Ia ;
+    chi2sum_tot   += CHUNK[ichunk].chi2sum_tot ;
+    nsnfit_thread[CHUNK[ichunk].id_thread] += CHUNK[ichunk].nsnfit ;
   }
 
+  // check CPU-load balance on first FCN call
+  if ( FITRESULT.NCALL_FCN == 1 && nthread > 1 ) {
+    for ( t = 0; t < nthread; t++ ) {
+      printf("\t %s-%3.3d: id_thread = %d of %d  nsnfit=%d \n", 
+	     fnam, FITRESULT.NCALL_FCN, t, nthread, nsnfit_thread[t] );
+    }
+    fflush(stdout);
+  }
 
   // load globals
   FITRESULT.NSNFIT        = nsnfit ;
@@ -3892,10 +4038,186 @@ void fcn(int *npar, double grad[], double *fval, double xval[],
   
   *fval = chi2sum_tot;
 
+  // update wall-time monitor
+  gettimeofday(&tv1, NULL);
+  dt = (double)(tv1.tv_sec - tv0.tv_sec) + 
+    1.0E-6*(double)(tv1.tv_usec - tv0.tv_usec);
+  FCN_THREADPOOL.NCALL_TIME++ ;
+  FCN_THREADPOOL.TSUM_FCN += dt ;
+  if ( dt > FCN_THREADPOOL.TMAX_FCN ) { FCN_THREADPOOL.TMAX_FCN = dt; }
+
   return ;
     
 } // end fcn for pthread
 
+
+// =================================================================
+void init_fcn_threadpool(void) {
+
+  // Created Oct 2026
+  // Create nthread-1 long-lived threads that wait for each fcn call;
+  // the thread calling fcn also does work, so total = nthread.
+  // Called once from SALT2mu_DRIVER_INIT.
+
+  int  nthread = INPUTS.nthread ;
+  int  t, rc ;
+  char fnam[] = "init_fcn_threadpool" ;
+
+  // ----------- BEGIN ----------------
+
+  if ( nthread < 1 ) { nthread = INPUTS.nthread = 1; }
+
+  FCN_THREADPOOL.NTHREAD_POOL  = nthread - 1 ;
+  FCN_THREADPOOL.ICALL         = 0 ;
+  FCN_THREADPOOL.STOP          = 0 ;
+  FCN_THREADPOOL.NCHUNK        = 0 ;
+  FCN_THREADPOOL.NCHUNK_ALLOC  = 0 ;
+  FCN_THREADPOOL.NEXT_CHUNK    = 0 ;
+  FCN_THREADPOOL.NTHREAD_DONE  = 0 ;
+  FCN_THREADPOOL.CHUNK         = NULL ;
+  FCN_THREADPOOL.NCALL_TIME    = 0 ;
+  FCN_THREADPOOL.TSUM_FCN      = 0.0 ;
+  FCN_THREADPOOL.TMAX_FCN      = 0.0 ;
+
+  pthread_mutex_init(&FCN_THREADPOOL.mutex, NULL);
+  pthread_cond_init(&FCN_THREADPOOL.cond_work, NULL);
+  pthread_cond_init(&FCN_THREADPOOL.cond_done, NULL);
+
+  if ( nthread == 1 ) { return; }
+
+  fprintf(FP_STDOUT, "\n %s: create %d pool threads "
+	  "(%d events per chunk)\n", 
+	  fnam, FCN_THREADPOOL.NTHREAD_POOL, NSN_PER_CHUNK_FCN );
+  fflush(FP_STDOUT);
+
+  // pool thread t does work with id_thread = t+1
+  for ( t = 0; t < FCN_THREADPOOL.NTHREAD_POOL; t++ ) {
+    rc = pthread_create(&FCN_THREADPOOL.thread[t], NULL, 
+			fcn_threadpool_worker, (void*)(long)(t+1) );
+    if ( rc != 0 ) {
+      sprintf(c1err,"pthread_create returned errcode=%d for t=%d", rc, t);
+      sprintf(c2err,"Try smaller nthread (=%d)", nthread);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+    }
+  }
+
+  return ;
+
+} // end init_fcn_threadpool
+
+
+// =================================================================
+void end_fcn_threadpool(void) {
+
+  // Created Oct 2026
+  // Stop and join pool threads; free chunk memory.
+
+  int t;
+  // ----------- BEGIN ----------------
+
+  pthread_mutex_lock(&FCN_THREADPOOL.mutex);
+  FCN_THREADPOOL.STOP = 1;
+  pthread_cond_broadcast(&FCN_THREADPOOL.cond_work);
+  pthread_mutex_unlock(&FCN_THREADPOOL.mutex);
+
+  for ( t = 0; t < FCN_THREADPOOL.NTHREAD_POOL; t++ ) 
+    { pthread_join(FCN_THREADPOOL.thread[t], NULL); }
+
+  FCN_THREADPOOL.NTHREAD_POOL = 0 ;
+  if ( FCN_THREADPOOL.NCHUNK_ALLOC > 0 ) { free(FCN_THREADPOOL.CHUNK); }
+  FCN_THREADPOOL.CHUNK        = NULL ;
+  FCN_THREADPOOL.NCHUNK_ALLOC = 0 ;
+
+  return ;
+
+} // end end_fcn_threadpool
+
+
+// =================================================================
+void *fcn_threadpool_worker(void *arg) {
+
+  // Created Oct 2026
+  // Main loop for each pool thread: sleep until fcn increments ICALL,
+  // grab chunks until none are left, then report done to fcn.
+
+  int id_thread  = (int)(long)arg ;
+  int icall_last = 0 ;
+
+  // ----------- BEGIN ----------------
+
+  pthread_mutex_lock(&FCN_THREADPOOL.mutex);
+  while ( 1 ) {
+
+    while ( FCN_THREADPOOL.ICALL == icall_last && !FCN_THREADPOOL.STOP ) 
+      { pthread_cond_wait(&FCN_THREADPOOL.cond_work,&FCN_THREADPOOL.mutex); }
+
+    if ( FCN_THREADPOOL.STOP ) { break; }
+    icall_last = FCN_THREADPOOL.ICALL ;
+    pthread_mutex_unlock(&FCN_THREADPOOL.mutex);
+
+    fcn_threadpool_work(id_thread);
+
+    pthread_mutex_lock(&FCN_THREADPOOL.mutex);
+    FCN_THREADPOOL.NTHREAD_DONE++ ;
+    if ( FCN_THREADPOOL.NTHREAD_DONE == FCN_THREADPOOL.NTHREAD_POOL ) 
+      { pthread_cond_signal(&FCN_THREADPOOL.cond_done); }
+  }
+  pthread_mutex_unlock(&FCN_THREADPOOL.mutex);
+
+  return(void *) 0 ;
+
+} // end fcn_threadpool_worker
+
+
+// =================================================================
+void fcn_threadpool_work(int id_thread) {
+
+  // Created Oct 2026
+  // Grab next available chunk and evaluate its chi2 sums with
+  // MNCHI2FUN; repeat until all chunks are taken.
+
+  int ichunk ;
+  // ----------- BEGIN ----------------
+
+  while ( 1 ) {
+    pthread_mutex_lock(&FCN_THREADPOOL.mutex);
+    ichunk = FCN_THREADPOOL.NEXT_CHUNK++ ;
+    pthread_mutex_unlock(&FCN_THREADPOOL.mutex);
+
+    if ( ichunk >= FCN_THREADPOOL.NCHUNK ) { break; }
+
+    FCN_THREADPOOL.CHUNK[ichunk].id_thread = id_thread ;
+    MNCHI2FUN(&FCN_THREADPOOL.CHUNK[ichunk]);
+  }
+
+  return ;
+
+} // end fcn_threadpool_work
+
+
+// =================================================================
+void print_fcn_timing(FILE *fp) {
+
+  // Created Oct 2026
+  // print wall time per fcn call to monitor scaling with nthread.
+
+  int    NCALL = FCN_THREADPOOL.NCALL_TIME ;
+  double tave ;
+  // ----------- BEGIN ----------------
+
+  if ( NCALL == 0 ) { return; }
+  tave = FCN_THREADPOOL.TSUM_FCN / (double)NCALL ;
+
+  fprintf(fp, "# FCN_TIME: %.4f ms/call (max %.4f ms, %d calls, "
+	  "nthread=%d)\n",
+	  1000.0*tave, 1000.0*FCN_THREADPOOL.TMAX_FCN, NCALL, 
+	  INPUTS.nthread );
+  fflush(fp);
+
+  return ;
+
+} // end print_fcn_timing
+
 // =================================================================
 void *MNCHI2FUN(void *thread) {
 
@@ -3909,13 +4231,13 @@ void *MNCHI2FUN(void *thread) {
   // Apr 8 2021: subtract muerr_vpec from muerr_raw
   // Sep 24 2021: abort on muerrsq < 0
   // Sep 27 2021: require muCOVadd>0 to implement; fixes rare muerrsq<0 problem.
+  // Oct 2026: called for each chunk of events from thread pool;
+  //           CCPRIOR_MUZMAP is computed once in fcn.
 
   thread_chi2sums_def *thread_chi2sums = (thread_chi2sums_def *)thread;
   //  int  npar      = thread_chi2sums->npar_fcn ;
   int  iflag     = thread_chi2sums->iflag_fcn ;
   double *xval   = thread_chi2sums->xval_fcn ;
-  int  nthread   = thread_chi2sums->nthread;
-  int  id_thread = thread_chi2sums->id_thread ;
   int  isn_min   = thread_chi2sums->isn_min ;
   int  isn_max   = thread_chi2sums->isn_max ;
   char fnam[]    = "MNCHI2FUN" ;
@@ -3995,8 +4317,7 @@ void *MNCHI2FUN(void *thread) {
   CCPRIOR_MUZMAP   = &INFO_CCPRIOR.MUZMAP;
   
   if ( USE_CCPRIOR  ) {   
-    // load CCPRIOR_MUZMAP
-    fcn_ccprior_muzmap(xval, USE_CCPRIOR_H11, CCPRIOR_MUZMAP);   
+    // CCPRIOR_MUZMAP already loaded in fcn
     ProbRatio_Ia = ProbRatio_CC = 0.0 ;
   }
 
@@ -4427,13 +4748,6 @@ void *MNCHI2FUN(void *thread) {
   thread_chi2sums->chi2sum_tot   = chi2sum_tot ;
   thread_chi2sums->chi2sum_Ia    = chi2sum_Ia  ;
 
-  // check CPU-load balance on first FCN call
-  if ( FITRESULT.NCALL_FCN == 1 && nthread > 1 ) {
-    printf("\t %s-%3.3d: id_thread = %d of %d  nsnfit=%d \n", 
-	   fnam, FITRESULT.NCALL_FCN, id_thread, nthread, nsnfit );
-    fflush(stdout);
-  }
-
   return(void *) 0 ;
 
 } // end MNCHI2FUN
@@ -10311,6 +10625,163 @@ void set_MAPCELL_biasCor(int IDSAMPLE) {
 } // end set_MAPCELL_biasCor
 
 
+// ================================================================
+void malloc_EVTSTAGE_biasCor(int NEVT) {
+
+  // Created Oct 2026
+  // Make sure per-event arrays in EVTSTAGE_BIASCOR hold NEVT events.
+  // Arrays are kept for the next IDSAMPLE and next prepare_biasCor call.
+
+  int MEMI, MEMD ;
+  char fnam[] = "malloc_EVTSTAGE_biasCor" ;
+
+  // ------------ BEGIN -------------
+
+  if ( NEVT <= EVTSTAGE_BIASCOR.NALLOC ) { return; }
+
+  if ( NEVT < 1 ) { NEVT = 1; }
+  MEMI = NEVT * sizeof(int);
+  MEMD = NEVT * sizeof(double);
+
+  EVTSTAGE_BIASCOR.J1D        = (int   *)realloc(EVTSTAGE_BIASCOR.J1D,  MEMI);
+  EVTSTAGE_BIASCOR.WGT_BINAVG = 
+    (double*)realloc(EVTSTAGE_BIASCOR.WGT_BINAVG, MEMD);
+  EVTSTAGE_BIASCOR.WGT_FITPAR = 
+    (double*)realloc(EVTSTAGE_BIASCOR.WGT_FITPAR, MEMD);
+  EVTSTAGE_BIASCOR.I1D_SIGMU  = 
+    (int   *)realloc(EVTSTAGE_BIASCOR.I1D_SIGMU,  MEMI);
+  EVTSTAGE_BIASCOR.MUDIF   = (double*)realloc(EVTSTAGE_BIASCOR.MUDIF,  MEMD);
+  EVTSTAGE_BIASCOR.MUERRSQ = (double*)realloc(EVTSTAGE_BIASCOR.MUERRSQ,MEMD);
+  EVTSTAGE_BIASCOR.PULL    = (double*)realloc(EVTSTAGE_BIASCOR.PULL,   MEMD);
+
+  if ( EVTSTAGE_BIASCOR.PULL == NULL ) {
+    sprintf(c1err,"Could not realloc per-event biasCor arrays");
+    sprintf(c2err,"NEVT=%d", NEVT);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);     
+  }
+
+  EVTSTAGE_BIASCOR.NALLOC = NEVT ;
+  return ;
+
+} // end malloc_EVTSTAGE_biasCor
+
+
+// ================================================================
+void exec_threads_biasCor(int TASK, int IDSAMPLE, int NJOB) {
+
+  // Created Oct 2026
+  // Split NJOB jobs (sparse biasCor events for IDSAMPLE, or IDSAMPLEs
+  // for TASK_BIASCOR_COVINT) into contiguous ranges, one per thread.
+  // The calling thread does the first range. Number of threads is from
+  // nthread= input; nthread=1 -> no pthread.
+  // Each job writes only its own output slot, so results do not
+  // depend on nthread.
+
+  int nthread = INPUTS.nthread ;
+  int NJOB_PER_THREAD, t, rc ;
+  pthread_t          thread[MXTHREAD];
+  thread_biasCor_def THREAD[MXTHREAD];
+  char fnam[] = "exec_threads_biasCor" ;
+
+  // ------------ BEGIN -------------
+
+  if ( nthread > NJOB     ) { nthread = NJOB; }
+  if ( nthread > MXTHREAD ) { nthread = MXTHREAD; }
+  if ( nthread < 1        ) { nthread = 1; }
+
+  NJOB_PER_THREAD = (NJOB + nthread - 1) / nthread ;
+
+  for ( t = 0; t < nthread; t++ ) {
+    THREAD[t].id_thread = t ;
+    THREAD[t].nthread   = nthread ;
+    THREAD[t].TASK      = TASK ;
+    THREAD[t].IDSAMPLE  = IDSAMPLE ;
+    THREAD[t].ijob_min  = t * NJOB_PER_THREAD ;
+    THREAD[t].ijob_max  = THREAD[t].ijob_min + NJOB_PER_THREAD ;
+    if ( THREAD[t].ijob_max > NJOB ) { THREAD[t].ijob_max = NJOB; }
+    THREAD[t].NCUTS = THREAD[t].NIDEAL = 0 ;
+  }
+
+  for ( t = 1; t < nthread; t++ ) {
+    rc = pthread_create(&thread[t], NULL, thread_biasCor_worker, 
+			(void*)&THREAD[t] );
+    if ( rc != 0 ) {
+      sprintf(c1err,"pthread_create returned errcode=%d for t=%d", rc, t);
+      sprintf(c2err,"TASK=%d  IDSAMPLE=%d  nthread=%d", 
+	      TASK, IDSAMPLE, nthread);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+    }
+  }
+
+  thread_biasCor_work(&THREAD[0]);
+
+  for ( t = 1; t < nthread; t++ ) { pthread_join(thread[t], NULL); }
+
+  if ( TASK == TASK_BIASCOR_COVINT ) {
+    EVTSTAGE_BIASCOR.NCUTS_COVINT = EVTSTAGE_BIASCOR.NIDEAL_COVINT = 0;
+    for ( t = 0; t < nthread; t++ ) {
+      EVTSTAGE_BIASCOR.NCUTS_COVINT  += THREAD[t].NCUTS ;
+      EVTSTAGE_BIASCOR.NIDEAL_COVINT += THREAD[t].NIDEAL ;
+    }
+  }
+
+  return ;
+
+} // end exec_threads_biasCor
+
+
+// ================================================================
+void *thread_biasCor_worker(void *arg) {
+  // Created Oct 2026: pthread entry point for exec_threads_biasCor
+  thread_biasCor_work( (thread_biasCor_def*)arg );
+  return(void *) 0 ;
+} // end thread_biasCor_worker
+
+
+// ================================================================
+void thread_biasCor_work(thread_biasCor_def *THREAD) {
+
+  // Created Oct 2026
+  // Do the work for jobs ijob_min to ijob_max-1 of one thread.
+
+  int TASK     = THREAD->TASK ;
+  int IDSAMPLE = THREAD->IDSAMPLE ;
+  int ijob, ievt ;
+  char fnam[] = "thread_biasCor_work" ;
+
+  // ------------ BEGIN -------------
+
+  for ( ijob = THREAD->ijob_min; ijob < THREAD->ijob_max; ijob++ ) {
+
+    if ( TASK == TASK_BIASCOR_COVINT ) {
+      sum_COVINT_biasCor(ijob, &THREAD->NCUTS, &THREAD->NIDEAL);
+      continue ;
+    }
+
+    ievt = SAMPLE_BIASCOR[IDSAMPLE].IROW_CUTS[ijob] ;
+
+    if ( TASK == TASK_BIASCOR_BINAVG ) {
+      EVTSTAGE_BIASCOR.J1D[ijob]        = J1D_biasCor(ievt,fnam);
+      EVTSTAGE_BIASCOR.WGT_BINAVG[ijob] = WGT_biasCor(1,ievt,fnam);
+    }
+    else if ( TASK == TASK_BIASCOR_FITPAR ) {
+      EVTSTAGE_BIASCOR.WGT_FITPAR[ijob] = WGT_biasCor(2,ievt,fnam);
+    }
+    else if ( TASK == TASK_BIASCOR_SIGMU ) {
+      stage_sigmu_biasCor(IDSAMPLE, ijob);
+    }
+    else {
+      sprintf(c1err,"Invalid TASK=%d", TASK);
+      sprintf(c2err,"Check TASK_BIASCOR_XXX");
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);  
+    }
+  }
+
+  return ;
+
+} // end thread_biasCor_work
+
+
 // ================================================================
 void makeMap_fitPar_biasCor(int IDSAMPLE, int ipar_LCFIT) {
 
@@ -10325,6 +10796,9 @@ void makeMap_fitPar_biasCor(int IDSAMPLE, int ipar_LCFIT) {
   //
   // Aug 26 2019: account for gammadm
   // Feb 24 2020: update for ipar_LCFIT = index_mu
+  // Oct 2026: WGT and J1D per event are computed in threads
+  //           (exec_threads_biasCor) once per IDSAMPLE instead of
+  //           for each ipar_LCFIT.
   //
   // - - - - - - - - - -
 
@@ -10380,6 +10854,13 @@ void makeMap_fitPar_biasCor(int IDSAMPLE, int ipar_LCFIT) {
   }
 
 
+  // WGT does not depend on ipar_LCFIT, so compute only once per IDSAMPLE.
+  // J1D is already loaded by makeMap_binavg_biasCor.
+  if ( EVTSTAGE_BIASCOR.IDSAMPLE_FITPAR != IDSAMPLE ) {
+    exec_threads_biasCor(TASK_BIASCOR_FITPAR, IDSAMPLE, NBIASCOR_CUTS);
+    EVTSTAGE_BIASCOR.IDSAMPLE_FITPAR = IDSAMPLE ;
+  }
+
   // -----------------------------------------------
   // -------- LOOP OVER BIASCOR SIM ROWS -----------
   // -----------------------------------------------
@@ -10404,9 +10885,9 @@ void makeMap_fitPar_biasCor(int IDSAMPLE, int ipar_LCFIT) {
 
     biasVal = fit_val - sim_val ; 
 
-    WGT     = WGT_biasCor(2,ievt,fnam) ;  // WGT= WGT_pop * 1/muerr^2 for wgted average
+    WGT     = EVTSTAGE_BIASCOR.WGT_FITPAR[isp] ; // WGT_pop/muerr^2 
     WGT_pop = WGT_biasCor_population(ievt,fnam) ;
-    J1D     = J1D_biasCor(ievt,fnam);     // 1D index
+    J1D     = EVTSTAGE_BIASCOR.J1D[isp] ;        // 1D index
 
     SUMBIAS[J1D]  += (WGT * biasVal) ;
     SUMWGT[J1D]   += WGT ;
@@ -10926,6 +11407,9 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
   // Sep 14 2021: little cleanup/refac 
   // Sep 16 2021: add dump utils; see i1d_dump_mucovscale and OPTMASK
   // Jun 05 2022: write SALT2 fit params in abort msg for crazy muErr
+  // Oct 2026: move per-event muBias & muErr to stage_sigmu_biasCor, 
+  //           called in threads; cell sums are still made here in
+  //           event order.
 
   int NBIASCOR_CUTS    = SAMPLE_BIASCOR[IDSAMPLE].NBIASCOR_CUTS ;
   int NBIASCOR_ALL     = INFO_BIASCOR.TABLEVAR.NSN_ALL ;
@@ -10937,20 +11421,17 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
   bool DO_COVADD   = (INPUTS.opt_biasCor & MASK_BIASCOR_MUCOVADD) > 0;
 
   int    NBINa, NBINb, NBINg, NBINz, NBINm, NBINc, NperCell ;
-  int    OPTMASK, DUMPFLAG = 0 ;
+  int    OPTMASK ;
   int    ia, ib, ig, iz, im, ic, i1d, NCELL, isp ; 
-  int    ievt, istat_cov, istat_bias, J1D, ipar, USEMASK, nevt_biascor ;
+  int    ievt, istat_cov, J1D, USEMASK ;
   double muErr, muErrsq, muErrsq_raw, muDif, muDifsq, pull, tmp1, tmp2  ;
-  double muBias, muBiasErr, muCOVscale, muCOVadd, fitParBias[NLCPAR+1] ;
-  double a, b, gDM, z, m, c, WGT_POP ;
+  double muCOVscale, z, m, c, WGT_POP ;
   double *SUM_MUERR, *SUM_SQMUERR;
   double *SUM_MUDIF, *SUM_SQMUDIF ;
   double *SQMUERR,   *SQMUSTD ;
   double *SUM_PULL,  *SUM_SQPULL ;
   double *SIG_PULL_MAD; //1.48*MedianAbsDev
   double *SIG_PULL_STD;
-  char   *name ;
-
   int NperCell_min = MINPERCELL_MUCOVSCALE;
 
   // Declare lists for debug_mucovscale
@@ -10961,11 +11442,6 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
   double    UNDEFINED = 9999.0 ;
   float    *ptr_MUCOVSCALE;
   float    *ptr_MUCOVADD;
-  BIASCORLIST_DEF     BIASCORLIST ;
-  FITPARBIAS_DEF      FITPARBIAS[MXa][MXb][MXg] ;
-  double              MUCOVSCALE[MXa][MXb][MXg] ;
-  double              MUCOVADD[MXa][MXb][MXg] ;
-  INTERPWGT_AlphaBetaGammaDM INTERPWGT ;
  
   CELLINFO_DEF *CELL_BIASCOR    = &CELLINFO_BIASCOR[IDSAMPLE];
   CELLINFO_DEF *CELL_MUCOVSCALE = &CELLINFO_MUCOVSCALE[IDSAMPLE];
@@ -11034,8 +11510,6 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
   for(ia=0; ia< NBINa; ia++ ) {
     for(ib=0; ib< NBINb; ib++ ) {  
       for(ig=0; ig< NBINg; ig++ ) {  
-	MUCOVSCALE[ia][ib][ig] = 1.0 ; // dummy arg for get_muBias below
-	MUCOVADD[ia][ib][ig] = 1.0 ; // dummy arg for get_muBias below
 	for(iz=0; iz < NBINz; iz++ ) {
 	  for(im=0; im < NBINm; im++ ) {
 	    for(ic=0; ic < NBINc; ic++ ) {
@@ -11069,6 +11543,9 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
     }
   }
 
+  // compute muDif, muErr, pull for each event in threads
+  exec_threads_biasCor(TASK_BIASCOR_SIGMU, IDSAMPLE, NBIASCOR_CUTS);
+
   for(isp=0; isp < NBIASCOR_CUTS; isp++ ) {
 
     ievt = SAMPLE_BIASCOR[IDSAMPLE].IROW_CUTS[isp] ;
@@ -11076,121 +11553,19 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
 
     if ( debug_mucovscale > 0 ) { INFO_BIASCOR.TABLEVAR.IMUCOV[ievt] = -9;  }
 
-    // check if there is valid biasCor for this event
-    J1D = J1D_biasCor(ievt,fnam);
-    if ( CELL_BIASCOR->NperCell[J1D] < INPUTS.min_per_cell_biasCor ) 
-      { continue ; } 
-
-    for(ia=0; ia<MXa; ia++ ) {
-      for(ib=0; ib<MXb; ib++ ) {
-	for(ig=0; ig<MXg; ig++ ) {
-	  zero_FITPARBIAS(&FITPARBIAS[ia][ib][ig] ); 
-	}
-      }
-    }
+    // skip events with no valid biasCor or muBias (see stage_sigmu_biasCor)
+    i1d = EVTSTAGE_BIASCOR.I1D_SIGMU[isp] ;
+    if ( i1d < 0 ) { continue ; }
     
     z    = (double)INFO_BIASCOR.TABLEVAR.zhd[ievt];
     m    = (double)INFO_BIASCOR.TABLEVAR.host_logmass[ievt];
-    a    = (double)INFO_BIASCOR.TABLEVAR.SIM_ALPHA[ievt];
-    b    = (double)INFO_BIASCOR.TABLEVAR.SIM_BETA[ievt];
-    gDM  = (double)INFO_BIASCOR.TABLEVAR.SIM_GAMMADM[ievt];
     c    = (double)INFO_BIASCOR.TABLEVAR.fitpar[INDEX_c][ievt];
 
-    ia   = (int)INFO_BIASCOR.IA[ievt];
-    ib   = (int)INFO_BIASCOR.IB[ievt];
-    ig   = (int)INFO_BIASCOR.IG[ievt];
-
-    name = INFO_BIASCOR.TABLEVAR.name[ievt];
-    for(ipar=0; ipar < NLCPAR; ipar++ ) 
-      { BIASCORLIST.FITPAR[ipar] = 
-	  (double)INFO_BIASCOR.TABLEVAR.fitpar[ipar][ievt]; 
-      }
-    BIASCORLIST.FITPAR[INDEX_mu] = 0.0; // mu slot not used
-
-    // allow color (c) and logmass to be outside map
-    iz = IBINFUN(z, &CELL_MUCOVSCALE->BININFO_z, 
-		 1, fnam );
-
-    im = IBINFUN(m, &CELL_MUCOVSCALE->BININFO_m, 
-		 2, fnam );
-
-    ic = IBINFUN(c, &CELL_MUCOVSCALE->BININFO_LCFIT[INDEX_c], 
-		 2, fnam );
-
-    // ---------------------------------------------------
-    // need bias corrected distance to compute pull
-
-    BIASCORLIST.z            = z ;
-    BIASCORLIST.host_logmass = m ;
-    BIASCORLIST.alpha        = a ;
-    BIASCORLIST.beta         = b ;
-    BIASCORLIST.gammadm      = gDM ;
-    BIASCORLIST.idsample     = IDSAMPLE ;
-
-    istat_bias = 
-      get_fitParBias(name, &BIASCORLIST, DUMPFLAG, fnam, 
-		     &FITPARBIAS[ia][ib][ig] ); // <== returned
-
-    //  DUMPFLAG = 0 ; // xxx REMOVE
-
-    // skip if bias cannot be computed, just like for data
-    if ( istat_bias <= 0 ) { continue ; }
-
-    get_INTERPWGT_abg(a,b,gDM, DUMPFLAG, &INTERPWGT, fnam );
-    get_muBias(name, &BIASCORLIST, FITPARBIAS,MUCOVSCALE,MUCOVADD, &INTERPWGT,
-	       fitParBias, &muBias, &muBiasErr, &muCOVscale, &muCOVadd,
-	       &nevt_biascor);  
-
-    // ----------------------------
-    muDif   =  muresid_biasCor(ievt);  // mu - muTrue
-    muDif  -=  muBias ;  
-    muDifsq =  muDif*muDif ;
-
-    // compute error with intrinsic scatter
-    // 2.10.2023: include vpec uncertainties in muerr computation
-    if ( DO_COVADD )
-      { USEMASK = USEMASK_BIASCOR_COVFIT + USEMASK_BIASCOR_ZMUERR; }
-    else
-      { USEMASK = USEMASK_BIASCOR_COVTOT + USEMASK_BIASCOR_ZMUERR; }
-
-    // - - - -  restore bugs - - - - - -
-    if ( INPUTS.restore_bug_muzerr )
-      { USEMASK = USEMASK_BIASCOR_COVTOT; } // not including VPEC uncertainties
-
-    if ( DO_COVADD && INPUTS.restore_bug2_mucovadd ) // May 30 2023
-      { USEMASK = USEMASK_BIASCOR_COVTOT + USEMASK_BIASCOR_ZMUERR; }
-
-    // - - - - - 
-
-    muErrsq = muerrsq_biasCor(ievt, USEMASK, &istat_cov, fnam) ; 
-
-    if ( muErrsq <= 1.0E-14 || muErrsq > 100.0 || isnan(muErrsq) ) {
-      print_preAbort_banner(fnam);
-      printf("\t z=%f  a=%f  b=%f  gDM=%f\n",
-	     z, a, b, gDM);
-      printf("\t ia,ib,ig = %d, %d, %d \n", ia, ib, ig);
-      printf("\t istat_cov = %d \n", istat_cov);
-      printf("\t IDSAMPLE=%d (%s) \n",
-	     IDSAMPLE, SAMPLE_BIASCOR[IDSAMPLE].NAME );
-      for(ipar=0; ipar < NLCPAR; ipar++ ) { 
-	char *name = BIASCOR_NAME_LCFIT[ipar];
-	float val  = INFO_BIASCOR.TABLEVAR.fitpar[ipar][ievt]; 
-	float err  = INFO_BIASCOR.TABLEVAR.fitpar_err[ipar][ievt]; 
-	printf("\t %3s = %f +_ %f \n", name, val, err); 
-	fflush(stdout);
-      }
-
-      sprintf(c1err,"Invalid muErrsq=%f for ievt=%d (SNID=%s)", 
-	      muErrsq, ievt, name );
-      sprintf(c2err,"Something is messed up.");
-      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);     
-    }
-
+    muDif   = EVTSTAGE_BIASCOR.MUDIF[isp] ;
+    muDifsq = muDif*muDif ;
+    muErrsq = EVTSTAGE_BIASCOR.MUERRSQ[isp] ;
     muErr   = sqrt(muErrsq) ;    
-    pull    = (muDif/muErr) ;
-
-    // get 1d index
-    i1d = CELL_MUCOVSCALE->MAPCELL[ia][ib][ig][iz][im][0][ic] ;
+    pull    = EVTSTAGE_BIASCOR.PULL[isp] ;
 
     if ( debug_mucovscale > 0 ) {
       INFO_BIASCOR.TABLEVAR.IMUCOV[ievt] = i1d;
@@ -11465,6 +11840,164 @@ void makeMap_sigmu_biasCor(int IDSAMPLE) {
 } // end makeMap_sigmu_biasCor
 
 
+// ======================================================
+void stage_sigmu_biasCor(int IDSAMPLE, int isp) {
+
+  // Created Oct 2026
+  // Per-event part of makeMap_sigmu_biasCor, moved here so that it
+  // can run in threads (exec_threads_biasCor). For sparse event isp,
+  // load muDif, muErrsq and pull into EVTSTAGE_BIASCOR; 
+  // I1D_SIGMU = -9 if event has no valid biasCor or muBias.
+
+  int  ievt      = SAMPLE_BIASCOR[IDSAMPLE].IROW_CUTS[isp] ;
+  bool DO_COVADD = (INPUTS.opt_biasCor & MASK_BIASCOR_MUCOVADD) > 0;
+  int  DUMPFLAG  = 0 ;
+
+  int    ia, ib, ig, iz, im, ic, J1D, ipar ;
+  int    istat_cov, istat_bias, USEMASK, nevt_biascor ;
+  double muErr, muErrsq, muDif, pull ;
+  double muBias, muBiasErr, muCOVscale, muCOVadd, fitParBias[NLCPAR+1] ;
+  double a, b, gDM, z, m, c ;
+  char   *name ;
+
+  BIASCORLIST_DEF     BIASCORLIST ;
+  FITPARBIAS_DEF      FITPARBIAS[MXa][MXb][MXg] ;
+  double              MUCOVSCALE[MXa][MXb][MXg] ;
+  double              MUCOVADD[MXa][MXb][MXg] ;
+  INTERPWGT_AlphaBetaGammaDM INTERPWGT ;
+
+  CELLINFO_DEF *CELL_BIASCOR    = &CELLINFO_BIASCOR[IDSAMPLE];
+  CELLINFO_DEF *CELL_MUCOVSCALE = &CELLINFO_MUCOVSCALE[IDSAMPLE];
+
+  char fnam[]  = "makeMap_sigmu_biasCor" ; // for error msg
+  
+  // ----------------- BEGIN -------------------
+
+  EVTSTAGE_BIASCOR.I1D_SIGMU[isp] = -9 ;
+
+  // check if there is valid biasCor for this event
+  J1D = EVTSTAGE_BIASCOR.J1D[isp] ;
+  if ( CELL_BIASCOR->NperCell[J1D] < INPUTS.min_per_cell_biasCor ) 
+    { return ; } 
+
+  for(ia=0; ia<MXa; ia++ ) {
+    for(ib=0; ib<MXb; ib++ ) {
+      for(ig=0; ig<MXg; ig++ ) {
+	zero_FITPARBIAS(&FITPARBIAS[ia][ib][ig] ); 
+	MUCOVSCALE[ia][ib][ig] = 1.0 ; // dummy arg for get_muBias below
+	MUCOVADD[ia][ib][ig]   = 1.0 ;
+      }
+    }
+  }
+  
+  z    = (double)INFO_BIASCOR.TABLEVAR.zhd[ievt];
+  m    = (double)INFO_BIASCOR.TABLEVAR.host_logmass[ievt];
+  a    = (double)INFO_BIASCOR.TABLEVAR.SIM_ALPHA[ievt];
+  b    = (double)INFO_BIASCOR.TABLEVAR.SIM_BETA[ievt];
+  gDM  = (double)INFO_BIASCOR.TABLEVAR.SIM_GAMMADM[ievt];
+  c    = (double)INFO_BIASCOR.TABLEVAR.fitpar[INDEX_c][ievt];
+
+  ia   = (int)INFO_BIASCOR.IA[ievt];
+  ib   = (int)INFO_BIASCOR.IB[ievt];
+  ig   = (int)INFO_BIASCOR.IG[ievt];
+
+  name = INFO_BIASCOR.TABLEVAR.name[ievt];
+  for(ipar=0; ipar < NLCPAR; ipar++ ) 
+    { BIASCORLIST.FITPAR[ipar] = 
+	(double)INFO_BIASCOR.TABLEVAR.fitpar[ipar][ievt]; 
+    }
+  BIASCORLIST.FITPAR[INDEX_mu] = 0.0; // mu slot not used
+
+  // allow color (c) and logmass to be outside map
+  iz = IBINFUN(z, &CELL_MUCOVSCALE->BININFO_z, 
+	       1, fnam );
+
+  im = IBINFUN(m, &CELL_MUCOVSCALE->BININFO_m, 
+	       2, fnam );
+
+  ic = IBINFUN(c, &CELL_MUCOVSCALE->BININFO_LCFIT[INDEX_c], 
+	       2, fnam );
+
+  // ---------------------------------------------------
+  // need bias corrected distance to compute pull
+
+  BIASCORLIST.z            = z ;
+  BIASCORLIST.host_logmass = m ;
+  BIASCORLIST.alpha        = a ;
+  BIASCORLIST.beta         = b ;
+  BIASCORLIST.gammadm      = gDM ;
+  BIASCORLIST.idsample     = IDSAMPLE ;
+
+  istat_bias = 
+    get_fitParBias(name, &BIASCORLIST, DUMPFLAG, fnam, 
+		   &FITPARBIAS[ia][ib][ig] ); // <== returned
+
+  // skip if bias cannot be computed, just like for data
+  if ( istat_bias <= 0 ) { return ; }
+
+  get_INTERPWGT_abg(a,b,gDM, DUMPFLAG, &INTERPWGT, fnam );
+  get_muBias(name, &BIASCORLIST, FITPARBIAS,MUCOVSCALE,MUCOVADD, &INTERPWGT,
+	     fitParBias, &muBias, &muBiasErr, &muCOVscale, &muCOVadd,
+	     &nevt_biascor);  
+
+  // ----------------------------
+  muDif   =  muresid_biasCor(ievt);  // mu - muTrue
+  muDif  -=  muBias ;  
+
+  // compute error with intrinsic scatter
+  // 2.10.2023: include vpec uncertainties in muerr computation
+  if ( DO_COVADD )
+    { USEMASK = USEMASK_BIASCOR_COVFIT + USEMASK_BIASCOR_ZMUERR; }
+  else
+    { USEMASK = USEMASK_BIASCOR_COVTOT + USEMASK_BIASCOR_ZMUERR; }
+
+  // - - - -  restore bugs - - - - - -
+  if ( INPUTS.restore_bug_muzerr )
+    { USEMASK = USEMASK_BIASCOR_COVTOT; } // not including VPEC uncertainties
+
+  if ( DO_COVADD && INPUTS.restore_bug2_mucovadd ) // May 30 2023
+    { USEMASK = USEMASK_BIASCOR_COVTOT + USEMASK_BIASCOR_ZMUERR; }
+
+  // - - - - - 
+
+  muErrsq = muerrsq_biasCor(ievt, USEMASK, &istat_cov, fnam) ; 
+
+  if ( muErrsq <= 1.0E-14 || muErrsq > 100.0 || isnan(muErrsq) ) {
+    print_preAbort_banner(fnam);
+    printf("\t z=%f  a=%f  b=%f  gDM=%f\n",
+	   z, a, b, gDM);
+    printf("\t ia,ib,ig = %d, %d, %d \n", ia, ib, ig);
+    printf("\t istat_cov = %d \n", istat_cov);
+    printf("\t IDSAMPLE=%d (%s) \n",
+	   IDSAMPLE, SAMPLE_BIASCOR[IDSAMPLE].NAME );
+    for(ipar=0; ipar < NLCPAR; ipar++ ) { 
+      char *name = BIASCOR_NAME_LCFIT[ipar];
+      float val  = INFO_BIASCOR.TABLEVAR.fitpar[ipar][ievt]; 
+      float err  = INFO_BIASCOR.TABLEVAR.fitpar_err[ipar][ievt]; 
+      printf("\t %3s = %f +_ %f \n", name, val, err); 
+      fflush(stdout);
+    }
+
+    sprintf(c1err,"Invalid muErrsq=%f for ievt=%d (SNID=%s)", 
+	    muErrsq, ievt, name );
+    sprintf(c2err,"Something is messed up.");
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);     
+  }
+
+  muErr   = sqrt(muErrsq) ;    
+  pull    = (muDif/muErr) ;
+
+  // load per-event output
+  EVTSTAGE_BIASCOR.MUDIF[isp]     = muDif ;
+  EVTSTAGE_BIASCOR.MUERRSQ[isp]   = muErrsq ;
+  EVTSTAGE_BIASCOR.PULL[isp]      = pull ;
+  EVTSTAGE_BIASCOR.I1D_SIGMU[isp] = 
+    CELL_MUCOVSCALE->MAPCELL[ia][ib][ig][iz][im][0][ic] ;
+
+  return ;
+
+} // end stage_sigmu_biasCor
+
 // ======================================================
 void  store_iaib_biasCor(void) {
 
@@ -11905,15 +12438,17 @@ void init_COVINT_biasCor(void) {
   // * For emprical method (IDEAL_COVINT=1), compute COV in bins of
   //   idsample,redshift,alpha,beta
   //
+  // Oct 2026: sums for each idsample are made in sum_COVINT_biasCor,
+  //           with idsamples split among threads.
+  //
 
   int  DO_IDEAL_COVINT = ( INPUTS.opt_biasCor & MASK_BIASCOR_COVINT ) ;
   int  DO_COV00_ONLY   = ( DO_IDEAL_COVINT ==0 ) ;
   int  NSAMPLE  = NSAMPLE_BIASCOR ;
-  int  NROW_TOT = INFO_BIASCOR.TABLEVAR.NSN_ALL ; 
   int  Na       = INFO_BIASCOR.BININFO_SIM_ALPHA.nbin ;
   int  Nb       = INFO_BIASCOR.BININFO_SIM_BETA.nbin ;
   int  Ng       = INFO_BIASCOR.BININFO_SIM_GAMMADM.nbin ;
-  int  Nz, idsample, iz, ia, ib, ig, ievt, ipar, ipar2 ; 
+  int  Nz, idsample, iz, ia, ib, ig ; 
   double sigInt, COV ;
   char fnam[] = "init_COVINT_biasCor" ;
 
@@ -11933,43 +12468,102 @@ void init_COVINT_biasCor(void) {
   // zero out entire COV matrix.
   // For traditional sigma_int model (IDEAL_COVINT=0), set COV[0][0]
   for(idsample=0; idsample < NSAMPLE; idsample++ ) {
-    zero_COV(INFO_BIASCOR.COVINT_AVG[idsample].VAL) ;
+    zero_COV(INFO_BIASCOR.COVINT_AVG[idsample].VAL) ;
+    Nz       = CELLINFO_BIASCOR[idsample].BININFO_z.nbin ;
+    for(iz=0; iz < Nz; iz++ ) {
+      for(ia=0; ia < Na; ia++ ) {
+	for(ib=0; ib < Nb; ib++ ) {
+	  for(ig=0; ig < Ng; ig++ ) {
+	    zero_COV(INFO_BIASCOR.COVINT[idsample][iz][ia][ib][ig].VAL) ;
+	    INFO_BIASCOR.NEVT_COVINT[idsample][iz][ia][ib][ig] = 0 ;
+	    if ( DO_COV00_ONLY ) {
+	      sigInt = INFO_BIASCOR.SIGINT_ABGRID[idsample][ia][ib][ig]; 
+	      COV    = (sigInt * sigInt) ;
+	      INFO_BIASCOR.COVINT[idsample][iz][ia][ib][ig].VAL[0][0] = COV ;
+	    }
+
+	  } // end ig
+	} // end ib
+      } // and ia
+    } // ene iz
+  }  // end idsample
+
+
+  if ( DO_COV00_ONLY ) { return ; }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - 
+  // If we get here, compute full COV matrix in bins of 
+  // IDSAMPLE, z, a, b  
+  //   COV(x,y) = sum[(x-xtrue)*(y-ytrue) ] / N
+
+  // sums for each IDSAMPLE are independent, so run IDSAMPLEs in threads
+  int NBIASCOR_IDEAL, NBIASCOR_CUTS ;
+  exec_threads_biasCor(TASK_BIASCOR_COVINT, -9, NSAMPLE);
+  NBIASCOR_CUTS  = EVTSTAGE_BIASCOR.NCUTS_COVINT ;
+  NBIASCOR_IDEAL = EVTSTAGE_BIASCOR.NIDEAL_COVINT ;
+
+
+  fprintf(FP_STDOUT, "\t %d of %d BiasCor events have IDEAL fit params. \n",
+	 NBIASCOR_IDEAL, NBIASCOR_CUTS);
+  fflush(FP_STDOUT) ;
+
+  // - - - - - - - - - - - - - - - - - 
+
+  // divide each sum-term by N, and load symmetric part of matrix
+  int N;
+  double XNINV;
+
+  for(idsample=0; idsample < NSAMPLE; idsample++ ) {
     Nz       = CELLINFO_BIASCOR[idsample].BININFO_z.nbin ;
     for(iz=0; iz < Nz; iz++ ) {
       for(ia=0; ia < Na; ia++ ) {
 	for(ib=0; ib < Nb; ib++ ) {
 	  for(ig=0; ig < Ng; ig++ ) {
-	    zero_COV(INFO_BIASCOR.COVINT[idsample][iz][ia][ib][ig].VAL) ;
-	    INFO_BIASCOR.NEVT_COVINT[idsample][iz][ia][ib][ig] = 0 ;
-	    if ( DO_COV00_ONLY ) {
-	      sigInt = INFO_BIASCOR.SIGINT_ABGRID[idsample][ia][ib][ig]; 
-	      COV    = (sigInt * sigInt) ;
-	      INFO_BIASCOR.COVINT[idsample][iz][ia][ib][ig].VAL[0][0] = COV ;
+	  
+	    N = INFO_BIASCOR.NEVT_COVINT[idsample][iz][ia][ib][ig]; 
+	    if ( N > 0 ) {
+	      XNINV = 1.0/(double)N;
+	      scale_COV(XNINV,INFO_BIASCOR.COVINT[idsample][iz][ia][ib][ig].VAL);
 	    }
-
+	    
+	    
+	    if ( iz < -4 ) { dump_COVINT_biasCor(idsample,iz,ia,ib,ig); }
 	  } // end ig
-	} // end ib
-      } // and ia
-    } // ene iz
-  }  // end idsample
+	}
+      }
+    }
+  }
 
+  
+  write_COVINT_biasCor();
 
-  if ( DO_COV00_ONLY ) { return ; }
 
-  // - - - - - - - - - - - - - - - - - - - - - - - - - 
-  // - - - - - - - - - - - - - - - - - - - - - - - - - 
-  // If we get here, compute full COV matrix in bins of 
-  // IDSAMPLE, z, a, b  
-  //   COV(x,y) = sum[(x-xtrue)*(y-ytrue) ] / N
+  return ;
+
+} // end init_COVINT_biasCor
+
+// ======================================================
+void sum_COVINT_biasCor(int idsample, int *NCUTS, int *NIDEAL) {
+
+  // Created Oct 2026
+  // Moved from init_COVINT_biasCor: increment COVINT sums for
+  // biasCor events in idsample, using sparse list from 
+  // makeSparseList_biasCor. Each idsample has its own COVINT cells,
+  // so this function can run in parallel threads for different idsample.
+  // Output NCUTS and NIDEAL are incremented.
 
-  int NBIASCOR_IDEAL=0, NBIASCOR_CUTS=0 ;
+  int    NBIASCOR_CUTS = SAMPLE_BIASCOR[idsample].NBIASCOR_CUTS ;
+  int    isp, ievt, iz, ia, ib, ig, ipar, ipar2 ;
   double tmpVal, tmpVal2, x0_IDEAL, mB_IDEAL ;
 
-  for(ievt=0; ievt < NROW_TOT; ievt++ ) {
+  // ------------- BEGIN ---------------
+
+  *NCUTS += NBIASCOR_CUTS ;
 
-    // apply selection
-    if ( INFO_BIASCOR.TABLEVAR.CUTMASK[ievt] ) { continue; }
-    NBIASCOR_CUTS++ ;
+  for(isp=0; isp < NBIASCOR_CUTS; isp++ ) {
+
+    ievt = SAMPLE_BIASCOR[idsample].IROW_CUTS[isp] ;
 
     // check for valid IDEAL fit params 
     tmpVal = INFO_BIASCOR.TABLEVAR.fitpar_ideal[INDEX_mB][ievt];
@@ -11986,7 +12580,6 @@ void init_COVINT_biasCor(void) {
       INFO_BIASCOR.TABLEVAR.SIM_FITPAR[INDEX_mB][ievt] ;
     if ( fabs(tmpVal) > 1.0 ) { continue ; }
 
-    idsample = (int)INFO_BIASCOR.TABLEVAR.IDSAMPLE[ievt];
     ia       = (int)INFO_BIASCOR.IA[ievt] ; // true alpha index
     ib       = (int)INFO_BIASCOR.IB[ievt] ; // true beta index
     ig       = (int)INFO_BIASCOR.IG[ievt] ; // true gamma DM
@@ -12023,49 +12616,14 @@ void init_COVINT_biasCor(void) {
       }
     }
 
-    NBIASCOR_IDEAL++ ;
-
-  } // end ievt loop
-
-
-  fprintf(FP_STDOUT, "\t %d of %d BiasCor events have IDEAL fit params. \n",
-	 NBIASCOR_IDEAL, NBIASCOR_CUTS);
-  fflush(FP_STDOUT) ;
-
-  // - - - - - - - - - - - - - - - - - 
-
-  // divide each sum-term by N, and load symmetric part of matrix
-  int N;
-  double XNINV;
-
-  for(idsample=0; idsample < NSAMPLE; idsample++ ) {
-    Nz       = CELLINFO_BIASCOR[idsample].BININFO_z.nbin ;
-    for(iz=0; iz < Nz; iz++ ) {
-      for(ia=0; ia < Na; ia++ ) {
-	for(ib=0; ib < Nb; ib++ ) {
-	  for(ig=0; ig < Ng; ig++ ) {
-	  
-	    N = INFO_BIASCOR.NEVT_COVINT[idsample][iz][ia][ib][ig]; 
-	    if ( N > 0 ) {
-	      XNINV = 1.0/(double)N;
-	      scale_COV(XNINV,INFO_BIASCOR.COVINT[idsample][iz][ia][ib][ig].VAL);
-	    }
-	    
-	    
-	    if ( iz < -4 ) { dump_COVINT_biasCor(idsample,iz,ia,ib,ig); }
-	  } // end ig
-	}
-      }
-    }
-  }
-
-  
-  write_COVINT_biasCor();
+    (*NIDEAL)++ ;
 
+  } // end isp loop
 
   return ;
 
-} // end init_COVINT_biasCor
+} // end sum_COVINT_biasCor
+
 
 
 // ======================================================
@@ -12722,6 +13280,8 @@ void  makeMap_binavg_biasCor(int IDSAMPLE) {
   // as interpolation nodes. The bin-center is not the
   // right quantity for interpolation.
   //
+  // Oct 2026: compute J1D and WGT per event in threads, and store 
+  //           them in EVTSTAGE_BIASCOR for makeMap_fitPar_biasCor.
   // 
   int NCELL   = CELLINFO_BIASCOR[IDSAMPLE].NCELL;
   int NROW    = SAMPLE_BIASCOR[IDSAMPLE].NBIASCOR_CUTS ;
@@ -12765,14 +13325,19 @@ void  makeMap_binavg_biasCor(int IDSAMPLE) {
   }
 
 
+  // per-event WGT and J1D for this IDSAMPLE
+  malloc_EVTSTAGE_biasCor(NROW);
+  EVTSTAGE_BIASCOR.IDSAMPLE_FITPAR = -9 ;
+  exec_threads_biasCor(TASK_BIASCOR_BINAVG, IDSAMPLE, NROW);
+
   // loop over biasCor sample ...
   for(isp=0; isp < NROW; isp++ ) {
 
     irow = SAMPLE_BIASCOR[IDSAMPLE].IROW_CUTS[isp] ;
 
-    WGT = WGT_biasCor(1,irow,fnam) ;  // WGT = WGT_population 1/muerr^2
+    WGT = EVTSTAGE_BIASCOR.WGT_BINAVG[isp] ; // WGT_population/muerr^2
 
-    J1D = J1D_biasCor(irow,fnam);     // 1D index
+    J1D = EVTSTAGE_BIASCOR.J1D[isp];      // 1D index
     NperCell[J1D]++ ; // not used ??
     SUM_WGT_5D[J1D] += WGT ;
 
@@ -16779,6 +17344,10 @@ int ppar(char* item) {
   if ( uniqueOverlap(item,"SUBPROCESS_OPTMASK=") ) {
     sscanf(&item[19], "%d", &SUBPROCESS.INPUT_OPTMASK ); return(1);
   }
+  if ( uniqueOverlap(item,"SUBPROCESS_SOCKET=") ) {
+    s = SUBPROCESS.INPUT_SOCKET ; // Unix-domain socket path
+    sscanf(&item[18],"%s",s); remove_quote(s); return(1);
+  }
 
 #endif
 
@@ -20624,6 +21193,9 @@ void write_fitres_driver(char* fileName) {
     write_version_info(fout);
     fprintf(fout,"# %s\n", STRING_MINUIT_ERROR[INPUTS.minos]);
     fprintf(fout,"# NCALL_FCN: %d \n", FITRESULT.NCALL_FCN );
+#ifdef USE_THREAD
+    print_fcn_timing(fout);
+#endif
     fprintf(fout,"# CPU: %.2f minutes\n",
 	    (t_end_fit-t_start_fit)/60.0  );
     if ( INPUTS.blindFlag > 0 && ISDATA_REAL ) 
@@ -22673,6 +23245,9 @@ void SUBPROCESS_MALLOC_INPUTS(void) {
   SUBPROCESS.INPUT_SIMREF_FILE =
     (char*) malloc( MXCHAR_FILENAME*sizeof(char) );
 
+  SUBPROCESS.INPUT_SOCKET =
+    (char*) malloc( MXCHAR_FILENAME*sizeof(char) );
+
   SUBPROCESS.N_OUTPUT_TABLE = 0 ;
   SUBPROCESS.INPUT_OUTPUT_TABLE =  (char**) malloc( 10*sizeof(char*) );
   for(i=0; i < 10; i++ ) {
@@ -22684,6 +23259,7 @@ void SUBPROCESS_MALLOC_INPUTS(void) {
   SUBPROCESS.INPUT_CID_REWGT_DUMP[0] = 0 ;
   SUBPROCESS.INPUT_VARNAMES_GENPDF_STRING[0] = 0;
   SUBPROCESS.INPUT_SIMREF_FILE[0] = 0;
+  SUBPROCESS.INPUT_SOCKET[0] = 0;
 
     return ;
 } // end SUBPROCESS_MALLOC_INPUTS
@@ -22716,6 +23292,24 @@ void  SUBPROCESS_HELP(void) {
 	 "\t CID < 10 -> isn index (e.g. CID=2 -> dump 2nd event)\n"
 	 "\t CID > 10 -> dump this exact CID\n"
 	 "\n" 
+	 "SUBPROCESS_SOCKET=<path>    (optional) \n"
+	 "\t connect to Unix-domain socket created by driver, and use\n"
+	 "\t binary messages instead of inpFile and outFile. If connect\n"
+	 "\t fails, inpFile and outFile are used. Each message is\n"
+	 "\t   int MAGIC(0x53554250) MSGTYPE ITER NBYTE ; NBYTE body bytes\n"
+	 "\t MSGTYPE=1 (GENPDF, driver->SALT2mu; replaces std input ITER):\n"
+	 "\t   int NMAP; per map: int NDIM NROW, "
+	 "char[40] VARNAME x (NDIM+1),\n"
+	 "\t   double VAL[NDIM+1][NROW] (last column is PROB)\n"
+	 "\t MSGTYPE=2 (OUTPUT, SALT2mu->driver):\n"
+	 "\t   int NSNFIT; double TIME_MSEC[4]; int NPAR; "
+	 "per par: char[40] NAME, double VAL ERR;\n"
+	 "\t   int NTABLE; per table: char[100] NAME, int NVAR NBINTOT;\n"
+	 "\t   per bin: int IBIN[NVAR] NEVT, "
+	 "double MURES_SUM STD STD_ROBUST\n"
+	 "\t MSGTYPE=3 (QUIT, driver->SALT2mu)\n"
+	 "\t Native byte order, no padding.\n"
+	 "\n" 
 	 "Example of full SUBPROCESS command:\n"
 	 "SALT2mu.exe SALT2mu_SIMDATA.input \\\n"
 	 "   SUBPROCESS_FILES="
@@ -22763,9 +23357,18 @@ void  SUBPROCESS_INIT(void) {
   tmpFiles[1]   = SUBPROCESS.OUTFILE ;
   tmpFiles[2]   = SUBPROCESS.STDOUT_FILE ;
   splitString(SUBPROCESS.INPUT_FILES, ",", fnam, 3, &NSPLIT, tmpFiles);
+
+  // Oct 2026: check option to use socket instead of INPFILE and OUTFILE
+  SUBPROCESS.SOCKET_FD  = -9 ;
+  SUBPROCESS.MSG_OUT    = NULL ;
+  SUBPROCESS.NBYTE_MSG_OUT = SUBPROCESS.NBYTE_MSG_OUT_ALLOC = 0 ;
+  if ( strlen(SUBPROCESS.INPUT_SOCKET) > 0 ) { SUBPROCESS_SOCKET_OPEN(); }
   
   // open INPFILE in read mode, but only for sim data.
   // skip for real data since there is nothing to rewgt.
+  if ( SUBPROCESS.SOCKET_FD >= 0 ) 
+    { goto OPEN_STDOUT; }
+
   if ( !ISDATA_REAL ) {
     SUBPROCESS.FP_INP = fopen(SUBPROCESS.INPFILE, "rt");
     if ( !SUBPROCESS.FP_INP ) {
@@ -22795,6 +23398,7 @@ void  SUBPROCESS_INIT(void) {
     fflush(stdout);
   }
 
+ OPEN_STDOUT:
   // open SALT2mu-LOGFILE in write mode
   FP_STDOUT = fopen(SUBPROCESS.STDOUT_FILE, "wt");
   if ( !FP_STDOUT ) {
@@ -22832,6 +23436,8 @@ void  SUBPROCESS_INIT(void) {
   printf("%s  Finished %s\n", KEYNAME_SUBPROCESS_STDOUT, fnam );
   fflush(stdout);
 
+  SUBPROCESS_TIME_STEP(-1); // start wall-time clock
+
   //  debugexit(fnam);
   return ;
 
@@ -23252,26 +23858,58 @@ void SUBPROCESS_PREP_NEXTITER(void) {
   // For sim, prepare for next iteration.
 
   int  ITER_EXPECT = -9 ;
+  int  HEADER[NINT_HEADER_SUBPROCESS_MSG];
   char fnam[] = "SUBPROCESS_PREP_NEXTITER";
 
   // --------- BEGIN -------------
 
   if ( ISDATA_REAL ) { return ; }
 
-  // request expected iteration number to be entered as std input
-  // or q to quit
+  SUBPROCESS_TIME_STEP(-1);
+
+  if ( SUBPROCESS.SOCKET_FD >= 0 ) {
+    // Oct 2026: ITER is in header of next message from driver
+    printf("\n%s Wait for GENPDF message on socket => \n",
+	   KEYNAME_SUBPROCESS_STDOUT );   fflush(stdout);
+    SUBPROCESS_SOCKET_RECV(HEADER, sizeof(HEADER) );
+    if ( HEADER[0] != MAGIC_SUBPROCESS_MSG ) {
+      SUBPROCESS_REMIND_STDOUT();
+      sprintf(c1err,"Invalid MAGIC=0x%x in socket message header", 
+	      HEADER[0]);
+      sprintf(c2err,"Expected MAGIC=0x%x", MAGIC_SUBPROCESS_MSG);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+    }
+    if ( HEADER[1] == MSGTYPE_SUBPROCESS_QUIT ) { SUBPROCESS_EXIT(); }
+    if ( HEADER[1] != MSGTYPE_SUBPROCESS_GENPDF ) {
+      SUBPROCESS_REMIND_STDOUT();
+      sprintf(c1err,"Invalid MSGTYPE=%d in socket message header", 
+	      HEADER[1]);
+      sprintf(c2err,"Expected MSGTYPE=%d(GENPDF) or %d(QUIT)", 
+	      MSGTYPE_SUBPROCESS_GENPDF, MSGTYPE_SUBPROCESS_QUIT);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+    }
+    ITER_EXPECT          = HEADER[2] ;
+    SUBPROCESS.NBYTE_MSG = HEADER[3] ;
+  }
+  else {
+    // request expected iteration number to be entered as std input
+    // or q to quit
+    printf("\n%s Enter expected ITERATION number (-1 to quit) => \n",
+	   KEYNAME_SUBPROCESS_STDOUT );   fflush(stdout);
+    scanf( "%d", &ITER_EXPECT); // read response
+  }
 
-  printf("\n%s Enter expected ITERATION number (-1 to quit) => \n",
-	 KEYNAME_SUBPROCESS_STDOUT );   fflush(stdout);
-  scanf( "%d", &ITER_EXPECT); // read response
   if ( ITER_EXPECT < 0 ) { SUBPROCESS_EXIT(); }
   SUBPROCESS.ITER = ITER_EXPECT ; 
+  SUBPROCESS_TIME_STEP(ISTEP_SUBPROCESS_WAIT);
 
   prep_input_repeat();
 
   // rewind all SUBPROCESS files
-  rewind(SUBPROCESS.FP_INP);   
-  rewind(SUBPROCESS.FP_OUT);   
+  if ( SUBPROCESS.SOCKET_FD < 0 ) {
+    rewind(SUBPROCESS.FP_INP);   
+    rewind(SUBPROCESS.FP_OUT);   
+  }
   if ( SUBPROCESS.STDOUT_CLOBBER ) { rewind(FP_STDOUT); }
 
   // - - - - - -
@@ -23309,6 +23947,12 @@ void SUBPROCESS_SIM_REWGT(int ITER_EXPECT) {
 
   // -------- BEGIN -----------
 
+  if ( SUBPROCESS.SOCKET_FD >= 0 ) {
+    SUBPROCESS_SOCKET_READ_GENPDF(SUBPROCESS.NBYTE_MSG);
+    ITER_FOUND = ITER_EXPECT ; // ITER was read from message header
+    goto GENPDF_LOADED ;
+  }
+
   // read input file until we reach iteration key
   while ( !FOUND_ITER_BEGIN && ISTAT_READ != EOF ) {
     ISTAT_READ = fscanf(FP_INP, "%s", c_get) ;
@@ -23346,6 +23990,9 @@ void SUBPROCESS_SIM_REWGT(int ITER_EXPECT) {
 
   init_genPDF(OPTMASK, FP_INP, INPFILE, BLANK_STRING);
 
+ GENPDF_LOADED:
+  SUBPROCESS_TIME_STEP(ISTEP_SUBPROCESS_READ);
+
   // over-write CUTBIT_SPLITRAN 
   sprintf(CUTSTRING_LIST[CUTBIT_SPLITRAN],  "GENPDF rewgt");
 
@@ -23463,6 +24110,8 @@ void SUBPROCESS_SIM_REWGT(int ITER_EXPECT) {
 	 KEYNAME_SUBPROCESS_STDOUT, NKEEP_REWGT, NKEEP_ORIG );
   fflush(stdout);
 
+  SUBPROCESS_TIME_STEP(ISTEP_SUBPROCESS_REWGT);
+
   return ;
 
 } // end SUBPROCESS_SIM_REWGT
@@ -23966,6 +24615,8 @@ void SUBPROCESS_OUTPUT_LOAD(void) {
 
   // ---------- BEGIN ----------
 
+  SUBPROCESS_TIME_STEP(ISTEP_SUBPROCESS_FIT);
+
   for(ITABLE=0; ITABLE < N_TABLE; ITABLE++ ) {
 
     SUBPROCESS_OUTPUT_TABLE_RESET(ITABLE);
@@ -24190,6 +24841,9 @@ void SUBPROCESS_OUTPUT_WRITE(void) {
   printf("%s write SALT2mu output\n",  KEYNAME_SUBPROCESS_STDOUT );
   fflush(stdout);
 
+  if ( SUBPROCESS.SOCKET_FD >= 0 ) 
+    { SUBPROCESS_SOCKET_WRITE_OUTPUT();  goto PRINT_TIME; }
+
   fprintf(FP_OUT,"# Created by SALT2mu SUBPROCESS\n"); // Aug 30 2021
 
   fprintf(FP_OUT,"# ITERATION: %d\n#\n", ITER);
@@ -24200,6 +24854,11 @@ void SUBPROCESS_OUTPUT_WRITE(void) {
   double t_per_event = (t_end_fit-t_start_fit)/(double)FITRESULT.NSNFIT;
   fprintf(FP_OUT, "# CPU:           %.2f minutes  \n", t_min );
   fprintf(FP_OUT, "# CPU_PER_EVENT: %.1f msec/event  \n", t_per_event*1000.);
+  fprintf(FP_OUT, "# TIME_MSEC: wait=%.1f read=%.1f rewgt=%.1f fit=%.1f\n",
+	  SUBPROCESS.TIME_STEP[ISTEP_SUBPROCESS_WAIT],
+	  SUBPROCESS.TIME_STEP[ISTEP_SUBPROCESS_READ],
+	  SUBPROCESS.TIME_STEP[ISTEP_SUBPROCESS_REWGT],
+	  SUBPROCESS.TIME_STEP[ISTEP_SUBPROCESS_FIT] );
   //  fprintf(FP_OUT, "#\n");
   fflush(FP_OUT);
 
@@ -24241,6 +24900,14 @@ void SUBPROCESS_OUTPUT_WRITE(void) {
   for(itable=0; itable < N_TABLE; itable++ )
     { SUBPROCESS_OUTPUT_TABLE_WRITE(itable); }
 
+ PRINT_TIME:
+  // Oct 2026: wall time for each step of this iteration
+  SUBPROCESS_TIME_STEP(ISTEP_SUBPROCESS_WRITE);
+  printf("%s ITER=%d TIME_MSEC:", KEYNAME_SUBPROCESS_STDOUT, ITER);
+  for(n=0; n < NSTEP_SUBPROCESS; n++ ) 
+    { printf(" %s=%.1f", STEPNAME_SUBPROCESS[n], SUBPROCESS.TIME_STEP[n]); }
+  printf("\n");  fflush(stdout);
+
   return ;
 
 } // end SUBPROCESS_OUTPUT_WRITE
@@ -24308,6 +24975,403 @@ void SUBPROCESS_OUTPUT_TABLE_WRITE(int ITABLE) {
 } //  end SUBPROCESS_OUTPUT_TABLE_WRITE
 
 
+// =======================================================
+void SUBPROCESS_TIME_STEP(int ISTEP) {
+
+  // Created Oct 2026
+  // Store wall time (msec) since previous call for step ISTEP.
+  // ISTEP < 0 -> reset clock and zero all steps.
+
+  struct timeval tv ;
+  double T, DT ;
+  int    istep ;
+
+  // ---------- BEGIN ----------
+
+  gettimeofday(&tv, NULL);
+  T  = (double)tv.tv_sec + 1.0E-6*(double)tv.tv_usec ;
+
+  if ( ISTEP < 0 ) {
+    for(istep=0; istep < NSTEP_SUBPROCESS; istep++ ) 
+      { SUBPROCESS.TIME_STEP[istep] = 0.0 ; }
+  }
+  else if ( ISTEP < NSTEP_SUBPROCESS ) {
+    DT = 1000.0 * ( T - SUBPROCESS.TWALL_LAST );
+    SUBPROCESS.TIME_STEP[ISTEP] = DT ;
+  }
+
+  SUBPROCESS.TWALL_LAST = T ;
+  return ;
+
+} // end SUBPROCESS_TIME_STEP
+
+
+// =======================================================
+void SUBPROCESS_SOCKET_OPEN(void) {
+
+  // Created Oct 2026
+  // Connect to Unix-domain socket SUBPROCESS.INPUT_SOCKET that was
+  // created (bind+listen) by python driver. If connect fails, give
+  // warning and leave SOCKET_FD < 0 so that files are used instead.
+
+  char *PATH = SUBPROCESS.INPUT_SOCKET ;
+  struct sockaddr_un ADDR ;
+  int  fd;
+  char fnam[] = "SUBPROCESS_SOCKET_OPEN" ;
+
+  // ---------- BEGIN ----------
+
+  SUBPROCESS.SOCKET_FD = -9 ;
+
+  if ( strlen(PATH) >= sizeof(ADDR.sun_path) ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Socket path is too long (%d chars; max is %d)",
+	    (int)strlen(PATH), (int)sizeof(ADDR.sun_path)-1 );
+    sprintf(c2err,"SUBPROCESS_SOCKET=%s", PATH);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if ( fd < 0 ) { goto FALLBACK; }
+
+  memset(&ADDR, 0, sizeof(ADDR));
+  ADDR.sun_family = AF_UNIX ;
+  strcpy(ADDR.sun_path, PATH);
+
+  if ( connect(fd, (struct sockaddr*)&ADDR, sizeof(ADDR)) < 0 ) 
+    { close(fd); goto FALLBACK; }
+
+  SUBPROCESS.SOCKET_FD = fd ;
+  printf("%s  Connected to socket: %s\n", KEYNAME_SUBPROCESS_STDOUT, PATH);
+  fflush(stdout);
+  return ;
+
+ FALLBACK:
+  printf("%s  WARNING: could not connect to socket %s (%s)\n"
+	 "%s  -> use files instead.\n", 
+	 KEYNAME_SUBPROCESS_STDOUT, PATH, strerror(errno),
+	 KEYNAME_SUBPROCESS_STDOUT );
+  fflush(stdout);
+  return ;
+
+} // end SUBPROCESS_SOCKET_OPEN
+
+
+// =======================================================
+void SUBPROCESS_SOCKET_RECV(void *buf, int NBYTE) {
+
+  // Created Oct 2026
+  // Read exactly NBYTE from socket; abort on error or closed socket.
+
+  char *ptr  = (char*)buf ;
+  int  NREAD = 0 ;
+  ssize_t n ;
+  char fnam[] = "SUBPROCESS_SOCKET_RECV" ;
+
+  // ---------- BEGIN ----------
+
+  while ( NREAD < NBYTE ) {
+    n = read(SUBPROCESS.SOCKET_FD, &ptr[NREAD], NBYTE-NREAD);
+    if ( n < 0 && errno == EINTR ) { continue; }
+    if ( n <= 0 ) {
+      SUBPROCESS_REMIND_STDOUT();
+      sprintf(c1err,"Socket read failed after %d of %d bytes", 
+	      NREAD, NBYTE);
+      sprintf(c2err,"%s", (n==0) ? "socket closed by driver" : 
+	      strerror(errno) );
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+    }
+    NREAD += (int)n ;
+  }
+
+  return ;
+
+} // end SUBPROCESS_SOCKET_RECV
+
+
+// =======================================================
+void SUBPROCESS_SOCKET_SEND(void *buf, int NBYTE) {
+
+  // Created Oct 2026
+  // Write exactly NBYTE to socket; abort on error.
+
+  char *ptr   = (char*)buf ;
+  int  NWRITE = 0 ;
+  ssize_t n ;
+  char fnam[] = "SUBPROCESS_SOCKET_SEND" ;
+
+  // ---------- BEGIN ----------
+
+  while ( NWRITE < NBYTE ) {
+    n = write(SUBPROCESS.SOCKET_FD, &ptr[NWRITE], NBYTE-NWRITE);
+    if ( n < 0 && errno == EINTR ) { continue; }
+    if ( n <= 0 ) {
+      SUBPROCESS_REMIND_STDOUT();
+      sprintf(c1err,"Socket write failed after %d of %d bytes", 
+	      NWRITE, NBYTE);
+      sprintf(c2err,"%s", strerror(errno) );
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+    }
+    NWRITE += (int)n ;
+  }
+
+  return ;
+
+} // end SUBPROCESS_SOCKET_SEND
+
+
+// =======================================================
+void SUBPROCESS_MSG_GET(char *BUF, int NBYTE, int *IPTR, void *dest, int n) {
+
+  // Created Oct 2026
+  // Copy n bytes from BUF[*IPTR] to dest, and increment *IPTR.
+  // Abort if message body is too short.
+
+  char fnam[] = "SUBPROCESS_MSG_GET" ;
+
+  if ( *IPTR + n > NBYTE ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Need %d bytes at byte %d of GENPDF message,", n, *IPTR);
+    sprintf(c2err,"but message body has only NBYTE=%d", NBYTE);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+  memcpy(dest, &BUF[*IPTR], n);
+  *IPTR += n ;
+
+} // end SUBPROCESS_MSG_GET
+
+
+// =======================================================
+void SUBPROCESS_MSG_PUT(void *src, int n) {
+
+  // Created Oct 2026
+  // Append n bytes to output message buffer SUBPROCESS.MSG_OUT.
+
+  int NEED = SUBPROCESS.NBYTE_MSG_OUT + n ;
+
+  if ( NEED > SUBPROCESS.NBYTE_MSG_OUT_ALLOC ) {
+    int NEW = 2*NEED + 4096 ;
+    SUBPROCESS.MSG_OUT = (char*)realloc(SUBPROCESS.MSG_OUT, NEW);
+    SUBPROCESS.NBYTE_MSG_OUT_ALLOC = NEW ;
+  }
+  memcpy(&SUBPROCESS.MSG_OUT[SUBPROCESS.NBYTE_MSG_OUT], src, n);
+  SUBPROCESS.NBYTE_MSG_OUT += n ;
+
+} // end SUBPROCESS_MSG_PUT
+
+
+// =======================================================
+void SUBPROCESS_SOCKET_READ_GENPDF(int NBYTE) {
+
+  // Created Oct 2026
+  // Binary analog of init_genPDF for SUBPROCESS: read GENPDF message
+  // body (NBYTE) from socket and load GENPDF maps directly with
+  // init_interp_GRIDMAP; no text parsing. See SUBPROCESS_HELP for 
+  // message format.
+  // Note that asymGauss SALT2ALPHA/SALT2BETA keys are not supported
+  // here; use files for such maps.
+
+  int  NFUN = 1 ;
+  int  IPTR = 0 ;
+  int  NMAP, imap, NDIM, NROW, NVAR, ivar, IDMAP, NDIM_TMP ;
+  char *BUF, varName[MXCHAR_NAME_SUBPROCESS_MSG+1] ;
+  double **TMPMAP2D ;
+  char fnam[] = "SUBPROCESS_SOCKET_READ_GENPDF" ;
+
+  // ---------- BEGIN ----------
+
+  BUF = (char*) malloc(NBYTE+1);
+  SUBPROCESS_SOCKET_RECV(BUF, NBYTE);
+
+  OPTMASK_GENPDF    = OPTMASK_GENPDF_EXTERNAL_FP ;
+  OPT_EXTRAP_GENPDF = 0 ;
+  NMAP_GENPDF = NCALL_GENPDF = 0;
+
+  SUBPROCESS_MSG_GET(BUF, NBYTE, &IPTR, &NMAP, sizeof(int) );
+  if ( NMAP < 0 || NMAP > MXMAP_GENPDF ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Invalid NMAP=%d in GENPDF message", NMAP);
+    sprintf(c2err,"Valid range is 0 to MXMAP_GENPDF=%d", MXMAP_GENPDF);
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  for(imap=0; imap < NMAP; imap++ ) {
+    SUBPROCESS_MSG_GET(BUF, NBYTE, &IPTR, &NDIM, sizeof(int) );
+    SUBPROCESS_MSG_GET(BUF, NBYTE, &IPTR, &NROW, sizeof(int) );
+    NVAR = NDIM + NFUN ;
+
+    if ( NDIM < 1 || NVAR > MXVAR_GENPDF || 
+	 NROW < 1 || NROW > MXROW_GENPDF ) {
+      SUBPROCESS_REMIND_STDOUT();
+      sprintf(c1err,"Invalid NDIM=%d or NROW=%d for imap=%d", 
+	      NDIM, NROW, imap);
+      sprintf(c2err,"MXVAR_GENPDF=%d  MXROW_GENPDF=%d",
+	      MXVAR_GENPDF, MXROW_GENPDF);
+      errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+    }
+
+    GENPDF[imap].NVAR = NVAR ;
+    for(ivar=0; ivar < NVAR; ivar++ ) {
+      SUBPROCESS_MSG_GET(BUF, NBYTE, &IPTR, varName, 
+			 MXCHAR_NAME_SUBPROCESS_MSG);
+      varName[MXCHAR_NAME_SUBPROCESS_MSG] = 0 ;
+      assign_VARNAME_GENPDF(imap, ivar, varName);
+      GENPDF[imap].IVAR_HOSTLIB[ivar] = -9 ;
+    }
+    checkAbort_VARNAME_GENPDF(GENPDF[imap].VARNAMES[0]);
+
+    TMPMAP2D = (double**) malloc(NVAR*sizeof(double*));
+    for(ivar=0; ivar < NVAR; ivar++ ) {
+      TMPMAP2D[ivar] = (double*) malloc(NROW*sizeof(double));
+      SUBPROCESS_MSG_GET(BUF, NBYTE, &IPTR, TMPMAP2D[ivar], 
+			 NROW*sizeof(double) );
+    }
+
+    // allocate VARNAMES only on first read; re-used on each iteration
+    for(ivar=0; ivar < NDIM; ivar++ ) {
+      if ( GENPDF[imap].GRIDMAP.VARNAMES[ivar] == NULL ) 
+	{ GENPDF[imap].GRIDMAP.VARNAMES[ivar] = (char*) malloc(100); }
+    }
+    splitString(GENPDF[imap].GRIDMAP.VARLIST, COMMA, fnam, MXDIM_GRIDMAP, 
+		&NDIM_TMP, GENPDF[imap].GRIDMAP.VARNAMES);
+
+    IDMAP = IDGRIDMAP_GENPDF + imap ;
+    init_interp_GRIDMAP(IDMAP, GENPDF[imap].MAPNAME, NROW, NDIM, NFUN,
+			OPT_EXTRAP_GENPDF, TMPMAP2D, &TMPMAP2D[NDIM],
+			&GENPDF[imap].GRIDMAP );
+
+    GENPDF[imap].N_CALL      = 0 ;
+    GENPDF[imap].N_ITER_SUM  = 0 ;
+    GENPDF[imap].N_ITER_MAX  = 0 ;
+    GENPDF[imap].PROB_EXPON_REWGT = 1.0 ;
+
+    printf("    Load GRIDMAP-%3.3d '%s(%s)'  NROW=%d  (socket)\n",
+	   IDMAP, GENPDF[imap].MAPNAME, GENPDF[imap].GRIDMAP.VARLIST, NROW);
+
+    for(ivar=0; ivar < NVAR; ivar++ ) { free(TMPMAP2D[ivar]); }
+    free(TMPMAP2D);
+  }
+
+  if ( IPTR != NBYTE ) {
+    SUBPROCESS_REMIND_STDOUT();
+    sprintf(c1err,"Read %d bytes of GENPDF message, but NBYTE=%d", 
+	    IPTR, NBYTE);
+    sprintf(c2err,"Check message format from driver.");
+    errlog(FP_STDOUT, SEV_FATAL, fnam, c1err, c2err);
+  }
+
+  NMAP_GENPDF = NMAP ;
+  fflush(stdout);
+  free(BUF);
+
+  return ;
+
+} // end SUBPROCESS_SOCKET_READ_GENPDF
+
+
+// =======================================================
+void SUBPROCESS_SOCKET_WRITE_OUTPUT(void) {
+
+  // Created Oct 2026
+  // Binary analog of SUBPROCESS_OUTPUT_WRITE: pack fit params and
+  // output tables into one message, and send it to driver.
+  // See SUBPROCESS_HELP for message format.
+
+  int  N_TABLE = SUBPROCESS.N_OUTPUT_TABLE ;
+  int  HEADER[NINT_HEADER_SUBPROCESS_MSG];
+  int  n, NPAR, ISFLOAT, ISM0, ITABLE, NVAR, NBINTOT, IBIN1D, ivar, ibin1d ;
+  int  NEVT ;
+  double TIME_MSEC[4], VAL_ERR[2], DVAL[3];
+  char NAME[MXCHAR_NAME_SUBPROCESS_MSG] ;
+  char TABLE_NAME[MXCHAR_TABLE_SUBPROCESS_MSG] ;
+  SUBPROCESS_TABLE_DEF *TABLE ;
+
+  // ---------- BEGIN ----------
+
+  // reserve space for header; NBYTE is set at the end
+  SUBPROCESS.NBYTE_MSG_OUT = 0 ;
+  HEADER[0] = MAGIC_SUBPROCESS_MSG ;
+  HEADER[1] = MSGTYPE_SUBPROCESS_OUTPUT ;
+  HEADER[2] = SUBPROCESS.ITER ;
+  HEADER[3] = 0 ;
+  SUBPROCESS_MSG_PUT(HEADER, sizeof(HEADER));
+
+  SUBPROCESS_MSG_PUT(&FITRESULT.NSNFIT, sizeof(int));
+
+  for(n=0; n < 4; n++ ) { TIME_MSEC[n] = SUBPROCESS.TIME_STEP[n]; }
+  SUBPROCESS_MSG_PUT(TIME_MSEC, sizeof(TIME_MSEC));
+
+  // fitted nuisance params, sigint, and MAXPROB_RATIO
+  NPAR = 2 ;
+  for ( n=0; n < FITINP.NFITPAR_ALL ; n++ ) {
+    ISFLOAT = FITINP.ISFLOAT[n] ;
+    ISM0    = (n >= MXCOSPAR) ;
+    if ( ISFLOAT && !ISM0 ) { NPAR++ ; }
+  }
+  SUBPROCESS_MSG_PUT(&NPAR, sizeof(int));
+
+  for ( n=0; n < FITINP.NFITPAR_ALL ; n++ ) {
+    ISFLOAT = FITINP.ISFLOAT[n] ;
+    ISM0    = (n >= MXCOSPAR) ;
+    if ( !ISFLOAT || ISM0 ) { continue; }
+    memset(NAME, 0, sizeof(NAME));
+    strncpy(NAME, FITRESULT.PARNAME[n], sizeof(NAME)-1);
+    VAL_ERR[0] = FITRESULT.PARVAL[1][n] ;
+    VAL_ERR[1] = FITRESULT.PARERR[1][n] ;
+    SUBPROCESS_MSG_PUT(NAME, sizeof(NAME));
+    SUBPROCESS_MSG_PUT(VAL_ERR, sizeof(VAL_ERR));
+  }
+
+  memset(NAME, 0, sizeof(NAME));
+  strncpy(NAME, FITRESULT.PARNAME[IPAR_COVINT_PARAM], sizeof(NAME)-1);
+  VAL_ERR[0] = FITINP.COVINT_PARAM_FIX ;  VAL_ERR[1] = 0.0 ;
+  SUBPROCESS_MSG_PUT(NAME, sizeof(NAME));
+  SUBPROCESS_MSG_PUT(VAL_ERR, sizeof(VAL_ERR));
+
+  memset(NAME, 0, sizeof(NAME));
+  sprintf(NAME, "MAXPROB_RATIO");
+  VAL_ERR[0] = SUBPROCESS.MAXPROB_RATIO ;  VAL_ERR[1] = 0.0 ;
+  SUBPROCESS_MSG_PUT(NAME, sizeof(NAME));
+  SUBPROCESS_MSG_PUT(VAL_ERR, sizeof(VAL_ERR));
+
+  // - - - - - tables - - - - - 
+  SUBPROCESS_MSG_PUT(&N_TABLE, sizeof(int));
+  for(ITABLE=0; ITABLE < N_TABLE; ITABLE++ ) {
+    TABLE   = &SUBPROCESS.OUTPUT_TABLE[ITABLE] ;
+    NVAR    = TABLE->NVAR ;
+    NBINTOT = TABLE->NBINTOT ;
+
+    memset(TABLE_NAME, 0, sizeof(TABLE_NAME));
+    strncpy(TABLE_NAME, SUBPROCESS.INPUT_OUTPUT_TABLE[ITABLE], 
+	    sizeof(TABLE_NAME)-1);
+    SUBPROCESS_MSG_PUT(TABLE_NAME, sizeof(TABLE_NAME));
+    SUBPROCESS_MSG_PUT(&NVAR,    sizeof(int));
+    SUBPROCESS_MSG_PUT(&NBINTOT, sizeof(int));
+
+    for(IBIN1D=0; IBIN1D < NBINTOT; IBIN1D++ ) {
+      for(ivar=0; ivar < NVAR; ivar++ ) {
+	ibin1d = TABLE->INDEX_BININFO[ivar][IBIN1D];
+	SUBPROCESS_MSG_PUT(&ibin1d, sizeof(int));
+      }
+      NEVT    = TABLE->NEVT[IBIN1D] ;
+      DVAL[0] = TABLE->MURES_SUM[IBIN1D] ;
+      DVAL[1] = TABLE->MURES_STD[IBIN1D] ;
+      DVAL[2] = TABLE->MURES_STD_ROBUST[IBIN1D] ;
+      SUBPROCESS_MSG_PUT(&NEVT, sizeof(int));
+      SUBPROCESS_MSG_PUT(DVAL,  sizeof(DVAL));
+    }
+  }
+
+  // set body size in header, and send
+  HEADER[3] = SUBPROCESS.NBYTE_MSG_OUT - (int)sizeof(HEADER);
+  memcpy(SUBPROCESS.MSG_OUT, HEADER, sizeof(HEADER));
+  SUBPROCESS_SOCKET_SEND(SUBPROCESS.MSG_OUT, SUBPROCESS.NBYTE_MSG_OUT);
+
+  return ;
+
+} // end SUBPROCESS_SOCKET_WRITE_OUTPUT
+
+
 // =======================================
 void SUBPROCESS_REMIND_STDOUT(void) {
   printf("\n");
@@ -45,10 +45,17 @@
  Aug 19 2022: in ranPhase_PERIODIC_LCLIB, disable phase shift if day grid
               is not uniform, and print warning message.
 
+ Oct 2026: 
+   + read compiled binary LCLIB (see genmag_LCLIB_bin.c) with O(1)
+     random start, PARVAL cuts before decoding light curve, and 
+     background prefetch. GENMODEL_MSKOPT += 64 compiles text LCLIB.
+   + refactor: init_EVENT_LCLIB, load_ROW_LCLIB, keep_PARLIST_LCLIB
+
 *************************************************/
 
 #include "sntools.h"           // community tools
 #include "genmag_LCLIB.h" 
+#include "genmag_LCLIB_bin.h" 
 #include "MWgaldust.h"
 
 #include <gsl/gsl_rng.h>
@@ -78,6 +85,7 @@ void init_genmag_LCLIB(char *lcLibFile, char *STRING_TEMPLATE_EPOCHS,
   //           GENMODEL_MSKOPT: <OPTMASK>
   //     += 1   --> ignore ANGLEMATCH cut 
   //     += 8   --> use LCLIB coordinates (Feb 2021)
+  //     += 64  --> compile ./[lcLibFile].BIN and use it (Oct 2026)
   //     += 512 --> DEGUB/REFACTOR flag
   //
   //  If LCLIBFILE's SURVEY and FILTERLIST does not match input,
@@ -87,6 +95,7 @@ void init_genmag_LCLIB(char *lcLibFile, char *STRING_TEMPLATE_EPOCHS,
   // HISTORY
   // Mar 26 2019: pass OPTMASK arg.
   // Feb    2021: option to use LCLIB coordinates
+  // Oct    2026: OPTMASK += 64 -> compile binary LCLIB and use it
 
   char fnam[] = "init_genmag_LCLIB" ;
 
@@ -110,6 +119,22 @@ void init_genmag_LCLIB(char *lcLibFile, char *STRING_TEMPLATE_EPOCHS,
   open_LCLIB(lcLibFile);
   read_GLOBAL_HEADER_LCLIB();
 
+  if ( (OPTMASK & OPTMASK_LCLIB_COMPILE_BIN) && !LCLIB_BIN.USE ) {
+    char binFile[MXPATHLEN], *ptrBase, *ptrGz ;
+    ptrBase = strrchr(LCLIB_INFO.FILENAME,'/');
+    ptrBase = ( ptrBase == NULL ) ? LCLIB_INFO.FILENAME : ptrBase+1 ;
+    sprintf(binFile, "%s", ptrBase);
+    if ( (ptrGz = strstr(binFile,".gz")) != NULL ) { *ptrGz = 0; }
+    strcat(binFile, SUFFIX_LCLIB_BIN);
+
+    compile_LCLIB_BIN(LCLIB_INFO.FILENAME, binFile);
+    // gz stream was already closed by snana_rewind in header read
+    if ( !LCLIB_INFO.GZIPFLAG ) { fclose(LCLIB_INFO.FP); }
+
+    open_LCLIB(binFile);
+    read_GLOBAL_HEADER_LCLIB();
+  }
+
   // -----------------------------------------------------
   // check that LCLIB survey and filters are consistent
   // with SIMLIB/cadence file:
@@ -174,6 +199,8 @@ void open_LCLIB(char *lcLibFile) {
   // Sep 30 2020:
   // remove check for ENV PRIVATE_MODELPATH_NAME, and instead
   // check user input PATH_USER_INPUT.
+  //
+  // Oct 2026: check for compiled binary LCLIB
 
   FILE *fp;
   int  OPTMASK_OPEN = 1;  // 1=verbose
@@ -187,6 +214,11 @@ void open_LCLIB(char *lcLibFile) {
 	   PATH_USER_INPUT, PATH_SNDATA_ROOT);
 
   printf("\n");
+
+  fp = open_LCLIB_BIN(MODELPATH_LIST, lcLibFile, LCLIB_FILE);
+  if ( fp != NULL ) 
+    { LCLIB_INFO.FP = fp;  LCLIB_INFO.GZIPFLAG = 0;  return; }
+
   fp = snana_openTextFile(OPTMASK_OPEN, MODELPATH_LIST, lcLibFile, 
 			  LCLIB_FILE, &LCLIB_INFO.GZIPFLAG ); // <=== returned
   
@@ -596,6 +628,8 @@ void set_randomStart_LCLIB(void) {
   // Created Jun 9 2018
   // If NEVENT(header) > NEVENT_MIN, then pick randon event 
   // and move to that event in the library.
+  //
+  // Oct 2026: for binary LCLIB, jump directly to event.
 
   int NEVENT_MIN = 20 ; // at least this many to set random start
   int NEVENT = LCLIB_INFO.NEVENT ;
@@ -616,6 +650,12 @@ void set_randomStart_LCLIB(void) {
   printf("\t Skip to random LCLIB event %d of %d ... ",
 	 IEVT_START, NEVENT ); fflush(stdout);
 
+  if ( LCLIB_BIN.USE ) {
+    seek_LCLIB_BIN(IEVT_START);
+    printf("arrived.\n");  fflush(stdout);
+    return ;
+  }
+
   // start reading until reading IEVT_START'th event
   ievt=0;
 
@@ -802,6 +842,9 @@ void readNext_LCLIB(double *RA, double *DEC) {
   // Jul 13 2018: MXWD -> += 2 in case NPAR=0
   // Aug 26 2018: call ranPhase_PERIODIC_LCLIB().
   // Feb 03 2021: check OPTMASK&8 option to pass RA,DEC back from HOSTLIB
+  // Oct    2026: 
+  //   + move event init to init_EVENT_LCLIB()
+  //   + check binary LCLIB: next_LCLIB_BIN applies cuts, then decodes
 
   double RA_LOCAL  = *RA  ;
   double DEC_LOCAL = *DEC ;
@@ -817,7 +860,7 @@ void readNext_LCLIB(double *RA, double *DEC) {
   int MXWD   = NFILT + NPAR + 2 ;
   bool FIRST_EVENT = LCLIB_EVENT.NEVENT_READ==0;
   int START_EVENT, END_EVENT, ISROW_T, ISROW_S ;
-  int ipar, ifilt, NROW_FOUND, NROW_EXPECT, KEEP, REJECT ;
+  int NROW_FOUND, NROW_EXPECT, KEEP, REJECT ;
   int NWD, iwd, NLINE_READ, NLINE_SKIP, Nfread, NCHAR_ROW, istat ;
   int NFAIL_ANGLEMATCH_b = 0;
   long int NCHAR_SKIP;
@@ -844,32 +887,16 @@ void readNext_LCLIB(double *RA, double *DEC) {
 
   for(iwd=0; iwd < MXWD; iwd++ )  { ptrWDLIST[iwd] = WDLIST[iwd] ; }
 
+  if ( LCLIB_BIN.USE ) {
+    NROW_FOUND = NROW_EXPECT = next_LCLIB_BIN(GalLat,GalLong, RA,DEC);
+    goto EVENT_LOADED ;
+  }
+
  NEXT_EVENT:
 
   START_EVENT = END_EVENT = 0 ; 
   REJECT = NLINE_READ = NLINE_SKIP = Nfread = 0;
-  LCLIB_EVENT.NROW = LCLIB_EVENT.NROW_S = LCLIB_EVENT.NROW_T = 0 ;
-  LCLIB_EVENT.RA     = LCLIB_EVENT.DEC     = 999. ;
-  LCLIB_EVENT.GLAT   = LCLIB_EVENT.GLON  = 999. ;
-  LCLIB_EVENT.DAYRANGE_S[0] = LCLIB_EVENT.DAYRANGE_T[0] = +9.E9 ;
-  LCLIB_EVENT.DAYRANGE_S[1] = LCLIB_EVENT.DAYRANGE_T[1] = -9.E9 ;
-  LCLIB_EVENT.DAYCOVER_S = LCLIB_EVENT.DAYCOVER_T = 0.0 ;
-  LCLIB_EVENT.DAYCOVER_ALL = 0.0 ;
-  LCLIB_EVENT.FIRSTROW_T = LCLIB_EVENT.LASTROW_T = 0 ;
-  LCLIB_EVENT.FIRSTROW_S = LCLIB_EVENT.LASTROW_S = 99999 ;
-  LCLIB_EVENT.PEAKMAG_S  =  MAG_ZEROFLUX ;
-  LCLIB_EVENT.PEAKDAY_S  = -99999.0 ;
-  LCLIB_EVENT.ANGLEMATCH = LCLIB_EVENT.ANGLEMATCH_b = 99999. ;
-
-  for(ipar=0; ipar < LCLIB_INFO.NPAR_MODEL_STORE; ipar++ ) 
-    { LCLIB_EVENT.PARVAL_MODEL[ipar] = -999.0 ; }
-
-  for(ifilt=0; ifilt<NFILT; ifilt++ ) {
-    LCLIB_EVENT.FIRSTMAG[ifilt] = 99.0 ;
-    LCLIB_EVENT.LASTMAG[ifilt]  = 99.0 ;
-  }
-
-  LCLIB_EVENT.REDSHIFT = LCLIB_EVENT.ZPHOT = LCLIB_EVENT.ZPHOTERR = 0.0 ;
+  init_EVENT_LCLIB();
 
   // init local var
   NROW_FOUND = NROW_EXPECT = 0 ;
@@ -1013,6 +1040,7 @@ void readNext_LCLIB(double *RA, double *DEC) {
   KEEP = keep_ANGLEMATCH_LCLIB(GalLat,GalLong);
   if ( KEEP == 0 ) { goto NEXT_EVENT ; }
 
+ EVENT_LOADED:
   // -----------------------------------
   LCLIB_EVENT.DAYCOVER_S = 
     LCLIB_EVENT.DAYRANGE_S[1] - LCLIB_EVENT.DAYRANGE_S[0] ;
@@ -1041,6 +1069,45 @@ void readNext_LCLIB(double *RA, double *DEC) {
 } // end void readNext_LCLIB
 
 
+// =========================================
+void init_EVENT_LCLIB(void) {
+
+  // Created Oct 2026 (moved from readNext_LCLIB)
+  // init LCLIB_EVENT before reading next event.
+
+  int NFILT = LCLIB_INFO.NFILTERS;
+  int ipar, ifilt;
+
+  // ------------- BEGIN --------------
+
+  LCLIB_EVENT.NROW = LCLIB_EVENT.NROW_S = LCLIB_EVENT.NROW_T = 0 ;
+  LCLIB_EVENT.RA     = LCLIB_EVENT.DEC     = 999. ;
+  LCLIB_EVENT.GLAT   = LCLIB_EVENT.GLON  = 999. ;
+  LCLIB_EVENT.DAYRANGE_S[0] = LCLIB_EVENT.DAYRANGE_T[0] = +9.E9 ;
+  LCLIB_EVENT.DAYRANGE_S[1] = LCLIB_EVENT.DAYRANGE_T[1] = -9.E9 ;
+  LCLIB_EVENT.DAYCOVER_S = LCLIB_EVENT.DAYCOVER_T = 0.0 ;
+  LCLIB_EVENT.DAYCOVER_ALL = 0.0 ;
+  LCLIB_EVENT.FIRSTROW_T = LCLIB_EVENT.LASTROW_T = 0 ;
+  LCLIB_EVENT.FIRSTROW_S = LCLIB_EVENT.LASTROW_S = 99999 ;
+  LCLIB_EVENT.PEAKMAG_S  =  MAG_ZEROFLUX ;
+  LCLIB_EVENT.PEAKDAY_S  = -99999.0 ;
+  LCLIB_EVENT.ANGLEMATCH = LCLIB_EVENT.ANGLEMATCH_b = 99999. ;
+
+  for(ipar=0; ipar < LCLIB_INFO.NPAR_MODEL_STORE; ipar++ ) 
+    { LCLIB_EVENT.PARVAL_MODEL[ipar] = -999.0 ; }
+
+  for(ifilt=0; ifilt<NFILT; ifilt++ ) {
+    LCLIB_EVENT.FIRSTMAG[ifilt] = 99.0 ;
+    LCLIB_EVENT.LASTMAG[ifilt]  = 99.0 ;
+  }
+
+  LCLIB_EVENT.REDSHIFT = LCLIB_EVENT.ZPHOT = LCLIB_EVENT.ZPHOTERR = 0.0 ;
+
+  return ;
+
+} // end init_EVENT_LCLIB
+
+
 // =========================================
 void read_ROW_LCLIB(int ROW, char *KEY, char **ptrWDLIST) {
 
@@ -1052,23 +1119,49 @@ void read_ROW_LCLIB(int ROW, char *KEY, char **ptrWDLIST) {
   //   ROW = index to load LCLIB_EVENT.DAY[MAGLIST]
   //   KEY = T: or S:
   //   **ptrWDLIST = words for line (includes KEY)
+  //
+  // Oct 2026: move storage to load_ROW_LCLIB (used by binary LCLIB)
 
   int NFILT  = LCLIB_INFO.NFILTERS;
-  int ifilt, I2MAG ;
-  //  int IFLAG_NONRECUR=(LCLIB_INFO.IFLAG_RECUR_CLASS==IFLAG_RECUR_NONRECUR);
-  double DAY, MAG, MAGLIST[MXFILTINDX];
-  double *ptrDAYRANGE ;
-  char fnam[] = "read_ROW_LCLIB" ;
+  int ifilt ;
+  double DAY, MAGLIST[MXFILTINDX];
 
   // -------------- BEGIN ---------------
 
   // parse input list of string-words to get DAY and MAGLIST.
   sscanf( ptrWDLIST[1], "%le", &DAY);
+  for(ifilt=0; ifilt < NFILT; ifilt++ )  
+    { sscanf( ptrWDLIST[2+ifilt], "%le", &MAGLIST[ifilt] );   }
+
+  load_ROW_LCLIB(ROW, KEY, DAY, MAGLIST);
+
+  return;
+
+} // end read_ROW_LCLIB
+
+
+// =========================================
+void load_ROW_LCLIB(int ROW, char *KEY, double DAY, double *MAGLIST) {
+
+  // Created Oct 2026 (moved from read_ROW_LCLIB)
+  // Store one ROW in LCLIB_EVENT.
+  // Inputs:
+  //   ROW      = index to load LCLIB_EVENT.DAY[MAGLIST]
+  //   KEY      = T: or S:
+  //   DAY      = DAY as read from LCLIB
+  //   MAGLIST  = mag per LCLIB band, as read from LCLIB
+
+  int NFILT  = LCLIB_INFO.NFILTERS;
+  int ifilt, I2MAG ;
+  double MAG ;
+  double *ptrDAYRANGE ;
+  char fnam[] = "load_ROW_LCLIB" ;
+
+  // -------------- BEGIN ---------------
+
   DAY *= LCLIB_DEBUG.DAYSCALE ; // default=1. user sets !=1 for debug
 
   for(ifilt=0; ifilt < NFILT; ifilt++ )  { 
-    sscanf( ptrWDLIST[2+ifilt], "%le", &MAGLIST[ifilt] );  
-
     if ( ROW==0 ) { LCLIB_EVENT.FIRSTMAG[ifilt] = MAGLIST[ifilt] ; }
     LCLIB_EVENT.LASTMAG[ifilt] = MAGLIST[ifilt] ;
   }
@@ -1143,7 +1236,7 @@ void read_ROW_LCLIB(int ROW, char *KEY, char **ptrWDLIST) {
  
   return;
 
-} // end read_ROW_LCLIB
+} // end load_ROW_LCLIB
 
 
 // =========================================
@@ -1238,6 +1331,22 @@ int keep_PARVAL_LCLIB(void) {
   // Oct 31 2017
   // check optional cuts on PARVAL
   // Returns 1 to keep, 0 to reject.
+  //
+  // Oct 2026: move cuts to keep_PARLIST_LCLIB
+
+  return( keep_PARLIST_LCLIB(LCLIB_EVENT.PARVAL_MODEL) );
+
+} // end keep_PARVAL_LCLIB
+
+
+// =========================================
+int keep_PARLIST_LCLIB(double *PARVAL) {
+
+  // Created Oct 2026 (moved from keep_PARVAL_LCLIB)
+  // Apply LCLIB_CUTWIN cuts to input PARVAL list.
+  // Returns 1 to keep, 0 to reject.
+  // Reads only LCLIB_INFO & LCLIB_CUTS, so that it can be used
+  // by the binary-LCLIB prefetch thread.
 
   int KEEP = 1;
   int NCUTWIN = LCLIB_CUTS.NCUTWIN ;
@@ -1255,7 +1364,7 @@ int keep_PARVAL_LCLIB(void) {
     for(icut=0; icut<NCUTWIN; icut++ ) {
       CUTNAME = LCLIB_CUTS.PARNAME[icut];
       if ( strcmp(PARNAME,CUTNAME) == 0 ) {
-	dval = LCLIB_EVENT.PARVAL_MODEL[ipar];
+	dval = PARVAL[ipar];
 	DMIN = LCLIB_CUTS.CUTWIN[icut][0] ;
 	DMAX = LCLIB_CUTS.CUTWIN[icut][1] ;
 	if ( dval < DMIN ) { KEEP = 0 ; }
@@ -1275,7 +1384,7 @@ int keep_PARVAL_LCLIB(void) {
 
   return(KEEP) ;
 
-} // end keep_PARVAL_LCLIB
+} // end keep_PARLIST_LCLIB
 
 // ============================================
 int keep_ANGLEMATCH_LCLIB(double b, double l) {
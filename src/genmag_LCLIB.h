@@ -178,6 +178,8 @@ void parse_PARNAMES_LCLIB(char *parNameString);
 void read_PARVAL_LCLIB(char *LINE);
 void coord_translate_LCLIB(double *RA, double *DEC);
 int  keep_PARVAL_LCLIB(void);
+int  keep_PARLIST_LCLIB(double *PARVAL);
+void init_EVENT_LCLIB(void);
 int  keep_ANGLEMATCH_LCLIB(double GalLat, double GalLong);
 
 void addTemplateRows_LCLIB(void);
@@ -205,6 +207,7 @@ void genmag_LCLIB (int EXTERNAL_ID, int ifilt_obs,
 
 void readNext_LCLIB(double *RA, double *DEC);
 void read_ROW_LCLIB(int IROW, char *KEY, char **ptrWDLIST); // read one row from LCLIB
+void load_ROW_LCLIB(int IROW, char *KEY, double DAY, double *MAGLIST);
 void malloc_LCLIB_EVENT(int OPT);
 
 void   set_TOBS_OFFSET_LCLIB(void) ;
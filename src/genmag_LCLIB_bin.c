@@ -0,0 +1,692 @@
+/**************************************************
+ Created Oct 2026
+
+ Compile a TEXT LCLIB into an indexed binary file, read it back via
+ mmap, and prefetch accepted events in a background thread.
+ See genmag_LCLIB_bin.h for the file layout.
+
+ Events are stored in file order, and the reader visits them in
+ the same order as the TEXT reader (with wrap-around), so that
+ the sequence of simulated LCLIB events is unchanged. Each row is
+ passed through the same load_ROW_LCLIB function as for TEXT,
+ so that all row checks and I2MAG packing are identical.
+
+ The prefetch thread reads only the mapped file, LCLIB_INFO and
+ LCLIB_CUTS (read-only after init); everything that changes
+ LCLIB_EVENT, or uses randoms, runs in the main thread.
+
+*********************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sntools.h"
+#include "genmag_LCLIB.h"
+#include "genmag_LCLIB_bin.h"
+
+// growable memory buffer used to assemble each file section
+typedef struct {
+  char    *BUF ;
+  int64_t  LEN, SIZE ;
+} LCLIB_BIN_BUFFER_DEF ;
+
+static void    append_LCLIB_BIN(LCLIB_BIN_BUFFER_DEF *B, void *ptr,
+				int64_t LEN);
+static int64_t pad8_LCLIB_BIN(int64_t LEN);
+static void    fwrite_pad8_LCLIB_BIN(FILE *fp, int64_t LEN);
+static void   *prefetch_LCLIB_BIN(void *arg);
+static void    start_prefetch_LCLIB_BIN(void);
+static double  time_LCLIB_BIN(void);
+
+
+// =======================================
+void compile_LCLIB_BIN(char *textFile, char *binFile) {
+
+  // Created Oct 2026
+  // Read TEXT LCLIB file (textFile) and write compiled binary
+  // LCLIB (binFile). Must be called after read_GLOBAL_HEADER_LCLIB
+  // so that NFILTERS and NPAR_MODEL are known.
+  //  + global header is copied verbatim through first START_EVENT.
+  //  + keys are parsed as in readNext_LCLIB; rows are streamed
+  //    to binFile as they are read, so that memory use is set by
+  //    the index and flags rather than by the light curves.
+  //  + file is written to a temporary name and then renamed, so that
+  //    other jobs that have the old binFile mapped keep a valid file.
+
+  int NFILT  = LCLIB_INFO.NFILTERS ;
+  int NPAR   = LCLIB_INFO.NPAR_MODEL ;
+  int MXWD   = NFILT + NPAR + 2 ;
+  int NDROW  = 1 + NFILT ;
+
+  LCLIB_BIN_BUFFER_DEF GLOBAL, FLAG, INDEX, PARVAL ;
+  LCLIB_BIN_HEAD_DEF   HEAD ;
+  LCLIB_BIN_INDEX_DEF  REC ;
+  FILE  *fp, *fpbin ;
+  int    gzipFlag, NWD, iwd, ipar, ifilt, NROW_EXPECT = 0 ;
+  int    ISROW_T, ISROW_S ;
+  bool   IN_GLOBAL = true, IN_EVENT = false ;
+  double ROW[MXFILTINDX+1], PARLIST[MXPAR_LCLIB] ;
+  char   LINE[MXCHAR_LINE_LCLIB_BIN], tmpLINE[MXCHAR_LINE_LCLIB_BIN];
+  char   WDLIST[MXFILTINDX+MXPAR_LCLIB][100], *ptrWDLIST[MXFILTINDX+MXPAR_LCLIB];
+  char  *WD0, *WD1, cflag ;
+  char   tmpFile[MXPATHLEN] ;
+  char   fnam[] = "compile_LCLIB_BIN" ;
+
+  // ------------- BEGIN -------------
+
+  printf("\n %s: \n\t read  %s \n\t write %s \n", fnam, textFile, binFile);
+  fflush(stdout);
+
+  for(iwd=0; iwd < MXWD; iwd++ )  { ptrWDLIST[iwd] = WDLIST[iwd] ; }
+
+  fp = open_TEXTgz(textFile, "rt", &gzipFlag);
+  if ( fp == NULL ) {
+    sprintf(c1err,"Cannot open TEXT LCLIB file");
+    sprintf(c2err,"'%s'", textFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  sprintf(tmpFile, "%s.TMP%d", binFile, (int)getpid() );
+  fpbin = fopen(tmpFile, "wb");
+  if ( fpbin == NULL ) {
+    sprintf(c1err,"Cannot open binary LCLIB file for writing");
+    sprintf(c2err,"'%s'", tmpFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  GLOBAL.BUF = FLAG.BUF = INDEX.BUF = PARVAL.BUF = NULL ;
+  GLOBAL.LEN = FLAG.LEN = INDEX.LEN = PARVAL.LEN = 0 ;
+  GLOBAL.SIZE= FLAG.SIZE= INDEX.SIZE= PARVAL.SIZE= 0 ;
+
+  memset(&HEAD, 0, sizeof(LCLIB_BIN_HEAD_DEF) );
+  memcpy(HEAD.MAGIC, MAGIC_LCLIB_BIN, 8);
+  HEAD.VERSION = VERSION_LCLIB_BIN ;
+  HEAD.NFILT   = NFILT ;
+  HEAD.NPAR    = NPAR ;
+  HEAD.OFFSET_GLOBAL = pad8_LCLIB_BIN(sizeof(LCLIB_BIN_HEAD_DEF)) ;
+
+  // placeholder header; re-written at the end
+  fwrite(&HEAD, sizeof(LCLIB_BIN_HEAD_DEF), 1, fpbin);
+  fwrite_pad8_LCLIB_BIN(fpbin, sizeof(LCLIB_BIN_HEAD_DEF) );
+
+  memset(&REC, 0, sizeof(LCLIB_BIN_INDEX_DEF) );
+
+  while ( fgets(LINE, MXCHAR_LINE_LCLIB_BIN, fp) != NULL ) {
+
+    if ( IN_GLOBAL ) { append_LCLIB_BIN(&GLOBAL, LINE, strlen(LINE)); }
+
+    if ( commentchar(LINE) ) { continue; }
+
+    sprintf(tmpLINE, "%s", LINE);
+    splitString2(tmpLINE, " ", MXWD, &NWD, ptrWDLIST);
+    if ( NWD < 2 ) { continue ; }
+
+    if ( strcmp(WDLIST[0],"START_EVENT:") == 0 ) {
+
+      // global header ends with first START_EVENT line
+      if ( IN_GLOBAL ) {
+	IN_GLOBAL       = false ;
+	HEAD.LEN_GLOBAL = GLOBAL.LEN ;
+	fwrite(GLOBAL.BUF, 1, GLOBAL.LEN, fpbin);
+	fwrite_pad8_LCLIB_BIN(fpbin, GLOBAL.LEN);
+	HEAD.OFFSET_ROW = HEAD.OFFSET_GLOBAL + pad8_LCLIB_BIN(GLOBAL.LEN);
+      }
+
+      sscanf(WDLIST[1],"%lld", (long long*)&REC.ID);
+      REC.IROW       = HEAD.NROW ;
+      REC.NROW       = 0 ;
+      REC.HAS_PARVAL = 0 ;
+      REC.RA   = REC.DEC  = 999.0 ;
+      REC.GLAT = REC.GLON = 999.0 ;
+      REC.ANGLEMATCH_b    = 99999. ;
+      for(ipar=0; ipar < NPAR; ipar++ ) { PARLIST[ipar] = -999.0 ; }
+      NROW_EXPECT = 0 ;
+      IN_EVENT    = true ;
+    }
+
+    if ( !IN_EVENT ) { continue; }
+
+    iwd = 0;
+    ISROW_T = ( strcmp(WDLIST[0],"T:") == 0 );
+    ISROW_S = ( strcmp(WDLIST[0],"S:") == 0 );
+
+    while ( iwd < NWD-1 ) {
+
+      WD0 = WDLIST[iwd+0];
+      WD1 = WDLIST[iwd+1];
+
+      if ( iwd==0 && (ISROW_T || ISROW_S) ) {
+	if ( NWD < NDROW+1 ) {
+	  sprintf(c1err,"Found %d words in %s row for Event ID=%lld",
+		  NWD, WDLIST[0], (long long)REC.ID );
+	  sprintf(c2err,"Expect DAY + %d mags", NFILT);
+	  errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+	}
+	for(ifilt=0; ifilt < NDROW; ifilt++ )
+	  { sscanf(WDLIST[1+ifilt], "%le", &ROW[ifilt] ); }
+	fwrite(ROW, sizeof(double), NDROW, fpbin);
+	cflag = WDLIST[0][0] ;
+	append_LCLIB_BIN(&FLAG, &cflag, 1);
+	REC.NROW++ ;  HEAD.NROW++ ;
+	iwd += NDROW ;
+      }
+      else if ( strcmp(WD0,"NOBS:") == 0  || strcmp(WD0,"NROW:") == 0 )
+	{ sscanf(WD1, "%d", &NROW_EXPECT); iwd++; }
+      else if ( strcmp(WD0,"RA:") == 0 )
+	{ sscanf(WD1,"%le", &REC.RA); iwd++; }
+      else if ( strcmp(WD0,"DEC:") == 0 )
+	{ sscanf(WD1,"%le", &REC.DEC); iwd++; }
+      else if ( strcmp(WD0,"l:") == 0  || strcmp(WD0,"GLON:")==0 )
+	{ sscanf(WD1,"%le", &REC.GLON); iwd++; }
+      else if ( strcmp(WD0,"b:") == 0  || strcmp(WD0,"GLAT:")==0  )
+	{ sscanf(WD1,"%le", &REC.GLAT); iwd++; }
+      else if ( strcmp(WD0,"PARVAL:") == 0 )  {
+	LCLIB_EVENT.ID = (long long)REC.ID ; // for error message
+	read_PARVAL_LCLIB(LINE);  iwd++ ;
+	for(ipar=0; ipar < NPAR; ipar++ )
+	  { PARLIST[ipar] = LCLIB_EVENT.PARVAL_MODEL[ipar]; }
+	REC.HAS_PARVAL = 1 ;
+      }
+      else if ( strcmp(WD0,"ANGLEMATCH:") == 0 ) {
+	sprintf(c1err,"ANGLEMATCH not yet implemented.");
+	sprintf(c2err,"Try ANGLEMATCH_b");
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+      }
+      else if ( strcmp(WD0,"ANGLEMATCH_b:") == 0 )
+	{ sscanf(WD1,"%le", &REC.ANGLEMATCH_b);  iwd++ ; }
+
+      else if ( strcmp(WD0,"END_EVENT:") == 0 ) {
+	if ( REC.NROW != NROW_EXPECT ) {
+	  sprintf(c1err,"NROW_FOUND=%d (T+S rows), but  NROW_EXPECT=%d",
+		  REC.NROW, NROW_EXPECT );
+	  sprintf(c2err,"Check  Event ID=%lld in LCLIB", (long long)REC.ID);
+	  errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+	}
+	append_LCLIB_BIN(&INDEX,  &REC,    sizeof(LCLIB_BIN_INDEX_DEF) );
+	append_LCLIB_BIN(&PARVAL, PARLIST, NPAR*sizeof(double) );
+	HEAD.NEVENT++ ;
+	IN_EVENT = false ;  iwd++ ;
+      }
+      else
+	{ iwd++ ; }
+
+    } // end while over words
+  } // end fgets loop
+
+  if ( gzipFlag ) { pclose(fp); } else { fclose(fp); }
+
+  if ( HEAD.NEVENT == 0 ) {
+    sprintf(c1err,"Found no complete LCLIB events in");
+    sprintf(c2err,"%s", textFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  // - - - - - remaining sections (rows of partial last event are
+  //           written, but not indexed)
+  int64_t LEN_ROW = HEAD.NROW * NDROW * (int64_t)sizeof(double) ;
+  fwrite_pad8_LCLIB_BIN(fpbin, LEN_ROW);
+  HEAD.OFFSET_FLAG   = HEAD.OFFSET_ROW   + pad8_LCLIB_BIN(LEN_ROW);
+  HEAD.OFFSET_INDEX  = HEAD.OFFSET_FLAG  + pad8_LCLIB_BIN(FLAG.LEN);
+  HEAD.OFFSET_PARVAL = HEAD.OFFSET_INDEX + pad8_LCLIB_BIN(INDEX.LEN);
+
+  fwrite(FLAG.BUF,   1, FLAG.LEN,   fpbin);
+  fwrite_pad8_LCLIB_BIN(fpbin, FLAG.LEN);
+  fwrite(INDEX.BUF,  1, INDEX.LEN,  fpbin);
+  fwrite_pad8_LCLIB_BIN(fpbin, INDEX.LEN);
+  fwrite(PARVAL.BUF, 1, PARVAL.LEN, fpbin);
+
+  fseek(fpbin, 0, SEEK_SET);
+  fwrite(&HEAD, sizeof(LCLIB_BIN_HEAD_DEF), 1, fpbin);
+
+  if ( fclose(fpbin) != 0 ) {
+    sprintf(c1err,"Error writing binary LCLIB file");
+    sprintf(c2err,"'%s'", tmpFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  // replace binFile atomically; existing mmaps keep the old file
+  if ( rename(tmpFile, binFile) != 0 ) {
+    sprintf(c1err,"Cannot rename '%s'", tmpFile);
+    sprintf(c2err,"to '%s'", binFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  printf("\t Wrote %d LCLIB events with %lld T:+S: rows\n",
+	 HEAD.NEVENT, (long long)HEAD.NROW );
+  printf("\t Next time use GENMODEL: LCLIB %s \n", binFile);
+  fflush(stdout);
+
+  free(GLOBAL.BUF); free(FLAG.BUF); free(INDEX.BUF); free(PARVAL.BUF);
+
+  return ;
+
+} // end compile_LCLIB_BIN
+
+
+// =======================================
+static void append_LCLIB_BIN(LCLIB_BIN_BUFFER_DEF *B, void *ptr,
+			     int64_t LEN) {
+
+  // Created Oct 2026
+  // Append LEN bytes to buffer B; double buffer size as needed.
+
+  char fnam[] = "append_LCLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  if ( B->LEN + LEN > B->SIZE ) {
+    int64_t SIZE = ( B->SIZE > 0 ? 2*B->SIZE : 1000000 );
+    while ( SIZE < B->LEN + LEN ) { SIZE *= 2; }
+    B->BUF = (char*)realloc(B->BUF, SIZE);
+    if ( B->BUF == NULL ) {
+      sprintf(c1err,"Cannot realloc %lld bytes", (long long)SIZE);
+      sprintf(c2err,"for binary LCLIB section");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    B->SIZE = SIZE;
+  }
+
+  memcpy(&B->BUF[B->LEN], ptr, LEN);
+  B->LEN += LEN ;
+
+} // end append_LCLIB_BIN
+
+static int64_t pad8_LCLIB_BIN(int64_t LEN)
+{ return ( (LEN + 7)/8 ) * 8 ; }
+
+static void fwrite_pad8_LCLIB_BIN(FILE *fp, int64_t LEN) {
+  // write zeros to pad section of length LEN to 8 bytes
+  char zero[8] = { 0,0,0,0,0,0,0,0 };
+  fwrite(zero, 1, pad8_LCLIB_BIN(LEN) - LEN, fp);
+}
+
+
+// =======================================
+FILE *open_LCLIB_BIN(char *PATH_LIST, char *fileName, char *fullName) {
+
+  // Created Oct 2026
+  // If fileName (searched in pwd, then in space-separated PATH_LIST)
+  // is a compiled LCLIB, mmap it, fill LCLIB_BIN struct, and
+  // return a stream over the global-header text so that the usual
+  // read_GLOBAL_HEADER_LCLIB can be used.
+  //
+  // Returns NULL (and LCLIB_BIN.USE=0) if file is not found or
+  // does not start with MAGIC_LCLIB_BIN; caller then reads TEXT.
+  //
+  // Output: fullName = name of opened file
+
+#define MXPATH_LCLIB_BIN 4
+
+  char *PATH[MXPATH_LCLIB_BIN], sepKey[] = " " ;
+  char magic[8];
+  int  ipath, NPATH, fd, i ;
+  struct stat statbuf ;
+  LCLIB_BIN_HEAD_DEF *HEAD ;
+  int64_t LEN_PARVAL ;
+  FILE *fp = NULL ;
+  char fnam[] = "open_LCLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  LCLIB_BIN.USE = 0 ;
+
+  // check pwd, then each path
+  sprintf(fullName, "%s", fileName );
+  fp = fopen(fullName, "rb");
+  if ( fp == NULL ) {
+    for(ipath=0; ipath < MXPATH_LCLIB_BIN; ipath++ )
+      { PATH[ipath] = (char*) malloc(MXPATHLEN*sizeof(char) ); }
+    splitString(PATH_LIST, sepKey, fnam, MXPATH_LCLIB_BIN, &NPATH, PATH);
+    for(ipath=0; ipath < NPATH && fp == NULL; ipath++ ) {
+      sprintf(fullName, "%s/%s", PATH[ipath], fileName );
+      fp = fopen(fullName, "rb");
+    }
+    for(ipath=0; ipath < MXPATH_LCLIB_BIN; ipath++ )  { free(PATH[ipath]); }
+  }
+
+  if ( fp == NULL ) { return NULL; }
+
+  magic[0] = 0;
+  i = fread(magic, 1, 8, fp);
+  fclose(fp);
+  if ( i != 8 || memcmp(magic, MAGIC_LCLIB_BIN, 8) != 0 ) { return NULL; }
+
+  // - - - - map entire file - - - -
+  fd = open(fullName, O_RDONLY);
+  if ( fd < 0 || fstat(fd, &statbuf) != 0 ) {
+    sprintf(c1err,"Cannot open/stat binary LCLIB");
+    sprintf(c2err,"%s", fullName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  LCLIB_BIN.SIZE = (size_t)statbuf.st_size ;
+  LCLIB_BIN.MAP  = (char*)mmap(NULL, LCLIB_BIN.SIZE, PROT_READ,
+			       MAP_SHARED, fd, 0);
+  close(fd);
+  if ( LCLIB_BIN.MAP == MAP_FAILED ) {
+    sprintf(c1err,"Cannot mmap %lld bytes of binary LCLIB",
+	    (long long)LCLIB_BIN.SIZE);
+    sprintf(c2err,"%s", fullName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  HEAD = (LCLIB_BIN_HEAD_DEF*)LCLIB_BIN.MAP ;
+  LEN_PARVAL = (int64_t)HEAD->NEVENT * HEAD->NPAR * (int64_t)sizeof(double);
+  if ( HEAD->VERSION != VERSION_LCLIB_BIN ||
+       HEAD->OFFSET_PARVAL + LEN_PARVAL > (int64_t)LCLIB_BIN.SIZE ) {
+    sprintf(c1err,"Invalid binary LCLIB (VERSION=%d, expect %d) "
+	    "or truncated file", HEAD->VERSION, VERSION_LCLIB_BIN );
+    sprintf(c2err,"Re-create %s", fullName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  LCLIB_BIN.HEAD   = HEAD ;
+  LCLIB_BIN.ROW    = (double*)(LCLIB_BIN.MAP + HEAD->OFFSET_ROW);
+  LCLIB_BIN.FLAG   = LCLIB_BIN.MAP + HEAD->OFFSET_FLAG ;
+  LCLIB_BIN.INDEX  = (LCLIB_BIN_INDEX_DEF*)(LCLIB_BIN.MAP+HEAD->OFFSET_INDEX);
+  LCLIB_BIN.PARVAL = (double*)(LCLIB_BIN.MAP + HEAD->OFFSET_PARVAL);
+  sprintf(LCLIB_BIN.FILENAME, "%s", fullName);
+
+  LCLIB_BIN.IEVT_NEXT      = 0 ;
+  LCLIB_BIN.THREAD_STARTED = 0 ;
+  LCLIB_BIN.NSCAN = LCLIB_BIN.NREJECT_PARVAL = 0.0 ;
+  LCLIB_BIN.NREJECT_ANGLEMATCH = LCLIB_BIN.NACCEPT = 0.0 ;
+  LCLIB_BIN.T_WAIT = 0.0 ;
+  LCLIB_BIN.USE = 1 ;
+
+  printf("\t Opened : %s \n", fullName );
+  printf("\t (binary LCLIB: %d events, %lld T:+S: rows)\n",
+	 HEAD->NEVENT, (long long)HEAD->NROW );
+  fflush(stdout);
+
+  fp = fmemopen(LCLIB_BIN.MAP + HEAD->OFFSET_GLOBAL,
+		(size_t)HEAD->LEN_GLOBAL, "r");
+  return fp ;
+
+} // end open_LCLIB_BIN
+
+
+// =======================================
+void seek_LCLIB_BIN(int IEVT) {
+
+  // Created Oct 2026
+  // Set next event to read; must be called before first read.
+
+  char fnam[] = "seek_LCLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  if ( LCLIB_BIN.THREAD_STARTED ) {
+    sprintf(c1err,"Cannot seek to event %d after prefetch started", IEVT);
+    sprintf(c2err,"for %s", LCLIB_BIN.FILENAME );
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  LCLIB_BIN.IEVT_NEXT = IEVT % LCLIB_BIN.HEAD->NEVENT ;
+
+} // end seek_LCLIB_BIN
+
+
+// =======================================
+static void start_prefetch_LCLIB_BIN(void) {
+
+  // Created Oct 2026
+  // Init prefetch queue and start prefetch thread.
+
+  int islot, istat ;
+  char fnam[] = "start_prefetch_LCLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  for(islot=0; islot < NSLOT_LCLIB_BIN; islot++ ) {
+    LCLIB_BIN.SLOT[islot].IEVT  = -1 ;
+    LCLIB_BIN.SLOT[islot].NROW  =  0 ;
+    LCLIB_BIN.SLOT[islot].MXROW =  0 ;
+    LCLIB_BIN.SLOT[islot].ROW   = NULL ;
+    LCLIB_BIN.SLOT[islot].FLAG  = NULL ;
+  }
+  LCLIB_BIN.IPUT = LCLIB_BIN.IGET = LCLIB_BIN.NREADY = 0 ;
+
+  pthread_mutex_init(&LCLIB_BIN.MUTEX, NULL);
+  pthread_cond_init (&LCLIB_BIN.COND_READY, NULL);
+  pthread_cond_init (&LCLIB_BIN.COND_SPACE, NULL);
+
+  istat = pthread_create(&LCLIB_BIN.THREAD, NULL, prefetch_LCLIB_BIN, NULL);
+  if ( istat != 0 ) {
+    sprintf(c1err,"pthread_create returned %d", istat);
+    sprintf(c2err,"Cannot start LCLIB prefetch thread");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+  pthread_detach(LCLIB_BIN.THREAD);
+
+  LCLIB_BIN.THREAD_STARTED = 1 ;
+
+} // end start_prefetch_LCLIB_BIN
+
+
+// =======================================
+static void *prefetch_LCLIB_BIN(void *arg) {
+
+  // Created Oct 2026
+  // Prefetch thread: for each free slot, find next event (file
+  // order, with wrap-around) passing LCLIB_CUTWIN, and copy its
+  // rows out of the mapped file. If no event passes after a full
+  // pass over the library, publish IEVT=-1 and exit; the main
+  // thread aborts.
+  //
+  // No errmsg or LCLIB_EVENT access here.
+
+  int NEVENT = LCLIB_BIN.HEAD->NEVENT ;
+  int NPAR   = LCLIB_BIN.HEAD->NPAR ;
+  int NDROW  = 1 + LCLIB_BIN.HEAD->NFILT ;
+  int islot, ievt, IEVT, NTRY, NROW ;
+  double NSCAN, NREJECT ;
+  LCLIB_BIN_SLOT_DEF  *SLOT ;
+  LCLIB_BIN_INDEX_DEF *REC ;
+
+  // ----------- BEGIN ------------
+
+  while ( 1 ) {
+
+    pthread_mutex_lock(&LCLIB_BIN.MUTEX);
+    while ( LCLIB_BIN.NREADY == NSLOT_LCLIB_BIN )
+      { pthread_cond_wait(&LCLIB_BIN.COND_SPACE, &LCLIB_BIN.MUTEX); }
+    islot = LCLIB_BIN.IPUT ;
+    pthread_mutex_unlock(&LCLIB_BIN.MUTEX);
+
+    // find next event passing PARVAL cuts
+    SLOT = &LCLIB_BIN.SLOT[islot] ;
+    IEVT = -1;  NTRY = 0;  NSCAN = NREJECT = 0.0 ;
+    while ( NTRY < NEVENT ) {
+      ievt = LCLIB_BIN.IEVT_NEXT ;
+      LCLIB_BIN.IEVT_NEXT = (ievt+1) % NEVENT ;
+      NTRY++ ;  NSCAN++ ;
+      if ( keep_PARLIST_LCLIB(&LCLIB_BIN.PARVAL[(int64_t)ievt*NPAR]) )
+	{ IEVT = ievt;  break; }
+      NREJECT++ ;
+    }
+
+    // copy rows out of mapped file
+    SLOT->IEVT = IEVT ;
+    SLOT->NROW = 0 ;
+    if ( IEVT >= 0 ) {
+      REC  = &LCLIB_BIN.INDEX[IEVT] ;
+      NROW = REC->NROW ;
+      if ( NROW > SLOT->MXROW ) {
+	SLOT->MXROW = NROW ;
+	SLOT->ROW   = (double*)realloc(SLOT->ROW,
+				       (size_t)NROW*NDROW*sizeof(double));
+	SLOT->FLAG  = (char  *)realloc(SLOT->FLAG, (size_t)NROW);
+      }
+      memcpy(SLOT->ROW, &LCLIB_BIN.ROW[REC->IROW*NDROW],
+	     (size_t)NROW*NDROW*sizeof(double) );
+      memcpy(SLOT->FLAG, &LCLIB_BIN.FLAG[REC->IROW], (size_t)NROW );
+      SLOT->NROW = NROW ;
+    }
+
+    pthread_mutex_lock(&LCLIB_BIN.MUTEX);
+    LCLIB_BIN.IPUT = (islot+1) % NSLOT_LCLIB_BIN ;
+    LCLIB_BIN.NREADY++ ;
+    LCLIB_BIN.NSCAN          += NSCAN ;
+    LCLIB_BIN.NREJECT_PARVAL += NREJECT ;
+    pthread_cond_signal(&LCLIB_BIN.COND_READY);
+    pthread_mutex_unlock(&LCLIB_BIN.MUTEX);
+
+    if ( IEVT < 0 ) { break; }
+  }
+
+  return NULL ;
+
+} // end prefetch_LCLIB_BIN
+
+
+// =======================================
+int next_LCLIB_BIN(double GalLat, double GalLong, double *RA, double *DEC) {
+
+  // Created Oct 2026
+  // Take next prefetched event, apply ANGLEMATCH_b cut, and load
+  // LCLIB_EVENT as readNext_LCLIB does for TEXT. Rejected events
+  // are dropped before their rows are decoded.
+  // Inputs GalLat,GalLong are for simulated event; RA,DEC are
+  // passed to coord_translate_LCLIB.
+  //
+  // Returns number of rows loaded.
+
+  int NPAR   = LCLIB_BIN.HEAD->NPAR ;
+  int NDROW  = 1 + LCLIB_BIN.HEAD->NFILT ;
+  int NFAIL_ANGLEMATCH_b = 0 ;
+  int islot, IEVT, ipar, irow, NROW, KEEP ;
+  double t0 ;
+  LCLIB_BIN_SLOT_DEF  *SLOT ;
+  LCLIB_BIN_INDEX_DEF *REC ;
+  char fnam[] = "next_LCLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  if ( !LCLIB_BIN.THREAD_STARTED ) { start_prefetch_LCLIB_BIN(); }
+
+ NEXT_SLOT:
+
+  t0 = time_LCLIB_BIN();
+  pthread_mutex_lock(&LCLIB_BIN.MUTEX);
+  while ( LCLIB_BIN.NREADY == 0 )
+    { pthread_cond_wait(&LCLIB_BIN.COND_READY, &LCLIB_BIN.MUTEX); }
+  islot = LCLIB_BIN.IGET ;
+  pthread_mutex_unlock(&LCLIB_BIN.MUTEX);
+  LCLIB_BIN.T_WAIT += ( time_LCLIB_BIN() - t0 );
+
+  SLOT = &LCLIB_BIN.SLOT[islot] ;
+  IEVT = SLOT->IEVT ;
+  if ( IEVT < 0 ) {
+    sprintf(c1err,"No event in %d-event LCLIB passes LCLIB_CUTWIN cuts",
+	    LCLIB_BIN.HEAD->NEVENT );
+    sprintf(c2err,"Check LCLIB_CUTWIN in sim-input file.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+  }
+
+  REC  = &LCLIB_BIN.INDEX[IEVT] ;
+  NROW = REC->NROW ;
+
+  init_EVENT_LCLIB();
+  LCLIB_EVENT.ID           = (long long)REC->ID ;
+  LCLIB_EVENT.NROW         = NROW ;
+  LCLIB_EVENT.RA           = REC->RA ;
+  LCLIB_EVENT.DEC          = REC->DEC ;
+  LCLIB_EVENT.GLAT         = REC->GLAT ;
+  LCLIB_EVENT.GLON         = REC->GLON ;
+  LCLIB_EVENT.ANGLEMATCH_b = REC->ANGLEMATCH_b ;
+
+  if ( REC->HAS_PARVAL ) {
+    for(ipar=0; ipar < NPAR; ipar++ ) {
+      LCLIB_EVENT.PARVAL_MODEL[ipar] =
+	LCLIB_BIN.PARVAL[(int64_t)IEVT*NPAR + ipar] ;
+    }
+    LCLIB_EVENT.PARVAL_MODEL[NPAR] = (double)LCLIB_EVENT.ID ;
+    set_REDSHIFT_LCLIB();
+  }
+
+  if ( REC->ANGLEMATCH_b < 500.0 )
+    { LCLIB_INFO.NREPEAT = 1 ; } // as for ANGLEMATCH_b key in TEXT
+
+  coord_translate_LCLIB(RA,DEC);
+
+  KEEP = keep_ANGLEMATCH_LCLIB(GalLat,GalLong);
+  if ( !KEEP ) {
+    LCLIB_BIN.NREJECT_ANGLEMATCH++ ;
+    NFAIL_ANGLEMATCH_b++ ;
+    if ( NFAIL_ANGLEMATCH_b > 10000 ) {
+      sprintf(c1err,"Unable to find %.1f deg b-angle match "
+	      "for %d LCLIB entries.",
+	      LCLIB_EVENT.ANGLEMATCH_b, NFAIL_ANGLEMATCH_b);
+      sprintf(c2err,"Sim b=%.2f deg\n", GalLat );
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+    }
+  }
+  else {
+    // decode rows
+    if ( NROW > 0 ) {
+      if ( LCLIB_EVENT.NEVENT_READ>0 ) { malloc_LCLIB_EVENT(-1); }
+      malloc_LCLIB_EVENT(+1);
+    }
+    for(irow=0; irow < NROW; irow++ ) {
+      load_ROW_LCLIB(irow, (SLOT->FLAG[irow]=='T') ? "T:" : "S:",
+		     SLOT->ROW[irow*NDROW], &SLOT->ROW[irow*NDROW+1] );
+    }
+    LCLIB_BIN.NACCEPT++ ;
+  }
+
+  // release slot
+  pthread_mutex_lock(&LCLIB_BIN.MUTEX);
+  LCLIB_BIN.IGET = (islot+1) % NSLOT_LCLIB_BIN ;
+  LCLIB_BIN.NREADY-- ;
+  pthread_cond_signal(&LCLIB_BIN.COND_SPACE);
+  pthread_mutex_unlock(&LCLIB_BIN.MUTEX);
+
+  if ( !KEEP ) { goto NEXT_SLOT; }
+
+  return NROW ;
+
+} // end next_LCLIB_BIN
+
+
+// =======================================
+void summary_LCLIB_BIN(void) {
+
+  // Created Oct 2026
+  // Print number of events scanned/rejected/accepted, and time
+  // that the sim waited for the prefetch thread.
+
+  double NSCAN ;
+
+  // ----------- BEGIN ------------
+
+  if ( !LCLIB_BIN.USE ) { return ; }
+
+  pthread_mutex_lock(&LCLIB_BIN.MUTEX);
+  NSCAN = LCLIB_BIN.NSCAN ;
+  pthread_mutex_unlock(&LCLIB_BIN.MUTEX);
+
+  printf("  Binary LCLIB: %.0f events accepted; rejected %.0f by "
+	 "LCLIB_CUTWIN (prefetch), %.0f by ANGLEMATCH_b \n",
+	 LCLIB_BIN.NACCEPT, LCLIB_BIN.NREJECT_PARVAL,
+	 LCLIB_BIN.NREJECT_ANGLEMATCH );
+  printf("                %.0f events scanned; sim waited %.3f sec "
+	 "for prefetch \n", NSCAN, LCLIB_BIN.T_WAIT );
+  fflush(stdout);
+
+  return ;
+
+} // end summary_LCLIB_BIN
+
+static double time_LCLIB_BIN(void) {
+  // monotonic wall-clock time (sec)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return( (double)ts.tv_sec + 1.0E-9*(double)ts.tv_nsec );
+}
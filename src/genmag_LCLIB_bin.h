@@ -0,0 +1,104 @@
+/********************************
+  Created Oct 2026
+
+  Compiled (binary) LCLIB: each event of a text LCLIB is stored
+  as one index record (ID, NROW, coordinates, ANGLEMATCH_b) plus
+  one row of PARVAL values, so that the sim can jump to any event
+  and apply PARVAL cuts without touching the light curve. The
+  T: and S: rows are stored as packed numbers so that they are
+  never re-parsed. The file is mapped with mmap.
+
+  File layout (native byte order, each section 8-byte aligned):
+    LCLIB_BIN_HEAD_DEF            fixed-size file header
+    global header text            verbatim, through first START_EVENT
+    double ROW[NROW][1+NFILT]     DAY and mag per band, as in text
+    char   FLAG[NROW]             'T' or 'S'
+    LCLIB_BIN_INDEX_DEF[NEVENT]   one entry per event (file order)
+    double PARVAL[NEVENT][NPAR]   -999 if event has no PARVAL key
+
+  Create with
+     GENMODEL_MSKOPT: 64
+  which writes ./<lcLibFile>.BIN (without .gz) and uses it;
+  later jobs can set GENMODEL: LCLIB <lcLibFile>.BIN
+
+  A background (pthread) prefetch fills a small queue with the next
+  events that pass the LCLIB_CUTWIN cuts, copying their rows out of
+  the mapped file while the current event is simulated. ANGLEMATCH_b
+  depends on the simulated event and is applied by the consumer.
+
+ *******************************/
+
+#include <stdint.h>
+#include <pthread.h>
+
+#define MAGIC_LCLIB_BIN        "SNLCLBIN"
+#define VERSION_LCLIB_BIN      1
+#define SUFFIX_LCLIB_BIN       ".BIN"
+#define OPTMASK_LCLIB_COMPILE_BIN  64  // GENMODEL_MSKOPT bit to compile
+#define NSLOT_LCLIB_BIN        8      // depth of prefetch queue
+#define MXCHAR_LINE_LCLIB_BIN  200    // same as fgets limit for TEXT LCLIB
+
+typedef struct {
+  char    MAGIC[8];
+  int     VERSION ;
+  int     NFILT ;              // number of bands (mags per row)
+  int     NPAR ;               // number of PARVAL values per event
+  int     NEVENT ;
+  int64_t NROW ;               // total number of T: + S: rows
+  int64_t OFFSET_GLOBAL, LEN_GLOBAL ;
+  int64_t OFFSET_ROW, OFFSET_FLAG ;
+  int64_t OFFSET_INDEX, OFFSET_PARVAL ;
+} LCLIB_BIN_HEAD_DEF ;
+
+typedef struct {
+  int64_t ID ;                 // after START_EVENT key
+  int64_t IROW ;               // index of first row
+  int     NROW ;               // number of T: + S: rows
+  int     HAS_PARVAL ;         // 1 -> PARVAL key was given
+  double  RA, DEC, GLAT, GLON ;// as read (999 if not given)
+  double  ANGLEMATCH_b ;       // 99999 if not given
+} LCLIB_BIN_INDEX_DEF ;
+
+typedef struct {
+  int     IEVT ;               // event index; -1 -> no event passes cuts
+  int     NROW, MXROW ;
+  double *ROW ;                // [NROW][1+NFILT]
+  char   *FLAG ;
+} LCLIB_BIN_SLOT_DEF ;
+
+
+struct {
+  int     USE ;
+  char    FILENAME[MXPATHLEN] ;
+  size_t  SIZE ;
+  char   *MAP ;
+
+  LCLIB_BIN_HEAD_DEF  *HEAD ;
+  LCLIB_BIN_INDEX_DEF *INDEX ;
+  double              *ROW, *PARVAL ;
+  char                *FLAG ;
+
+  int     IEVT_NEXT ;          // next event for prefetch to examine
+
+  // prefetch queue
+  int                 THREAD_STARTED ;
+  pthread_t           THREAD ;
+  pthread_mutex_t     MUTEX ;
+  pthread_cond_t      COND_READY, COND_SPACE ;
+  LCLIB_BIN_SLOT_DEF  SLOT[NSLOT_LCLIB_BIN] ;
+  int                 IPUT, IGET, NREADY ;
+
+  // stats
+  double  NSCAN, NREJECT_PARVAL, NREJECT_ANGLEMATCH, NACCEPT ;
+  double  T_WAIT ;             // time (sec) sim waited for prefetch
+} LCLIB_BIN ;
+
+
+// ---- function prototypes -----
+
+void  compile_LCLIB_BIN(char *textFile, char *binFile);
+FILE *open_LCLIB_BIN(char *PATH_LIST, char *fileName, char *fullName);
+void  seek_LCLIB_BIN(int IEVT);
+int   next_LCLIB_BIN(double GalLat, double GalLong, double *RA, double *DEC);
+void  summary_LCLIB_BIN(void);
+
@@ -41,6 +41,19 @@
 
  Oct 01 2021: no longer set magerr=5.0 -> avoid LC fit discontinuity.
 
+ Oct 2026: GENMODEL_MSKOPT += 256 -> use precomputed band-flux tables
+           vs. (z,Trest,color) instead of integrating each epoch;
+           GENMODEL_MSKOPT += 512 -> also compare with full integral and
+           report max mag difference (output uses full integral).
+
+ Oct 2026: INTEG_zSED_SALT2 resolves per-lambda branches into 
+           contiguous arrays, then calls branch-free integ_kernel_SALT2
+           compiled with runtime-selected AVX-512/AVX2/default clones.
+           Spectra (OPT_SPEC) with x2 surface (ised>=2) change by more
+           than rounding: fix bug where Finteg_spec was reset only
+           for ised=0,1, so x2 term was never initialized and summed
+           over all spectral bins.
+
 *************************************/
 
 #include "sntools.h"           // community tools
@@ -361,6 +374,9 @@ int init_genmag_SALT2(char *MODEL_VERSION, char *MODEL_EXTRAP_LATETIME,
   int EXTRAP_METHOD_PREFER = EXTRAP_PHASE_FLAM; 
   set_METHOD_EXTRAP_PHASE(EXTRAP_METHOD_PREFER);
 
+  // check option for precomputed band-flux tables (Oct 2026)
+  init_BANDFLUX_SALT2(OPTMASK);
+
 
   fflush(stdout) ;
 
@@ -2882,6 +2898,9 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
   // May 31 2021: refactor to pass parList_SN and parList_HOST
   // Aug 31 2023: use zero_NEGFLAM_SEDMODEL() util
   // Dec 28 2023: implement x2 component
+  // Oct 2026: check option to use precomputed band-flux table
+  // Oct 2026: use vectorized integ_kernel_SALT2 unless FLAM-extrap
+  //           or zero_NEGFLAM option (which need per-lambda logic)
 
   int NSED = SEDMODEL.NSURFACE;
 
@@ -2928,6 +2947,28 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
 
   // ----------- BEGIN ---------------
 
+  // check option for precomputed band-flux tables (Oct 2026)
+  if ( BANDFLUX_SALT2.USE && OPT_SPEC == 0 && !BANDFLUX_SALT2.INSIDE_CHECK ) {
+    double Ftable, Ftable_errPar;
+    int USE_TABLE = get_BANDFLUX_SALT2(ifilt_obs, z, Tobs, 
+				       parList_SN, parList_HOST,
+				       &Ftable, &Ftable_errPar);
+    if ( USE_TABLE ) {
+      if ( !BANDFLUX_SALT2.CHECK ) {
+	*Finteg = Ftable;  *Finteg_errPar = Ftable_errPar ;
+	return ;
+      }
+      // CHECK mode: return full integral, but compare with table
+      BANDFLUX_SALT2.INSIDE_CHECK = true ;
+      INTEG_zSED_SALT2(OPT_SPEC, ifilt_obs, z, Tobs, parList_SN, parList_HOST,
+		       Finteg, Finteg_errPar, Fspec);
+      BANDFLUX_SALT2.INSIDE_CHECK = false ;
+      check_BANDFLUX_SALT2(ifilt_obs, z, Tobs/(1.0+z), parList_SN[2],
+			   Ftable, *Finteg);
+      return ;
+    }
+  }
+
   *Finteg = *Finteg_errPar = 0.0 ;
   Fspec[0] = 0.0 ; // init only first element
 
@@ -3020,6 +3061,124 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
     free(lam);
   }
 
+  // - - - - - - - - - 
+  // Oct 2026: vectorized integration. Stage 1 below resolves all
+  // lambda-dependent branches (model range, smearing, host & MW
+  // extinction, color law, spectrograph sub-bins) into contiguous 
+  // arrays; stage 2 is a branch-free kernel for each SED surface.
+  if ( !DO_EXTRAP_LOCAL && NEGFLAM_SEDMODEL.ALLOW && !LDMP_KERNEL_SALT2 ) {
+    int    NK = 0, k ;
+    double WBASE, W_ERR, SUMS[2];
+    KERNEL_BUFFER_SALT2_DEF *BUF = &KERNEL_BUFFER_SALT2 ;
+
+    if ( OPT_SPEC ) { 
+      malloc_KERNEL_BUFFER_SALT2(NLAMFILT);
+      for(ilamobs=0; ilamobs < NLAMFILT; ilamobs++ ) 
+	{ BUF->FSPEC[ilamobs] = 0.0 ; }
+    }
+
+    for ( ilamobs=0; ilamobs < NLAMFILT; ilamobs++ ) {
+
+      get_LAMTRANS_SEDMODEL(ifilt,ilamobs, &LAMOBS, &TRANS);
+      if ( TRANS < 1.0E-12 && OPT_SPEC==0) { continue ; }
+
+      MWXT_FRAC  = SEDMODEL_TABLE_MWXT_FRAC[ifilt][ilamobs] ;
+      if( RV_host > 1.0E-9 && AV_host > 1.0E-9 ) 
+	{ HOSTXT_FRAC = SEDMODEL_TABLE_HOSTXT_FRAC[ifilt][ilamobs] ; }
+      else 
+	{ HOSTXT_FRAC = 1.0 ; }
+
+      LAMSED     = LAMOBS / z1 ;
+      LAMSED_MIN = LAMSED_MAX = LAMSED ;
+      if ( LAMSED <= SALT2_TABLE.LAMMIN ) { continue ; }
+      if ( LAMSED >= SALT2_TABLE.LAMMAX ) { continue ; } 
+
+      if ( OPT_SPEC > 0 && DO_SPECTROGRAPH ) {
+	LAMSED_MIN = SPECTROGRAPH_SEDMODEL.LAMMIN_LIST[ilamobs]/z1 ; 
+	LAMSED_MAX = SPECTROGRAPH_SEDMODEL.LAMMAX_LIST[ilamobs]/z1 ;
+      }
+
+      FSMEAR = 1.0 ;
+      if ( ISTAT_GENSMEAR ) 
+	{ FSMEAR = pow(TEN, -0.4*GENSMEAR.MAGSMEAR_LIST[ilamobs]) ; }
+
+      for(LAMSED = LAMSED_MIN; LAMSED <= LAMSED_MAX; LAMSED+=LAMSED_STEP ) {
+
+	if ( LAMSED <= SALT2_TABLE.LAMMIN ) { continue ; }
+	if ( LAMSED >= SALT2_TABLE.LAMMAX ) { continue ; } 
+
+	LAMDIF  = LAMSED - SALT2_TABLE.LAMMIN ;
+	ilamsed = (int)(LAMDIF/LAMSED_STEP); 
+	LAMDIF  = LAMSED - SALT2_TABLE.LAMSED[ilamsed] ;
+	FRAC_INTERP_LAMSED = LAMDIF / LAMSED_STEP ; 
+
+	// let legacy loop below print pre-abort info
+	LABORT_ILAM = ( ilamsed < 0 || ilamsed >= SALT2_TABLE.NLAMSED );     
+	LABORT_FRAC = ( FRAC_INTERP_LAMSED < -1.0E-8 || 
+			FRAC_INTERP_LAMSED > 1.0000000001 ) ;
+	if ( LABORT_ILAM || LABORT_FRAC ) { goto LEGACY_LOOP ; }
+
+	VAL0  = SALT2_TABLE.COLORLAW[ic+0][ilamsed];
+	VAL1  = SALT2_TABLE.COLORLAW[ic+1][ilamsed];
+	CCOR_LAM0  = VAL0 + (VAL1-VAL0) * FRAC_INTERP_COLOR ;
+	VAL0  = SALT2_TABLE.COLORLAW[ic+0][ilamsed+1];
+	VAL1  = SALT2_TABLE.COLORLAW[ic+1][ilamsed+1];
+	CCOR_LAM1  = VAL0 + (VAL1-VAL0) * FRAC_INTERP_COLOR ;
+	CCOR = CCOR_LAM0 + (CCOR_LAM1-CCOR_LAM0)*FRAC_INTERP_LAMSED ;
+
+	malloc_KERNEL_BUFFER_SALT2(NK+1);
+	WBASE = FSMEAR * CCOR * HOSTXT_FRAC ;
+	W_ERR = WBASE * LAMSED * TRANS ;
+	BUF->ILAM[NK]   = ilamsed ;
+	BUF->FRAC[NK]   = FRAC_INTERP_LAMSED ;
+	BUF->W_ERR[NK]  = W_ERR ;
+	BUF->W_FLUX[NK] = W_ERR * MWXT_FRAC ;
+
+	if ( OPT_SPEC ) {
+	  LAMSPEC_STEP = LAMFILT_STEP ;
+	  if ( DO_SPECTROGRAPH ) {
+	    if ( LAMSED+LAMSED_STEP < LAMSED_MAX ) 
+	      { LAMSPEC_STEP = LAMSED_STEP  ; }
+	    else
+	      { LAMSPEC_STEP = (LAMSED_MAX-LAMSED) ; }
+	  }
+	  BUF->W_SPEC[NK] = WBASE * MWXT_FRAC * (LAMSPEC_STEP/LAMFILT_STEP);
+	  BUF->IOUT[NK]   = ilamobs ;
+	}
+	NK++ ;
+      } // end LAMSED loop
+
+      Fnorm_SALT3  += (TRANS * LAMOBS ); 
+    } // end ilamobs
+
+    // stage 2: kernel for each SED surface
+    for(ised=0; ised < NSED; ised++ ) {
+      integ_kernel_SALT2(NK, BUF->ILAM, BUF->FRAC, BUF->W_FLUX, BUF->W_ERR,
+			 ptr_FLUXSED[ised][0], ptr_FLUXSED[ised][1],
+			 FRAC_INTERP_DAY, BUF->FSED, SUMS);
+      Finteg_filter[ised] = SUMS[0] ;
+      Finteg_forErr[ised] = SUMS[1] ;
+
+      if ( OPT_SPEC ) {
+	for(k=0; k < NK; k++ ) {
+	  BUF->FSPEC[BUF->IOUT[k]] += 
+	    x_loop[ised] * BUF->W_SPEC[k] * BUF->FSED[k] ;
+	}
+      }
+    }
+
+    if ( OPT_SPEC ) {
+      for(ilamobs=0; ilamobs < NLAMFILT; ilamobs++ ) 
+	{ Fspec[ilamobs] = BUF->FSPEC[ilamobs] * x0 * MODELNORM_Fspec ; }
+    }
+
+    goto SUM_FINTEG ;
+  }
+
+ LEGACY_LOOP:
+  Fnorm_SALT3 = 0.0 ;
+  for(ised=0; ised < 3; ised++ )  
+    { Finteg_filter[ised] = Finteg_forErr[ised] = 0.0 ; }
 
   // Loop over obs-filter lambda-bins. XTMW has the same binning,
   // but the color and SED flux must be interpolated.
@@ -3051,7 +3210,8 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
 
     // check spectrum options
     if ( OPT_SPEC > 0 ) {
-      for(ised=0; ised<=1; ised++ ) { Finteg_spec[ised] = 0.0 ; }
+      // Oct 2026: reset all surfaces (was ised<=1 -> x2 spectrum bug)
+      for(ised=0; ised < NSED; ised++ ) { Finteg_spec[ised] = 0.0 ; }
       if ( DO_SPECTROGRAPH )  {
 	// prepare sub-bins since SPECTROGRAPH bins can be large
 	LAMSED_MIN = SPECTROGRAPH_SEDMODEL.LAMMIN_LIST[ilamobs]/z1 ; 
@@ -3219,6 +3379,7 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
   } // end ilamobs loop over obs filter
 
  
+ SUM_FINTEG:
   // - - - - - - - - - - 
   // compute total flux in filter
   for(ised=0; ised < NSED; ised++ ) 
@@ -3246,6 +3407,477 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
 } // end of INTEG_zSED_SALT2
 
 
+// **********************************************
+TARGET_CLONES_SALT2
+void integ_kernel_SALT2(int NK, const int *ILAM, const double *FRAC,
+			const double *W_FLUX, const double *W_ERR,
+			const double *SED_DAY0, const double *SED_DAY1,
+			double FRAC_DAY, double *FSED, double *SUMS) {
+
+  // Created Oct 2026
+  // Branch-free integration kernel for one SED surface:
+  //   FSED[k] = SED interpolated to lambda-bin k and Trest,
+  //   SUMS[0] = Sum_k W_FLUX[k]*FSED[k]  (filter integral)
+  //   SUMS[1] = Sum_k W_ERR[k]*FSED[k]   (idem without MW, for errors)
+  // ILAM/FRAC are the rest-frame SED lambda index and fraction;
+  // SED_DAY0/1 are the SED fluxes on the two days sandwiching Trest.
+  //
+  // Lanes of NLANE_KERNEL_SALT2 independent accumulators allow the
+  // compiler to vectorize the sum (incl. gathers) without fast-math;
+  // TARGET_CLONES_SALT2 selects AVX-512, AVX2 or default at runtime.
+
+  double ACC_FLUX[NLANE_KERNEL_SALT2], ACC_ERR[NLANE_KERNEL_SALT2];
+  double F0, F1, F ;
+  int    k, j, i, NK_LANE = NK - (NK % NLANE_KERNEL_SALT2) ;
+
+  // ----------- BEGIN -----------
+
+  for(j=0; j < NLANE_KERNEL_SALT2; j++ ) { ACC_FLUX[j] = ACC_ERR[j] = 0.0; }
+
+  for(k=0; k < NK_LANE; k += NLANE_KERNEL_SALT2 ) {
+    for(j=0; j < NLANE_KERNEL_SALT2; j++ ) {
+      i  = ILAM[k+j] ;
+      F0 = SED_DAY0[i] + (SED_DAY0[i+1]-SED_DAY0[i]) * FRAC[k+j] ;
+      F1 = SED_DAY1[i] + (SED_DAY1[i+1]-SED_DAY1[i]) * FRAC[k+j] ;
+      F  = F0 + (F1-F0) * FRAC_DAY ;
+      FSED[k+j]    = F ;
+      ACC_FLUX[j] += W_FLUX[k+j] * F ;
+      ACC_ERR[j]  += W_ERR[k+j]  * F ;
+    }
+  }
+
+  for(k=NK_LANE; k < NK; k++ ) {
+    i  = ILAM[k] ;
+    F0 = SED_DAY0[i] + (SED_DAY0[i+1]-SED_DAY0[i]) * FRAC[k] ;
+    F1 = SED_DAY1[i] + (SED_DAY1[i+1]-SED_DAY1[i]) * FRAC[k] ;
+    F  = F0 + (F1-F0) * FRAC_DAY ;
+    FSED[k]      = F ;
+    ACC_FLUX[0] += W_FLUX[k] * F ;
+    ACC_ERR[0]  += W_ERR[k]  * F ;
+  }
+
+  SUMS[0] = SUMS[1] = 0.0 ;
+  for(j=0; j < NLANE_KERNEL_SALT2; j++ ) 
+    { SUMS[0] += ACC_FLUX[j];  SUMS[1] += ACC_ERR[j]; }
+
+  return ;
+
+} // end integ_kernel_SALT2
+
+
+// **********************************************
+void malloc_KERNEL_BUFFER_SALT2(int NK) {
+
+  // Created Oct 2026
+  // Make sure that integ_kernel_SALT2 buffers have at least NK
+  // elements; grow geometrically to avoid frequent realloc.
+
+  KERNEL_BUFFER_SALT2_DEF *BUF = &KERNEL_BUFFER_SALT2 ;
+  int NEW ;
+
+  // ----------- BEGIN -----------
+
+  if ( NK <= BUF->NALLOC ) { return; }
+
+  NEW = 2*BUF->NALLOC ;
+  if ( NEW < NK   ) { NEW = NK ; }
+  if ( NEW < 1000 ) { NEW = 1000 ; }
+
+  BUF->ILAM   = (int   *)realloc(BUF->ILAM,   NEW*sizeof(int)   );
+  BUF->IOUT   = (int   *)realloc(BUF->IOUT,   NEW*sizeof(int)   );
+  BUF->FRAC   = (double*)realloc(BUF->FRAC,   NEW*sizeof(double));
+  BUF->W_FLUX = (double*)realloc(BUF->W_FLUX, NEW*sizeof(double));
+  BUF->W_ERR  = (double*)realloc(BUF->W_ERR,  NEW*sizeof(double));
+  BUF->W_SPEC = (double*)realloc(BUF->W_SPEC, NEW*sizeof(double));
+  BUF->FSED   = (double*)realloc(BUF->FSED,   NEW*sizeof(double));
+  BUF->FSPEC  = (double*)realloc(BUF->FSPEC,  NEW*sizeof(double));
+  BUF->NALLOC = NEW ;
+
+  return ;
+
+} // end malloc_KERNEL_BUFFER_SALT2
+
+
+
+// **********************************************
+void init_BANDFLUX_SALT2(int OPTMASK) {
+
+  // Created Oct 2026
+  // Init optional tables of band-integrated SED-surface fluxes.
+  // Tables are indexed by z-node, color-node, SED surface, and
+  // SED day; each column [ised][iday][imom] is filled on first use
+  // by column_BANDFLUX_SALT2, so that only the z and color range
+  // of the simulation is computed and stored.
+
+  int NFILT = NFILT_SEDMODEL ;
+  int ifilt, iz, NZ, NC, MEMP ;
+  char fnam[] = "init_BANDFLUX_SALT2" ;
+
+  // ------------ BEGIN -------------
+
+  BANDFLUX_SALT2.USE   = 
+    ( (OPTMASK & GENMODEL_MSKOPT_SALT2_BANDFLUX_TABLE) > 0 ||
+      (OPTMASK & GENMODEL_MSKOPT_SALT2_BANDFLUX_CHECK) > 0 ) ;
+  BANDFLUX_SALT2.CHECK = 
+    ( (OPTMASK & GENMODEL_MSKOPT_SALT2_BANDFLUX_CHECK) > 0 ) ;
+  BANDFLUX_SALT2.INSIDE_CHECK = false ;
+
+  if ( !BANDFLUX_SALT2.USE ) { return; }
+
+  BANDFLUX_SALT2.DZ     = DZ_BANDFLUX_SALT2 ;
+  BANDFLUX_SALT2.DC     = DC_BANDFLUX_SALT2 ;
+  BANDFLUX_SALT2.NCSTEP = (int)(DC_BANDFLUX_SALT2/SALT2_TABLE.CSTEP + 0.5);
+  BANDFLUX_SALT2.NZ     = (int)(ZMAX_BANDFLUX_SALT2/DZ_BANDFLUX_SALT2) + 2 ;
+  BANDFLUX_SALT2.NC     = (SALT2_TABLE.NCBIN-1)/BANDFLUX_SALT2.NCSTEP + 1 ;
+  BANDFLUX_SALT2.NDAY   = SALT2_TABLE.NDAY ;
+  BANDFLUX_SALT2.NSED   = SEDMODEL.NSURFACE ;
+  BANDFLUX_SALT2.RV_MW  = -9.0 ;
+
+  BANDFLUX_SALT2.NCALL_TABLE = BANDFLUX_SALT2.NCALL_INTEG = 0 ;
+  BANDFLUX_SALT2.NCOLUMN     = 0 ;
+  BANDFLUX_SALT2.MEMORY_MB   = 0.0 ;
+  BANDFLUX_SALT2.NCHECK      = 0 ;
+  BANDFLUX_SALT2.DMAG_MAX    = BANDFLUX_SALT2.DMAG_SUM = 0.0 ;
+  BANDFLUX_SALT2.IFILT_atMAX = -9 ;
+
+  // color nodes must land on SALT2_TABLE color bins
+  if ( fabs(BANDFLUX_SALT2.NCSTEP*SALT2_TABLE.CSTEP - 
+	    DC_BANDFLUX_SALT2) > 1.0E-6 ) {
+    sprintf(c1err,"DC_BANDFLUX_SALT2=%.4f is not a multiple of CSTEP=%.4f",
+	    DC_BANDFLUX_SALT2, SALT2_TABLE.CSTEP);
+    sprintf(c2err,"Fix DC_BANDFLUX_SALT2 in genmag_SALT2.h");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
+  NZ   = BANDFLUX_SALT2.NZ ;
+  NC   = BANDFLUX_SALT2.NC ;
+  MEMP = (NFILT+1) * sizeof(double*) ;
+  BANDFLUX_SALT2.R_MW  = (double **)malloc(MEMP);
+  BANDFLUX_SALT2.FNORM = (double **)malloc(MEMP);
+  BANDFLUX_SALT2.FLUX  = (double***)malloc((NFILT+1) * sizeof(double**));
+
+  for(ifilt=0; ifilt <= NFILT; ifilt++ ) {
+    BANDFLUX_SALT2.R_MW[ifilt]  = NULL ;
+    BANDFLUX_SALT2.FNORM[ifilt] = NULL ;
+    BANDFLUX_SALT2.FLUX[ifilt]  = NULL ;
+    if ( ifilt == JFILT_SPECTROGRAPH ) { continue; }
+
+    BANDFLUX_SALT2.FNORM[ifilt] = (double *)malloc(NZ*sizeof(double));
+    BANDFLUX_SALT2.FLUX[ifilt]  = (double**)malloc(NZ*NC*sizeof(double*));
+    for(iz=0; iz < NZ; iz++ ) { BANDFLUX_SALT2.FNORM[ifilt][iz] = -1.0; }
+    for(iz=0; iz < NZ*NC; iz++ ) { BANDFLUX_SALT2.FLUX[ifilt][iz] = NULL;}
+  }
+
+  printf("\n  %s: band-flux tables with dz=%.3f, dc=%.3f, %d SED days\n",
+	 fnam, BANDFLUX_SALT2.DZ, BANDFLUX_SALT2.DC, BANDFLUX_SALT2.NDAY );
+  if ( BANDFLUX_SALT2.CHECK ) 
+    { printf("\t CHECK mode: compare table with full integral.\n"); }
+  fflush(stdout);
+
+  return ;
+
+} // end init_BANDFLUX_SALT2
+
+
+// **********************************************
+int get_BANDFLUX_SALT2(int ifilt_obs, double z, double Tobs,
+		       double *parList_SN, double *parList_HOST,
+		       double *Finteg, double *Finteg_errPar ) {
+
+  // Created Oct 2026
+  // Return band-integrated flux from precomputed tables, with the
+  // same normalization as INTEG_zSED_SALT2. Interpolation is linear
+  // in Trest (exact since INTEG_zSED_SALT2 interpolates SEDs linearly
+  // in day), and quadratic in z and in color. Galactic extinction
+  // is applied with the 2nd-order cumulant of R(lam) within the band:
+  //   F = M0 * exp( -a*E*<R> + (a*E)^2 * Var(R)/2 ),  a=0.4*ln(10).
+  //
+  // Functions returns 1 if table was used, or 0 if caller must do
+  // full integration; e.g., per-lambda intrinsic smearing, host
+  // extinction, FLAM extrapolation, negative-flux zeroing, or
+  // z/color outside table range.
+
+  int  NSED  = BANDFLUX_SALT2.NSED ;
+  int  NDAY  = BANDFLUX_SALT2.NDAY ;
+  int  NC    = BANDFLUX_SALT2.NC ;
+  int  NZ    = BANDFLUX_SALT2.NZ ;
+  int  NMOM  = NMOM_BANDFLUX_SALT2 ;
+  double x0  = parList_SN[0];
+  double x1  = parList_SN[1];
+  double c   = parList_SN[2];
+  double x2  = parList_SN[4];
+  double x_loop[3] = { 1.0, x1, x2 } ;
+  double RV_host = parList_HOST[0];
+  double AV_host = parList_HOST[1];
+  double mwebv   = SEDMODEL_MWEBV_LAST ;
+  double z1      = 1.0 + z ;
+  double Trest   = Tobs / z1 ;
+  double hc8     = (double)hc ;
+
+  int    ifilt, IDAY, iz0, ic0, jz, jc, ised, imom, iz, ic, j0, j1 ;
+  double DAYDIF, FRAC_DAY, tz, tc, WZ[3], WC[3], W ;
+  double S[MXSURFACE_SALT2][NMOM_BANDFLUX_SALT2], M[NMOM_BANDFLUX_SALT2];
+  double Fnorm, aE, Rmean, Rvar, F, *col, MODELNORM ;
+
+  // ------------ BEGIN -------------
+
+  *Finteg = *Finteg_errPar = 0.0 ;
+
+  // options with lambda-dependent per-event inputs need full integral
+  if ( istat_genSmear() )                          { goto INTEG ; }
+  if ( RV_host > 1.0E-9 && AV_host > 1.0E-9 )      { goto INTEG ; }
+  if ( !NEGFLAM_SEDMODEL.ALLOW )                   { goto INTEG ; }
+  if ( ifilt_obs == JFILT_SPECTROGRAPH )           { goto INTEG ; }
+  if ( EXTRAP_PHASE_METHOD == EXTRAP_PHASE_FLAM &&
+       Trest > INPUT_EXTRAP_LATETIME_Ia.DAYMIN )   { goto INTEG ; }
+  if ( BANDFLUX_SALT2.RV_MW > 0.0 && 
+       BANDFLUX_SALT2.RV_MW != MWXT_SEDMODEL.RV )  { goto INTEG ; }
+
+  ifilt = IFILTMAP_SEDMODEL[ifilt_obs] ;
+
+  // day index; same as in INTEG_zSED_SALT2
+  DAYDIF   = Trest - SALT2_TABLE.DAY[0] ;
+  IDAY     = (int)(DAYDIF/SALT2_TABLE.DAYSTEP);
+  if ( IDAY < 0 || IDAY >= NDAY-1 )  { goto INTEG ; }
+  FRAC_DAY = (Trest - SALT2_TABLE.DAY[IDAY]) / SALT2_TABLE.DAYSTEP ;
+
+  // nearest z and color nodes, and quadratic Lagrange weights
+  iz0 = (int)(z/BANDFLUX_SALT2.DZ + 0.5);
+  if ( iz0 < 1 ) { iz0 = 1; }
+  if ( iz0 > NZ-2 ) { goto INTEG ; }
+  tz  = z/BANDFLUX_SALT2.DZ - (double)iz0 ;
+
+  tc  = (c - SALT2_TABLE.CMIN)/BANDFLUX_SALT2.DC ;
+  ic0 = (int)(tc + 0.5);
+  if ( ic0 < 1 || ic0 > NC-2 ) { goto INTEG ; }
+  tc -= (double)ic0 ;
+
+  WZ[0] = 0.5*tz*(tz-1.0);  WZ[1] = (1.0-tz)*(1.0+tz);  WZ[2] = 0.5*tz*(tz+1.0);
+  WC[0] = 0.5*tc*(tc-1.0);  WC[1] = (1.0-tc)*(1.0+tc);  WC[2] = 0.5*tc*(tc+1.0);
+
+  for(ised=0; ised < NSED; ised++ ) 
+    { for(imom=0; imom < NMOM; imom++ ) { S[ised][imom] = 0.0; } }
+  Fnorm = 0.0 ;
+
+  for(jz=0; jz < 3; jz++ ) {
+    iz = iz0 - 1 + jz ;
+    for(jc=0; jc < 3; jc++ ) {
+      ic  = ic0 - 1 + jc ;
+      col = column_BANDFLUX_SALT2(ifilt, iz, ic);
+      W   = WZ[jz] * WC[jc] ;
+      for(ised=0; ised < NSED; ised++ ) {
+	j0 = (ised*NDAY + IDAY) * NMOM ;
+	j1 = j0 + NMOM ;
+	for(imom=0; imom < NMOM; imom++ ) {
+	  S[ised][imom] += W * ( col[j0+imom] + 
+				 (col[j1+imom]-col[j0+imom])*FRAC_DAY ) ;
+	}
+      }
+    }
+    Fnorm += WZ[jz] * BANDFLUX_SALT2.FNORM[ifilt][iz] ;
+  }
+
+  // combine surfaces
+  for(imom=0; imom < NMOM; imom++ ) {
+    M[imom] = 0.0 ;
+    for(ised=0; ised < NSED; ised++ ) 
+      { M[imom] += x_loop[ised] * S[ised][imom] ; }
+  }
+
+  // apply Galactic extinction
+  F = M[0] ;
+  if ( mwebv > 0.0 ) {
+    if ( M[0] <= 0.0 ) { goto INTEG ; }
+    aE    = 0.4 * LNTEN * mwebv ;
+    Rmean = M[1]/M[0] ;
+    Rvar  = M[2]/M[0] - Rmean*Rmean ;
+    F     = M[0] * exp( -aE*Rmean + 0.5*aE*aE*Rvar ) ;
+  }
+
+  MODELNORM = FILTER_SEDMODEL[ifilt].lamstep * SEDMODEL.FLUXSCALE / hc8 ;
+  *Finteg   = x0 * F * MODELNORM ;
+
+  // error parameter: same definition as in INTEG_zSED_SALT2
+  if ( ISMODEL_SALT2 ) {
+    if ( S[0][0] != 0.0 ) { *Finteg_errPar = S[1][0] / S[0][0] ; }
+  }
+  else if ( ISMODEL_SALT3 ) {
+    if ( Fnorm > 0.0 ) { *Finteg_errPar = M[0] / Fnorm ; }
+  }
+
+  BANDFLUX_SALT2.NCALL_TABLE++ ;
+  return 1 ;
+
+ INTEG:
+  BANDFLUX_SALT2.NCALL_INTEG++ ;
+  return 0 ;
+
+} // end get_BANDFLUX_SALT2
+
+
+// **********************************************
+double *column_BANDFLUX_SALT2(int ifilt, int iz, int ic) {
+
+  // Created Oct 2026
+  // Return pointer to table column [ised][iday][imom] for 
+  // sparse filter index ifilt, z-node iz and color-node ic.
+  // If column is not yet filled, integrate each SED surface and
+  // SED day over the filter using the same lambda sampling,
+  // interpolation and model-range cuts as INTEG_zSED_SALT2.
+
+  int  NSED   = BANDFLUX_SALT2.NSED ;
+  int  NDAY   = BANDFLUX_SALT2.NDAY ;
+  int  NC     = BANDFLUX_SALT2.NC ;
+  int  NMOM   = NMOM_BANDFLUX_SALT2 ;
+  int  icol   = iz*NC + ic ;
+  int  icT    = ic * BANDFLUX_SALT2.NCSTEP ; // SALT2_TABLE color bin
+  int  NLAMFILT = FILTER_SEDMODEL[ifilt].NLAM ;
+
+  double z    = (double)iz * BANDFLUX_SALT2.DZ ;
+  double z1   = 1.0 + z ;
+  double LAMSED_STEP = SALT2_TABLE.LAMSTEP ;
+  bool   DO_FNORM    = ( BANDFLUX_SALT2.FNORM[ifilt][iz] < 0.0 ) ;
+
+  int    ilamobs, ilamsed, ised, iday, j, MEMD ;
+  double LAMOBS, TRANS, LAMSED, LAMDIF, FRAC, CCOR, W, R, VAL0, VAL1 ;
+  double FSED, Fnorm = 0.0, *col, *FLUXSED ;
+
+  // ------------ BEGIN -------------
+
+  col = BANDFLUX_SALT2.FLUX[ifilt][icol] ;
+  if ( col != NULL ) { return col; }
+
+  // MW color law R(lam) for this filter, computed once
+  if ( BANDFLUX_SALT2.R_MW[ifilt] == NULL ) {
+    double RV = MWXT_SEDMODEL.RV ;
+    BANDFLUX_SALT2.RV_MW       = RV ;
+    BANDFLUX_SALT2.R_MW[ifilt] = (double*)malloc(NLAMFILT*sizeof(double));
+    for(ilamobs=0; ilamobs < NLAMFILT; ilamobs++ ) {
+      LAMOBS = FILTER_SEDMODEL[ifilt].lam[ilamobs] ;
+      BANDFLUX_SALT2.R_MW[ifilt][ilamobs] = 
+	GALextinct(RV, RV, LAMOBS, MWXT_SEDMODEL.OPT_COLORLAW);
+    }
+  }
+
+  MEMD = NSED * NDAY * NMOM * sizeof(double) ;
+  col  = (double*)malloc(MEMD);
+  for(j=0; j < NSED*NDAY*NMOM; j++ ) { col[j] = 0.0 ; }
+
+  for(ilamobs=0; ilamobs < NLAMFILT; ilamobs++ ) {
+
+    get_LAMTRANS_SEDMODEL(ifilt, ilamobs, &LAMOBS, &TRANS);
+    if ( TRANS < 1.0E-12 ) { continue ; }
+
+    LAMSED = LAMOBS / z1 ;
+    if ( LAMSED <= SALT2_TABLE.LAMMIN ) { continue ; }
+    if ( LAMSED >= SALT2_TABLE.LAMMAX ) { continue ; } 
+
+    LAMDIF  = LAMSED - SALT2_TABLE.LAMMIN ;
+    ilamsed = (int)(LAMDIF/LAMSED_STEP); 
+    FRAC    = (LAMSED - SALT2_TABLE.LAMSED[ilamsed]) / LAMSED_STEP ;
+
+    // color node is exactly on SALT2_TABLE color bin
+    VAL0 = SALT2_TABLE.COLORLAW[icT][ilamsed];
+    VAL1 = SALT2_TABLE.COLORLAW[icT][ilamsed+1];
+    CCOR = VAL0 + (VAL1-VAL0)*FRAC ;
+
+    W = CCOR * LAMSED * TRANS ;
+    R = BANDFLUX_SALT2.R_MW[ifilt][ilamobs] ;
+
+    for(ised=0; ised < NSED; ised++ ) {
+      for(iday=0; iday < NDAY; iday++ ) {
+	FLUXSED = SALT2_TABLE.SEDFLUX[ised][iday] ;
+	VAL0    = FLUXSED[ilamsed+0] ;
+	VAL1    = FLUXSED[ilamsed+1] ;
+	FSED    = (VAL0 + (VAL1-VAL0)*FRAC) * W ;
+	j       = (ised*NDAY + iday) * NMOM ;
+	col[j+0] += FSED ;
+	col[j+1] += FSED * R ;
+	col[j+2] += FSED * R * R ;
+      }
+    }
+
+    Fnorm += (TRANS * LAMOBS);
+
+  } // end ilamobs
+
+  if ( DO_FNORM ) { BANDFLUX_SALT2.FNORM[ifilt][iz] = Fnorm; }
+
+  BANDFLUX_SALT2.FLUX[ifilt][icol] = col ;
+  BANDFLUX_SALT2.NCOLUMN++ ;
+  BANDFLUX_SALT2.MEMORY_MB += 1.0E-6 * (double)MEMD ;
+
+  return col ;
+
+} // end column_BANDFLUX_SALT2
+
+
+// **********************************************
+void check_BANDFLUX_SALT2(int ifilt_obs, double z, double Trest, double c,
+			  double Ftable, double Finteg) {
+
+  // Created Oct 2026
+  // For CHECK mode, accumulate mag difference between table-flux
+  // and full integral; track max difference for summary.
+
+  double DMAG ;
+
+  // ------------ BEGIN -------------
+
+  if ( Ftable <= 0.0 || Finteg <= 0.0 ) { return; }
+
+  DMAG = fabs( 2.5*log10(Ftable/Finteg) ) ;
+  BANDFLUX_SALT2.NCHECK++ ;
+  BANDFLUX_SALT2.DMAG_SUM += DMAG ;
+
+  if ( DMAG > BANDFLUX_SALT2.DMAG_MAX ) {
+    BANDFLUX_SALT2.DMAG_MAX    = DMAG ;
+    BANDFLUX_SALT2.Z_atMAX     = z ;
+    BANDFLUX_SALT2.TREST_atMAX = Trest ;
+    BANDFLUX_SALT2.C_atMAX     = c ;
+    BANDFLUX_SALT2.IFILT_atMAX = ifilt_obs ;
+  }
+
+  return ;
+
+} // end check_BANDFLUX_SALT2
+
+
+// **********************************************
+void summary_BANDFLUX_SALT2(void) {
+
+  // Created Oct 2026
+  // Print table usage, memory, and CHECK-mode accuracy.
+
+  long long NCHECK = BANDFLUX_SALT2.NCHECK ;
+  int  ifilt_obs   = BANDFLUX_SALT2.IFILT_atMAX ;
+  char cfilt[2]    = "?" ;
+
+  // ------------ BEGIN -------------
+
+  if ( !BANDFLUX_SALT2.USE ) { return; }
+
+  printf("  SALT2 band-flux tables: %lld table calls, %lld integrals, "
+	 "%d columns (%.1f MB)\n",
+	 BANDFLUX_SALT2.NCALL_TABLE, BANDFLUX_SALT2.NCALL_INTEG,
+	 BANDFLUX_SALT2.NCOLUMN, BANDFLUX_SALT2.MEMORY_MB );
+
+  if ( NCHECK > 0 ) {
+    if ( ifilt_obs >= 0 ) { cfilt[0] = FILTERSTRING[ifilt_obs]; }
+    printf("  SALT2 band-flux CHECK: <|dmag|>=%.2e  max|dmag|=%.2e "
+	   "(band=%s z=%.3f Trest=%.1f c=%.3f)\n",
+	   BANDFLUX_SALT2.DMAG_SUM/(double)NCHECK, BANDFLUX_SALT2.DMAG_MAX,
+	   cfilt, BANDFLUX_SALT2.Z_atMAX, BANDFLUX_SALT2.TREST_atMAX, 
+	   BANDFLUX_SALT2.C_atMAX );
+  }
+  fflush(stdout);
+
+  return ;
+
+} // end summary_BANDFLUX_SALT2
+
+
+
 // **********************************************
 double SALT2x0calc(
 		   double alpha   // (I)
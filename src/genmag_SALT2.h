@@ -37,6 +37,8 @@
 #define GENMODEL_MSKOPT_SALT2_DISABLE_WAVESHIFT   8  // disable WAVESHIFT keys
 #define GENMODEL_MSKOPT_SALT2_ABORT_LAMRANGE   64  // abort on bad model-LAMRANGE
 #define GENMODEL_MSKOPT_SALT2_DEBUG   1024    // Refactor for developer only
+#define GENMODEL_MSKOPT_SALT2_BANDFLUX_TABLE 256 // precomputed band-flux tables
+#define GENMODEL_MSKOPT_SALT2_BANDFLUX_CHECK 512 // compare table vs. integral
 
 
 int  DEBUG_SALT2;
@@ -224,6 +226,37 @@ struct SALT2_TABLE {
 
 
 
+// Oct 2026: optional tables of band-integrated SED-surface fluxes
+// vs. (z, Trest) for a set of color nodes. Each table column is
+// [ised][iday][imom], with moments imom=0,1,2 -> Sum[w*R^imom] where 
+// w = FSED*CCOR*LAMSED*TRANS and R = A_MW(lam)/E(B-V). Galactic
+// extinction is applied from the moments (2nd-order cumulant), so the
+// tables do not depend on MWEBV. Columns are filled on first use.
+#define DZ_BANDFLUX_SALT2     0.01   // z-node spacing (quadratic interp)
+#define DC_BANDFLUX_SALT2     0.05   // color-node spacing (quadratic interp)
+#define ZMAX_BANDFLUX_SALT2   4.0    // max z-node
+#define NMOM_BANDFLUX_SALT2   3      // moments 1, R, R^2 of MW color law
+
+struct {
+  bool    USE, CHECK ;
+  bool    INSIDE_CHECK ;    // T -> doing full integral for CHECK
+  int     NZ, NC, NDAY, NSED, NCSTEP ;
+  double  DZ, DC, RV_MW ;
+  double  **R_MW ;          // [ifilt][ilamobs] = A(lam)/E(B-V) for MW
+  double  ***FLUX ;         // [ifilt][iz*NC+ic] -> column
+  double  **FNORM ;         // [ifilt][iz] = Sum TRANS*LAMOBS (SALT3 err)
+
+  // diagnostics
+  long long NCALL_TABLE, NCALL_INTEG ;
+  int     NCOLUMN ;
+  double  MEMORY_MB ;
+  long long NCHECK ;
+  double  DMAG_MAX, DMAG_SUM ;
+  double  Z_atMAX, TREST_atMAX, C_atMAX ;
+  int     IFILT_atMAX ;
+} BANDFLUX_SALT2 ;
+
+
 // define structure for storing SALT2 spectrum and storing in table.
 
 
@@ -299,6 +332,39 @@ void INTEG_zSED_SALT2(int OPT_SPEC, int ifilt_obs, double z, double Tobs,
 		      double *Finteg, double *Finteg_errPar, 
 		      double *Fspec );
 
+// Oct 2026: vectorized integration kernel; runtime dispatch of 
+// AVX-512/AVX2/default clones where GCC target_clones is available.
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) && !defined(NO_TARGET_CLONES)
+#define TARGET_CLONES_SALT2 __attribute__((target_clones("avx512f","avx2","default")))
+#else
+#define TARGET_CLONES_SALT2
+#endif
+#define NLANE_KERNEL_SALT2  8   // independent accumulators in kernel
+#define LDMP_KERNEL_SALT2   0   // 1 -> force legacy loop (debug)
+
+typedef struct {
+  int    NALLOC ;
+  int    *ILAM, *IOUT ;
+  double *FRAC, *W_FLUX, *W_ERR, *W_SPEC, *FSED, *FSPEC ;
+} KERNEL_BUFFER_SALT2_DEF ;
+KERNEL_BUFFER_SALT2_DEF KERNEL_BUFFER_SALT2 ;
+
+void integ_kernel_SALT2(int NK, const int *ILAM, const double *FRAC,
+			const double *W_FLUX, const double *W_ERR,
+			const double *SED_DAY0, const double *SED_DAY1,
+			double FRAC_DAY, double *FSED, double *SUMS);
+void malloc_KERNEL_BUFFER_SALT2(int NK);
+
+// precomputed band-flux tables (Oct 2026)
+void init_BANDFLUX_SALT2(int OPTMASK);
+int  get_BANDFLUX_SALT2(int ifilt_obs, double z, double Tobs,
+			double *parList_SN, double *parList_HOST,
+			double *Finteg, double *Finteg_errPar );
+double *column_BANDFLUX_SALT2(int ifilt, int iz, int ic);
+void check_BANDFLUX_SALT2(int ifilt_obs, double z, double Trest, double c,
+			  double Ftable, double Finteg);
+void summary_BANDFLUX_SALT2(void);
+
 int gencovar_SALT2(int MATSIZE, int *ifilt_obs, double *epobs, 
 		   double z, double *parList_SN, double *parList_HOST, 
 		   double mwebv, double *covar );
@@ -51,6 +51,13 @@
       extinction table is no longer created for every iteration.
       Fits now go almost x10 faster ... same speed as in March 2020
 
+  Oct 2026:
+    + flux table stored with epoch as innermost index (was SED), so that
+      the epochs needed to interpolate one SED are contiguous.
+      Binary files keep the original order via fread/fwrite_FLUXTABLE.
+    + new interpBlend_flux_SEDMODEL interpolates a weighted sum of SEDs
+      that share one DAY grid in a single pass over the table.
+
 ********************************************/
 
 #include "sntools.h"           // community tools
@@ -572,6 +579,8 @@ void malloc_FLUXTABLE_SEDMODEL( int NFILT, int NZBIN, int NLAMPOW,
   // Jan 30, 2010: switch from fancy 5-dim pointer to 1d pointer
   // Dec 15, 2021: fix isize=sizeof(float) instead of pointer size.
   // Feb 01, 2024: abort if max pointer size (NBTOT_DBL) exceeds 2 billion
+  // Oct     2026: epoch is innermost index (was SED) so that epochs
+  //               for each SED are contiguous.
   int isize;
   char fnam[] = "malloc_FLUXTABLE_SEDMODEL" ;
 
@@ -638,10 +647,10 @@ void malloc_FLUXTABLE_SEDMODEL( int NFILT, int NZBIN, int NLAMPOW,
     (NSED+1) * (NDAY+1) * (NLAMPOW+1) ;
   N1DBINOFF_SEDMODEL_FLUXTABLE[3] = 
     (NSED+1) * (NDAY+1) ;
-  N1DBINOFF_SEDMODEL_FLUXTABLE[4] = 
-    (NSED+1) ;
-  N1DBINOFF_SEDMODEL_FLUXTABLE[5] = 
-    1;
+  N1DBINOFF_SEDMODEL_FLUXTABLE[4] =   // day
+    1 ;
+  N1DBINOFF_SEDMODEL_FLUXTABLE[5] =   // sed
+    (NDAY+1);
 
   sprintf(VARNAME_SEDMODEL_FLUXTABLE[1],"NFILT");
   sprintf(VARNAME_SEDMODEL_FLUXTABLE[2],"NZBIN");
@@ -1578,6 +1587,40 @@ double interp_flux_SEDMODEL(
   // Return interpolated flux-integral 'S' 
   // from pre-tabulated tables
   //
+  // Oct 2026: shell for interpBlend_flux_SEDMODEL with one SED.
+
+  int    ISED_LIST[1] = { ISED } ;
+  double WGT_LIST[1]  = { 1.0  } ;
+  return interpBlend_flux_SEDMODEL(1, ISED_LIST, WGT_LIST, 
+				   ilampow, ifilt_obs, z, Trest);
+
+} // end of interp_flux_SEDMODEL
+
+
+// ***************************************
+double interpBlend_flux_SEDMODEL(
+			    int NSED        // number of SEDs to blend
+			    ,int *ISED_LIST // SED surface ids 1-MXSED
+			    ,double *WGT_LIST // weight per SED
+			    ,int ilampow    // lambda power of integral
+			    ,int ifilt_obs  // observer  filter index
+			    ,double z       // redshift
+			    ,double Trest   // Tobs (days; 0=peak)
+			    ) {
+
+  // Return interpolated flux-integral 'S' for weighted sum of
+  // NSED SEDs, SUM_i WGT_LIST[i] * S(ISED_LIST[i]).
+  // Interpolation is linear in the table values, so the weighted
+  // sum is done on the local (logz,Trest) table slice and then
+  // interpolated once. Caller must ensure that all SEDs share the
+  // DAY grid and wavelength coverage of ISED_LIST[0], which is used
+  // for all range checks below. NSED=1 & WGT=1 is the original
+  // interp_flux_SEDMODEL.
+  //
+  // Oct 2026: refactored from interp_flux_SEDMODEL.
+  //
+  // HISTORY from interp_flux_SEDMODEL:
+  //
   // Aug 17 2015: fix long-standing bug; replace TEMP_SEDMODEL.DAY with
   //              DAYLIST from this SED. Previously was using last read
   //              DAYLIST.
@@ -1595,7 +1638,9 @@ double interp_flux_SEDMODEL(
   //   results in negative flux from quadratic assumption.
   //
   int 
-    ifilt, NDAY, EPMAX, index, LDMP, NZBIN, IZLO, EPLO, ep, iz, NZTMP
+    ISED = ISED_LIST[0]
+    ,ifilt, NDAY, EPMAX, index, LDMP, NZBIN, IZLO, EPLO, ep, iz, NZTMP
+    ,ised, ISED_TMP
     ,NBIN_SPLINE = 3
     ,NZBIN_SPLINE, NEPBIN_SPLINE
     ;
@@ -1611,7 +1656,7 @@ double interp_flux_SEDMODEL(
     ,z1 = 1.0 + z
     ;
 
-  char fnam[] = "interp_flux_SEDMODEL" ;
+  char fnam[] = "interpBlend_flux_SEDMODEL" ;
   
   // ---------- BEGIN -------------
 
@@ -1726,13 +1771,19 @@ double interp_flux_SEDMODEL(
   // for now do quad-interp in each dimension ...
   // later should use a real spline-interp
  
-  // create local LOGZ x TREST grid 
+  // create local LOGZ x TREST grid; sum over SEDs with epochs
+  // contiguous in the table.
   for ( iz=0; iz < NZBIN_SPLINE; iz++ ) {
-    for ( ep=0; ep < NEPBIN_SPLINE; ep++ ) {
-      index = INDEX_SEDMODEL_FLUXTABLE(ifilt,IZLO+iz,ilampow,EPLO+ep,ISED);
-      S2DTMP[iz][ep] = PTR_SEDMODEL_FLUXTABLE[index] ;
-      
-    } // ep
+    for ( ep=0; ep < NEPBIN_SPLINE; ep++ ) { S2DTMP[iz][ep] = 0.0 ; }
+
+    for ( ised=0; ised < NSED; ised++ ) {
+      ISED_TMP = ISED_LIST[ised] ;
+      index = INDEX_SEDMODEL_FLUXTABLE(ifilt,IZLO+iz,ilampow,EPLO,ISED_TMP);
+      for ( ep=0; ep < NEPBIN_SPLINE; ep++ ) {
+	S2DTMP[iz][ep] += 
+	  WGT_LIST[ised] * (double)PTR_SEDMODEL_FLUXTABLE[index+ep] ;
+      }
+    } // ised
 
     // interpolate across epoch to get SZ
     if ( NDAY > 1 ) {
@@ -1780,7 +1831,7 @@ double interp_flux_SEDMODEL(
 
   return(S) ;
 
-} // end of interp_flux_SEDMODEL
+} // end of interpBlend_flux_SEDMODEL
 
 
 
@@ -1808,6 +1859,106 @@ long int INDEX_SEDMODEL_FLUXTABLE(int ifilt, int iz,
 
 } // end of INDEX_SEDMODEL_FLUXTABLE
 
+
+// *******************************************
+void fwrite_FLUXTABLE_SEDMODEL(FILE *fp) {
+
+  // Created Oct 2026
+  // Write flux table to binary file in original order with SED as 
+  // innermost index, so that binary files are independent of the 
+  // memory layout (epoch innermost). Writes one row of SEDs at a time.
+
+  int NFILT = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_FILTER] ;
+  int NZBIN = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_REDSHIFT] ;
+  int NLPOW = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_LAMPOW] ;
+  int NDAY  = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_DAY] ;
+  int NSED  = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_SED] ;
+  long int NSTRIDE = N1DBINOFF_SEDMODEL_FLUXTABLE[5] ;
+  long int INDEX ;
+  int ifilt, iz, ilampow, iep, ised ;
+  float *ROW ;
+  char fnam[] = "fwrite_FLUXTABLE_SEDMODEL" ;
+
+  // ------- BEGIN --------
+
+  ROW = (float*) malloc( (NSED+1) * sizeof(float) );
+  if ( ROW == NULL ) {
+    sprintf(c1err,"Cannot malloc %d floats", NSED+1);
+    sprintf(c2err,"for flux-table row");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  for(ifilt=0; ifilt <= NFILT; ifilt++ ) {
+    for(iz=0; iz <= NZBIN; iz++ ) {
+      for(ilampow=0; ilampow <= NLPOW; ilampow++ ) {
+	for(iep=0; iep <= NDAY; iep++ ) {
+	  INDEX = INDEX_SEDMODEL_FLUXTABLE(ifilt,iz,ilampow,iep,0);
+	  for(ised=0; ised <= NSED; ised++ ) 
+	    { ROW[ised] = PTR_SEDMODEL_FLUXTABLE[INDEX + ised*NSTRIDE]; }
+	  fwrite(ROW, sizeof(float), NSED+1, fp);
+	}
+      }
+    }
+  }
+
+  free(ROW);
+  return ;
+
+} // end fwrite_FLUXTABLE_SEDMODEL
+
+
+// *******************************************
+void fread_FLUXTABLE_SEDMODEL(FILE *fp) {
+
+  // Created Oct 2026
+  // Read flux table written by fwrite_FLUXTABLE_SEDMODEL (or any
+  // earlier version, which wrote the same order in one fwrite),
+  // and store with epoch as innermost index.
+
+  int NFILT = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_FILTER] ;
+  int NZBIN = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_REDSHIFT] ;
+  int NLPOW = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_LAMPOW] ;
+  int NDAY  = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_DAY] ;
+  int NSED  = NBIN_SEDMODEL_FLUXTABLE[IDIM_SEDMODEL_SED] ;
+  long int NSTRIDE = N1DBINOFF_SEDMODEL_FLUXTABLE[5] ;
+  long int INDEX ;
+  int ifilt, iz, ilampow, iep, ised, NRD ;
+  float *ROW ;
+  char fnam[] = "fread_FLUXTABLE_SEDMODEL" ;
+
+  // ------- BEGIN --------
+
+  ROW = (float*) malloc( (NSED+1) * sizeof(float) );
+  if ( ROW == NULL ) {
+    sprintf(c1err,"Cannot malloc %d floats", NSED+1);
+    sprintf(c2err,"for flux-table row");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  for(ifilt=0; ifilt <= NFILT; ifilt++ ) {
+    for(iz=0; iz <= NZBIN; iz++ ) {
+      for(ilampow=0; ilampow <= NLPOW; ilampow++ ) {
+	for(iep=0; iep <= NDAY; iep++ ) {
+	  NRD = fread(ROW, sizeof(float), NSED+1, fp);
+	  if ( NRD != NSED+1 ) {
+	    sprintf(c1err,"Read %d of %d floats for ifilt=%d iz=%d iep=%d",
+		    NRD, NSED+1, ifilt, iz, iep );
+	    sprintf(c2err,"Binary flux table is truncated.");
+	    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+	  }
+	  INDEX = INDEX_SEDMODEL_FLUXTABLE(ifilt,iz,ilampow,iep,0);
+	  for(ised=0; ised <= NSED; ised++ ) 
+	    { PTR_SEDMODEL_FLUXTABLE[INDEX + ised*NSTRIDE] = ROW[ised]; }
+	}
+      }
+    }
+  }
+
+  free(ROW);
+  return ;
+
+} // end fread_FLUXTABLE_SEDMODEL
+
 // ************************************
 double get_magerr_SEDMODEL( int ISED, int ifilt_obs,
 			     double z, double Trest) {
@@ -224,6 +224,10 @@ float SEDBINARY[MXBIN_SED_SEDMODEL];
 //  - additional power of lambda inside integral
 //  - epoch
 //  - template-SED id
+//
+// Oct 2026: in memory, epoch is the innermost (fastest) index so that
+// the epochs of one SED are contiguous; binary flux-table files keep
+// the original SED-innermost order (see fread/fwrite_FLUXTABLE_SEDMODEL).
 
 
 
@@ -302,6 +306,9 @@ bool zero_NEGFLAM_SEDMODEL(int INDEX_SED, double LAM, double Trest, double FLAM)
 
 double interp_flux_SEDMODEL(int ISED, int ilampower, int ifilt_obs, 
 			    double z, double Trest );
+double interpBlend_flux_SEDMODEL(int NSED, int *ISED_LIST, double *WGT_LIST,
+				 int ilampow, int ifilt_obs, 
+				 double z, double Trest);
 double get_flux_SEDMODEL(int ISED, int ilampow, int ifilt_obs,
 			 double z, double Trest) ;
 double get_magerr_SEDMODEL(int ISED, int ifilt_obs,
@@ -329,6 +336,8 @@ void pack_SEDBINARY(int OPT); // OP+1 => PACK;  OPT=-1 => UNPACK
 
 long int INDEX_SEDMODEL_FLUXTABLE(int ifilt, int iz, 
 			     int ilampow, int iep, int  ised);
+void fwrite_FLUXTABLE_SEDMODEL(FILE *fp);
+void fread_FLUXTABLE_SEDMODEL(FILE *fp);
 
 int get_SEDMODEL_INDICES( int IPAR, double LUMIPAR, 
 			 int *ILOSED, int *IHISED);
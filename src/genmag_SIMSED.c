@@ -56,6 +56,14 @@
  Mar 02 2022: fix bug so that UVLAM_EXTRAP works when reading binary file
               or original text files.
 
+ Oct 2026:
+   + SED corners & weights for multi-parameter interpolation are found
+     once per event (set_interp_SIMSED) instead of per epoch & filter.
+   + corners with the same DAY grid are summed on the flux-table slice
+     and interpolated once (corner_flux_SIMSED).
+   + flux-table binary is read/written with fread/fwrite_FLUXTABLE so
+     that file format is unchanged with new epoch-innermost memory layout.
+
 *************************************/
 
 #include  <stdio.h> 
@@ -215,6 +223,7 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
 
   ISIMSED_SEQUENTIAL = -9 ;  // xxx mark delete 
   ISIMSED_SELECT     = -9 ;  // for SEQUENTIAL or WGT opton
+  INTERP_SIMSED.VALID = false ; // Oct 2026
 
   SEDMODEL.NSURFACE   = 0 ;
   SEDMODEL.FLUXSCALE  = 1.0 ;
@@ -420,7 +429,7 @@ int init_genmag_SIMSED(char *VERSION      // SIMSED version
     if ( BINARYFLAG_KCORFILENAME ) 
       { fwrite(SIMSED_KCORFILE,  MXPATHLEN, 1, fpbin2 ); }
 
-    fwrite(PTR_SEDMODEL_FLUXTABLE, ISIZE_SEDMODEL_FLUXTABLE,1,fpbin2);
+    fwrite_FLUXTABLE_SEDMODEL(fpbin2); // Oct 2026
     fclose(fpbin2);
     printf("\n  Write filter-integral flux-table to binary file: \n");
     printf("\t %s \n\n", bin2File);
@@ -702,7 +711,7 @@ void read_SIMSED_TABBINARY(FILE *fp, char *binFile) {
   // ------------
   // read entire flux table
   printf("\t Read entire flux table ... "); fflush(stdout);
-  fread(PTR_SEDMODEL_FLUXTABLE, ISIZE_SEDMODEL_FLUXTABLE, 1, fp);
+  fread_FLUXTABLE_SEDMODEL(fp); // Oct 2026: reorder to epoch-innermost
   printf("Done reading. \n"); fflush(stdout);
 
   return ;
@@ -1469,6 +1478,9 @@ void genmag_SIMSED(
 
   Mar 6 2024: minor refactor to handle SEQUENTIAL and WGT using same tools.
 
+  Oct 2026: find SED corners & weights once before epoch loop 
+            (set_interp_SIMSED), then corner_flux_SIMSED for each epoch.
+
   ***/
 
   double  meanlam_obs, meanlam_rest, ZP, z1, Tobs, Trest, flux, arg, Sinterp  ;
@@ -1537,6 +1549,13 @@ void genmag_SIMSED(
 	   Nobs, ifilt_obs, z, SEDMODEL.DAYMAX_ALL, *lumipar );
     fflush(stdout);
   }
+
+  // SED corners & weights depend only on lumipar, so find them once
+  // here (or re-use from previous filter) rather than for each epoch.
+  if ( !LSED_SELECT && Nobs > 0 ) {
+    set_interp_SIMSED(iflagpar, iparmap, lumipar,
+		      ifilt_obs, z, Tobs_list[0]/z1 );
+  }
   
   for ( epobs=0; epobs < Nobs; epobs++ ) {
     
@@ -1552,8 +1571,7 @@ void genmag_SIMSED(
     else {
       // interpolate flux for these lumipar. Note that
       // early/late extrap is included in underlying get_flux_SEDMODEL.
-      Sinterp = interp_flux_SIMSED(iflagpar,  iparmap,  lumipar,
-				   ifilt_obs, z, Trest);
+      Sinterp = corner_flux_SIMSED(ifilt_obs, z, Trest);
     }
 
     
@@ -1692,6 +1710,29 @@ double interp_flux_SIMSED(
 			  double z,          // (I) redshift
 			  double Trest       // (I) Trest (days)
 )
+{
+
+  // Interpolate in multi-dimensional space of SIMSED parameters
+  // to get flux-integral.
+  //
+  // Oct 2026: split into set_interp_SIMSED (SED corners & weights,
+  //           cached per lumipar) and corner_flux_SIMSED.
+
+  set_interp_SIMSED(iflag, iparmap, lumipar, ifilt_obs, z, Trest);
+  return corner_flux_SIMSED(ifilt_obs, z, Trest);
+
+} // end of interp_flux_SIMSED
+
+
+// ****************************************************
+void set_interp_SIMSED(
+			  int *iflag,        // (I) flag params
+			  int *iparmap,      // (I) ipar index map
+			  double *lumipar,   // (I/O) SIMSED lumipars
+			  int ifilt_obs,     // (I) obs filter (for abort msg)
+			  double z,          // (I) redshift   (for abort msg)
+			  double Trest       // (I) Trest      (for abort msg)
+)
 {
 
   /* ------------------------------------------------
@@ -1713,6 +1754,14 @@ double interp_flux_SIMSED(
     + check option to use WGT column to select ISED. 
       Beware for WGT option because input *lumipar is the ISED index,
       not the WGT value, so don't update *lumipar = WGT.  
+
+   Oct 2026:
+    + refactored from interp_flux_SIMSED: find SED corners and weights,
+      but do not evaluate flux. Results are stored in INTERP_SIMSED,
+      and re-used if called again with the same lumipar; i.e., the
+      search over all SEDs is done once per event instead of once 
+      per epoch and filter.
+    + for NSURFACE=1, fix index bug loading *lumipar.
    
   -------------------------------------------------- */
 
@@ -1727,14 +1776,32 @@ double interp_flux_SIMSED(
   int found_corner, index, ipar_model, NPAR, ipar, ipar_user ;
   int flag, NGRIDONLY, NMATCH=0;
   int ISED_MIN=1, ISED_MAX = SEDMODEL.NSURFACE ;
+  bool SAME ;
 
-  double Sinterp, left_min_diff, right_min_diff;
-  double diff, diff0, diff1, parval, range, term;
+  double left_min_diff, right_min_diff, WGT1 = 1.0 ;
+  double diff, diff0, diff1, parval, range, wgt;
 
-  char fnam[] = "interp_flux_SIMSED";
+  char fnam[] = "set_interp_SIMSED";
 
   // --------------- BEGIN --------------
 
+  // check if corners are already known for these lumipar
+  if ( INTERP_SIMSED.VALID && INTERP_SIMSED.NPAR == SEDMODEL.NPAR ) {
+    SAME = true ;
+    for (i = 0; i < SEDMODEL.NPAR && SAME ; i++) {
+      if ( iflag[i]   != INTERP_SIMSED.IFLAG[i]   ) { SAME = false; }
+      if ( iparmap[i] != INTERP_SIMSED.IPARMAP[i] ) { SAME = false; }
+      if ( iflag[i] & OPTMASK_GEN_SIMSED_param    ) { continue; } // output
+      if ( lumipar[i] != INTERP_SIMSED.LUMIPAR[i] ) { SAME = false; }
+    }
+    if ( SAME ) {
+      for (i = 0; i < SEDMODEL.NPAR; i++) 
+	{ lumipar[i] = INTERP_SIMSED.LUMIPAR[i]; }
+      ISED_SEDMODEL = INTERP_SIMSED.ISED_SEDMODEL ;
+      return ;
+    }
+  }
+
   //  if ( fabsf(Trest) < 1.0  ) { verbose = 1; } // xxxxxxxxxxxxxx
 
   num_dims = 0;
@@ -1751,15 +1818,15 @@ double interp_flux_SIMSED(
   if ( SEDMODEL.NSURFACE == 1 ) {
     ISED = 1;
     ISED_SEDMODEL = ISED; 
-    Sinterp = get_flux_SEDMODEL( ISED, 0, ifilt_obs, z, Trest);
 
     // load *lumipar array
     for ( ipar=0; ipar < SEDMODEL.NPAR ; ipar++ ) {
-      ipar_model    = iparmap[i];
+      ipar_model    = iparmap[ipar];
       lumipar[ipar] = SEDMODEL.PARVAL[ISED][ipar_model];  
     }
 
-    return(Sinterp) ;
+    store_interp_SIMSED(iflag, iparmap, lumipar, 1, &ISED, &WGT1);
+    return ;
   }
 
 
@@ -1820,7 +1887,6 @@ double interp_flux_SIMSED(
       }
 
       if ( NMATCH == NGRIDONLY ) { 
-	Sinterp = get_flux_SEDMODEL(ISED, 0, ifilt_obs, z, Trest);	
 	ISED_SEDMODEL = ISED; // set globa, Mar 6 2017
 
 	// load *lumipar array
@@ -1829,7 +1895,8 @@ double interp_flux_SIMSED(
 	  lumipar[ipar] = SEDMODEL.PARVAL[ISED][ipar_model];	
 	}
 
-	return(Sinterp) ;
+	store_interp_SIMSED(iflag, iparmap, lumipar, 1, &ISED, &WGT1);
+	return ;
       }
     } // end ISED loop
 
@@ -2051,10 +2118,12 @@ double interp_flux_SIMSED(
     }
 
   /*
-   * Interpolation; each corner represents a distance-weighted term.
+   * Interpolation weights; each corner represents a distance-weighted 
+   * term, divided by the volume of the hypercube in coordinate space.
    */
-  Sinterp = 0;
-  
+  int    ISED_LIST[num_corners];
+  double WGT_LIST[num_corners];
+
   for(k = 0; k < num_pars_baggage; k++)
     {
       pars_baggage_interp[k] = 0;
@@ -2071,52 +2140,26 @@ double interp_flux_SIMSED(
 	  bits[j] = ((i & dual_bits_SIMSED[j]) != 0);
 	}
       
-      /*
-       * Set term to data point in question; 
-       * multiply term by distance weightings for each
-       * dimension.
-       */
-      term = get_flux_SEDMODEL(corners[i] + 1, 0, ifilt_obs, z, Trest);
-      ISED_SEDMODEL = corners[0]+1;
-      
-      for(k = 0; k < num_pars_baggage; k++)
-	{
-	  ipar_model = iparmap[num_dims+k]; // RK
-	  pars_baggage_term[k] = 
-	    SEDMODEL.PARVAL[corners[i] + 1][ipar_model]; // RK
-	}
-      
+      wgt = 1.0 ;
       for (j = 0; j < num_dims; j++)
 	{
-	  term = term * fabs(lumipar[pars[j]] - hypercube[j][1 - bits[j]]);
-	  
-	  for(k = 0; k < num_pars_baggage; k++)
-	    {
-	      pars_baggage_term[k] = pars_baggage_term[k] * fabs(lumipar[pars[j]] - hypercube[j][1 - bits[j]]);
-	    }
+	  wgt = wgt * fabs(lumipar[pars[j]] - hypercube[j][1 - bits[j]]) 
+	    / (hypercube[j][1] - hypercube[j][0]);
 	}
-      
-      Sinterp = Sinterp + term;
 
-      for(k = 0; k < num_pars_baggage; k++)
-	{
-	  pars_baggage_interp[k] = pars_baggage_interp[k] + pars_baggage_term[k];
-	}
-    }
-  
-  /*
-   * Divide by the volume of the hypercube in coordinate space.
-   */
-  for (i = 0; i < num_dims; i++)
-    {
-      Sinterp = Sinterp / (hypercube[i][1] - hypercube[i][0]);
+      ISED_LIST[i] = corners[i] + 1 ;
+      WGT_LIST[i]  = wgt ;
 
       for(k = 0; k < num_pars_baggage; k++)
 	{
-	  pars_baggage_interp[k] = pars_baggage_interp[k] / (hypercube[i][1] - hypercube[i][0]);
+	  ipar_model = iparmap[num_dims+k]; // RK
+	  pars_baggage_term[k] = 
+	    SEDMODEL.PARVAL[corners[i] + 1][ipar_model]; // RK
+	  pars_baggage_interp[k] += wgt * pars_baggage_term[k] ;
 	}
     }
-
+  
+  ISED_SEDMODEL = corners[0]+1;
 
   // fill baggage parameters in lumipar array
 
@@ -2125,10 +2168,129 @@ double interp_flux_SIMSED(
     lumipar[ipar_user] = pars_baggage_interp[k]; // RK
   }
 
+  store_interp_SIMSED(iflag, iparmap, lumipar, 
+		      num_corners, ISED_LIST, WGT_LIST);
 
-  return(Sinterp) ;
+  return ;
   
-} // end of interp_flux_SIMSED
+} // end of set_interp_SIMSED
+
+
+// ****************************************************
+void store_interp_SIMSED(int *iflag, int *iparmap, double *lumipar,
+			 int NCORNER, int *ISED_LIST, double *WGT_LIST) {
+
+  // Created Oct 2026
+  // Store SED corners and weights found by set_interp_SIMSED,
+  // along with lumipar (on output) used as key to re-use corners.
+  // Also check if all corners have the same DAY grid so that
+  // corner_flux_SIMSED can sum corners before interpolating in
+  // Trest and redshift.
+
+  int  USE_DAYSTEP = ( (SEDMODEL.OPTMASK & OPTMASK_DAYLIST_SEDMODEL)==0 );
+  int  ipar, icorner, ISED, ISED0 = ISED_LIST[0], iday ;
+  bool SAME ;
+  double DAYMIN, DAYMAX ;
+
+  // ----------- BEGIN -----------
+
+  INTERP_SIMSED.NPAR = SEDMODEL.NPAR ;
+  for ( ipar=0; ipar < SEDMODEL.NPAR ; ipar++ ) {
+    INTERP_SIMSED.IFLAG[ipar]   = iflag[ipar];
+    INTERP_SIMSED.IPARMAP[ipar] = iparmap[ipar];
+    INTERP_SIMSED.LUMIPAR[ipar] = lumipar[ipar];
+  }
+  INTERP_SIMSED.ISED_SEDMODEL = ISED_SEDMODEL ;
+
+  INTERP_SIMSED.NCORNER     = NCORNER ;
+  INTERP_SIMSED.DAYRANGE[0] = -1.0E9 ;
+  INTERP_SIMSED.DAYRANGE[1] = +1.0E9 ;
+  SAME = true ;
+
+  for ( icorner=0; icorner < NCORNER; icorner++ ) {
+    ISED   = ISED_LIST[icorner];
+    DAYMIN = SEDMODEL.DAYMIN[ISED];
+    DAYMAX = SEDMODEL.DAYMAX[ISED];
+    INTERP_SIMSED.ISED[icorner] = ISED ;
+    INTERP_SIMSED.WGT[icorner]  = WGT_LIST[icorner] ;
+    if ( DAYMIN > INTERP_SIMSED.DAYRANGE[0] ) 
+      { INTERP_SIMSED.DAYRANGE[0] = DAYMIN; }
+    if ( DAYMAX < INTERP_SIMSED.DAYRANGE[1] ) 
+      { INTERP_SIMSED.DAYRANGE[1] = DAYMAX; }
+
+    if ( SEDMODEL.NDAY[ISED]   != SEDMODEL.NDAY[ISED0]   ) { SAME = false; }
+    if ( SEDMODEL.DAYMIN[ISED] != SEDMODEL.DAYMIN[ISED0] ) { SAME = false; }
+    if ( !SAME ) { continue; }
+
+    if ( USE_DAYSTEP ) {
+      if ( SEDMODEL.DAYSTEP[ISED] != SEDMODEL.DAYSTEP[ISED0] ) 
+	{ SAME = false; }
+    }
+    else {
+      for(iday=0; iday < SEDMODEL.NDAY[ISED]; iday++ ) {
+	if ( SEDMODEL.DAY[ISED][iday] != SEDMODEL.DAY[ISED0][iday] )
+	  { SAME = false; break; }
+      }
+    }
+  }
+
+  INTERP_SIMSED.SAME_DAYGRID = SAME ;
+  INTERP_SIMSED.VALID        = true ;
+
+  return ;
+
+} // end store_interp_SIMSED
+
+
+// ****************************************************
+double corner_flux_SIMSED(int ifilt_obs, double z, double Trest) {
+
+  // Created Oct 2026
+  // Return SUM_corner WGT * flux for corners & weights from
+  // set_interp_SIMSED.
+  // If all corners have the same DAY grid and cover the filter, and 
+  // Trest is within the DAY range of all corners (i.e., no early/late
+  // extrapolation), the weighted sum is done on the table slice and
+  // interpolated once (interpBlend_flux_SEDMODEL); interpolation is
+  // linear in the table, so this is the same as summing the flux of
+  // each corner. Otherwise, sum get_flux_SEDMODEL over corners.
+
+  int    NCORNER = INTERP_SIMSED.NCORNER ;
+  int    ifilt   = IFILTMAP_SEDMODEL[ifilt_obs] ;
+  double z1      = 1.0 + z ;
+  double LAMMIN  = FILTER_SEDMODEL[ifilt].lammin / z1 ;
+  double LAMMAX  = FILTER_SEDMODEL[ifilt].lammax / z1 ;
+  bool   BLEND   = INTERP_SIMSED.SAME_DAYGRID ;
+  int    icorner, ISED ;
+  double Sinterp = 0.0 ;
+
+  // ------------ BEGIN -----------
+
+  if ( Trest < INTERP_SIMSED.DAYRANGE[0]     ) { BLEND = false; }
+  if ( Trest > INTERP_SIMSED.DAYRANGE[1]-1.0 ) { BLEND = false; }
+
+  for ( icorner=0; icorner < NCORNER && BLEND ; icorner++ ) {
+    ISED = INTERP_SIMSED.ISED[icorner];
+    if ( LAMMIN < SEDMODEL.LAMMIN[ISED] ) { BLEND = false; }
+    if ( LAMMAX > SEDMODEL.LAMMAX[ISED] ) { BLEND = false; }
+  }
+
+  if ( BLEND ) {
+    Sinterp = interpBlend_flux_SEDMODEL(NCORNER, INTERP_SIMSED.ISED, 
+					INTERP_SIMSED.WGT,
+					0, ifilt_obs, z, Trest);
+  }
+  else {
+    for ( icorner=0; icorner < NCORNER; icorner++ ) {
+      ISED     = INTERP_SIMSED.ISED[icorner];
+      Sinterp += INTERP_SIMSED.WGT[icorner] * 
+	get_flux_SEDMODEL(ISED, 0, ifilt_obs, z, Trest);
+    }
+  }
+
+  return(Sinterp) ;
+
+} // end corner_flux_SIMSED
 
 
 // ****************************************************
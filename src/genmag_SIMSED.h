@@ -71,6 +71,25 @@ struct {
  
 } SIMSED_BINARY_INFO ;
 
+
+// Oct 2026: SED corners and weights for interpolation in the space of
+// SIMSED parameters depend only on lumipar, so they are resolved once
+// per event and re-used for every epoch and filter.
+#define MXCORNER_INTERP_SIMSED 256  // 2^INTERP_SIMSED_MAX_DIM
+struct {
+  bool   VALID ;
+  int    NPAR ;
+  int    IFLAG[MXPAR_SEDMODEL], IPARMAP[MXPAR_SEDMODEL] ;
+  double LUMIPAR[MXPAR_SEDMODEL] ;      // lumipar on output (also cache key)
+  int    ISED_SEDMODEL ;                // value for global ISED_SEDMODEL
+
+  int    NCORNER ;
+  int    ISED[MXCORNER_INTERP_SIMSED] ; // SED index (1-NSURFACE) per corner
+  double WGT[MXCORNER_INTERP_SIMSED] ;  // interp weight per corner
+  bool   SAME_DAYGRID ;                 // all corners have same DAY grid
+  double DAYRANGE[2] ;                  // max DAYMIN, min DAYMAX of corners
+} INTERP_SIMSED ;
+
 /**********************************************
    Function Declarations
 **********************************************/
@@ -107,6 +126,12 @@ void genmag_SIMSED(int OPTMASK, int ifilt, double x0,
 double interp_flux_SIMSED(int *iflagpar, int *iparmap, double *lumipar, 
 			  int ifilt_obs, double z, double Trest );
 
+void set_interp_SIMSED(int *iflagpar, int *iparmap, double *lumipar, 
+		       int ifilt_obs, double z, double Trest );
+void store_interp_SIMSED(int *iflagpar, int *iparmap, double *lumipar,
+			 int NCORNER, int *ISED_LIST, double *WGT_LIST);
+double corner_flux_SIMSED(int ifilt_obs, double z, double Trest);
+
 double nextgrid_flux_SIMSED(int *iflagpar, int *iparmap, double *lumipar, 
 			    int ifilt_obs, double z, double Trest );
 
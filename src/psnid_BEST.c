@@ -296,6 +296,17 @@
   Jan 10 2024:
     + add vpec=0 as dLmag argument
 
+  Oct 2026:
+    + flat, 64-byte aligned copy of model grid (PSNID_MODEL_FLAT) with
+      [filter][epoch] layout within each (shape,z) cell.
+    + psnid_best_grid_compare evaluates chi2 for all color cells of a 
+      (z,dmu,shape,Tmax) cell with one pass over the data 
+      (psnid_best_chisq_flatgrid); results are identical to the
+      per-cell psnid_best_calc_chisq.
+    + for each redshift, chi2 of all (dmu,shape,Tmax) cells are filled
+      with &PSNIDINP NTHREAD pthreads (psnid_best_fill_flatgrid);
+      color loop uses masks instead of range branches.
+
  ================================================================ */
 
 #include <stdio.h>
@@ -304,6 +315,7 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <pthread.h>
 
 
 #include <sys/types.h>
@@ -477,6 +489,55 @@ double PSNID_FIRST_MJD;
 double ***PSNID_MODEL_EPOCH, ****PSNID_MODEL_MAG, ****PSNID_MODEL_MAGERR,
   ****PSNID_MODEL_EXTINCT, ****PSNID_MODEL_MWEXTINCT;
 
+// Oct 2026: contiguous copy of grid models for the chi2 scan.
+// Each (shape,z) cell holds [filter][epoch] blocks; epoch dimension is
+// padded to ND_PAD so that each filter block is 64-byte aligned.
+#define PSNID_FLAT_ALIGN  64
+typedef struct {
+  int    NL, NZ, NF, ND, ND_PAD ;
+  long   NCELL ;     // doubles per (shape,z) cell (NF*ND_PAD)
+  double *EPOCH ;    // [shape][z][ND_PAD]
+  double *MAG, *MAGERR, *EXTINCT ;  // [shape][z][filter][ND_PAD]
+} PSNID_MODEL_FLAT_DEF ;
+PSNID_MODEL_FLAT_DEF PSNID_MODEL_FLAT ;
+
+// work space for psnid_best_chisq_flatgrid (one per thread)
+#define MXTHREAD_PSNID  64
+
+// With the Makefile default -O2, GCC vectorizes only loops with a
+// known trip count; allow the color passes in the chi2 kernel to be 
+// vectorized with the regular cost model.
+#if defined(__GNUC__) && !defined(__clang__)
+#define VECTORIZE_PSNID __attribute__((optimize("vect-cost-model=dynamic")))
+#else
+#define VECTORIZE_PSNID
+#endif
+typedef struct {
+  double *FIT_EPOCH ;   // shifted model epochs, 1..MAXND
+  double *MAG ;         // interpolated model mag per color
+  double *FLUX ;        // model flux per color (0 if model undefined)
+  double *MASK ;        // 1.0 -> model mag is defined for color
+} PSNID_CHISQ_WORK_DEF ;
+
+typedef struct {
+  int    ID_THREAD ;
+  int    JMIN, JMAX ;   // range of (dmu,shape,Tmax) cells for thread
+  PSNID_CHISQ_WORK_DEF WORK ;
+} PSNID_THREAD_DEF ;
+
+// (dmu,shape,Tmax) cells for one redshift; read-only for threads
+// except for each thread's own range of NGOOD and CHISQ.
+struct {
+  int    nobs, *useobs, *data_filt ;
+  double *data_mjd, *data_fluxcal, *data_fluxcalerr ;
+  int    z, minu, ustep, mind, dstep, mini ;
+  int    NU, ND, NTMAX, NCOLOR ;
+  double istep, *u_grid, *cfac_list ;
+  int    *SKIP_SHAPE ;   // [id] 1 -> skip shape (AVOID_SIMCHEAT)
+  int    *NGOOD ;        // [j], j = (iu*ND + id)*NTMAX + it
+  double *CHISQ ;        // [j*NCOLOR + ic]
+} PSNID_FLATJOB ;
+
 
 double PSNID_BIGN=1.e30, PSNID_SMALLN=1.e-30, PSNID_SPECZSIG=20.0;
 double PSNID_BASE_COLOR[PSNID_NTYPES];
@@ -576,6 +637,8 @@ void psnid_best_setup_searchgrid();
 
 void psnid_best_model_alloc();
 void psnid_best_model_free();
+void psnid_best_model_flatten();
+double *psnid_best_malloc_aligned(long NDOUBLE);
 
 void psnid_best_split_nonia_types(int *types, int optdebug);
 void psnid_best_set_grid_limits(int typeindex);
@@ -638,6 +701,15 @@ void psnid_best_calc_chisq(int nobs, int *useobs,
 			   double **model_mag, double **model_magerr,
 			   int *ngood, double *chisq, int optDebug,
 			   int doReject);
+void psnid_best_chisq_flatgrid(int nobs, int *useobs,
+			       int *data_filt, double *data_mjd,
+			       double *data_fluxcal, double *data_fluxcalerr,
+			       PSNID_CHISQ_WORK_DEF *WORK,
+			       int d, int z, double peak_guess, double ushift,
+			       int NCOLOR, double *cfac_list,
+			       int *ngood, double *chisq_list);
+void  psnid_best_fill_flatgrid(int NTHREAD, PSNID_THREAD_DEF *THREAD);
+void *psnid_best_thread_flatgrid(void *thread);
 
 int psnid_best_flag_outlier(int itype, int zpind, int nobs,
 			    int *data_filt, double *data_mjd,
@@ -931,6 +1003,7 @@ int PSNID_BEST_DOFIT(char *CCID, int NOBS, int *IFILT,
     psnid_best_set_grid_limits(i);
     psnid_best_model_alloc();
     psnid_best_set_grid_values(i, nonia_types);
+    psnid_best_model_flatten();
 
     // flag early and late epochs
     for (j=0; j<=NOBS; j++) { useobs[j] = 1 ; }  // use all points by default
@@ -1828,12 +1901,95 @@ void psnid_best_model_free()
   free_d4tensor(PSNID_MODEL_MWEXTINCT, ONE8,PSNID_NFILTER, ONE8,
 		PSNID_MAXNL, ONE8, PSNID_MAXNZ, ONE8,PSNID_MAXND);
 
+  // Oct 2026: free flat copy
+  if ( PSNID_MODEL_FLAT.MAG != NULL ) {
+    free(PSNID_MODEL_FLAT.EPOCH);   free(PSNID_MODEL_FLAT.MAG);
+    free(PSNID_MODEL_FLAT.MAGERR);  free(PSNID_MODEL_FLAT.EXTINCT);
+    PSNID_MODEL_FLAT.EPOCH  = PSNID_MODEL_FLAT.MAG     = NULL ;
+    PSNID_MODEL_FLAT.MAGERR = PSNID_MODEL_FLAT.EXTINCT = NULL ;
+  }
 
   return;
 }
 // end of psnid_best_model_free
 
 
+/**********************************************************************/
+double *psnid_best_malloc_aligned(long NDOUBLE)
+/**********************************************************************/
+{
+  // Created Oct 2026
+  // return pointer to NDOUBLE doubles aligned on PSNID_FLAT_ALIGN bytes.
+
+  void *ptr = NULL ;
+  size_t MEM = (size_t)NDOUBLE * sizeof(double) ;
+  char fnam[] = "psnid_best_malloc_aligned" ;
+
+  if ( posix_memalign(&ptr, PSNID_FLAT_ALIGN, MEM) != 0 ) {
+    sprintf(c1err,"Could not allocate %ld doubles", NDOUBLE);
+    sprintf(c2err,"for flat PSNID model grid.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+  return (double*)ptr ;
+}
+// end of psnid_best_malloc_aligned
+
+
+/**********************************************************************/
+void psnid_best_model_flatten()
+/**********************************************************************/
+{
+  // Created Oct 2026
+  // Copy PSNID_MODEL_[EPOCH,MAG,MAGERR,EXTINCT] tensors (filled by 
+  // psnid_best_set_grid_values) into contiguous, aligned arrays in
+  // PSNID_MODEL_FLAT. Within each (shape,z) cell, the layout is
+  // [filter][epoch] so that all model epochs needed for one
+  // observation are adjacent. Epoch index t=1..ND is stored at t-1.
+
+  int  NL = PSNID_MAXNL, NZ = PSNID_MAXNZ ;
+  int  NF = PSNID_NFILTER, ND = PSNID_MAXND ;
+  int  NPAD = PSNID_FLAT_ALIGN/sizeof(double);
+  int  ND_PAD = ((ND + NPAD - 1)/NPAD) * NPAD ;
+  int  d, z, f, t ;
+  long NCELL = (long)NF * (long)ND_PAD ;
+  long icell, off ;
+
+  // ------------ BEGIN -------------
+
+  PSNID_MODEL_FLAT.NL = NL;  PSNID_MODEL_FLAT.NZ = NZ;
+  PSNID_MODEL_FLAT.NF = NF;  PSNID_MODEL_FLAT.ND = ND;
+  PSNID_MODEL_FLAT.ND_PAD = ND_PAD ;
+  PSNID_MODEL_FLAT.NCELL  = NCELL ;
+
+  PSNID_MODEL_FLAT.EPOCH   = psnid_best_malloc_aligned((long)NL*NZ*ND_PAD);
+  PSNID_MODEL_FLAT.MAG     = psnid_best_malloc_aligned((long)NL*NZ*NCELL);
+  PSNID_MODEL_FLAT.MAGERR  = psnid_best_malloc_aligned((long)NL*NZ*NCELL);
+  PSNID_MODEL_FLAT.EXTINCT = psnid_best_malloc_aligned((long)NL*NZ*NCELL);
+
+  for(d=1; d <= NL; d++ ) {
+    for(z=1; z <= NZ; z++ ) {
+      icell = (long)(d-1)*NZ + (long)(z-1) ;
+
+      off = icell * ND_PAD ;
+      for(t=1; t <= ND; t++ ) 
+	{ PSNID_MODEL_FLAT.EPOCH[off+t-1] = PSNID_MODEL_EPOCH[d][z][t]; }
+
+      for(f=1; f <= NF; f++ ) {
+	off = icell*NCELL + (long)(f-1)*ND_PAD ;
+	for(t=1; t <= ND; t++ ) {
+	  PSNID_MODEL_FLAT.MAG[off+t-1]     = PSNID_MODEL_MAG[f][d][z][t] ;
+	  PSNID_MODEL_FLAT.MAGERR[off+t-1]  = PSNID_MODEL_MAGERR[f][d][z][t];
+	  PSNID_MODEL_FLAT.EXTINCT[off+t-1] = PSNID_MODEL_EXTINCT[f][d][z][t];
+	}
+      }
+    } // end z
+  } // end d
+
+  return;
+}
+// end of psnid_best_model_flatten
+
+
 /**********************************************************************/
 void psnid_best_setup_searchgrid()
 /**********************************************************************/
@@ -1951,6 +2107,17 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
     double **evidence  = dmatrix(0,PSNID_NZPRIOR, 0,PSNID_NTYPES);
                        = Bayesian evidence for each z prior and type
 
+  Oct 2026: for ipass <= NITER, chi2 for all (color,Tmax) cells of each
+            (z,dmu,shape) are computed first with psnid_best_chisq_flatgrid
+            (one data pass per Tmax for all colors), then the priors,
+            evidence and min-chi2 logic loop over (color,Tmax) in the
+            original order. The debug pass (ipass > NITER) still uses
+            psnid_best_calc_chisq.
+            For each z, the (dmu,shape,Tmax) cells are filled first
+            with NTHREAD threads (psnid_best_fill_flatgrid). AV prior
+            (depends only on color) and rate prior (only on shape,z)
+            are evaluated once instead of per cell.
+
 ***/
 /**********************************************************************/
 {
@@ -1966,6 +2133,10 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
   double ZPRIOR, ZPRIOR_ERR, DZ, ZSIG ;
   int    DOPRIOR_ZSPEC, DOPRIOR_ZPHOT, optDebug, NON1A_INDEX, isp;
   int    AWID, ZWID, ZRBN, ARBN, UWID, URBN, indTmp ;
+  int    USE_FLAT, NCOLOR, NTMAX, ic, iu, id, j0 ;
+  int    NU_LOOP, ND_LOOP, NCELL, NTHREAD, ithread ;
+  double *cfac_list, *chisq_av_list, wgt_rate = 1.0 ;
+  PSNID_THREAD_DEF THREAD[MXTHREAD_PSNID];
 
   //  char fnam[] = "psnid_best_grid_compare" ;
 
@@ -1977,6 +2148,33 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
   fit_mag    = dmatrix(1,PSNID_NFILTER, 1,PSNID_MAXND);
   fit_magerr = dmatrix(1,PSNID_NFILTER, 1,PSNID_MAXND);
 
+  // Oct 2026: work space for flat-grid chi2; one per thread
+  cfac_list     = (double*) malloc( (PSNID_MAXNA+1) * sizeof(double) );
+  chisq_av_list = (double*) malloc( (PSNID_MAXNA+1) * sizeof(double) );
+
+  NTHREAD = PSNID_INPUTS.NTHREAD ;
+  if ( NTHREAD < 1              ) { NTHREAD = 1 ; }
+  if ( NTHREAD > MXTHREAD_PSNID ) { NTHREAD = MXTHREAD_PSNID ; }
+  for(ithread=0; ithread < NTHREAD; ithread++ ) {
+    THREAD[ithread].ID_THREAD = ithread ;
+    THREAD[ithread].WORK.FIT_EPOCH = 
+      (double*) malloc( (PSNID_MAXND+1) * sizeof(double) );
+    THREAD[ithread].WORK.MAG  = 
+      (double*) malloc( (PSNID_MAXNA+1) * sizeof(double) );
+    THREAD[ithread].WORK.FLUX = 
+      (double*) malloc( (PSNID_MAXNA+1) * sizeof(double) );
+    THREAD[ithread].WORK.MASK = 
+      (double*) malloc( (PSNID_MAXNA+1) * sizeof(double) );
+  }
+
+  PSNID_FLATJOB.nobs            = nobs ;
+  PSNID_FLATJOB.useobs          = useobs ;
+  PSNID_FLATJOB.data_filt       = data_filt ;
+  PSNID_FLATJOB.data_mjd        = data_mjd ;
+  PSNID_FLATJOB.data_fluxcal    = data_fluxcal ;
+  PSNID_FLATJOB.data_fluxcalerr = data_fluxcalerr ;
+  PSNID_FLATJOB.cfac_list       = cfac_list ;
+
 
   c_grid   = dvector(1,PSNID_MAXNA);
   z_grid   = dvector(1,PSNID_MAXNZ);
@@ -2204,6 +2402,20 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
 
     evidence[zpind][itype] = 0.0;
 
+    // Oct 2026: color list, and AV prior that depends only on color
+    USE_FLAT   = ( ipass <= PSNID_NITER ) ;
+    NTMAX      = maxi - mini + 1 ;
+    NCOLOR     = 0 ;
+    for (a = mina; a <= maxa; a = a + astep) { 
+      cfac_list[NCOLOR]     = c_grid[a] - PSNID_BASE_COLOR[itype]; 
+      chisq_av_list[NCOLOR] = 0.0 ;
+      if (PSNID_USE_AV_PRIOR == 1) {
+	pav = psnid_best_avprior1(itype, c_grid[a]);
+	chisq_av_list[NCOLOR] = -2.0*PSNID_INPUTS.AV_PRIOR_STR*log(pav);
+      }
+      NCOLOR++; 
+    }
+
     // dmu grid
     if (itype != PSNID_ITYPE_SNIA && PSNID_FITDMU_CC == 0) {
       minu  = 1 ;
@@ -2222,6 +2434,34 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
     ustep = 1;
     */
 
+    // Oct 2026: chi2 buffers for all (dmu,shape,Tmax,color) cells of a z
+    NU_LOOP = (maxu - minu)/ustep + 1 ;
+    ND_LOOP = (maxd - mind)/dstep + 1 ;
+    NCELL   = NU_LOOP * ND_LOOP * NTMAX ;
+    PSNID_FLATJOB.minu   = minu ;   PSNID_FLATJOB.ustep = ustep ;
+    PSNID_FLATJOB.mind   = mind ;   PSNID_FLATJOB.dstep = dstep ;
+    PSNID_FLATJOB.mini   = mini ;   PSNID_FLATJOB.istep = istep ;
+    PSNID_FLATJOB.NU     = NU_LOOP ;
+    PSNID_FLATJOB.ND     = ND_LOOP ;
+    PSNID_FLATJOB.NTMAX  = NTMAX ;
+    PSNID_FLATJOB.NCOLOR = NCOLOR ;
+    PSNID_FLATJOB.u_grid = u_grid ;
+    PSNID_FLATJOB.SKIP_SHAPE = (int   *) malloc( ND_LOOP * sizeof(int) );
+    PSNID_FLATJOB.NGOOD      = (int   *) malloc( NCELL   * sizeof(int) );
+    PSNID_FLATJOB.CHISQ      = 
+      (double*) malloc( ((long)NCELL*NCOLOR+1) * sizeof(double) );
+
+    for (d = mind; d <= maxd; d = d + dstep) {
+      id = (d - mind)/dstep ;
+      PSNID_FLATJOB.SKIP_SHAPE[id] = 0 ;
+      if ( AVOID_SIMCHEAT ) {
+	isp         = PSNID_NONIA_ABSINDEX[itype][d]; 
+	NON1A_INDEX = SNGRID_PSNID[TYPEINDX_NONIA_PSNID].NON1A_INDEX[isp];
+	if ( NON1A_INDEX == DATA_PSNID_DOFIT.SIM_NON1A_INDEX ) 
+	  { PSNID_FLATJOB.SKIP_SHAPE[id] = 1 ; }
+      }
+    }
+
     /*
     printf("\t itype = %d, ipass = %d"
 	   "   minz,maxz,zstep = %d %d %d"
@@ -2255,6 +2495,11 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
 	chisq_z = 0.0 ; 
       }
 
+      // Oct 2026: chi2 for all (dmu,shape,Tmax,color) cells at this z
+      if ( USE_FLAT ) {
+	PSNID_FLATJOB.z = z ;
+	psnid_best_fill_flatgrid(NTHREAD, THREAD);
+      }
 
       for (u = minu; u <= maxu; u = u + ustep) {      // dmu
 	chisqlozu = PSNID_BIGN;
@@ -2272,14 +2517,30 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
 	      { continue ; }
 	  } // end AVOID_SIMCHEAT
 
+	  // Oct 2026: offset of this (dmu,shape) in flat chi2 buffers,
+	  //   and rate prior that does not depend on color or Tmax
+	  iu = (u - minu)/ustep ;
+	  id = (d - mind)/dstep ;
+	  j0 = (iu*ND_LOOP + id) * NTMAX ;
+	  if ( USE_FLAT && ipass == PSNID_NITER ) 
+	    { wgt_rate = psnid_best_ratePrior(itype,d,z_grid[z]); }
 
+	  ic = -1 ;
 	  for (a = mina; a <= maxa; a = a + astep) {  // colorpar
+	    ic++ ;
 
 	    for (i = mini; i <= maxi; i++) {           // peak MJD (RK fix?)
 	      //   for (i = mini; i < maxi; i++) {  // peak MJD (bug?)
 
 	      // shift model along time axis
 	      peak_guess   = PSNID_PEAK_START + i*istep;
+
+	      if ( USE_FLAT ) {
+		chisq = PSNID_FLATJOB.CHISQ[(long)(j0+i-mini)*NCOLOR + ic] ;
+		ngood = PSNID_FLATJOB.NGOOD[j0+i-mini] ;
+		goto PRIORS ;
+	      }
+
 	      for (t = 1; t <= PSNID_MAXND; t++) {
 		fit_epoch[t] = PSNID_MODEL_EPOCH[d][z][t] + peak_guess;
 		for (f = 1; f <= PSNID_NFILTER; f++) {
@@ -2304,14 +2565,20 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
 
 	      //////////////////////////
 	      //  PRIORS
+	    PRIORS:
 
 	      // photo-z(host)
 	      if ( DOPRIOR_ZPHOT ) { chisq += chisq_z ; } 
 
 	      // AV
 	      if (PSNID_USE_AV_PRIOR == 1) {
-		pav = psnid_best_avprior1(itype, c_grid[a]);
-		chisq += -2.0*PSNID_INPUTS.AV_PRIOR_STR*log(pav);
+		if ( USE_FLAT ) {
+		  chisq += chisq_av_list[ic] ;
+		}
+		else {
+		  pav = psnid_best_avprior1(itype, c_grid[a]);
+		  chisq += -2.0*PSNID_INPUTS.AV_PRIOR_STR*log(pav);
+		}
 	      }
 
 
@@ -2326,7 +2593,10 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
 	      // Bayesian evidence //
 	      if (ipass == PSNID_NITER) {
 		if (chisq < 10000.) {
-		  wgt = psnid_best_ratePrior(itype,d,z_grid[z]); // Sep 6 2013 - RK
+		  if ( USE_FLAT ) 
+		    { wgt = wgt_rate ; }
+		  else
+		    { wgt = psnid_best_ratePrior(itype,d,z_grid[z]); } // Sep 6 2013 - RK
 		  evidence[zpind][itype] += wgt * exp(-(chisq)/2.);
 		}
 	      }
@@ -2362,6 +2632,10 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
     }
     /**********************************************************/
 
+    free(PSNID_FLATJOB.SKIP_SHAPE);  
+    free(PSNID_FLATJOB.NGOOD);  
+    free(PSNID_FLATJOB.CHISQ);
+
     // zero index is not allowed
     psnid_best_check_ind_bounds(ipass, itype, ind);
 
@@ -2492,7 +2766,13 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
   free_dvector(c_grid, 1,PSNID_MAXNA);
   free_dvector(z_grid, 1,PSNID_MAXNZ);
   free_dvector(u_grid, 1,PSNID_MAXNU);
-
+  free(cfac_list);  free(chisq_av_list);
+  for(ithread=0; ithread < NTHREAD; ithread++ ) {
+    free(THREAD[ithread].WORK.FIT_EPOCH);
+    free(THREAD[ithread].WORK.MAG);
+    free(THREAD[ithread].WORK.FLUX);
+    free(THREAD[ithread].WORK.MASK);
+  }
 
   return;
 }
@@ -2500,6 +2780,255 @@ void psnid_best_grid_compare(int itype, int zpind, int nobs,
 
 
 
+/**********************************************************************/
+void psnid_best_fill_flatgrid(int NTHREAD, PSNID_THREAD_DEF *THREAD)
+/*
+  Created Oct 2026
+
+  Fill PSNID_FLATJOB.CHISQ and NGOOD for all (dmu,shape,Tmax) cells 
+  at redshift index PSNID_FLATJOB.z. Cells are independent (each reads
+  the flat model store and writes only its own buffer slot), so they
+  are split into contiguous ranges over NTHREAD threads. Thread 0 runs
+  in the calling process. Results do not depend on NTHREAD.
+
+ */
+/**********************************************************************/
+{
+  int NCELL = PSNID_FLATJOB.NU * PSNID_FLATJOB.ND * PSNID_FLATJOB.NTMAX ;
+  int NCELL_PER_THREAD, ithread ;
+  pthread_t THREAD_ID[MXTHREAD_PSNID];
+
+  // ------------ BEGIN -------------
+
+  if ( NTHREAD > NCELL ) { NTHREAD = NCELL ; }
+  if ( NTHREAD < 1     ) { NTHREAD = 1 ; }
+  NCELL_PER_THREAD = (NCELL + NTHREAD - 1) / NTHREAD ;
+
+  for(ithread=0; ithread < NTHREAD; ithread++ ) {
+    THREAD[ithread].JMIN = ithread * NCELL_PER_THREAD ;
+    THREAD[ithread].JMAX = THREAD[ithread].JMIN + NCELL_PER_THREAD - 1 ;
+    if ( THREAD[ithread].JMAX >= NCELL ) 
+      { THREAD[ithread].JMAX = NCELL - 1 ; }
+  }
+
+  for(ithread=1; ithread < NTHREAD; ithread++ ) {
+    pthread_create(&THREAD_ID[ithread], NULL, psnid_best_thread_flatgrid,
+		   (void*)&THREAD[ithread] );
+  }
+  psnid_best_thread_flatgrid( (void*)&THREAD[0] );
+  for(ithread=1; ithread < NTHREAD; ithread++ ) 
+    { pthread_join(THREAD_ID[ithread], NULL); }
+
+  return ;
+}
+// end of psnid_best_fill_flatgrid
+
+
+/**********************************************************************/
+void *psnid_best_thread_flatgrid(void *thread)
+/*
+  Created Oct 2026
+  Thread function for psnid_best_fill_flatgrid: compute chi2 for 
+  cells JMIN to JMAX, j = (iu*ND + id)*NTMAX + it.
+ */
+/**********************************************************************/
+{
+  PSNID_THREAD_DEF *THREAD = (PSNID_THREAD_DEF*)thread ;
+  int    NTMAX  = PSNID_FLATJOB.NTMAX ;
+  int    ND     = PSNID_FLATJOB.ND ;
+  int    NCOLOR = PSNID_FLATJOB.NCOLOR ;
+  int    z      = PSNID_FLATJOB.z ;
+  int    j, it, id, iu, u, d, i ;
+  double peak_guess ;
+
+  // ------------ BEGIN -------------
+
+  for(j=THREAD->JMIN; j <= THREAD->JMAX; j++ ) {
+    it = j % NTMAX ;
+    id = (j / NTMAX) % ND ;
+    iu = j / (NTMAX*ND) ;
+    if ( PSNID_FLATJOB.SKIP_SHAPE[id] ) { continue ; }
+
+    u  = PSNID_FLATJOB.minu + iu*PSNID_FLATJOB.ustep ;
+    d  = PSNID_FLATJOB.mind + id*PSNID_FLATJOB.dstep ;
+    i  = PSNID_FLATJOB.mini + it ;
+    peak_guess = PSNID_PEAK_START + i*PSNID_FLATJOB.istep;
+
+    psnid_best_chisq_flatgrid(PSNID_FLATJOB.nobs, PSNID_FLATJOB.useobs, 
+			      PSNID_FLATJOB.data_filt, PSNID_FLATJOB.data_mjd,
+			      PSNID_FLATJOB.data_fluxcal, 
+			      PSNID_FLATJOB.data_fluxcalerr,
+			      &THREAD->WORK, d, z, peak_guess, 
+			      PSNID_FLATJOB.u_grid[u],
+			      NCOLOR, PSNID_FLATJOB.cfac_list, 
+			      &PSNID_FLATJOB.NGOOD[j],
+			      &PSNID_FLATJOB.CHISQ[(long)j*NCOLOR] );
+  }
+
+  return NULL ;
+}
+// end of psnid_best_thread_flatgrid
+
+
+/**********************************************************************/
+VECTORIZE_PSNID
+void psnid_best_chisq_flatgrid(int nobs, int *useobs,
+			       int *data_filt, double *data_mjd,
+			       double *data_fluxcal, double *data_fluxcalerr,
+			       PSNID_CHISQ_WORK_DEF *WORK,
+			       int d, int z, double peak_guess, double ushift,
+			       int NCOLOR, double *cfac_list,
+			       int *ngood, double *chisq_list)
+/*
+  Created Oct 2026
+
+  Same chi2 as psnid_best_calc_chisq, but for NCOLOR models that differ
+  only in color: model mag = MAG - cfac_list[ic]*EXTINCT + ushift,
+  using the flat model store PSNID_MODEL_FLAT for shape index d and
+  redshift index z, shifted by peak_guess. 
+  *WORK is the work space of the calling thread.
+
+  The model-epoch bin, interpolation fraction and model mag-error 
+  depend only on (d,z,peak_guess), so they are computed once per 
+  observation. The color loop is split into three stride-1 passes:
+  mag & validity mask (range checks as masks, no branches), 
+  mag->flux, and chi2 sum. Arithmetic and summation order per color
+  are the same as in psnid_best_calc_chisq, so chi2 values are 
+  identical.
+
+  Output:
+    int *ngood          = number of good filter-epochs (same for all colors)
+    double *chisq_list  = chi2 for each color, [0 .. NCOLOR-1]
+
+ */
+/**********************************************************************/
+{
+  int    ND     = PSNID_MODEL_FLAT.ND ;
+  int    ND_PAD = PSNID_MODEL_FLAT.ND_PAD ;
+  long   icell  = (long)(d-1)*PSNID_MODEL_FLAT.NZ + (long)(z-1) ;
+  double *EPOCH = PSNID_MODEL_FLAT.EPOCH   + icell*ND_PAD ;
+  double *MAG   = PSNID_MODEL_FLAT.MAG     + icell*PSNID_MODEL_FLAT.NCELL ;
+  double *ERR   = PSNID_MODEL_FLAT.MAGERR  + icell*PSNID_MODEL_FLAT.NCELL ;
+  double *EXT   = PSNID_MODEL_FLAT.EXTINCT + icell*PSNID_MODEL_FLAT.NCELL ;
+  double *fit_epoch = WORK->FIT_EPOCH ;
+  double *MAG_LIST  = WORK->MAG ;
+  double *FLUX_LIST = WORK->FLUX ;
+  double *MASK_LIST = WORK->MASK ;
+  int    USE_LOOKUP = ( SIZEOF_PSNID_FLUXCAL_LOOKUP > 0 ) ;
+  double ZEROPOINT_FLUXCAL = 27.5 ;
+  double MAG_LO = PSNID_GOODMAG_LO, MAG_HI = PSNID_GOODMAG_HI ;
+
+  int    t, f, ic, jt, this_t=0, this_filt, count=0, USEMJD, OKERR, OK ;
+  long   off ;
+  double mjd, tFrac, data_flux, SQERR_DATA, FDIF, SQFERR, FERRFAC ;
+  double M0, M1, E0, E1, X0, X1, m0, m1, mag, mage, ERRDIF ;
+  double model_flux, model_fluxe, cfac ;
+
+  // ------------ BEGIN -------------
+
+  for(ic=0; ic < NCOLOR; ic++ ) { chisq_list[ic] = 0.0 ; }
+
+  for (t = 1; t <= ND; t++) { fit_epoch[t] = EPOCH[t-1] + peak_guess; }
+
+  for (t = 0; t < nobs; t++) {  // filter-epochs
+
+    f = data_filt[t]+1;   // data_filt = 0 .. NFILTER-1, so add 1
+    this_filt = PSNID_INPUTS.IFILTLIST[f-1];
+    if ( PSNID_INPUTS.USEFILT[this_filt] != 1 || useobs[t] != 1 ) 
+      { continue ; }
+
+    mjd    = data_mjd[t] ;
+    USEMJD = ( mjd >= fit_epoch[1]  &&  mjd < fit_epoch[ND] ) ;
+    tFrac  = 0.0 ;
+    if ( USEMJD ) {
+      hunt(fit_epoch, ND, mjd, &this_t);
+      tFrac = (mjd - fit_epoch[this_t]) / 
+	(fit_epoch[this_t+1] - fit_epoch[this_t]) ;
+    }
+
+    if ( data_fluxcalerr[t] <= 0.0 ) { continue ; }
+    count++ ;
+
+    data_flux  = data_fluxcal[t] ;
+    SQERR_DATA = data_fluxcalerr[t] * data_fluxcalerr[t] ;
+
+    // model values at the two bracketing epochs (0-indexed in flat store)
+    OKERR = 0 ;
+    if ( USEMJD ) {
+      jt  = this_t - 1 ;
+      off = (long)(f-1)*ND_PAD + jt ;
+      M0  = MAG[off];   M1 = MAG[off+1] ;
+      E0  = ERR[off];   E1 = ERR[off+1] ;
+      X0  = EXT[off];   X1 = EXT[off+1] ;
+      ERRDIF = E1 - E0 ;
+      mage   = E0 + ERRDIF * tFrac ;
+
+      // color-independent checks, same as psnid_best_calc_chisq
+      // and psnid_pogson2fluxcal
+      OKERR = ( E0 < PSNID_GOODMAGERR_HI && E0 > PSNID_GOODMAGERR_LO &&
+		E1 < PSNID_GOODMAGERR_HI && E1 > PSNID_GOODMAGERR_LO &&
+		mage <= PSNID_GOODMAGERR_HI && mage >= PSNID_GOODMAGERR_LO );
+    }
+
+    if ( !OKERR ) {
+      // invalid MJD or model error -> model flux = 0 for every color
+      FDIF = -data_flux ;
+      for(ic=0; ic < NCOLOR; ic++ ) 
+	{ chisq_list[ic] += (FDIF*FDIF) / SQERR_DATA ; }
+      continue ;
+    }
+
+    // pass 1: model mag and range mask for each color
+    for(ic=0; ic < NCOLOR; ic++ ) {
+      cfac = cfac_list[ic] ;
+      m0   = M0 - cfac*X0 + ushift ;
+      m1   = M1 - cfac*X1 + ushift ;
+      mag  = m0 + (m1 - m0) * tFrac ;
+      OK   = 
+	(m0  <  MAG_HI) & (m0  >  MAG_LO) & 
+	(m1  <  MAG_HI) & (m1  >  MAG_LO) &
+	(mag <= MAG_HI) & (mag >= MAG_LO) ;
+      MAG_LIST[ic]  = mag ;
+      MASK_LIST[ic] = ( OK ? 1.0 : 0.0 ) ; // double mask vectorizes
+    }
+
+    // pass 2: mag -> flux; flux=0 where model is undefined
+    if ( USE_LOOKUP ) {
+      for(ic=0; ic < NCOLOR; ic++ ) {
+	FLUX_LIST[ic] = 0.0 ;
+	if ( MASK_LIST[ic] > 0.0 ) {
+	  FLUX_LIST[ic] = PSNID_FLUXCAL_LOOKUP
+	    [(int)((MAG_LIST[ic] - MAG_LO) * PSNID_MAGSCALE_for_LOOKUP)] ;
+	}
+      }
+    }
+    else {
+      for(ic=0; ic < NCOLOR; ic++ ) {
+	FLUX_LIST[ic] = 0.0 ;
+	if ( MASK_LIST[ic] > 0.0 ) 
+	  { FLUX_LIST[ic] = pow(10.0,-0.4*(MAG_LIST[ic]-ZEROPOINT_FLUXCAL)); }
+      }
+    }
+
+    // pass 3: chi2
+    FERRFAC = mage * .921 ; // .921 = ln(10)/2.5
+    for(ic=0; ic < NCOLOR; ic++ ) {
+      model_flux  = FLUX_LIST[ic] ;
+      model_fluxe = model_flux * FERRFAC ;
+      FDIF   = model_flux - data_flux ;
+      SQFERR = model_fluxe*model_fluxe + SQERR_DATA ;
+      chisq_list[ic] += (FDIF * FDIF) / SQFERR ;
+    }
+
+  }   // end of nobs loop
+
+  *ngood = count ;
+
+  return ;
+}
+// end of psnid_best_chisq_flatgrid
+
+
 /**********************************************************************/
 void psnid_best_calc_chisq(int nobs, int *useobs,
 			   int *data_filt, double *data_mjd,
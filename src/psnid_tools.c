@@ -232,6 +232,10 @@ void PSNID_USER_INPUT(int NVAR, double *input_array, char *input_string ) {
     PSNID_INPUTS.ZRATEPRIOR_NONIA[i] = dval ; 
   }
 
+  // Oct 2026
+  ivar++ ; dval = input_array[ivar];
+  PSNID_INPUTS.NTHREAD = (int)dval ;
+
   // -----------------------------------------------
   // break the input string into separate words
   //  printf(" xxx input_string = '%s' \n", input_string);
@@ -307,6 +311,8 @@ void PSNID_USER_INPUT(int NVAR, double *input_array, char *input_string ) {
 
     printf("\t Input MCMC_NSTEP = %d \n", PSNID_INPUTS.MCMC_NSTEP);
 
+    printf("\t Input NTHREAD = %d \n", PSNID_INPUTS.NTHREAD);
+
     printf("\t Input COLOR_MIN, COLOR_MAX, NCOLOR = %f %f %d \n"
 	   ,PSNID_INPUTS.COLOR_MIN
 	   ,PSNID_INPUTS.COLOR_MAX
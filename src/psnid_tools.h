@@ -135,6 +135,7 @@ struct  PSNID_INPUTS  {
   int OPT_SIMCHEAT;        // 3/10/2017: 
 
   int NREJECT_OUTLIER;       // max number of outlier points to reject
+  int NTHREAD;               // Oct 2026: threads for grid search per SN
   double CHISQMIN_OUTLIER;   // min chi2 for outlier rejection
 
   double TMAX_START[MXITER_PSNID];
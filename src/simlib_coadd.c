@@ -58,6 +58,9 @@
     simlib_coadd <simlib_file> SORT_BAND (sort by band before coadd) 
          # e.g., g,r,i,g,r,i -> gg,rr,ii so that each band is coadded.
 
+    simlib_coadd <simlib_file> BINARY  
+         # also write compiled <simlib_file>.COADD.BIN for fast sim read
+
   History
   ---------
 
@@ -106,6 +109,10 @@
    + fix bug computing min/max MJD for in update_summary_info();
      no impact on SIMLIB contents.
 
+ Oct 2026
+   + BINARY option writes compiled SIMLIB (LIBID index + packed S: rows)
+     that snlc_sim reads via mmap; see sntools_simlib_bin.c
+
 ***************************************/
 
 #include <stdio.h>
@@ -117,6 +124,7 @@
 
 #include "sntools.h" 
 #include "simlib_tools.c"
+#include "sntools_simlib_bin.h"
 
 #define MXMJD     100000    // max MJDs per LIBID
 #define MXLIBID   6000
@@ -153,6 +161,7 @@ struct INPUTS {
   int   OPT_SNLS;       // SNLS options
 
   int   OPT_SORT_BAND;  // Mar 2022
+  int   OPT_BINARY;     // Oct 2026: also write compiled binary SIMLIB
 } INPUTS ;
 
 // -----------------------
@@ -337,6 +346,12 @@ int main(int argc, char **argv) {
 
   insert_NLIBID();
 
+  if ( INPUTS.OPT_BINARY ) {
+    char binFile[MXPATHLEN+10];
+    sprintf(binFile,"%s%s", SIMLIB_OUTPUT.FILE, SUFFIX_SIMLIB_BIN);
+    compile_SIMLIB_BIN(SIMLIB_OUTPUT.FILE, binFile);
+  }
+
   print_summary_info();
 
 }  // end of main
@@ -374,6 +389,9 @@ void  print_simlib_coadd_help(void) {
     ""
     "SORT_BAND   # sort by band before coadd",
     "#   (e.g., g,r,i,g,r,i -> gg,rr,ii so that each band is coadded)",
+    "",
+    "BINARY      # also write compiled <simlib_file>.COADD.BIN ",
+    "#   (LIBID index + packed rows; sim jumps to any LIBID)",
     0
   };
 
@@ -403,6 +421,7 @@ void  parse_args(int argc, char **argv) {
   INPUTS.OPT_SNLS    = 0 ;
   INPUTS.OPT_MWEBV   = 0 ;
   INPUTS.OPT_SORT_BAND = 0 ;
+  INPUTS.OPT_BINARY    = 0 ;
 
   // combine consecutive exposures in same filter 
   // within this time-diff (days)
@@ -454,6 +473,9 @@ void  parse_args(int argc, char **argv) {
     if ( strcmp(argv[i], "SORT_BAND" ) == 0 ) 
       { INPUTS.OPT_SORT_BAND = 1; }
 
+    if ( strcmp(argv[i], "BINARY" ) == 0 ) 
+      { INPUTS.OPT_BINARY = 1; }
+
     if ( strcmp(argv[i],"MJD_DMP") == 0 ) 
       { INPUTS.OPT_MJD_DMP = 1;  }
 
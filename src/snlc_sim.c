@@ -10,6 +10,8 @@
              Jan 2014: separate trigger code into sntools_trigger.c[h]
              Jan 2017: add SPECTROGRAPH 
              Aug 2017: refactor SIMLIB_read 
+             Oct 2026: read compiled (binary) SIMLIB; see sntools_simlib_bin.c
+             Oct 2026: per-stage profiler (TIMERS_STAGE) written to YAML
 
  ---------------------------------------------------------
 
@@ -48,6 +50,8 @@
 #include "sntools_modelgrid.h"
 #include "sntools_spectrograph.h"
 #include "sntools_genPDF.h"
+#include "sntools_simlib_bin.h"
+#include "genmag_LCLIB_bin.h"
 #include "sntools_output.h"
 #include "sntools_sim_readme.h"
 #include "sntools_sim_atmosphere.h"
@@ -61,6 +65,7 @@
 #include <gsl/gsl_sort.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 
 // include C code
 #include "SNcadenceFoM.c"
@@ -110,6 +115,7 @@ int main(int argc, char **argv) {
   rewrite_HOSTLIB_DRIVER();
 
   // init random number generator, and store first random.
+  GENRAN_INFO.USE_COUNTER = INPUTS.RANGEN_COUNTER ;
   if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID  ) 
     { init_random_seed(INPUTS.ISEED, INPUTS.NSTREAM_RAN); }
 
@@ -164,7 +170,9 @@ int main(int argc, char **argv) {
   // extraGalactic inits only
   if ( INDEX_GENMODEL != MODEL_LCLIB )  { 
     // init host-galaxy model (in sntools_host.c)
+    start_TIMER_STAGE(ISTAGE_INIT_HOSTLIB);
     INIT_HOSTLIB();
+    stop_TIMER_STAGE(ISTAGE_INIT_HOSTLIB);
     
     // init weak and strong lensing 
     init_lensDMU(INPUTS.WEAKLENS_PROBMAP_FILE, INPUTS.WEAKLENS_DSIGMADZ ); 
@@ -215,8 +223,14 @@ int main(int argc, char **argv) {
   rewgt_genPDF(+1); // option to rewgt (intended for BiasCor)
 
   // - - - - 
+  start_TIMER_STAGE(ISTAGE_INIT_GENMODEL);
   init_genmodel();
+  stop_TIMER_STAGE(ISTAGE_INIT_GENMODEL);
+
+  start_TIMER_STAGE(ISTAGE_INIT_MODELSMEAR);
   init_modelSmear(); 
+  stop_TIMER_STAGE(ISTAGE_INIT_MODELSMEAR);
+
   init_genSpec();     // July 2016: prepare optional spectra
 
   // init atmosphere/DCR after we know survey ID from SIMLIB, and
@@ -238,6 +252,10 @@ int main(int argc, char **argv) {
 
   set_TIMERS(1);
 
+  // check option to split event generation among worker processes;
+  // each worker returns here with its own NGEN, CIDOFF and seed.
+  if ( INPUTS.NTHREAD_SIM > 1 ) { fork_SIMTHREADS(&SIMFILE_AUX); }
+
   // =================================================
   // start main loop over "ilc"
 
@@ -258,10 +276,16 @@ int main(int argc, char **argv) {
 
     if ( INPUTS.TRACE_MAIN  ) { dmp_trace_main("02", ilc) ; }
 
-    if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID ) 
-      { fill_RANLISTs(); }      // init list of random numbers for each SN    
+    if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID ) {
+      if ( INPUTS.RANGEN_COUNTER ) 
+	{ event_RANCOUNTER(GENLC.CIDOFF+ilc); } // randoms keyed by event slot
+      else
+	{ fill_RANLISTs(); }   // init list of random numbers for each SN    
+    }
 
+    start_TIMER_STAGE(ISTAGE_GEN_EVENT);
     gen_event_driver(ilc); 
+    stop_TIMER_STAGE(ISTAGE_GEN_EVENT);
 
     if ( GENLC.STOPGEN_FLAG ) { NGENLC_TOT--;  goto ENDLOOP ; }
     
@@ -309,7 +333,9 @@ int main(int argc, char **argv) {
 
 
     if ( INPUTS.TRACE_MAIN ) { dmp_trace_main("07", ilc) ; }
+    start_TIMER_STAGE(ISTAGE_GENMAG);
     GENMAG_DRIVER();   // July 2016
+    stop_TIMER_STAGE(ISTAGE_GENMAG);
 
     if ( GENMAG_CUT() == 0  ) {
       gen_event_reject(&ilc, &SIMFILE_AUX, "GENMAG");
@@ -321,12 +347,16 @@ int main(int argc, char **argv) {
     // generate spectra before broadband fluxes in case TEXPOSE
     // is computed from requested SNR; TEXPOSE is then used for
     // synthetic bands.
+    start_TIMER_STAGE(ISTAGE_GENSPEC);
     GENSPEC_DRIVER(); 
+    stop_TIMER_STAGE(ISTAGE_GENSPEC);
 
     if ( INPUTS.TRACE_MAIN ) { dmp_trace_main("09", ilc) ; }
 
     // convert generated mags into observed fluxes
+    start_TIMER_STAGE(ISTAGE_GENFLUX);
     GENFLUX_DRIVER(); 
+    stop_TIMER_STAGE(ISTAGE_GENFLUX);
 
     // Oct 1 2023
     // bail of there are no observations to write out; e.g., pre-explosion 
@@ -352,12 +382,14 @@ int main(int argc, char **argv) {
     GENLC.SEARCHEFF_MASK = 3 ;
     if ( GENLC.IFLAG_GENSOURCE != IFLAG_GENGRID  ) {
       MJD_DETECT_DEF MJD_DETECT;
+      start_TIMER_STAGE(ISTAGE_SEARCHEFF);
       LOAD_SEARCHEFF_DATA();
       GENLC.SEARCHEFF_MASK = 
 	gen_SEARCHEFF(GENLC.CID                 // (I) ID for dump/abort
 		      ,&GENLC.SEARCHEFF_SPEC     // (O)
 		      ,&GENLC.SEARCHEFF_zHOST    // (O) Mar 2018
 		      ,&MJD_DETECT   );          // (O) Oct 2021
+      stop_TIMER_STAGE(ISTAGE_SEARCHEFF);
 
       GENLC.MJD_TRIGGER        = (float)MJD_DETECT.TRIGGER ;
       GENLC.MJD_DETECT_FIRST   = (float)MJD_DETECT.FIRST ;
@@ -407,7 +439,9 @@ int main(int argc, char **argv) {
     if ( INPUTS.TRACE_MAIN ) { dmp_trace_main("13", ilc) ; }
 
     // update SNDATA files & auxiliary files
+    start_TIMER_STAGE(ISTAGE_WRITE);
     update_simFiles(&SIMFILE_AUX);
+    stop_TIMER_STAGE(ISTAGE_WRITE);
 
     GENLC.ACCEPTFLAG = 1 ;  // Added Dec 2015
 
@@ -416,6 +450,7 @@ int main(int argc, char **argv) {
   GENEFF:
 
     if ( INPUTS.NGENTOT_LC > 0 ) { screen_update(); }
+    if ( INPUTS.NGEN_RATE_UPDATE > 0 ) { rate_TIMER_STAGE(); }
 
     GENLC.STOPGEN_FLAG = geneff_calc();  // calc generation effic & error  
     if ( GENLC.STOPGEN_FLAG )  { goto ENDLOOP; }
@@ -429,6 +464,9 @@ int main(int argc, char **argv) {
 
   set_TIMERS(2);
 
+  // workers exit here; main process collects & merges worker output
+  if ( INPUTS.NTHREAD_SIM > 1 ) { end_SIMTHREADS(&SIMFILE_AUX); }
+
   // print final statistics on generated lightcurves.
 
   simEnd(&SIMFILE_AUX);
@@ -528,6 +566,27 @@ void simEnd(SIMFILE_AUX_DEF *SIMFILE_AUX) {
   sprintf(str_cputime,"%s(ACC)", STRING_CPUTIME_PROC_RATE);
   print_cputime(t_end_init, str_cputime, UNIT_TIME_SECOND, NGENLC_WRITE);
 
+  // Oct 2026: MWEBV map lookup rate
+  double NLOOKUP_MWDUST, TLOOKUP_MWDUST;
+  get_MWgaldust_stats(&NLOOKUP_MWDUST, &TLOOKUP_MWDUST);
+  if ( NLOOKUP_MWDUST > 0.0 ) {
+    printf("  MWEBV map lookups: %.0f in %.2f sec  (%.3e lookups/sec)\n",
+	   NLOOKUP_MWDUST, TLOOKUP_MWDUST, 
+	   NLOOKUP_MWDUST / (TLOOKUP_MWDUST + 1.0E-9) );
+  }
+
+  // Oct 2026: SALT2 band-flux table usage (and CHECK accuracy)
+  if ( INDEX_GENMODEL == MODEL_SALT2 ) { summary_BANDFLUX_SALT2(); }
+
+  // Oct 2026: correlated flux-noise timing, structured vs. dense
+  if ( NREDCOV_FLUXERRMODEL > 0 ) { summary_REDCOV_STATS(); }
+
+  // Oct 2026: genSmear cache hit rate and time saved
+  summary_genSmear_cache();
+
+  // Oct 2026: binary LCLIB prefetch stats
+  if ( LCLIB_BIN.USE ) { summary_LCLIB_BIN(); }
+
   fflush(stdout);
 
   // - - - - 
@@ -566,6 +625,561 @@ void simEnd(SIMFILE_AUX_DEF *SIMFILE_AUX) {
 } // end of simEnd
 
 
+// ***************************************
+void summary_REDCOV_STATS(void) {
+
+  // Created Oct 2026
+  // Print number of REDCOV flux-noise calls, mean NOBS and time per call
+  // for O(N) structured method and for dense Cholesky fallback.
+
+  int    NCALL[2] = { REDCOV_STATS.NCALL_STRUCT, REDCOV_STATS.NCALL_DENSE };
+  double NOBS[2]  = { REDCOV_STATS.NOBS_STRUCT,  REDCOV_STATS.NOBS_DENSE  };
+  double TSUM[2]  = { REDCOV_STATS.T_STRUCT,     REDCOV_STATS.T_DENSE     };
+  char   NAME[2][20] = { "structured O(N)", "dense Cholesky" } ;
+  int    i ;
+  // ------------- BEGIN -------------
+
+  printf("  REDCOV flux-noise (SNR > %.1f): \n", 
+	 INPUTS.FLUXERRMODEL_SNRMIN_REDCOV);
+  for(i=0; i < 2; i++ ) {
+    if ( NCALL[i] == 0 ) { continue; }
+    printf("    %-16s : %8d calls, <NOBS>=%7.1f, %.3e sec/call \n",
+	   NAME[i], NCALL[i], NOBS[i]/(double)NCALL[i], 
+	   TSUM[i]/(double)NCALL[i] );
+  }
+  fflush(stdout);
+
+  return ;
+
+} // end summary_REDCOV_STATS
+
+
+// ***************************************
+void fork_SIMTHREADS(SIMFILE_AUX_DEF *SIMFILE_AUX) {
+
+  // Created Oct 2026
+  // Split event generation among NTHREAD_SIM processes: the main 
+  // process (ITHREAD=0) plus NTHREAD_SIM-1 forked workers.
+  // Forking after full init shares read-only tables (HOSTLIB, SED
+  // surfaces, GENPDF maps, SEARCHEFF maps ...) via copy-on-write,
+  // while each process has private GENLC, SNHOSTGAL, GENRAN_INFO and
+  // SIMLIB_HEADER structs.
+  //
+  // Events are split into contiguous blocks: thread i generates NGEN[i]
+  // events starting at CIDOFF[i] so that the CID range is the same as
+  // for a single-process job. Main process keeps its random sequence;
+  // worker i is re-seeded with ISEED + i*ISEED_SHIFT_THREAD so that 
+  // output is reproducible for given ISEED and NTHREAD_SIM.
+  // With RANGEN_COUNTER=1, all threads use ISEED since randoms are
+  // keyed by event slot (CIDOFF+ilc) instead of by sequence.
+  //
+  // Workers return to main and generate their block of events; at
+  // end of job, see end_SIMTHREADS.
+
+  int  NGEN = INPUTS.NGEN ;
+  int  NTHREAD, ithread, CIDOFF, fd[2], pid ;
+  char prefix[MXPATHLEN+100];
+  char fnam[] = "fork_SIMTHREADS" ;
+
+  // ------------- BEGIN -------------
+
+  check_SIMTHREADS();
+  NTHREAD = SIMTHREAD.NTHREAD ;
+
+  print_banner(fnam);
+  printf("\t Split NGEN=%d among %d processes (main + %d workers)\n",
+	 NGEN, NTHREAD, NTHREAD-1 );
+
+  CIDOFF = GENLC.CIDOFF ;
+  for(ithread=0; ithread < NTHREAD; ithread++ ) {
+    SIMTHREAD.NGEN[ithread]    = NGEN / NTHREAD ;
+    if ( ithread < NGEN % NTHREAD ) { SIMTHREAD.NGEN[ithread]++ ; }
+    SIMTHREAD.CIDOFF[ithread]  = CIDOFF ;
+    SIMTHREAD.ISEED[ithread]   = INPUTS.ISEED + ithread*ISEED_SHIFT_THREAD;
+    if ( INPUTS.RANGEN_COUNTER ) { SIMTHREAD.ISEED[ithread] = INPUTS.ISEED; }
+    SIMTHREAD.PID[ithread]     = -9 ;
+    SIMTHREAD.FD_PIPE[ithread] = -9 ;
+    CIDOFF += SIMTHREAD.NGEN[ithread] ;
+
+    sprintf(prefix,"%s/%s_THREAD%2.2d", 
+	    PATH_SNDATA_SIM, INPUTS.GENVERSION, ithread);
+    sprintf(SIMTHREAD.LIST[ithread],      "%s.LIST", prefix);
+    sprintf(SIMTHREAD.DUMP[ithread],      "%s.DUMP", prefix);
+    sprintf(SIMTHREAD.DUMP_DCR[ithread],  "%s.DCR",  prefix);
+    sprintf(SIMTHREAD.DUMP_SPEC[ithread], "%s.SPEC", prefix);
+
+    printf("\t ITHREAD=%2d : NGEN=%d  CID > %d  ISEED=%d \n",
+	   ithread, SIMTHREAD.NGEN[ithread], SIMTHREAD.CIDOFF[ithread],
+	   SIMTHREAD.ISEED[ithread] );
+  }
+
+  // flush every stdio buffer so that nothing is written twice
+  fflush(NULL);
+
+  SIMTHREAD.ITHREAD = 0 ;
+  for(ithread=1; ithread < NTHREAD; ithread++ ) {
+
+    if ( pipe(fd) != 0 ) {
+      sprintf(c1err,"Cannot create pipe for ITHREAD=%d", ithread);
+      sprintf(c2err,"Try smaller NTHREAD_SIM (=%d)", NTHREAD);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+
+    pid = fork();
+    if ( pid < 0 ) {
+      sprintf(c1err,"fork failed for ITHREAD=%d", ithread);
+      sprintf(c2err,"Try smaller NTHREAD_SIM (=%d)", NTHREAD);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+
+    if ( pid == 0 ) {
+      // worker process
+      close(fd[0]);
+      SIMTHREAD.ITHREAD          = ithread ;
+      SIMTHREAD.FD_PIPE[ithread] = fd[1] ;
+      init_SIMTHREAD_worker(SIMFILE_AUX);
+      return ;
+    }
+
+    // main process
+    close(fd[1]);
+    SIMTHREAD.PID[ithread]     = pid ;
+    SIMTHREAD.FD_PIPE[ithread] = fd[0] ;
+  }
+
+  // main process generates first block of events
+  INPUTS.NGEN  = SIMTHREAD.NGEN[0] ;
+  GENLC.CIDOFF = SIMTHREAD.CIDOFF[0] ;
+
+  return ;
+
+} // end fork_SIMTHREADS
+
+
+// ***************************************
+void check_SIMTHREADS(void) {
+
+  // Created Oct 2026
+  // Set SIMTHREAD.NTHREAD, and abort on sim options whose state
+  // spans multiple events or whose output cannot be merged.
+
+  int NTHREAD = INPUTS.NTHREAD_SIM ;
+  int NGEN    = INPUTS.NGEN ;
+  char fnam[] = "check_SIMTHREADS" ;
+
+  // ------------- BEGIN -------------
+
+  if ( NTHREAD > MXTHREAD_SIM ) {
+    sprintf(c1err,"NTHREAD_SIM=%d exceeds bound", NTHREAD);
+    sprintf(c2err,"Reduce NTHREAD_SIM or increase MXTHREAD_SIM=%d",
+	    MXTHREAD_SIM);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  c1err[0] = 0 ;
+  if ( GENLC.IFLAG_GENSOURCE == IFLAG_GENGRID ) 
+    { sprintf(c1err,"GENSOURCE=GRID"); }
+  else if ( INDEX_GENMODEL == MODEL_LCLIB ) 
+    { sprintf(c1err,"GENMODEL=LCLIB (sequential LCLIB read)"); }
+  else if ( INPUTS_STRONGLENS.USE_FLAG ) 
+    { sprintf(c1err,"STRONGLENS (lens images span events)"); }
+  else if ( INPUTS.NON1ASED.NINDEX > 0 ) 
+    { sprintf(c1err,"NON1A sparse index (CIDRANGE per index)"); }
+  else if ( INPUTS.SIMLIB_IDLOCK > 0 ) 
+    { sprintf(c1err,"SIMLIB_IDLOCK"); }
+  else if ( INPUTS.HOSTLIB_MSKOPT & HOSTLIB_MSKOPT_USEONCE ) 
+    { sprintf(c1err,"HOSTLIB USEONCE (used hosts not shared by workers)"); }
+
+  if ( strlen(c1err) > 0 ) {
+    sprintf(c2err,"is not compatible with NTHREAD_SIM=%d", NTHREAD);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  // don't fork more processes than events
+  if ( NTHREAD > NGEN ) { NTHREAD = NGEN; }
+  SIMTHREAD.NTHREAD = NTHREAD ;
+
+  return ;
+
+} // end check_SIMTHREADS
+
+
+// ***************************************
+void init_SIMTHREAD_worker(SIMFILE_AUX_DEF *SIMFILE_AUX) {
+
+  // Created Oct 2026
+  // Called in forked worker process to set up private event context:
+  //  + NGEN, CIDOFF and random seed for this thread
+  //  + private SIMLIB file handle, with start point chosen as if
+  //    this worker were a batch job.
+  //  + private data & aux files.
+  //
+  // Inherited file handles are never closed or rewound here because
+  // their file offsets are shared with the main process.
+
+  int  ithread = SIMTHREAD.ITHREAD ;
+  int  NTHREAD = SIMTHREAD.NTHREAD ;
+  int  JOBID   = INPUTS.JOBID ;
+  int  NJOBTOT = INPUTS.NJOBTOT ;
+  int  gzipFlag ;
+  char c_get[200], prefix[MXPATHLEN+20], headFile[MXPATHLEN];
+  char fnam[] = "init_SIMTHREAD_worker" ;
+
+  // ------------- BEGIN -------------
+
+  INPUTS.NGEN  = SIMTHREAD.NGEN[ithread] ;
+  GENLC.CIDOFF = SIMTHREAD.CIDOFF[ithread] ;
+  init_random_seed(SIMTHREAD.ISEED[ithread], INPUTS.NSTREAM_RAN);
+
+  // - - - - SIMLIB - - - - 
+  if ( SIMLIB_BIN.USE ) {
+    // mmap is shared after fork; only the read cursor is private
+    rewind_SIMLIB_BIN();
+  }
+  else {
+    fp_SIMLIB = open_TEXTgz(INPUTS.SIMLIB_OPENFILE, "rt", &gzipFlag);
+    if ( fp_SIMLIB == NULL ) {
+      sprintf(c1err,"ITHREAD=%d cannot re-open SIMLIB file", ithread);
+      sprintf(c2err,"%s", INPUTS.SIMLIB_OPENFILE);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+
+    // skip global header
+    while( (fscanf(fp_SIMLIB, "%s", c_get)) != EOF) 
+      { if ( strcmp(c_get,"BEGIN") == 0 ) { break; } }
+  }
+
+  // each worker starts at different LIBID using batch-job logic
+  if ( NJOBTOT > 0 ) {
+    INPUTS.JOBID   = (JOBID-1)*NTHREAD + ithread + 1 ;
+    INPUTS.NJOBTOT = NJOBTOT * NTHREAD ;
+  }
+  else {
+    INPUTS.JOBID   = ithread + 1 ;
+    INPUTS.NJOBTOT = NTHREAD ;
+  }
+  SIMLIB_HEADER.LIBID = -9 ;
+  SIMLIB_findStart();
+  INPUTS.JOBID   = JOBID ;
+  INPUTS.NJOBTOT = NJOBTOT ;
+
+  // - - - - private output files - - - - -
+  if ( INPUTS.FORMAT_MASK <= 0 ) { return; }
+
+  SIMFILE_AUX->FP_LIST = fopen(SIMTHREAD.LIST[ithread], "wt");
+
+  if ( INPUTS.NVAR_SIMGEN_DUMP > 0 ) 
+    { SIMFILE_AUX->FP_DUMP = fopen(SIMTHREAD.DUMP[ithread], "wt"); }
+
+  if ( INPUTS_ATMOSPHERE.OPTMASK & ATMOSPHERE_OPTMASK_SIMGEN_DUMP_DCR ) 
+    { SIMFILE_AUX->FP_DUMP_DCR = fopen(SIMTHREAD.DUMP_DCR[ithread], "wt"); }
+
+  if ( NPEREVT_TAKE_SPECTRUM > 0 ) 
+    { SIMFILE_AUX->FP_DUMP_SPEC = fopen(SIMTHREAD.DUMP_SPEC[ithread],"wt"); }
+
+  if ( WRFLAG_FITS ) {
+    sprintf(prefix,"%s_THREAD%2.2d", INPUTS.GENPREFIX, ithread);
+    WR_SNFITSIO_INIT(PATH_SNDATA_SIM
+		     , INPUTS.GENVERSION
+		     , prefix
+		     , INPUTS.WRITE_MASK
+		     , INPUTS.NSUBSAMPLE_MARK
+		     , headFile); // <== return arg for list file
+    fprintf(SIMFILE_AUX->FP_LIST,"%s", headFile);
+  }
+
+  return ;
+
+} // end init_SIMTHREAD_worker
+
+
+// ***************************************
+void end_SIMTHREADS(SIMFILE_AUX_DEF *SIMFILE_AUX) {
+
+  // Created Oct 2026
+  // Called by every process at end of generation loop.
+  // Worker process: close files, send stats to main and exit.
+  // Main process: for each worker in ITHREAD order, read stats from 
+  // pipe, wait for worker to finish, sum stats, and merge worker
+  // LIST and aux-dump files into main files.
+
+  int  NTHREAD = SIMTHREAD.NTHREAD ;
+  int  ithread, status, NBYTE, NREAD, NTOT ;
+  int  NGEN_TOT = SIMTHREAD.NGEN[0] ;
+  SIMTHREAD_STATS_DEF STATS ;
+  char *ptr ;
+  char fnam[] = "end_SIMTHREADS" ;
+
+  // ------------- BEGIN -------------
+
+  if ( SIMTHREAD.ITHREAD > 0 ) { end_SIMTHREAD_worker(SIMFILE_AUX); }
+
+  print_banner(fnam);
+  printf("\t ITHREAD=%2d : NGENLC_TOT=%d  NGENLC_WRITE=%d \n",
+	 0, NGENLC_TOT, NGENLC_WRITE);
+  fflush(stdout);
+
+  for(ithread=1; ithread < NTHREAD; ithread++ ) {
+
+    // read full stats struct from pipe
+    ptr = (char*)&STATS;  NBYTE = sizeof(SIMTHREAD_STATS_DEF); NTOT = 0;
+    while ( NTOT < NBYTE ) {
+      NREAD = read(SIMTHREAD.FD_PIPE[ithread], ptr+NTOT, NBYTE-NTOT);
+      if ( NREAD <= 0 ) { break; }
+      NTOT += NREAD ;
+    }
+    close(SIMTHREAD.FD_PIPE[ithread]);
+
+    waitpid(SIMTHREAD.PID[ithread], &status, 0);
+    if ( NTOT != NBYTE || !WIFEXITED(status) || WEXITSTATUS(status) != 0 ) {
+      sprintf(c1err,"Worker ITHREAD=%d (pid=%d) failed: exit status=%d",
+	      ithread, SIMTHREAD.PID[ithread], WEXITSTATUS(status) );
+      sprintf(c2err,"Read %d of %d stat bytes; check worker output above",
+	      NTOT, NBYTE);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+
+    printf("\t ITHREAD=%2d : NGENLC_TOT=%d  NGENLC_WRITE=%d \n",
+	   ithread, STATS.NGENLC_TOT, STATS.NGENLC_WRITE);
+    fflush(stdout);
+
+    add_SIMTHREAD_STATS(&STATS);
+    NGEN_TOT += SIMTHREAD.NGEN[ithread] ;
+
+    if ( INPUTS.FORMAT_MASK <= 0 ) { continue; }
+
+    // append worker output to main files
+    // FITS LIST has head-file name without <CR>
+    if ( WRFLAG_FITS ) { fprintf(SIMFILE_AUX->FP_LIST, "\n"); }
+    merge_SIMTHREAD_file(SIMFILE_AUX->FP_LIST, SIMTHREAD.LIST[ithread], "");
+
+    if ( INPUTS.NVAR_SIMGEN_DUMP > 0 ) {
+      merge_SIMTHREAD_file(SIMFILE_AUX->FP_DUMP, 
+			   SIMTHREAD.DUMP[ithread], "SN:");
+    }
+    if ( INPUTS_ATMOSPHERE.OPTMASK & ATMOSPHERE_OPTMASK_SIMGEN_DUMP_DCR ) {
+      merge_SIMTHREAD_file(SIMFILE_AUX->FP_DUMP_DCR, 
+			   SIMTHREAD.DUMP_DCR[ithread], "ROW:");
+    }
+    if ( NPEREVT_TAKE_SPECTRUM > 0 ) {
+      merge_SIMTHREAD_file(SIMFILE_AUX->FP_DUMP_SPEC, 
+			   SIMTHREAD.DUMP_SPEC[ithread], "ROW:");
+    }
+  } // end ithread
+
+  // restore totals for end-of-job summary
+  INPUTS.NGEN  = NGEN_TOT ;
+  GENLC.CIDOFF = INPUTS.CIDOFF ;
+  geneff_calc();
+
+  return ;
+
+} // end end_SIMTHREADS
+
+
+// ***************************************
+void end_SIMTHREAD_worker(SIMFILE_AUX_DEF *SIMFILE_AUX) {
+
+  // Created Oct 2026
+  // close private worker files, send stats to main process through
+  // pipe, and exit without touching any file inherited from main.
+
+  int  ithread = SIMTHREAD.ITHREAD ;
+  int  fd      = SIMTHREAD.FD_PIPE[ithread] ;
+  int  NBYTE   = sizeof(SIMTHREAD_STATS_DEF);
+  int  NTOT    = 0, NWR, OPTMASK = 0 ;
+  SIMTHREAD_STATS_DEF STATS ;
+  char *ptr = (char*)&STATS ;
+
+  // ------------- BEGIN -------------
+
+  memset(&STATS, 0, NBYTE);
+
+  if ( INPUTS.FORMAT_MASK > 0 ) {
+    if ( INPUTS.NVAR_SIMGEN_DUMP > 0 ) 
+      { fclose(SIMFILE_AUX->FP_DUMP); }
+    if ( INPUTS_ATMOSPHERE.OPTMASK & ATMOSPHERE_OPTMASK_SIMGEN_DUMP_DCR ) 
+      { fclose(SIMFILE_AUX->FP_DUMP_DCR); }
+    if ( NPEREVT_TAKE_SPECTRUM > 0 ) 
+      { fclose(SIMFILE_AUX->FP_DUMP_SPEC); }
+
+    if ( WRFLAG_FITS ) {
+      if ( INPUTS.JOBID > 0 && INPUTS.GZIP_DATA_FILES ) 
+	{ OPTMASK = OPTMASK_SNFITSIO_END_GZIP; }
+      WR_SNFITSIO_END(OPTMASK); 
+    }
+    fclose(SIMFILE_AUX->FP_LIST);
+  }
+
+  load_SIMTHREAD_STATS(&STATS);
+
+  while ( NTOT < NBYTE ) {
+    NWR = write(fd, ptr+NTOT, NBYTE-NTOT);
+    if ( NWR <= 0 ) { break; }
+    NTOT += NWR ;
+  }
+  close(fd);
+
+  fflush(stdout);
+  _exit( NTOT == NBYTE ? 0 : 1 );
+
+} // end end_SIMTHREAD_worker
+
+
+// ***************************************
+void load_SIMTHREAD_STATS(SIMTHREAD_STATS_DEF *STATS) {
+
+  // Created Oct 2026
+  // load end-of-job counters of this process into *STATS
+
+  int i ;
+  // ------------- BEGIN -------------
+
+  STATS->NGENLC_TOT      = NGENLC_TOT ;
+  STATS->NGENLC_WRITE    = NGENLC_WRITE ;
+  STATS->NGENSPEC_TOT    = NGENSPEC_TOT ;
+  STATS->NGENSPEC_WRITE  = NGENSPEC_WRITE ;
+  STATS->NGEN_ALLSKIP    = NGEN_ALLSKIP ;
+  STATS->NGEN_REJECT     = NGEN_REJECT ;
+  get_MWgaldust_stats(&STATS->NLOOKUP_MWDUST, &STATS->TLOOKUP_MWDUST);
+
+  for(i=0; i < MXSTAGE_TIMER; i++ ) {
+    STATS->T_SUM_STAGE[i] = TIMERS_STAGE.T_SUM[i] ;
+    STATS->NCALL_STAGE[i] = TIMERS_STAGE.NCALL[i] ;
+  }
+
+  STATS->NCALL_REDCOV[0] = REDCOV_STATS.NCALL_STRUCT ;
+  STATS->NCALL_REDCOV[1] = REDCOV_STATS.NCALL_DENSE ;
+  STATS->NOBS_REDCOV[0]  = REDCOV_STATS.NOBS_STRUCT ;
+  STATS->NOBS_REDCOV[1]  = REDCOV_STATS.NOBS_DENSE ;
+  STATS->T_REDCOV[0]     = REDCOV_STATS.T_STRUCT ;
+  STATS->T_REDCOV[1]     = REDCOV_STATS.T_DENSE ;
+
+  get_genSmear_cache_stats(STATS->STATS_GENSMEAR_CACHE);
+
+  STATS->NTYPE_SPEC           = GENLC.NTYPE_SPEC ;
+  STATS->NTYPE_SPEC_CUTS      = GENLC.NTYPE_SPEC_CUTS ;
+  STATS->NTYPE_PHOT           = GENLC.NTYPE_PHOT ;
+  STATS->NTYPE_PHOT_CUTS      = GENLC.NTYPE_PHOT_CUTS ;
+  STATS->NTYPE_PHOT_WRONGHOST = GENLC.NTYPE_PHOT_WRONGHOST ;
+
+  for(i=0; i < MXIDSURVEY; i++ ) {
+    STATS->NGENLC_TOT_SUBSURVEY[i]   = NGENLC_TOT_SUBSURVEY[i] ;
+    STATS->NGENLC_WRITE_SUBSURVEY[i] = NGENLC_WRITE_SUBSURVEY[i] ;
+  }
+
+  for(i=0; i < 10; i++ ) {
+    STATS->NGENLC_HOSTMATCH[i]  = WRITE_HOSTMATCH.NGENLC[i] ;
+    STATS->NGENLC_NO_HOST[i]    = WRITE_HOSTMATCH.NGENLC_NO_HOST[i] ;
+    STATS->NGENLC_MULTI_HOST[i] = WRITE_HOSTMATCH.NGENLC_MULTI_HOST[i] ;
+  }
+
+  return ;
+
+} // end load_SIMTHREAD_STATS
+
+
+// ***************************************
+void add_SIMTHREAD_STATS(SIMTHREAD_STATS_DEF *STATS) {
+
+  // Created Oct 2026
+  // add worker counters *STATS to counters of main process
+
+  int i ;
+  // ------------- BEGIN -------------
+
+  NGENLC_TOT      += STATS->NGENLC_TOT ;
+  NGENLC_WRITE    += STATS->NGENLC_WRITE ;
+  NGENSPEC_TOT    += STATS->NGENSPEC_TOT ;
+  NGENSPEC_WRITE  += STATS->NGENSPEC_WRITE ;
+  NGEN_ALLSKIP    += STATS->NGEN_ALLSKIP ;
+  add_MWgaldust_stats(STATS->NLOOKUP_MWDUST, STATS->TLOOKUP_MWDUST);
+
+  // per-stage profile: sum over processes for main-loop stages only;
+  // init stages ran once in main process before fork.
+  for(i=ISTAGE_FIRST_LOOP; i < MXSTAGE_TIMER; i++ ) {
+    TIMERS_STAGE.T_SUM[i] += STATS->T_SUM_STAGE[i] ;
+    TIMERS_STAGE.NCALL[i] += STATS->NCALL_STAGE[i] ;
+  }
+
+  REDCOV_STATS.NCALL_STRUCT += STATS->NCALL_REDCOV[0] ;
+  REDCOV_STATS.NCALL_DENSE  += STATS->NCALL_REDCOV[1] ;
+  REDCOV_STATS.NOBS_STRUCT  += STATS->NOBS_REDCOV[0] ;
+  REDCOV_STATS.NOBS_DENSE   += STATS->NOBS_REDCOV[1] ;
+  REDCOV_STATS.T_STRUCT     += STATS->T_REDCOV[0] ;
+  REDCOV_STATS.T_DENSE      += STATS->T_REDCOV[1] ;
+
+  add_genSmear_cache_stats(STATS->STATS_GENSMEAR_CACHE);
+
+  NGEN_REJECT.GENRANGE           += STATS->NGEN_REJECT.GENRANGE ;
+  NGEN_REJECT.GENMAG             += STATS->NGEN_REJECT.GENMAG ;
+  NGEN_REJECT.GENPAR_SELECT_FILE += STATS->NGEN_REJECT.GENPAR_SELECT_FILE ;
+  NGEN_REJECT.HOSTLIB            += STATS->NGEN_REJECT.HOSTLIB ;
+  NGEN_REJECT.SEARCHEFF          += STATS->NGEN_REJECT.SEARCHEFF ;
+  NGEN_REJECT.CUTWIN             += STATS->NGEN_REJECT.CUTWIN ;
+  NGEN_REJECT.NEPOCH             += STATS->NGEN_REJECT.NEPOCH ;
+
+  GENLC.NTYPE_SPEC           += STATS->NTYPE_SPEC ;
+  GENLC.NTYPE_SPEC_CUTS      += STATS->NTYPE_SPEC_CUTS ;
+  GENLC.NTYPE_PHOT           += STATS->NTYPE_PHOT ;
+  GENLC.NTYPE_PHOT_CUTS      += STATS->NTYPE_PHOT_CUTS ;
+  GENLC.NTYPE_PHOT_WRONGHOST += STATS->NTYPE_PHOT_WRONGHOST ;
+  if ( NGENLC_WRITE > 0 ) {
+    GENLC.FRAC_PHOT_WRONGHOST = 
+      (float)GENLC.NTYPE_PHOT_WRONGHOST / (float)NGENLC_WRITE ;
+  }
+
+  for(i=0; i < MXIDSURVEY; i++ ) {
+    NGENLC_TOT_SUBSURVEY[i]   += STATS->NGENLC_TOT_SUBSURVEY[i] ;
+    NGENLC_WRITE_SUBSURVEY[i] += STATS->NGENLC_WRITE_SUBSURVEY[i] ;
+  }
+
+  for(i=0; i < 10; i++ ) {
+    WRITE_HOSTMATCH.NGENLC[i]            += STATS->NGENLC_HOSTMATCH[i] ;
+    WRITE_HOSTMATCH.NGENLC_NO_HOST[i]    += STATS->NGENLC_NO_HOST[i] ;
+    WRITE_HOSTMATCH.NGENLC_MULTI_HOST[i] += STATS->NGENLC_MULTI_HOST[i] ;
+  }
+
+  return ;
+
+} // end add_SIMTHREAD_STATS
+
+
+// ***************************************
+void merge_SIMTHREAD_file(FILE *FP, char *threadFile, char *KEY_ROW) {
+
+  // Created Oct 2026
+  // Append lines of worker file *threadFile to main file FP,
+  // then remove threadFile. If KEY_ROW is not blank, only lines 
+  // starting with KEY_ROW are appended (i.e., skip header).
+
+  int  LENKEY = strlen(KEY_ROW);
+  FILE *FP_THREAD ;
+  char LINE[MXPATHLEN*4] ;
+  char fnam[] = "merge_SIMTHREAD_file" ;
+
+  // ------------- BEGIN -------------
+
+  FP_THREAD = fopen(threadFile, "rt");
+  if ( FP_THREAD == NULL ) {
+    sprintf(c1err,"Cannot open worker file to merge:");
+    sprintf(c2err,"%s", threadFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  while ( fgets(LINE, sizeof(LINE), FP_THREAD) != NULL ) {
+    if ( LENKEY > 0 && strncmp(LINE,KEY_ROW,LENKEY) != 0 ) { continue; }
+    fputs(LINE, FP);
+  }
+
+  fclose(FP_THREAD);
+  remove(threadFile);
+
+  return ;
+
+} // end merge_SIMTHREAD_file
+
+
 // *************************
 int LUPDGEN(int N) {
   // May 27, 2009
@@ -710,6 +1324,7 @@ void set_user_defaults(void) {
   INPUTS.ISEED       = 1 ;
 
   INPUTS.RANLIST_START_GENSMEAR = 1 ;
+  INPUTS.RANGEN_COUNTER         = 0 ; // default: srandom + RANSTORE lists
 
 #ifdef ONE_RANDOM_STREAM
   INPUTS.NSTREAM_RAN = 1 ; // for Mac (7.30.2020
@@ -734,6 +1349,7 @@ void set_user_defaults(void) {
   INPUTS.GZIP_DATA_FILES = 1;
   INPUTS.JOBID      = 0;         // for batch only
   INPUTS.NJOBTOT    = 0;         // for batch only
+  INPUTS.NTHREAD_SIM = 1;        // 1 -> no forked workers
   INPUTS.NSUBSAMPLE_MARK = 0 ;
 
   // Mar 2020: use updated cosmoparameters defined in sntools.h
@@ -977,6 +1593,8 @@ void set_user_defaults(void) {
   sprintf(INPUTS.GENMAG_SMEAR_MODELNAME, "NONE") ;
   INPUTS.GENMAG_SMEAR_MODELARG[0] = 0;
   INPUTS.GENMAG_SMEAR_MSKOPT      = 0 ;
+  INPUTS.GENMAG_SMEAR_CACHE[0]    = 0.0 ; // DLAM=0 -> no cache
+  INPUTS.GENMAG_SMEAR_CACHE[1]    = 0.001 ;
 
   sprintf(INPUTS.STRONGLENS_FILE,       "NONE");
   sprintf(INPUTS.WEAKLENS_PROBMAP_FILE, "NONE");
@@ -1004,6 +1622,8 @@ void set_user_defaults(void) {
   INPUTS.WRITE_MASK       = WRITE_MASK_SIM_SNANA ; // default
   INPUTS.WRFLAG_MODELPAR  = 1;  // default is yes
   INPUTS.WRFLAG_YAML_FILE = 0;  // batch-sumbit scripts should set this
+  INPUTS.NEVT_BUFFER_FITS = 0;  // 0 -> default; <0 -> no FITS buffer
+  INPUTS.NGEN_RATE_UPDATE = 0;  // 0 -> no stage-rate line to stdout
 
   INPUTS.NPE_PIXEL_SATURATE = 1000000000; // billion
   INPUTS.PHOTFLAG_SATURATE = 0 ;
@@ -1818,6 +2438,9 @@ int parse_input_key_driver(char **WORDS, int keySource ) {
 			WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%f", &INPUTS.NGEN_SCALE_NON1A );
   }
+  else if ( keyMatchSim(1, "NTHREAD_SIM",  WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%d", &INPUTS.NTHREAD_SIM );
+  }
   else if ( keyMatchSim(1, "NSUBSAMPLE_MARK",  WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.NSUBSAMPLE_MARK );
   }
@@ -1833,6 +2456,12 @@ int parse_input_key_driver(char **WORDS, int keySource ) {
   else if ( keyMatchSim(1, "WRFLAG_YAML_FILE",  WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.WRFLAG_YAML_FILE );
   }
+  else if ( keyMatchSim(1, "NEVT_BUFFER_FITS",  WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%d", &INPUTS.NEVT_BUFFER_FITS );
+  }
+  else if ( keyMatchSim(1, "NGEN_RATE_UPDATE",  WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%d", &INPUTS.NGEN_RATE_UPDATE );
+  }
   // - - - -
   else if ( keyMatchSim(1, "NPE_PIXEL_SATURATE",  WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.NPE_PIXEL_SATURATE );
@@ -1964,6 +2593,9 @@ int parse_input_key_driver(char **WORDS, int keySource ) {
   else if ( keyMatchSim(1,"NSTREAM_RAN", WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.NSTREAM_RAN );
   } 
+  else if ( keyMatchSim(1,"RANGEN_COUNTER", WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%d", &INPUTS.RANGEN_COUNTER );
+  } 
   else if ( keyMatchSim(1,"RANLIST_START_GENSMEAR", WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.RANLIST_START_GENSMEAR );
   }
@@ -4809,6 +5441,10 @@ int parse_input_GENMAG_SMEAR(char **WORDS, int keySource ) {
   else if ( keyMatchSim(1, "GENMAG_SMEAR_MSKOPT",  WORDS[0],keySource) ) {
     N++;  sscanf(WORDS[N], "%d", &INPUTS.GENMAG_SMEAR_MSKOPT );
   }
+  else if ( keyMatchSim(1, "GENMAG_SMEAR_CACHE",  WORDS[0],keySource) ) {
+    N++;  sscanf(WORDS[N], "%le", &INPUTS.GENMAG_SMEAR_CACHE[0] ); // DLAM
+    N++;  sscanf(WORDS[N], "%le", &INPUTS.GENMAG_SMEAR_CACHE[1] ); // TOL
+  }
 
   if ( keyMatchSim(1, "GENMAG_SMEAR_MODELNAME", WORDS[0], keySource) ) {
     char *modelName = INPUTS.GENMAG_SMEAR_MODELNAME  ;
@@ -6682,6 +7318,16 @@ void prep_user_input(void) {
   OPT  = INPUTS.OPT_MWEBV ;
   text_MWoption(PARNAME_EBV, OPT, INPUTS.STR_MWEBV ); // return STR
   if ( OPT == 0 ) { INPUTS.MWEBV_FLAG = 0; } // turn off
+
+  // Oct 2026: keep SFD maps in memory for MWEBV lookups. If SFD map
+  // is always used, preload here (before NTHREAD_SIM fork) so that 
+  // workers share memory; otherwise load only if needed.
+  if ( INPUTS.MWEBV_FLAG == 1 ) {
+    if ( OPT >= OPT_MWEBV_SFD98 ) 
+      { init_MWgaldust_cache(OPT_MWDUST_CACHE_PRELOAD); }
+    else
+      { init_MWgaldust_cache(OPT_MWDUST_CACHE_LAZY); }
+  }
   
   // --------------------------------------------------
   // check exposure time for each filter
@@ -6769,8 +7415,8 @@ void prep_user_input(void) {
 
   printf(" \n" );
 
-  printf("\t Random number seed: %d  (NSTREAM=%d)\n", 
-	 INPUTS.ISEED, INPUTS.NSTREAM_RAN );
+  printf("\t Random number seed: %d  (NSTREAM=%d, RANGEN_COUNTER=%d)\n", 
+	 INPUTS.ISEED, INPUTS.NSTREAM_RAN, INPUTS.RANGEN_COUNTER );
 
   printf("\t Gen-Range for RA(deg)  : %8.3f to %8.3f \n", 
 	 INPUTS.GENRANGE_RA[0], INPUTS.GENRANGE_RA[1] );
@@ -9259,6 +9905,8 @@ void init_modelSmear(void) {
   //
   // Feb 11 2020: call init_genSmear_phaseCor(magSmear,expTau);
   //
+  // Oct 2026: call init_genSmear_cache (sim-input GENMAG_SMEAR_CACHE)
+  //
 
   double GENMODEL_ERRSCALE   = (double)INPUTS.GENMODEL_ERRSCALE ;
   char  *SMEAR_SCALE_STRING  = INPUTS.GENMAG_SMEAR_SCALE;
@@ -9433,6 +10081,10 @@ void init_modelSmear(void) {
     //    dump_modelSmearSigma();
   }
 
+  // optional per-event cache of smear surface (Oct 2026)
+  init_genSmear_cache(INPUTS.GENMAG_SMEAR_CACHE[0], 
+		      INPUTS.GENMAG_SMEAR_CACHE[1], LAMRANGE);
+
 
  SKIP_GENSMEAR:
 
@@ -12003,7 +12655,9 @@ void gen_event_driver(int ilc) {
     // Note that SNHOST_DRIVER can change GENLC.REDSHIFT_CMB 
     // and DLMAG to match that of the HOST
     // Similarly, GENLC.REDSHIFT_HOST is changed to be the true zhost
+    start_TIMER_STAGE(ISTAGE_GEN_SNHOST);
     GEN_SNHOST_DRIVER(zHOST, GENLC.PEAKMJD); 
+    stop_TIMER_STAGE(ISTAGE_GEN_SNHOST);
 
     // Jun 12 2020 
     //  if no SN par in WGTMAP, generate SN params after picking host
@@ -13776,17 +14430,38 @@ void set_TIMERS(int flag) {
   // flag=0 -> start
   // flag=1 -> end of init
   // flat=2 -> end of job
+  //
+  // Oct 2026: flag=0 also inits per-stage profiler (TIMERS_STAGE)
 
+  int  istage;
   char fnam[] = "set_TIMERS" ;
   // ---------- BEGIN -----------
 
   if ( flag == 0 ) {
     TIMERS.t_start = time(NULL);
+
+    for(istage=0; istage < MXSTAGE_TIMER; istage++ ) {
+      TIMERS_STAGE.T_START[istage] = 0.0 ;
+      TIMERS_STAGE.T_SUM[istage]   = 0.0 ;
+      TIMERS_STAGE.NCALL[istage]   = 0 ;
+    }
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_INIT_HOSTLIB],    "INIT_HOSTLIB");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_INIT_GENMODEL],   "init_genmodel");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_INIT_MODELSMEAR], "init_modelSmear");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_GEN_EVENT],       "gen_event_driver");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_GEN_SNHOST],      "GEN_SNHOST_DRIVER");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_GENMAG],          "GENMAG_DRIVER");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_GENSPEC],         "GENSPEC_DRIVER");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_GENFLUX],         "GENFLUX_DRIVER");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_SEARCHEFF],       "gen_SEARCHEFF");
+    sprintf(TIMERS_STAGE.NAME[ISTAGE_WRITE],           "update_simFiles");
   }
   else if ( flag == 1 ) {
     TIMERS.t_end_init    = time(NULL); // Mar 15 2020
     TIMERS.t_update_last = TIMERS.t_end_init;
     TIMERS.NGENTOT_LAST  = 0 ;
+    TIMERS_STAGE.T_RATE_LAST       = get_time_monotonic();
+    TIMERS_STAGE.NGENTOT_RATE_LAST = 0 ;
 
     print_banner(fnam);
     print_cputime(TIMERS.t_start, STRING_CPUTIME_INIT, UNIT_TIME_SECOND, 0);
@@ -13799,11 +14474,117 @@ void set_TIMERS(int flag) {
   return;
 } // end set_TIMERS
 
+
+// ***********************************************
+double get_time_monotonic(void) {
+
+  // Created Oct 2026
+  // Return monotonic clock time in seconds (arbitrary origin);
+  // unaffected by system clock changes, ~nsec resolution.
+
+  struct timespec ts ;
+  // ---------- BEGIN -----------
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return( (double)ts.tv_sec + 1.0E-9*(double)ts.tv_nsec );
+
+} // end get_time_monotonic
+
+// ***********************************************
+void start_TIMER_STAGE(int ISTAGE) {
+  // Created Oct 2026: start timer for stage ISTAGE (see snlc_sim.h)
+  TIMERS_STAGE.T_START[ISTAGE] = get_time_monotonic();
+} // end start_TIMER_STAGE
+
+void stop_TIMER_STAGE(int ISTAGE) {
+  // Created Oct 2026: increment time sum and call count for ISTAGE
+  double t_now = get_time_monotonic();
+  TIMERS_STAGE.T_SUM[ISTAGE] += (t_now - TIMERS_STAGE.T_START[ISTAGE]);
+  TIMERS_STAGE.NCALL[ISTAGE]++ ;
+} // end stop_TIMER_STAGE
+
+
+// ***********************************************
+void rate_TIMER_STAGE(void) {
+
+  // Created Oct 2026
+  // Every INPUTS.NGEN_RATE_UPDATE generated events, print generation
+  // rate since last update, and fraction of main-loop time spent
+  // in each stage since start of generation.
+
+  int    NGEN_UPD = INPUTS.NGEN_RATE_UPDATE ;
+  int    NDIF     = NGENLC_TOT - TIMERS_STAGE.NGENTOT_RATE_LAST ;
+  double t_now, t_dif, t_loop, frac ;
+  int    istage ;
+  char   cfrac[200], ctmp[40] ;
+
+  // ---------- BEGIN -----------
+
+  if ( NDIF < NGEN_UPD ) { return; }
+
+  t_now  = get_time_monotonic();
+  t_dif  = t_now - TIMERS_STAGE.T_RATE_LAST ;
+  t_loop = 0.0 ;
+  for(istage=ISTAGE_FIRST_LOOP; istage < MXSTAGE_TIMER; istage++ ) {
+    if ( istage == ISTAGE_GEN_SNHOST ) { continue; } // nested in GEN_EVENT
+    t_loop += TIMERS_STAGE.T_SUM[istage] ;
+  }
+
+  cfrac[0] = 0 ;
+  if ( t_loop > 0.0 ) {
+    for(istage=ISTAGE_FIRST_LOOP; istage < MXSTAGE_TIMER; istage++ ) {
+      if ( TIMERS_STAGE.NCALL[istage] == 0 ) { continue; }
+      frac = 100.0 * TIMERS_STAGE.T_SUM[istage] / t_loop ;
+      sprintf(ctmp," %s=%.0f%%", TIMERS_STAGE.NAME[istage], frac);
+      strcat(cfrac,ctmp);
+    }
+  }
+
+  printf("\t RATE(NGEN=%d): %.1f gen/sec %s\n",
+	 NGENLC_TOT, (double)NDIF/(t_dif+1.0E-9), cfrac );
+  fflush(stdout);
+
+  TIMERS_STAGE.T_RATE_LAST       = t_now ;
+  TIMERS_STAGE.NGENTOT_RATE_LAST = NGENLC_TOT ;
+
+  return ;
+
+} // end rate_TIMER_STAGE
+
+
+// ***********************************************
+void wr_TIMER_STAGE_YAML(FILE *fp) {
+
+  // Created Oct 2026
+  // Write per-stage profile to YAML summary file *fp.
+  // Times are summed over all processes (NTHREAD_SIM).
+
+  int    istage, NCALL ;
+  double T_SUM, T_PERCALL ;
+  char   key[40];
+  // ---------- BEGIN -----------
+
+  fprintf(fp, "TIMING_STAGES:   # T_SUM(sec)  NCALL  T_PER_CALL(msec)\n");
+  for(istage=0; istage < MXSTAGE_TIMER; istage++ ) {
+    NCALL = TIMERS_STAGE.NCALL[istage] ;
+    if ( NCALL == 0 ) { continue; }
+    T_SUM     = TIMERS_STAGE.T_SUM[istage] ;
+    T_PERCALL = 1.0E3 * T_SUM / (double)NCALL ;
+    sprintf(key, "%s:", TIMERS_STAGE.NAME[istage]);
+    fprintf(fp, "  %-20s [ %10.3f, %9d, %10.4f ]\n", 
+	    key, T_SUM, NCALL, T_PERCALL );
+  }
+
+  return ;
+
+} // end wr_TIMER_STAGE_YAML
+
 // ***********************************************
 void wr_SIMGEN_YAML_SUMMARY(SIMFILE_AUX_DEF *SIMFILE_AUX) {
   
   // Write yaml-formatted summary to communicate with pipelines 
   // such as submit_batch_jobs.py or pippin.py.
+  //
+  // Oct 2026: write per-stage timing (TIMING_STAGES)
 
   FILE *fp ;
   char *ptrFile  = SIMFILE_AUX->YAML ;
@@ -13835,6 +14616,9 @@ void wr_SIMGEN_YAML_SUMMARY(SIMFILE_AUX_DEF *SIMFILE_AUX) {
     fprintf(fp,"REDSHIFT_MAX_SNR5:         %.3f   # max z with SNR>5\n", 
 	    GENLC.REDSHIFT_MAX_SNR5);
   }
+
+  // Oct 2026: per-stage timing breakdown
+  wr_TIMER_STAGE_YAML(fp);
   
   fclose(fp);
   
@@ -16832,6 +17616,15 @@ void SIMLIB_INIT_DRIVER(void) {
 
   SIMLIB_prepGlobalHeader();  
 
+  // packed S: rows in binary SIMLIB depend on PSF_UNIT
+  if ( SIMLIB_BIN.USE && 
+       SIMLIB_BIN.HEAD->NEA_PSF_UNIT != SIMLIB_GLOBAL_HEADER.NEA_PSF_UNIT ) {
+    sprintf(c1err,"NEA_PSF_UNIT=%d in binary SIMLIB, but %d from header",
+	    SIMLIB_BIN.HEAD->NEA_PSF_UNIT, SIMLIB_GLOBAL_HEADER.NEA_PSF_UNIT);
+    sprintf(c2err,"Re-create %s", INPUTS.SIMLIB_OPENFILE);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
   SIMLIB_INIT_IDEAL_GRID(); // 512-bit of SIMLIB_MSKOPT
 
   if ( INPUTS.INIT_ONLY == 1 ) { return; } 
@@ -16898,6 +17691,8 @@ void SIMLIB_readGlobalHeader_TEXT(void) {
   //
   // Sep 3 2020: check REQUIRE_DOCANA
   // Nov 12 2021: read optional FIELD
+  // Oct 2026: if SIMLIB_FILE is a compiled (binary) SIMLIB, read its
+  //           global-header text from the mmap.
 
   char PATH_DEFAULT[2*MXPATHLEN];
   char *OPENFILE      = INPUTS.SIMLIB_OPENFILE;
@@ -16915,8 +17710,17 @@ void SIMLIB_readGlobalHeader_TEXT(void) {
   // xxx  OPENMASK = OPENMASK_VERBOSE + OPENMASK_IGNORE_DOCANA;
 
   sprintf(PATH_DEFAULT, "%s %s/simlib",  PATH_USER_INPUT, PATH_SNDATA_ROOT );
-  fp_SIMLIB = snana_openTextFile(OPENMASK, PATH_DEFAULT, INPUTS.SIMLIB_FILE, 
-				 OPENFILE, &INPUTS.SIMLIB_GZIPFLAG );
+
+  fp_SIMLIB = open_SIMLIB_BIN(PATH_DEFAULT, INPUTS.SIMLIB_FILE, OPENFILE);
+  if ( fp_SIMLIB != NULL ) {
+    INPUTS.SIMLIB_GZIPFLAG = 0 ;
+    if ( !check_openFile_docana(REQUIRE_DOCANA, fp_SIMLIB, OPENFILE) )
+      { rewind(fp_SIMLIB); }
+  }
+  else {
+    fp_SIMLIB = snana_openTextFile(OPENMASK, PATH_DEFAULT, INPUTS.SIMLIB_FILE,
+				   OPENFILE, &INPUTS.SIMLIB_GZIPFLAG );
+  }
   
   if ( fp_SIMLIB == NULL ) {
     abort_openTextFile("SIMLIB_FILE", PATH_DEFAULT, INPUTS.SIMLIB_FILE, fnam);
@@ -17240,6 +18044,13 @@ void SIMLIB_INIT_IDEAL_GRID(void) {
 
   print_banner(fnam);
 
+  if ( SIMLIB_BIN.USE ) {
+    sprintf(c1err,"IDEAL_GRID option (SIMLIB_MSKOPT += %d) not available", 
+	    SIMLIB_MSKOPT_IDEAL_GRID );
+    sprintf(c2err,"for binary SIMLIB; use TEXT SIMLIB instead.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
   MJD_MIN  =  1.0E9 ;
   MJD_MAX  = -1.0E9 ;
 
@@ -17493,6 +18304,9 @@ void SIMLIB_findStart(void) {
   //
   // Jul 5 2023: fix IDSEEK to stop 1 before LIBID to avoid SIMLIB wrap-around.
   //
+  // Oct 2026: for binary SIMLIB, jump directly to the record for
+  //           NSKIP_LIBID or IDSEEK-1 instead of reading up to it.
+  //
   int IDSTART  = INPUTS.SIMLIB_IDSTART ;
   int IDLOCK   = INPUTS.SIMLIB_IDLOCK ;
   int NLIBID   = SIMLIB_GLOBAL_HEADER.NLIBID ;
@@ -17604,6 +18418,16 @@ void SIMLIB_findStart(void) {
   // Jun 23 2023: few speed-ups:
   //   + Reading all MXPATHLEN chars is faster than reading only 40 !
   //   + check first char only (=='E') before using strstr to check key match.
+  if ( SIMLIB_BIN.USE ) {
+    int IREC = -1 ;
+    if ( NSKIP_LIBID > 0 ) 
+      { IREC = NSKIP_LIBID % SIMLIB_BIN.HEAD->NREC ; }
+    if ( IDSEEK > 0 ) 
+      { IREC = irec_SIMLIB_BIN(IDSEEK-1); }
+    if ( IREC >= 0 ) { seek_SIMLIB_BIN(IREC); }
+    NSKIP_LIBID = 0 ;
+  }
+
   while ( NREAD < NSKIP_LIBID ) {
     fgets(LINE, MXPATHLEN, fp_SIMLIB) ;
     if ( LINE[0] != 'E' ) { continue; }  //quick reject (Jun 2023)
@@ -17993,6 +18817,9 @@ void  SIMLIB_readNextCadence_TEXT(void) {
   // Feb 23 2024: increase string lengths to MXCHAR_LINE_SIMLIB to handle
   //              long GROUPID strings.
   //
+  // Oct 2026: for binary SIMLIB, get lines from the mmap record and
+  //           copy each S: row from its packed struct (no sscanf).
+  //
 
 #define MXWDLIST_SIMLIB 20  // max number of words per line to read
 #define MXCHAR_LINE_SIMLIB 400
@@ -18014,6 +18841,7 @@ void  SIMLIB_readNextCadence_TEXT(void) {
   char *FIELD_LIST = SIMLIB_HEADER.FIELD; // plus-separated list of fields
   char field[40];                         // field per epoch
   char sepKey[] = " ";
+  SIMLIB_BIN_ROW_DEF *ROW_BIN = NULL ;
   char fnam[] = "SIMLIB_readNextCadence_TEXT" ;
 
   // ------------ BEGIN --------------
@@ -18052,7 +18880,11 @@ void  SIMLIB_readNextCadence_TEXT(void) {
     NLINE++ ;
     cline[0] = 0 ;   FOUND_EOF = false ;
 
-    if ( fgets(cline, 380, fp_SIMLIB) == NULL ) { FOUND_EOF = true; }
+    if ( SIMLIB_BIN.USE ) {
+      if ( nextLine_SIMLIB_BIN(cline, &ROW_BIN) == NULL ) { FOUND_EOF = true; }
+    }
+    else if ( fgets(cline, 380, fp_SIMLIB) == NULL ) 
+      { FOUND_EOF = true; }
 
     if ( !FOUND_EOF ) {
       // remove line feed    
@@ -18073,8 +18905,12 @@ void  SIMLIB_readNextCadence_TEXT(void) {
       // check SIMLIB after 5 passes to avoid infinite loop
       ENDSIMLIB_check();
       if ( GENLC.IFLAG_GENSOURCE == IFLAG_GENRANDOM ) {
-	snana_rewind(fp_SIMLIB, INPUTS.SIMLIB_OPENFILE,
-		     INPUTS.SIMLIB_GZIPFLAG);
+	if ( SIMLIB_BIN.USE ) 
+	  { rewind_SIMLIB_BIN(); }
+	else {
+	  snana_rewind(fp_SIMLIB, INPUTS.SIMLIB_OPENFILE,
+		       INPUTS.SIMLIB_GZIPFLAG);
+	}
 	SIMLIB_HEADER.NWRAP++ ; 
 	SIMLIB_HEADER.LIBID = SIMLIB_ID_REWIND ; 
 	NOBS_FOUND = NOBS_FOUND_ALL = USEFLAG_LIBID = USEFLAG_MJD = 0 ;
@@ -18215,7 +19051,10 @@ void  SIMLIB_readNextCadence_TEXT(void) {
 	NOBS_FOUND++ ; 	IWD = iwd;  
 
 	//read MJD into scalar to see if it is within GENRANGE_MJD
-	IWD++; sscanf(WDLIST[IWD], "%le", &MJD  );
+	if ( ROW_BIN != NULL ) 
+	  { MJD = ROW_BIN->MJD ; }
+	else
+	  { IWD++; sscanf(WDLIST[IWD], "%le", &MJD  ); }
        
 	KEEP_MJD = 
 	  (MJD >= INPUTS.GENRANGE_MJD[0] && MJD <= INPUTS.GENRANGE_MJD[1]) ;
@@ -18227,35 +19066,56 @@ void  SIMLIB_readNextCadence_TEXT(void) {
 	  SIMLIB_OBS_RAW.OPTLINE[ISTORE] = OPTLINE ;
 	  SIMLIB_OBS_RAW.MJD[ISTORE]     = MJD;
 
-	  IWD++; sscanf(WDLIST[IWD], "%s", ctmp );
-	  parse_SIMLIB_IDplusNEXPOSE(ctmp, 
-				     &SIMLIB_OBS_RAW.IDEXPT[ISTORE],
-				     &SIMLIB_OBS_RAW.NEXPOSE[ISTORE] );
+	  if ( ROW_BIN != NULL ) {
+	    SIMLIB_OBS_RAW.IDEXPT[ISTORE]    = ROW_BIN->IDEXPT ;
+	    SIMLIB_OBS_RAW.NEXPOSE[ISTORE]   = ROW_BIN->NEXPOSE ;
+	    sprintf(SIMLIB_OBS_RAW.BAND[ISTORE], "%s", ROW_BIN->BAND);
+	    SIMLIB_OBS_RAW.CCDGAIN[ISTORE]   = ROW_BIN->CCDGAIN ;
+	    SIMLIB_OBS_RAW.READNOISE[ISTORE] = ROW_BIN->READNOISE ;
+	    SIMLIB_OBS_RAW.SKYSIG[ISTORE]    = ROW_BIN->SKYSIG ;
+	    if ( SIMLIB_GLOBAL_HEADER.NEA_PSF_UNIT ) 
+	      { SIMLIB_OBS_RAW.NEA[ISTORE] = ROW_BIN->NEA ; }
+	    else {
+	      SIMLIB_OBS_RAW.PSFSIG1[ISTORE]  = ROW_BIN->PSFSIG1 ;
+	      SIMLIB_OBS_RAW.PSFSIG2[ISTORE]  = ROW_BIN->PSFSIG2 ;
+	      SIMLIB_OBS_RAW.PSFRATIO[ISTORE] = ROW_BIN->PSFRATIO ;
+	    }
+	    SIMLIB_OBS_RAW.ZPTADU[ISTORE]    = ROW_BIN->ZPTADU ;
+	    SIMLIB_OBS_RAW.ZPTERR[ISTORE]    = ROW_BIN->ZPTERR ;
+	    SIMLIB_OBS_RAW.MAG[ISTORE]       = ROW_BIN->MAG ;
+	  }
+	  else {
+	    IWD++; sscanf(WDLIST[IWD], "%s", ctmp );
+	    parse_SIMLIB_IDplusNEXPOSE(ctmp, 
+				       &SIMLIB_OBS_RAW.IDEXPT[ISTORE],
+				       &SIMLIB_OBS_RAW.NEXPOSE[ISTORE] );
 	  
-	  IWD++; sscanf(WDLIST[IWD], "%s" , SIMLIB_OBS_RAW.BAND[ISTORE]     );
-	  IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.CCDGAIN[ISTORE]  );
-	  IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.READNOISE[ISTORE]);
-	  IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.SKYSIG[ISTORE]   );
+	    IWD++; sscanf(WDLIST[IWD], "%s" , SIMLIB_OBS_RAW.BAND[ISTORE]  );
+	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.CCDGAIN[ISTORE]);
+	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.READNOISE[ISTORE]);
+	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.SKYSIG[ISTORE] );
 	  
-	  if ( SIMLIB_GLOBAL_HEADER.NEA_PSF_UNIT ) 
-	    { IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.NEA[ISTORE] ); }
-	  else {
-	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.PSFSIG1[ISTORE] );
-	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.PSFSIG2[ISTORE] );
-	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.PSFRATIO[ISTORE]);
-	    
-	    // if NEA is here, but user forgets "PSF_UNIT: NEA_PIXEL" in header,
-	    // this trap will hopefully abort.
+	    if ( SIMLIB_GLOBAL_HEADER.NEA_PSF_UNIT ) 
+	      { IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.NEA[ISTORE]); }
+	    else {
+	      IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.PSFSIG1[ISTORE]);
+	      IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.PSFSIG2[ISTORE]);
+	      IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.PSFRATIO[ISTORE]);
+	    }
+	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.ZPTADU[ISTORE] ); 
+	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.ZPTERR[ISTORE] );  
+	    IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.MAG[ISTORE]   );
+	  }
+
+	  // if NEA is here, but user forgets "PSF_UNIT: NEA_PIXEL" in header,
+	  // this trap will hopefully abort.
+	  if ( !SIMLIB_GLOBAL_HEADER.NEA_PSF_UNIT ) {
 	    checkval_D("PSF1(readNextCadence)", 1, 
 		       &SIMLIB_OBS_RAW.PSFSIG1[ISTORE], 0.0, 30.0 ) ;
 	  }
-	  IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.ZPTADU[ISTORE] ); 
 	  checkval_D("ZPT(readNextCadence)", 1, 
 		     &SIMLIB_OBS_RAW.ZPTADU[ISTORE], 5.0, 50.0 ) ;
 	  
-	  IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.ZPTERR[ISTORE] );  
-	  IWD++; sscanf(WDLIST[IWD], "%le", &SIMLIB_OBS_RAW.MAG[ISTORE]   );
-	  
 	  if ( INPUTS.FORCEVAL_PSF > 0.001 )  // Sep 2020
 	    { SIMLIB_OBS_RAW.PSFSIG1[ISTORE] = INPUTS.FORCEVAL_PSF;  }
 	  
@@ -26349,19 +27209,21 @@ void gen_fluxNoise_fudge_cov(int icov) {
   // GENLC.NEPOCH total epochs, so watch indices.
   //
   // Sep 3 2023: make sparse list of epochs for speed.
+  //
+  // Oct 2026: 
+  //   + covariance is sig_i*sig_j*[REDCOV + (1-REDCOV)*delta_ij] within
+  //     each block, so use O(N) gen_fluxNoise_cov_struct; dense
+  //     Cholesky (gen_fluxNoise_cov_dense) is only a fallback.
+  //   + optional block structure (per band or per season)
 
   int  NOBS = COVINFO_FLUXERRMODEL[icov].NOBS ;
-  int  MEMD0 = NOBS*sizeof(double);
-  int  MEMD1 = NOBS*sizeof(double*);
   int  NEPOCH  = GENLC.NEPOCH ;
-  int  TYPE_F  = TYPE_FLUXNOISE_F ;  // fudge noise
+  bool FORCE_DENSE = 
+    (INPUTS.FLUXERRMODEL_OPTMASK & MASK_DENSECOV_FLUXERRMODEL) > 0 ;
 
-  int  ep, iep0, iep1, indx_1D, IFILT_OBS, INDEX_REDCOV, NEPOCH_USE=0 ;
-  int  obs0, obs1, o, *epMAP;
-  double *covFlux_1D, **covCholesky_2D ;
-  double SQSIG_FUDGE[2] ;
-  double SIGxSIG, REDCOV, COV, SNR ;
-  int LDMP = 0 ; 
+  int  iep0, IFILT_OBS, INDEX_REDCOV, NEPOCH_USE=0, istat=ERROR ;
+  int  *epMAP, *IBLOCK, NBLOCK ;
+  double SNR, t0, t1 ;
   char fnam[] = "gen_fluxNoise_fudge_cov" ;
 
   // --------- BEGIN --------
@@ -26371,11 +27233,6 @@ void gen_fluxNoise_fudge_cov(int icov) {
 
   if ( NOBS <= 1 ) { return ; }
 
-  if ( LDMP ) 
-    { printf("\n xxx ------------- DUMP on for %s --------------- \n", fnam); }
-
-  // create matrix for each cov matrix
-
   epMAP          = (int   *) malloc( NOBS * sizeof(int) );
 
   // make sparse list epMAP of epochs to process
@@ -26398,10 +27255,173 @@ void gen_fluxNoise_fudge_cov(int icov) {
 
   if ( NOBS == 0 ) { free(epMAP); return; } // avoid crash on zero-size matrix below
 
+  // assign block index to each obs; different blocks are uncorrelated
+  IBLOCK = (int*) malloc( NOBS * sizeof(int) );
+  NBLOCK = set_block_fluxNoise_cov(icov, NOBS, epMAP, IBLOCK);
+
+  t0 = get_time_monotonic();
+  if ( !FORCE_DENSE ) 
+    { istat = gen_fluxNoise_cov_struct(icov, NOBS, NBLOCK, epMAP, IBLOCK); }
+
+  if ( istat == SUCCESS ) {
+    t1 = get_time_monotonic();
+    REDCOV_STATS.NCALL_STRUCT++ ;
+    REDCOV_STATS.NOBS_STRUCT += (double)NOBS ;
+    REDCOV_STATS.T_STRUCT    += (t1-t0);
+  }
+  else {
+    gen_fluxNoise_cov_dense(icov, NOBS, epMAP, IBLOCK);
+    t1 = get_time_monotonic();
+    REDCOV_STATS.NCALL_DENSE++ ;
+    REDCOV_STATS.NOBS_DENSE += (double)NOBS ;
+    REDCOV_STATS.T_DENSE    += (t1-t0);
+  }
+
+  free(epMAP);  free(IBLOCK);
+
+  return ;
+
+} // end of  gen_fluxNoise_fudge_cov
+
+
+// ******************************
+int set_block_fluxNoise_cov(int icov, int NOBS, int *epMAP, int *IBLOCK) {
+
+  // Created Oct 2026
+  // Load IBLOCK[o] = block index for each obs o in REDCOV group icov,
+  // and return number of blocks. Obs in different blocks are 
+  // uncorrelated. Block option is from REDCOV string (e.g., gr:0.2:BAND).
+  // Season block index increments for MJD gap > TGAP_SEASON_SIMLIB
+  // between consecutive obs.
+
+  int OPT_BLOCK = COVINFO_FLUXERRMODEL[icov].OPT_BLOCK ;
+  int o, ep, ifilt_obs, NBLOCK = 1 ;
+  int IBLOCK_vsIFILT[MXFILTINDX];
+  double MJD, MJD_LAST ;
+
+  // --------- BEGIN --------
+
+  if ( OPT_BLOCK == OPT_BLOCK_REDCOV_BAND ) {
+    NBLOCK = 0 ;
+    for(ifilt_obs=0; ifilt_obs < MXFILTINDX; ifilt_obs++ ) 
+      { IBLOCK_vsIFILT[ifilt_obs] = -9; }
+
+    for(o=0; o < NOBS; o++ ) {
+      ep        = epMAP[o];
+      ifilt_obs = GENLC.IFILT_OBS[ep];
+      if ( IBLOCK_vsIFILT[ifilt_obs] < 0 ) 
+	{ IBLOCK_vsIFILT[ifilt_obs] = NBLOCK;  NBLOCK++ ; }
+      IBLOCK[o] = IBLOCK_vsIFILT[ifilt_obs];
+    }
+  }
+  else if ( OPT_BLOCK == OPT_BLOCK_REDCOV_SEASON ) {
+    NBLOCK = 0 ;   MJD_LAST = -9.0 ;
+    for(o=0; o < NOBS; o++ ) {
+      ep  = epMAP[o];
+      MJD = GENLC.MJD[ep];
+      if ( o == 0 || fabs(MJD-MJD_LAST) > TGAP_SEASON_SIMLIB ) 
+	{ NBLOCK++ ; }
+      IBLOCK[o] = NBLOCK - 1 ;
+      MJD_LAST  = MJD;
+    }
+  }
+  else {
+    for(o=0; o < NOBS; o++ ) { IBLOCK[o] = 0; }
+  }
+
+  return NBLOCK ;
+
+} // end set_block_fluxNoise_cov
+
+
+// ******************************
+int gen_fluxNoise_cov_struct(int icov, int NOBS, int NBLOCK,
+			     int *epMAP, int *IBLOCK) {
+
+  // Created Oct 2026
+  // O(NOBS) replacement for dense Cholesky decomposition.
+  // Within each block the correlation matrix is compound symmetric,
+  //    R = rho*11^T + (1-rho)*I ,
+  // and after eliminating k rows the Schur complement is again
+  // compound symmetric with diag A_k and off-diag B_k.
+  // Hence Cholesky column k has diag D_k=sqrt(A_k) and a single 
+  // off-diag value C_k=B_k/D_k, with
+  //    A_{k+1} = A_k - C_k^2  ,   B_{k+1} = B_k - C_k^2 .
+  // Correlated random for k-th obs is
+  //    GAURAN_NEW[k] = D_k*GAURAN[k] + sum_{j<k} C_j*GAURAN[j] ,
+  // which equals (L*GAURAN)[k] from the dense Cholesky decomposition,
+  // so the generated noise is unchanged (to rounding).
+  // The sigma_i factors cancel: cov = diag(sig) R diag(sig).
+  //
+  // Returns SUCCESS, or ERROR if R is not positive definite 
+  // (GENLC randoms are then not modified).
+
+  double RHO = COVINFO_FLUXERRMODEL[icov].REDCOV ;
+  double A, B, D, C, SUM, GAURAN, *GAURAN_NEW ;
+  int    o, ep, ib, istat = SUCCESS ;
+
+  // --------- BEGIN --------
+
+  GAURAN_NEW = (double*) malloc( NOBS * sizeof(double) );
+
+  for(ib=0; ib < NBLOCK; ib++ ) {
+    A = 1.0;  B = RHO;  SUM = 0.0 ;
+    for(o=0; o < NOBS; o++ ) {
+      if ( IBLOCK[o] != ib ) { continue; }
+      if ( A <= 0.0 ) { istat = ERROR; goto DONE; }
+      ep     = epMAP[o];
+      GAURAN = GENLC.RANGauss_NOISE_FUDGE[ep] ;
+      D      = sqrt(A);
+      C      = B / D ;
+      GAURAN_NEW[o] = SUM + D*GAURAN ;
+      SUM   += C * GAURAN ;
+      A     -= C*C ;
+      B     -= C*C ;
+    }
+  }
+
+  // all blocks are valid: update randoms
+  for(o=0; o < NOBS; o++ ) {
+    ep = epMAP[o];
+    GENLC.RANGauss_NOISE_FUDGE[ep] = GAURAN_NEW[o] ;
+  }
+
+ DONE:
+  free(GAURAN_NEW);
+  return istat ;
+
+} // end gen_fluxNoise_cov_struct
+
+
+// ******************************
+void gen_fluxNoise_cov_dense(int icov, int NOBS, int *epMAP, int *IBLOCK) {
+
+  // Created Oct 2026 from original dense-matrix code in
+  // gen_fluxNoise_fudge_cov; used only as fallback, or if 
+  // FLUXERRMODEL_OPTMASK includes MASK_DENSECOV_FLUXERRMODEL.
+  // Correlation between different blocks (IBLOCK) is zero.
+
+  int  MEMD0 = NOBS*sizeof(double);
+  int  MEMD1 = NOBS*sizeof(double*);
+  int  TYPE_F  = TYPE_FLUXNOISE_F ;  // fudge noise
+
+  int  ep, iep0, iep1, indx_1D ;
+  int  obs0, obs1, o ;
+  double *covFlux_1D, **covCholesky_2D ;
+  double SQSIG_FUDGE[2] ;
+  double SIGxSIG, REDCOV, COV ;
+  int LDMP = 0 ; 
+  char fnam[] = "gen_fluxNoise_cov_dense" ;
+
+  // --------- BEGIN --------
+
+  if ( LDMP ) 
+    { printf("\n xxx ------------- DUMP on for %s --------------- \n", fnam); }
+
   /* xxx
   if ( SIMLIB_HEADER.LIBID == 1273 ) {
-    printf(" xxx %s: NEP_USE=%d for LIBID=%d \n",
-	   fnam, NEPOCH_USE, SIMLIB_HEADER.LIBID ); fflush(stdout);
+    printf(" xxx %s: NOBS=%d for LIBID=%d \n",
+	   fnam, NOBS, SIMLIB_HEADER.LIBID ); fflush(stdout);
   }
   */
 
@@ -26419,6 +27439,7 @@ void gen_fluxNoise_fudge_cov(int icov) {
       iep1 = epMAP[obs1];
 
       REDCOV  = COVINFO_FLUXERRMODEL[icov].REDCOV;
+      if ( IBLOCK[obs0] != IBLOCK[obs1] ) { REDCOV = 0.0 ; }
       if ( obs0 == obs1 ) { REDCOV = 1.0 ; }
 
       SQSIG_FUDGE[0] = GENLC.FLUXNOISE[iep0].SQSIG_FINAL_TRUE[TYPE_F];
@@ -26495,11 +27516,11 @@ void gen_fluxNoise_fudge_cov(int icov) {
   for(o=0; o < NOBS; o++ ) { free(covCholesky_2D[o]); }
   free(covCholesky_2D);
 
-  free(epMAP);  free(flux_scatter);
+  free(flux_scatter);
 
   return ;
 
-} // end of  gen_fluxNoise_fudge_cov
+} // end gen_fluxNoise_cov_dense
 
 
 // *********************a****************
@@ -29042,6 +30063,7 @@ void init_simFiles(SIMFILE_AUX_DEF *SIMFILE_AUX) {
       errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
     }
 
+    NEVT_BUFFER_WR_SNFITSIO = INPUTS.NEVT_BUFFER_FITS ;
     WR_SNFITSIO_INIT(PATH_SNDATA_SIM
 		     , INPUTS.GENVERSION
 		     , INPUTS.GENPREFIX
@@ -167,6 +167,31 @@ struct {
   int    NGENTOT_LAST ;
 } TIMERS ;
 
+// Oct 2026: per-stage profiler with monotonic clock; stages are timed 
+// with start/stop_TIMER_STAGE and summarized in the YAML output.
+// GEN_EVENT includes GEN_SNHOST (nested); other stages are disjoint.
+#define ISTAGE_INIT_HOSTLIB      0
+#define ISTAGE_INIT_GENMODEL     1
+#define ISTAGE_INIT_MODELSMEAR   2
+#define ISTAGE_GEN_EVENT         3  // gen_event_driver
+#define ISTAGE_GEN_SNHOST        4  // GEN_SNHOST_DRIVER
+#define ISTAGE_GENMAG            5  // GENMAG_DRIVER
+#define ISTAGE_GENSPEC           6  // GENSPEC_DRIVER
+#define ISTAGE_GENFLUX           7  // GENFLUX_DRIVER
+#define ISTAGE_SEARCHEFF         8  // LOAD_SEARCHEFF_DATA + gen_SEARCHEFF
+#define ISTAGE_WRITE             9  // update_simFiles
+#define MXSTAGE_TIMER           10
+#define ISTAGE_FIRST_LOOP        ISTAGE_GEN_EVENT
+
+struct {
+  char    NAME[MXSTAGE_TIMER][28] ;
+  double  T_START[MXSTAGE_TIMER] ;  // monotonic time (sec) at start
+  double  T_SUM[MXSTAGE_TIMER] ;    // summed time (sec) per stage
+  int     NCALL[MXSTAGE_TIMER] ;    // number of calls per stage
+  double  T_RATE_LAST ;             // time of last rate update
+  int     NGENTOT_RATE_LAST ;
+} TIMERS_STAGE ;
+
 
 // define auxillary files produced with data files.
 typedef struct { // SIMFILE_AUX_DEF
@@ -556,6 +581,7 @@ struct INPUTS {
 
   int  JOBID;       // command-line only (for batch) to compute SIMLIB_IDSTART
   int  NJOBTOT;     // id em, for submit_batch_jobs.py
+  int  NTHREAD_SIM; // number of forked worker processes to generate events
   int  GZIP_DATA_FILES ;  // flag to gzip FITS files  (default=1/true)
 
   int  HOSTLIB_USE ;            // 1=> used; 0 => not used, 2=>rewrite HOSTLIB
@@ -659,9 +685,11 @@ struct INPUTS {
   int  GENMODEL_MSKOPT;     // bit-mask of model options
   char GENMODEL_ARGLIST[400] ;
   int  GENMAG_SMEAR_MSKOPT;   // bit-mask of GENSMEAR options
+  double GENMAG_SMEAR_CACHE[2]; // DLAM, TOL for per-event smear cache
   unsigned int ISEED;         // random seed
   unsigned int ISEED_ORIG;    // for readme output
   int          NSTREAM_RAN;   // number of independent random streams
+  int          RANGEN_COUNTER; // 1 -> counter-based randoms per event (Oct 2026)
 
   int    RANLIST_START_GENSMEAR;  // to pick different genSmear randoms
 
@@ -873,6 +901,8 @@ struct INPUTS {
   int  WRITE_MASK ;          ;  // computed from FORMAT_MASK
   int  WRFLAG_MODELPAR;    // write model pars to data files (e.g,SIMSED,LCLIB)
   int  WRFLAG_YAML_FILE ;  // write YAML file (Aug 12 2020)
+  int  NEVT_BUFFER_FITS ;  // events per FITS column write (Oct 2026)
+  int  NGEN_RATE_UPDATE ;  // print stage-rate line every N events (Oct 2026)
 
   int   SMEARFLAG_FLUX ;        // 0,1 => off,on for photo-stat smearing
   int   SMEARFLAG_ZEROPT ;      // 0,1 => off,on for zeropt smearing
@@ -1430,6 +1460,14 @@ int NGENSPEC_TOT;            // total number of generated spectra
 int NGENSPEC_WRITE ;         // number of spectra written
 int NGENFLUX_DRIVER;         // number of calls to GENFLUX_DRIVER
 
+// Oct 2026: calls, NOBS and time for correlated (REDCOV) flux noise
+// with O(N) structured method vs. dense Cholesky fallback.
+struct {
+  int    NCALL_STRUCT, NCALL_DENSE ;
+  double NOBS_STRUCT,  NOBS_DENSE ;
+  double T_STRUCT,     T_DENSE ;    // summed time (sec)
+} REDCOV_STATS ;
+
 struct NGEN_REJECT {
   int GENRANGE, GENMAG;
   int GENPAR_SELECT_FILE ;
@@ -1440,6 +1478,51 @@ struct NGEN_REJECT {
 } NGEN_REJECT ;
 
 
+// Oct 2026: NTHREAD_SIM option.
+// Main process forks NTHREAD_SIM-1 worker processes after full init so
+// that read-only model tables are shared (copy-on-write). Each worker
+// gets its own event context (GENLC, SNHOSTGAL, SIMLIB cursor ...),
+// random seed and CID range; end-of-job counters are funneled back
+// through a pipe, and the main process merges worker
+// outputs in ITHREAD order so that output is reproducible for given
+// ISEED and NTHREAD_SIM.
+#define MXTHREAD_SIM        64
+#define ISEED_SHIFT_THREAD  7919  // ISEED(thread) = ISEED + ITHREAD*SHIFT
+
+typedef struct {  // SIMTHREAD_STATS_DEF
+  int  NGENLC_TOT, NGENLC_WRITE, NGENSPEC_TOT, NGENSPEC_WRITE ;
+  int  NGEN_ALLSKIP ;
+  int  NGENLC_TOT_SUBSURVEY[MXIDSURVEY];
+  int  NGENLC_WRITE_SUBSURVEY[MXIDSURVEY];
+  int  NTYPE_SPEC, NTYPE_SPEC_CUTS, NTYPE_PHOT, NTYPE_PHOT_CUTS;
+  int  NTYPE_PHOT_WRONGHOST ;
+  int  NGENLC_HOSTMATCH[10], NGENLC_NO_HOST[10], NGENLC_MULTI_HOST[10] ;
+  struct NGEN_REJECT NGEN_REJECT ;
+  double NLOOKUP_MWDUST, TLOOKUP_MWDUST ; // MWEBV map lookups & time
+  double T_SUM_STAGE[MXSTAGE_TIMER] ;     // per-stage profile
+  int    NCALL_STAGE[MXSTAGE_TIMER] ;
+  int    NCALL_REDCOV[2] ;                // REDCOV noise: struct, dense
+  double NOBS_REDCOV[2], T_REDCOV[2] ;
+  double STATS_GENSMEAR_CACHE[10] ;  // NSTAT_GENSMEAR_CACHE in genSmear.h
+} SIMTHREAD_STATS_DEF ;
+
+struct {
+  int   NTHREAD ;   // total number of processes (including main)
+  int   ITHREAD ;   // 0=main process, 1 to NTHREAD-1 for workers
+  int   ISEED[MXTHREAD_SIM] ;
+  int   NGEN[MXTHREAD_SIM] ;    // NGEN per thread
+  int   CIDOFF[MXTHREAD_SIM] ;  // CIDOFF per thread
+  int   PID[MXTHREAD_SIM] ;     // process id for each worker
+  int   FD_PIPE[MXTHREAD_SIM] ; // main reads worker stats from this pipe
+
+  // per-thread aux files; merged into main files at end of job
+  char  LIST[MXTHREAD_SIM][MXPATHLEN] ;  
+  char  DUMP[MXTHREAD_SIM][MXPATHLEN] ;
+  char  DUMP_DCR[MXTHREAD_SIM][MXPATHLEN] ;
+  char  DUMP_SPEC[MXTHREAD_SIM][MXPATHLEN] ;
+} SIMTHREAD ;
+
+
 // valid Z-range with defined rest-frame model for each obs-filter
 // (for README comment only)
 double ZVALID_FILTER[2][MXFILTINDX] ;
@@ -1840,6 +1923,12 @@ int    SIMLIB_read_templateNoise(char *field, char *whatNoise, char **wdlist);
 void   SIMLIB_TAKE_SPECTRUM(void) ;
 
 void   set_TIMERS(int flag);
+void   summary_REDCOV_STATS(void);
+double get_time_monotonic(void);
+void   start_TIMER_STAGE(int ISTAGE);
+void   stop_TIMER_STAGE(int ISTAGE);
+void   rate_TIMER_STAGE(void);
+void   wr_TIMER_STAGE_YAML(FILE *fp);
 
 int    SKIP_SIMLIB_FIELD(char *field);
 int    USE_SAME_SIMLIB_ID(int IFLAG) ;
@@ -2024,6 +2113,15 @@ void update_accept_counters(void);
 void update_hostmatch_counters(void);
 
 void    simEnd(SIMFILE_AUX_DEF *SIMFILE_AUX);
+
+void    fork_SIMTHREADS(SIMFILE_AUX_DEF *SIMFILE_AUX);
+void    check_SIMTHREADS(void);
+void    init_SIMTHREAD_worker(SIMFILE_AUX_DEF *SIMFILE_AUX);
+void    end_SIMTHREADS(SIMFILE_AUX_DEF *SIMFILE_AUX);
+void    end_SIMTHREAD_worker(SIMFILE_AUX_DEF *SIMFILE_AUX);
+void    load_SIMTHREAD_STATS(SIMTHREAD_STATS_DEF *STATS);
+void    add_SIMTHREAD_STATS(SIMTHREAD_STATS_DEF *STATS);
+void    merge_SIMTHREAD_file(FILE *FP, char *threadFile, char *KEY_ROW);
 double  gen_AV(void);          // generate AV from model
 
 double  GENAV_WV07(void);
@@ -2044,6 +2142,10 @@ void   gen_fluxNoise_calc(int ep, int vbose, FLUXNOISE_DEF *FLUXNOISE);
 void   gen_fluxNoise_fudge_diag(int ep, int vbose, FLUXNOISE_DEF *FLUXNOISE);
 void   gen_fluxNoise_fudge_cov(int icov);
 void   gen_fluxNoise_driver_cov(void);
+int    set_block_fluxNoise_cov(int icov, int NOBS, int *epMAP, int *IBLOCK);
+int    gen_fluxNoise_cov_struct(int icov, int NOBS, int NBLOCK,
+				int *epMAP, int *IBLOCK);
+void   gen_fluxNoise_cov_dense(int icov, int NOBS, int *epMAP, int *IBLOCK);
 void   gen_fluxNoise_apply(int ep, int vbose, FLUXNOISE_DEF *FLUXNOISE);
 void   dumpLine_fluxNoise(char *fnam, int ep, FLUXNOISE_DEF *FLUXNOISE);
 void   dumpEpoch_fluxNoise_apply(char *fnam, int ep, FLUXNOISE_DEF *FLUXNOISE);
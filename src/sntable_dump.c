@@ -45,6 +45,9 @@
 
    sntable_dump.exe <tableFile>  <tableName>  OBS
      (dump all observations, intended for fluxerrmap-analysis)
+
+   sntable_dump.exe <tableFile>  <tableName>  -tobin <outFile>
+     (convert table to binary columnar format; e.g., for BBC biasCor)
   
    If only the tableFile and tableName are given, then a list of
    each variable is given.  If an optional list of <varNames>
@@ -115,6 +118,9 @@
  Jun 22 2021: replace 200 -> MXPATHLEN for input file names.
                 [fixes failure found by Dillon]
 
+ Oct 2026: new option -tobin <outFile> to convert table (e.g., FITRES
+           text file) into binary columnar table; see SNTABLE_CONVERT_BIN.
+
 ********************************************/
 
 #include <stdio.h>
@@ -142,6 +148,7 @@ struct INPUTS {
   char VARLIST[MXVAR_DUMP*60];     // space-separate list
   char OUTFILE_FITRES[MXPATHLEN] ;
   char OUTFILE_IGNORE[MXPATHLEN] ;   // if --format IGNORE
+  char OUTFILE_BIN[MXPATHLEN] ;      // if -tobin (Oct 2026)
   char FORMAT_OUTFILE[40];   
   int  ISFORMAT_CSV ;
 
@@ -212,7 +219,12 @@ int main(int argc, char **argv) {
   }
 
 
-  if ( INPUTS.SNTABLE_NEVT ) {
+  if ( strlen(INPUTS.OUTFILE_BIN) > 0 ) {
+    SNTABLE_CONVERT_BIN(TFILE, TID, INPUTS.OUTFILE_BIN); // Oct 2026
+    printf("\n OUTFILE_BIN: %s \n", INPUTS.OUTFILE_BIN ); 
+    fflush(stdout);
+  }
+  else if ( INPUTS.SNTABLE_NEVT ) {
     int NEVT = SNTABLE_NEVT(TFILE,TID);  // Aug 2020
     printf(" NEVT:  %d \n", NEVT);   // script-parsable output
   }
@@ -278,6 +290,7 @@ void parse_args(int NARG, char **argv) {
 
   INPUTS.FORMAT_OUTFILE[0] = 0;
   INPUTS.VARLIST[0]        = 0;
+  INPUTS.OUTFILE_BIN[0]    = 0;
   sprintf(INPUTS.OUTFILE_FITRES, "sntable_dump.fitres" );
   sprintf(INPUTS.OUTFILE_IGNORE, "sntable_dump.ignore" );
   sprintf(INPUTS.OUTLIER_VARNAME_CHI2FLUX, "NULL_CHI2FLUX" );
@@ -358,6 +371,11 @@ void parse_args(int NARG, char **argv) {
       sprintf(INPUTS.OUTFILE_FITRES,"%s", argv[i+1])  ; 
     }
     
+    if ( keyMatch_dash(argv[i],"tobin") ) {
+      IFLAG_VARNAMES = 0;
+      sprintf(INPUTS.OUTFILE_BIN,"%s", argv[i+1])  ; 
+    }
+
     if ( strcmp_ignoreCase(argv[i],"-format" ) == 0 ) {
       sscanf(argv[i+1], "%s", INPUTS.FORMAT_OUTFILE );
       IFLAG_VARNAMES = 0;
@@ -6639,6 +6639,9 @@ void init_random_seed(int ISEED, int NSTREAM) {
   // Init random seed(s) 
   // NSTREAM = 1 -> one random stream and regular init with srandom()
   // NSTREAM = 2 -> two independent streams, use srandom_r
+  //
+  // Oct 2026: if GENRAN_INFO.USE_COUNTER is set by calling program,
+  //           also init counter-based randoms (init_RANCOUNTER).
 
   GENRAN_INFO.NSTREAM = NSTREAM ;
   int i ;
@@ -6667,6 +6670,8 @@ void init_random_seed(int ISEED, int NSTREAM) {
 #endif
   }
 
+  if ( GENRAN_INFO.USE_COUNTER ) { init_RANCOUNTER(ISEED); }
+
   fill_RANLISTs(); 
   for ( i=1; i <= GENRAN_INFO.NLIST_RAN; i++ )  { 
     GENRAN_INFO.RANFIRST[i]    = getRan_Flat1(i); 
@@ -6696,6 +6701,8 @@ void fill_RANLISTs(void) {
   //
   // Jun 9 2018: use unix_getRan_Flat1() call.
   // Jun 4 2020: change function name from init_RANLIST -> fill_RANLISTs
+  // Oct 2026: for counter-based randoms, skip bulk fill and 
+  //           advance to next event index.
 
   int ilist, istore, NLIST_RAN;
   char fnam[] = "fill_RANLISTs" ;
@@ -6714,6 +6721,9 @@ void fill_RANLISTs(void) {
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
   }
 
+  if ( GENRAN_INFO.USE_COUNTER ) 
+    { event_RANCOUNTER(GENRAN_INFO.IEVT_COUNTER+1);  return; }
+
   sumstat_RANLISTs(0);
 
   for (ilist = 1; ilist <= NLIST_RAN; ilist++ ) {
@@ -6762,6 +6772,10 @@ void sumstat_RANLISTs(int FLAG) {
       SUM   = GENRAN_INFO.NWRAP_SUM[ilist] ;
       SUMSQ = GENRAN_INFO.NWRAP_SUMSQ[ilist] ;
       NCALL = GENRAN_INFO.NCALL_fill_RANSTATs ;
+      if ( NCALL == 0 ) {  // e.g., counter-based randoms
+	GENRAN_INFO.NWRAP_AVG[ilist] = GENRAN_INFO.NWRAP_RMS[ilist] = 0.0 ;
+	continue ;
+      }
       GENRAN_INFO.NWRAP_AVG[ilist] = SUM/(double)NCALL ; 
       GENRAN_INFO.NWRAP_RMS[ilist] = STD_from_SUMS(NCALL, SUM, SUMSQ);
     }
@@ -6778,11 +6792,17 @@ double unix_getRan_Flat1(int istream) {
   // Return random between 0 and 1.
   //
   // Jul 30 2020: check pre-proc flag ONE_RANDOM_STREAM
+  // Oct 2026: check counter-based randoms
 
   int NSTREAM = GENRAN_INFO.NSTREAM ;
   int JRAN ;
   char fnam[] = "unix_getRan_Flat1";
   // ------------ BEGIN ----------------
+  if ( GENRAN_INFO.USE_COUNTER ) {
+    long long n = GENRAN_INFO.NCALL_COUNTER[istream]++ ;
+    return getRan_RANCOUNTER(ISTREAM_OFFSET_COUNTER+istream, n);
+  }
+
   if ( NSTREAM == 1 )  { 
     JRAN = random(); 
   }
@@ -6860,6 +6880,8 @@ double getRan_Flat1(int ilist) {
 
   // return random number between 0 and 1
   // Feb 2013: pass argument 'ilist' to pick random list.
+  // Oct 2026: for counter-based randoms, NSTORE_RAN[ilist] is the
+  //           position in the stream; there is no wrap-around.
 
   int  N ;
   double   x8;
@@ -6874,6 +6896,11 @@ double getRan_Flat1(int ilist) {
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
   }
 
+  if ( GENRAN_INFO.USE_COUNTER ) {
+    N = GENRAN_INFO.NSTORE_RAN[ilist]++ ;
+    return getRan_RANCOUNTER(ilist, (long long)N);
+  }
+
   // check to wrap around with random list.
   if ( GENRAN_INFO.NSTORE_RAN[ilist] >= MXSTORE_RAN ) { 
     GENRAN_INFO.NSTORE_RAN[ilist] = 0;  
@@ -6896,6 +6923,133 @@ double getran_gauss__(int *ilist) { return getRan_Gauss(*ilist); }
 double getran_flat1__(int *ilist) { return getRan_Flat1(*ilist); }
 
 
+// *********************************
+void init_RANCOUNTER(int ISEED) {
+
+  // Created Oct 2026
+  // Init counter-based randoms for this ISEED. Event index is set
+  // to -1 so that the following fill_RANLISTs call selects IEVT=0
+  // for randoms used during init.
+
+  GENRAN_INFO.KEY_COUNTER[0] = (unsigned int)ISEED ;
+  GENRAN_INFO.KEY_COUNTER[1] = KEY1_COUNTER ;
+  GENRAN_INFO.IEVT_COUNTER   = -1 ;
+  GENRAN_INFO.ITRY_COUNTER   =  0 ;
+
+  return ;
+
+} // end init_RANCOUNTER
+
+
+// *********************************
+void event_RANCOUNTER(int IEVT) {
+
+  // Created Oct 2026
+  // Start counter-based randoms for event IEVT; replaces the 
+  // per-event fill_RANLISTs. If IEVT is the same as the previous 
+  // call (e.g., sim event rejected and re-generated in same slot),
+  // increment ITRY so that the next try gets new randoms.
+  // All stream positions are reset to zero.
+
+  int ilist, istream ;
+
+  // ----------- BEGIN -------------
+
+  if ( IEVT == GENRAN_INFO.IEVT_COUNTER ) 
+    { GENRAN_INFO.ITRY_COUNTER++ ; }
+  else
+    { GENRAN_INFO.ITRY_COUNTER = 0 ; }
+
+  GENRAN_INFO.IEVT_COUNTER = IEVT ;
+
+  for ( ilist=0; ilist <= MXLIST_RAN; ilist++ ) 
+    { GENRAN_INFO.NSTORE_RAN[ilist] = 0 ; }
+
+  for ( istream=0; istream < MXSTREAM_RAN; istream++ ) 
+    { GENRAN_INFO.NCALL_COUNTER[istream] = 0 ; }
+
+  for ( istream=0; istream < MXSTREAM_COUNTER; istream++ ) 
+    { GENRAN_INFO.IBLOCK_COUNTER[istream] = -1 ; }
+
+  return ;
+
+} // end event_RANCOUNTER
+
+
+// *********************************
+double getRan_RANCOUNTER(int istream_counter, long long n) {
+
+  // Created Oct 2026
+  // Return n'th flat random (0 < r < 1) of counter-stream 
+  // istream_counter for current event. Each Philox block returns 
+  // 4 randoms; the last block is cached per stream.
+  //
+  // Counter words: [0] = block index, [1] = stream | ITRY<<8,
+  //                [2] = event index, [3] = upper bits of block index.
+
+  long long    IBLOCK = n >> 2 ;
+  int          IWORD  = (int)(n & 3) ;
+  unsigned int ctr[4], *out ;
+
+  // ----------- BEGIN -------------
+
+  out = GENRAN_INFO.OUT_COUNTER[istream_counter] ;
+
+  if ( IBLOCK != GENRAN_INFO.IBLOCK_COUNTER[istream_counter] ) {
+    ctr[0] = (unsigned int)(IBLOCK & 0xFFFFFFFF) ;
+    ctr[1] = (unsigned int)istream_counter | 
+      ((unsigned int)GENRAN_INFO.ITRY_COUNTER << 8) ;
+    ctr[2] = (unsigned int)GENRAN_INFO.IEVT_COUNTER ;
+    ctr[3] = (unsigned int)(IBLOCK >> 32) ;
+    philox4x32_RANCOUNTER(ctr, GENRAN_INFO.KEY_COUNTER, out);
+    GENRAN_INFO.IBLOCK_COUNTER[istream_counter] = IBLOCK ;
+  }
+
+  // map 32-bit word to open interval (0,1)
+  return ( (double)out[IWORD] + 0.5 ) / 4294967296.0 ;
+
+} // end getRan_RANCOUNTER
+
+
+// *********************************
+void philox4x32_RANCOUNTER(unsigned int *ctr, unsigned int *key, 
+			   unsigned int *out) {
+
+  // Created Oct 2026
+  // Philox4x32 with 10 rounds (Salmon et al. 2011, "Parallel random 
+  // numbers: as easy as 1, 2, 3"). Maps 128-bit counter *ctr and
+  // 64-bit *key into 128 random bits, *out.
+
+  unsigned int M0 = 0xD2511F53, M1 = 0xCD9E8D57 ;
+  unsigned int W0 = 0x9E3779B9, W1 = 0xBB67AE85 ;
+  unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3] ;
+  unsigned int k0 = key[0], k1 = key[1] ;
+  unsigned int hi0, lo0, hi1, lo1 ;
+  unsigned long long prod ;
+  int iround ;
+
+  // ----------- BEGIN -------------
+
+  for ( iround=0; iround < 10; iround++ ) {
+    prod = (unsigned long long)M0 * c0 ;
+    hi0  = (unsigned int)(prod >> 32);  lo0 = (unsigned int)prod ;
+    prod = (unsigned long long)M1 * c2 ;
+    hi1  = (unsigned int)(prod >> 32);  lo1 = (unsigned int)prod ;
+
+    c0 = hi1 ^ c1 ^ k0 ;
+    c1 = lo1 ;
+    c2 = hi0 ^ c3 ^ k1 ;
+    c3 = lo0 ;
+
+    k0 += W0 ;  k1 += W1 ;
+  }
+
+  out[0] = c0;  out[1] = c1;  out[2] = c2;  out[3] = c3;
+  return ;
+
+} // end philox4x32_RANCOUNTER
+
+
 // ********************************************************
 double interp_SINFUN(double VAL, double *VALREF, double *FUNREF,
 		     char *ABORT_COMMENT) {
@@ -46,6 +46,9 @@
   Jun 15 2022: MXCHARWORD_PARSE_WORDS -> MXPATHLEN + 200 
              (for long rows in FITRES or HOSTLIB)
 
+  Oct 2026: optional counter-based randoms (Philox4x32-10) keyed by
+            (seed, event, stream); see GENRAN_INFO.USE_COUNTER
+
 ********************************************************/
 
 
@@ -230,6 +233,12 @@ char FILTERSTRING[MXFILTINDX] ;
 #define MXSTREAM_RAN    2  // max number of independent streams
 #define BUFSIZE_RAN   256
 
+// Oct 2026: counter-based randoms; one counter stream per RANLIST
+// (1 to MXLIST_RAN) and per unix stream (OFFSET + istream)
+#define ISTREAM_OFFSET_COUNTER  (MXLIST_RAN+1)
+#define MXSTREAM_COUNTER        (MXLIST_RAN+1+MXSTREAM_RAN)
+#define KEY1_COUNTER            0x534E414E   // fixed 2nd key word
+
 struct {
   int     NSTREAM ; // number of srandom streams (legacy is 1)
   double  RANSTORE[MXLIST_RAN+1][MXSTORE_RAN] ;
@@ -257,6 +266,17 @@ struct {
   double NWRAP_SUM[MXLIST_RAN+1] ;
   double NWRAP_SUMSQ[MXLIST_RAN+1] ;
 
+  // Oct 2026: counter-based randoms (Philox4x32-10). The n'th random
+  // in a stream depends only on (seed, IEVT, ITRY, stream, n), so that
+  // any event can be regenerated independently of all other events.
+  int          USE_COUNTER ;      // 1 -> replace RANSTORE and srandom
+  unsigned int KEY_COUNTER[2] ;   // seed, KEY1_COUNTER
+  int          IEVT_COUNTER ;     // event index (0 = init)
+  int          ITRY_COUNTER ;     // repeat index for same IEVT
+  long long    NCALL_COUNTER[MXSTREAM_RAN];  // position in unix streams
+  long long    IBLOCK_COUNTER[MXSTREAM_COUNTER]; // cached block per stream
+  unsigned int OUT_COUNTER[MXSTREAM_COUNTER][4]; // cached block output
+
 } GENRAN_INFO ;
 
 
@@ -890,6 +910,12 @@ void   sumstat_RANLISTs(int FLAG);
 double unix_getRan_Flat1(int istream) ;
 double unix_getRan_Gauss(int istream);
 
+void   init_RANCOUNTER(int ISEED);
+void   event_RANCOUNTER(int IEVT);
+double getRan_RANCOUNTER(int istream_counter, long long n);
+void   philox4x32_RANCOUNTER(unsigned int *ctr, unsigned int *key, 
+			     unsigned int *out);
+
 double getRan_Flat(int ilist, double *range);  //return rnmd on range[0-1]
 double getRan_Flat1(int ilist);          // return 0 < random  < 1
 double getRan_Gauss(int ilist);   // return Gauss randon (sigma=1)
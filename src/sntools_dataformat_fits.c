@@ -69,6 +69,9 @@
  Aug 04 2023: write RA_AVG_[band] and DEC_AVG_[band] for ATMOS
  Dec 22 2023: write SIM_WGT_POPULATION
  Mar 28 2024: add logic to close SPEC file and free SPEC memory to fix memory leak.
+ Oct 2026: buffer HEAD & PHOT rows for NEVT_BUFFER_WR_SNFITSIO events and
+           write each column in one fits_write_col block; report write
+           throughput in WR_SNFITSIO_END.
 
 **************************************************/
 
@@ -81,6 +84,7 @@
 #include "sntools_spectrograph.h"
 
 #include <sys/stat.h>
+#include <sys/time.h>
 
 // ======================================================================
 void WR_SNFITSIO_INIT(char *path, char *version, char *prefix, int writeFlag, 
@@ -110,6 +114,7 @@ void WR_SNFITSIO_INIT(char *path, char *version, char *prefix, int writeFlag,
   // Sep 10 2020: begin refactor with BYOSED -> PySEDMODEL
   // Oct 14 2021: change simFlag to writeFlag that has spectra bit
   // Jul 30 2023: check WRITE_MASK_COMPACT_noFLUXCAL to suppress FLUXCAL[ERR]
+  // Oct 2026: init HEAD & PHOT write buffers
 
   int  MEMC = MXPATHLEN * sizeof(char);
   int  itype, ipar, OVP, lenpath, lenfile, lentot ;
@@ -239,6 +244,19 @@ void WR_SNFITSIO_INIT(char *path, char *version, char *prefix, int writeFlag,
   wr_snfitsio_init_head();
   wr_snfitsio_init_phot();
 
+  // Oct 2026: buffers to write many events per fits_write_col call
+  int NEVT_BUFFER = NEVT_BUFFER_WR_SNFITSIO ;
+  if ( NEVT_BUFFER == 0 ) { NEVT_BUFFER = NEVT_BUFFER_SNFITSIO_DEFAULT; }
+  if ( NEVT_BUFFER <  0 ) { NEVT_BUFFER = 0; }
+  wr_snfitsio_init_buffer(ITYPE_SNFITSIO_HEAD, NEVT_BUFFER);
+  wr_snfitsio_init_buffer(ITYPE_SNFITSIO_PHOT, 
+			  NEVT_BUFFER * NOBS_BUFFER_SNFITSIO);
+  wr_snfitsio_init_buffer(ITYPE_SNFITSIO_SPEC,    0);
+  wr_snfitsio_init_buffer(ITYPE_SNFITSIO_SPECTMP, 0);
+
+  WR_SNFITSIO_STATS.NCALL  = WR_SNFITSIO_STATS.NROW = 0 ;
+  WR_SNFITSIO_STATS.NBYTE  = WR_SNFITSIO_STATS.TWRITE = 0.0 ;
+
   if ( SNFITSIO_SPECTRA_FLAG ) {
     wr_snfitsio_create ( ITYPE_SNFITSIO_SPEC    ) ; 
     wr_snfitsio_create ( ITYPE_SNFITSIO_SPECTMP ) ; 
@@ -2158,33 +2176,29 @@ void wr_snfitsio_fillTable(int *COLNUM, char *parName, int itype ) {
   // Sep 20 2017: define logical ALLOW_BLANK to allow exceptions
   //              for the no-blank rule on strins. See SUBSURVEY.
   //
-  int istat, colnum, firstelem, firstrow, nrow, LEN, OPTMASK ;
-  int LDMP = 0 ;
-  fitsfile *fp ;
-  char *ptrForm, cfirst[2], clast[2] ;
+  // Oct 2026: pick datatype & value pointer, then either store value
+  //           in write buffer or call fits_write_col for this row.
+  //
+  int colnum, firstrow, LEN, OPTMASK ;
+  int datatype = -9, size = 0 ;
+  void *ptrVal = NULL ;
+  char *ptrForm, clast[2] ;
   char fnam[] = "wr_snfitsio_fillTable";
 
   // ------------ BEGIN -----------
 
-  fp    = fp_wr_snfitsio[itype] ;
-
   if ( *COLNUM < 0 ) { 
     OPTMASK = OPTMASK_WR_SNFITSIO + OPTMASK_ABORT_SNFITSIO ;
     *COLNUM = IPAR_SNFITSIO(OPTMASK,parName,itype);
   }
 
   colnum    = *COLNUM ;
-  nrow      = 1 ;
-  firstelem = 1 ;
   firstrow  = WR_SNFITSIO_TABLEVAL[itype].NROW ;
   ptrForm   = WR_SNFITSIO_TABLEDEF[itype].ptrForm[colnum];
   
   LEN = strlen(ptrForm);
-  sprintf(cfirst, "%c",  ptrForm[0] ); // first character only
   sprintf(clast,  "%c",  ptrForm[LEN-1] ); // last char only
 
-  istat     = 0 ;
-
   /*
   printf(" %2d : xxxx colnum = %2d  clast = %s (parName=%s) \n", 
 	 NWR_SNFITSIO, colnum, clast, parName );
@@ -2199,31 +2213,29 @@ void wr_snfitsio_fillTable(int *COLNUM, char *parName, int itype ) {
       sprintf(c2err,"to colnum=%d of table=%s", colnum, snfitsType[itype]);
       errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
     }
-    fits_write_col(fp, TSTRING, colnum, firstrow, firstelem, nrow,
-		   &WR_SNFITSIO_TABLEVAL[itype].value_A, &istat);  
+    datatype = TSTRING ;  size = strlen(A) ;
+    ptrVal   = &WR_SNFITSIO_TABLEVAL[itype].value_A ;
   }
   else if ( strcmp(ptrForm,"1D") == 0 ) {
-    fits_write_col(fp, TDOUBLE, colnum, firstrow, firstelem, nrow,
-		   &WR_SNFITSIO_TABLEVAL[itype].value_1D, &istat);  
+    datatype = TDOUBLE ;  size = sizeof(double);
+    ptrVal   = &WR_SNFITSIO_TABLEVAL[itype].value_1D ;
   }
   else if ( strcmp(ptrForm,"1E") == 0 ) {
-    fits_write_col(fp, TFLOAT, colnum, firstrow, firstelem, nrow,
-		   &WR_SNFITSIO_TABLEVAL[itype].value_1E, &istat);  
+    datatype = TFLOAT ;   size = sizeof(float);
+    ptrVal   = &WR_SNFITSIO_TABLEVAL[itype].value_1E ;
   }
   else if ( strcmp(ptrForm,"1J") == 0 ) {  // 32-bit signed int
-    fits_write_col(fp, TINT, colnum, firstrow, firstelem, nrow,
-		   &WR_SNFITSIO_TABLEVAL[itype].value_1J, &istat);  
+    datatype = TINT ;     size = sizeof(int);
+    ptrVal   = &WR_SNFITSIO_TABLEVAL[itype].value_1J ;
   }
   else if ( strcmp(ptrForm,"1I") == 0 ) {  // 16-bit unsigned int
-    fits_write_col(fp, TSHORT, colnum, firstrow, firstelem, nrow,
-		   &WR_SNFITSIO_TABLEVAL[itype].value_1I, &istat);  
+    datatype = TSHORT ;   size = sizeof(short int);
+    ptrVal   = &WR_SNFITSIO_TABLEVAL[itype].value_1I ;
   }
   else if ( strcmp(ptrForm,"1K") == 0 ) {  // 64 bit long long
-    fits_write_col(fp, TLONGLONG, colnum, firstrow, firstelem, nrow,
-		   &WR_SNFITSIO_TABLEVAL[itype].value_1K, &istat);  
+    datatype = TLONGLONG; size = sizeof(long long);
+    ptrVal   = &WR_SNFITSIO_TABLEVAL[itype].value_1K ;
   }
-
-
   else {
     sprintf(c1err,"Unrecognized Form = '%s' for param='%s' ", 
 	    ptrForm, parName) ;
@@ -2231,16 +2243,192 @@ void wr_snfitsio_fillTable(int *COLNUM, char *parName, int itype ) {
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
   }
 
+  if ( WR_SNFITSIO_BUFFER[itype].NROW_MAX > 0 ) {
+    wr_snfitsio_fillBuffer(itype, colnum, firstrow, datatype, ptrVal);
+    return ;
+  }
+
   sprintf(BANNER,"fits_write_col for %s-param: %s", 
 	  snfitsType[itype], parName );
-
-  snfitsio_errorCheck(BANNER, istat);
+  wr_snfitsio_write_col(itype, datatype, colnum, firstrow, 1, size, 
+			ptrVal, BANNER);
 
   return ;
 
 } //  end of wr_snfitsio_fillTable
 
 
+// ====================================
+void wr_snfitsio_init_buffer(int itype, int NROW_MAX) {
+
+  // Created Oct 2026
+  // Init write buffer for table itype with NROW_MAX rows.
+  // NROW_MAX=0 -> no buffer; each value is written immediately.
+  // Column memory is allocated on first use in wr_snfitsio_fillBuffer.
+
+  SNFITSIO_WRBUFFER_DEF *B = &WR_SNFITSIO_BUFFER[itype] ;
+  int colnum ;
+
+  // ------------ BEGIN -----------
+
+  B->NROW_MAX = NROW_MAX ;
+  B->ROW0     = 1 ;
+  B->PTR_A    = NULL ;
+  for(colnum=0; colnum < MXPAR_SNFITSIO; colnum++ ) {
+    B->NFILL[colnum] = B->SIZE[colnum] = B->DTYPE[colnum] = 0 ;
+    B->BUF[colnum]   = NULL ;
+  }
+
+  if ( NROW_MAX > 0 ) 
+    { B->PTR_A = (char**) malloc(NROW_MAX * sizeof(char*) ); }
+
+  return ;
+
+} // end wr_snfitsio_init_buffer
+
+
+// ====================================
+void wr_snfitsio_fillBuffer(int itype, int colnum, int row,
+			    int datatype, void *ptrVal ) {
+
+  // Created Oct 2026
+  // Store value (*ptrVal) for table row (1,2, ...) and column colnum.
+  // If row is beyond buffer, flush buffer first; rows are filled
+  // in order, so all previous rows are complete.
+
+  SNFITSIO_WRBUFFER_DEF *B = &WR_SNFITSIO_BUFFER[itype] ;
+  int  irow, SIZE ;
+  char *ptr, *ptrForm ;
+  char fnam[] = "wr_snfitsio_fillBuffer" ;
+
+  // ------------ BEGIN -----------
+
+  irow = row - B->ROW0 ;
+  if ( irow >= B->NROW_MAX ) 
+    { wr_snfitsio_flush_buffer(itype);  irow = row - B->ROW0 ; }
+
+  if ( irow < 0 || irow >= B->NROW_MAX ) {
+    sprintf(c1err,"Invalid row=%d for %s buffer (ROW0=%d, NROW_MAX=%d)",
+	    row, snfitsType[itype], B->ROW0, B->NROW_MAX);
+    sprintf(c2err,"colnum=%d", colnum);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+  }
+
+  if ( B->BUF[colnum] == NULL ) {
+    if ( datatype == TSTRING ) {
+      ptrForm = WR_SNFITSIO_TABLEDEF[itype].ptrForm[colnum];
+      SIZE    = atoi(ptrForm) + 1 ;
+      if ( SIZE < 2 ) { SIZE = 2; }
+    }
+    else if ( datatype == TDOUBLE   ) { SIZE = sizeof(double);    }
+    else if ( datatype == TFLOAT    ) { SIZE = sizeof(float);     }
+    else if ( datatype == TINT      ) { SIZE = sizeof(int);       }
+    else if ( datatype == TSHORT    ) { SIZE = sizeof(short int); }
+    else                              { SIZE = sizeof(long long); }
+
+    B->DTYPE[colnum] = datatype ;
+    B->SIZE[colnum]  = SIZE ;
+    B->BUF[colnum]   = (char*) calloc(B->NROW_MAX, SIZE);
+  }
+
+  SIZE = B->SIZE[colnum] ;
+  ptr  = &B->BUF[colnum][irow*SIZE] ;
+
+  if ( datatype == TSTRING ) 
+    { strncpy(ptr, *(char**)ptrVal, SIZE-1);  ptr[SIZE-1] = 0 ; }
+  else 
+    { memcpy(ptr, ptrVal, SIZE); }
+
+  if ( irow >= B->NFILL[colnum] ) { B->NFILL[colnum] = irow + 1; }
+
+  return ;
+
+} // end wr_snfitsio_fillBuffer
+
+
+// ====================================
+void wr_snfitsio_flush_buffer(int itype) {
+
+  // Created Oct 2026
+  // Write buffered rows for each column of table itype with one
+  // fits_write_col call per column, then reset buffer.
+
+  SNFITSIO_WRBUFFER_DEF *B = &WR_SNFITSIO_BUFFER[itype] ;
+  int  NPAR = NPAR_WR_SNFITSIO[itype] ;
+  int  colnum, NFILL, NFILL_MAX = 0, SIZE, irow ;
+  void *ptrVal ;
+  char comment[100];
+
+  // ------------ BEGIN -----------
+
+  if ( B->NROW_MAX == 0 ) { return; }
+
+  for(colnum=1; colnum <= NPAR; colnum++ ) {
+    NFILL = B->NFILL[colnum] ;
+    if ( NFILL == 0 ) { continue; }
+    SIZE  = B->SIZE[colnum] ;
+
+    if ( B->DTYPE[colnum] == TSTRING ) {
+      for(irow=0; irow < NFILL; irow++ ) 
+	{ B->PTR_A[irow] = &B->BUF[colnum][irow*SIZE] ; }
+      ptrVal = B->PTR_A ;
+    }
+    else
+      { ptrVal = B->BUF[colnum] ; }
+
+    sprintf(comment,"flush %s-buffer for %s (%d rows)", 
+	    snfitsType[itype], WR_SNFITSIO_TABLEDEF[itype].name[colnum], 
+	    NFILL);
+    wr_snfitsio_write_col(itype, B->DTYPE[colnum], colnum, B->ROW0, NFILL,
+			  NFILL*SIZE, ptrVal, comment);
+
+    memset(B->BUF[colnum], 0, NFILL*SIZE);
+    if ( NFILL > NFILL_MAX ) { NFILL_MAX = NFILL; }
+    B->NFILL[colnum] = 0 ;
+  }
+
+  B->ROW0 += NFILL_MAX ;
+
+  return ;
+
+} // end wr_snfitsio_flush_buffer
+
+
+// ====================================
+void wr_snfitsio_write_col(int itype, int datatype, int colnum, int firstrow,
+			   int nrow, int size, void *ptrVal, char *comment) {
+
+  // Created Oct 2026
+  // Call fits_write_col and update write-throughput stats for
+  // HEAD & PHOT tables; size is number of bytes for stats.
+
+  fitsfile *fp = fp_wr_snfitsio[itype] ;
+  int  istat = 0, firstelem = 1 ;
+  bool DO_STATS = ( itype <= ITYPE_SNFITSIO_PHOT );
+  struct timeval tv0, tv1 ;
+
+  // ------------ BEGIN -----------
+
+  if ( DO_STATS ) { gettimeofday(&tv0, NULL); }
+
+  fits_write_col(fp, datatype, colnum, firstrow, firstelem, nrow,
+		 ptrVal, &istat);
+  snfitsio_errorCheck(comment, istat);
+
+  if ( DO_STATS ) {
+    gettimeofday(&tv1, NULL);
+    WR_SNFITSIO_STATS.TWRITE += 
+      (double)(tv1.tv_sec - tv0.tv_sec) + 1.0E-6*(tv1.tv_usec - tv0.tv_usec);
+    WR_SNFITSIO_STATS.NCALL++ ;
+    WR_SNFITSIO_STATS.NBYTE += (double)size ;
+    if ( colnum == 1 ) { WR_SNFITSIO_STATS.NROW += nrow; }
+  }
+
+  return ;
+
+} // end wr_snfitsio_write_col
+
+
 void wr_snfitsio_fillTable_filters(int *COLNUM_INDX, char *PREFIX, int ITYPE, float *VAL) {
 
   // Created Aug 4 2023
@@ -2823,8 +3011,9 @@ void WR_SNFITSIO_END(int OPTMASK) {
 
   // Close FITS files
   // Dec 20 2021: pass OPTMASK and check for GZIP flag.
+  // Oct 2026: flush write buffers and print write throughput.
 
-  int istat, extver, ifile, itype, NTYPE, isys ;
+  int istat, extver, ifile, itype, NTYPE, isys, colnum ;
   bool DO_GZIP = ( (OPTMASK & OPTMASK_SNFITSIO_END_GZIP) > 0 ) ;
   fitsfile *fp ;
   char cmd[MXPATHLEN*2];    
@@ -2834,6 +3023,23 @@ void WR_SNFITSIO_END(int OPTMASK) {
 
   printf(" %s: wrote %d events and %d spectra to FITS format\n",
 	 fnam, NSNLC_WR_SNFITSIO_TOT, NSPEC_WR_SNFITSIO_TOT);
+
+  // Oct 2026: flush HEAD & PHOT buffers and report write throughput
+  for ( itype=ITYPE_SNFITSIO_HEAD; itype <= ITYPE_SNFITSIO_PHOT; itype++ ) {
+    wr_snfitsio_flush_buffer(itype);
+    for(colnum=0; colnum < MXPAR_SNFITSIO; colnum++ ) 
+      { free(WR_SNFITSIO_BUFFER[itype].BUF[colnum]); }
+    free(WR_SNFITSIO_BUFFER[itype].PTR_A);
+    wr_snfitsio_init_buffer(itype,0);
+  }
+
+  double TWRITE = WR_SNFITSIO_STATS.TWRITE ;
+  double MBYTE  = WR_SNFITSIO_STATS.NBYTE / 1.0E6 ;
+  double RATE   = ( TWRITE > 0.0 ? MBYTE/TWRITE : 0.0 );
+  printf("\t HEAD+PHOT: %lld rows, %.1f MB in %lld fits_write_col calls, "
+	 "%.2f sec -> %.1f MB/sec  (NROW_BUFFER[PHOT]=%d)\n", 
+	 WR_SNFITSIO_STATS.NROW, MBYTE, WR_SNFITSIO_STATS.NCALL,
+	 TWRITE, RATE, WR_SNFITSIO_BUFFER[ITYPE_SNFITSIO_PHOT].NROW_MAX );
   fflush(stdout);
 
   NTYPE = 2 ; // defult is HEAD + PHOT
@@ -14,6 +14,8 @@
   Mar 07 2022: 
     split IFILE_SNFITSIO into IFILE_RD_SNFITSIO and IFILE_WR_SNFITSIO;
     Same for NFILE_SNFITSIO.
+  Oct 2026: column-major write buffers for HEAD & PHOT tables;
+            see WR_SNFITSIO_BUFFER and NEVT_BUFFER_WR_SNFITSIO.
 
 **************************************************/
 
@@ -142,6 +144,32 @@ struct {
 } WR_SNFITSIO_TABLEVAL[MXTYPE_SNFITSIO] ;  // index is itype
 
 
+// Oct 2026: HEAD & PHOT values are accumulated in column-major buffers
+// and written with one fits_write_col call per column per flush.
+#define NEVT_BUFFER_SNFITSIO_DEFAULT 1000 // events per flush
+#define NOBS_BUFFER_SNFITSIO          100 // PHOT rows per event in buffer
+
+int NEVT_BUFFER_WR_SNFITSIO ; // 0 -> default; <0 -> no buffer (legacy)
+
+typedef struct {
+  int    NROW_MAX ;                // buffer size (rows); 0 -> no buffer
+  int    ROW0 ;                    // table row (1,2,...) of buffer row 0
+  int    DTYPE[MXPAR_SNFITSIO] ;   // cfitsio datatype per column
+  int    SIZE[MXPAR_SNFITSIO] ;    // bytes per value (string: width+1)
+  int    NFILL[MXPAR_SNFITSIO] ;   // number of filled rows per column
+  char  *BUF[MXPAR_SNFITSIO] ;     // NROW_MAX values per column
+  char **PTR_A ;                   // string pointers for fits_write_col
+} SNFITSIO_WRBUFFER_DEF ;
+
+SNFITSIO_WRBUFFER_DEF WR_SNFITSIO_BUFFER[MXTYPE_SNFITSIO] ;
+
+struct {
+  long long NCALL, NROW ;  // fits_write_col calls, rows (HEAD+PHOT)
+  double    NBYTE ;        // bytes passed to fits_write_col
+  double    TWRITE ;       // seconds inside fits_write_col
+} WR_SNFITSIO_STATS ;
+
+
 #define IFORM_A   1
 #define IFORM_1J  2
 #define IFORM_1I  3
@@ -240,6 +268,12 @@ void wr_snfitsio_update_head(void);
 void wr_snfitsio_update_phot(int ep);
 void wr_snfitsio_update_spec(int imjd);
 void wr_snfitsio_fillTable(int *COLNUM, char *parName, int itype );
+void wr_snfitsio_init_buffer(int itype, int NROW_MAX);
+void wr_snfitsio_fillBuffer(int itype, int colnum, int row,
+			    int datatype, void *ptrVal );
+void wr_snfitsio_flush_buffer(int itype);
+void wr_snfitsio_write_col(int itype, int datatype, int colnum, int firstrow,
+			   int nrow, int size, void *ptrVal, char *comment);
 void wr_snfitsio_fillTable_filters (int *COLNUM_INDX, char *PREFIX, int ITYPE, float *VAL) ;
 void wr_snfitsio_fillTable_filtersD(int *COLNUM_INDX, char *PREFIX, int ITYPE, double *VAL) ;
 
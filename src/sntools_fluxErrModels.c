@@ -11,6 +11,8 @@
   Mar 16 2019: 
     refactor INIT_FLUXERRMODEL to use read_GRIDMAP, and to read OPT_EXTRAP.
 
+  Oct 2026: optional REDCOV block structure (e.g., gr:0.2:BAND) 
+
 ****************************************************/
 
 
@@ -506,11 +508,16 @@ int load_REDCOV_FLUXERRMODEL(char *ITEM_REDCOV, char *FIELD) {
   //
   // Function returns istat=0 on valid REDCOV;
   // returns -1 if |REDCOV| > 1. 
+  //
+  // Oct 2026: optional 3rd item selects block structure; e.g.,
+  //   gr:0.2:BAND   -> correlations only within each band
+  //   gr:0.2:SEASON -> correlations only within each season
 
   int  NREDCOV = NREDCOV_FLUXERRMODEL ;
   int  N2, ifilt_obs, NBAND_TMP, iband, INDEX_CHECK, istat=0 ;
+  int  OPT_BLOCK = OPT_BLOCK_REDCOV_NONE ;
   double REDCOV ;
-  char *ptr_BANDSTRING, *ptr_BANDLIST, *ptrSplit2[2];
+  char *ptr_BANDSTRING, *ptr_BANDLIST, *ptrSplit2[3];
   char *ptr_FIELDGRP, *ptr_FIELDLIST, band[2] ;
   char fnam[]= "load_REDCOV_FLUXERRMODEL";
 
@@ -518,18 +525,33 @@ int load_REDCOV_FLUXERRMODEL(char *ITEM_REDCOV, char *FIELD) {
 
   ptrSplit2[0] = (char*)malloc( 40*sizeof(char) );
   ptrSplit2[1] = (char*)malloc( 40*sizeof(char) );
+  ptrSplit2[2] = (char*)malloc( 40*sizeof(char) );
 
   ptr_BANDSTRING = COVINFO_FLUXERRMODEL[NREDCOV].BANDSTRING ;
   ptr_BANDLIST   = COVINFO_FLUXERRMODEL[NREDCOV].BANDLIST ;
   ptr_FIELDGRP   = COVINFO_FLUXERRMODEL[NREDCOV].FIELDGROUP ;
   ptr_FIELDLIST  = COVINFO_FLUXERRMODEL[NREDCOV].FIELDLIST ;
 
-  splitString(ITEM_REDCOV, COLON, fnam, 2, &N2, ptrSplit2);    
+  splitString(ITEM_REDCOV, COLON, fnam, 3, &N2, ptrSplit2);    
   sprintf(ptr_BANDSTRING,  "%s", ITEM_REDCOV );
   sprintf(ptr_BANDLIST,    "%s", ptrSplit2[0] );
   sprintf(ptr_FIELDGRP,    "%s", FIELD);
   sscanf(ptrSplit2[1], "%le", &REDCOV );
 
+  if ( N2 == 3 ) {
+    if ( strcmp(ptrSplit2[2],STRING_BLOCK_REDCOV_BAND) == 0 ) 
+      { OPT_BLOCK = OPT_BLOCK_REDCOV_BAND; }
+    else if ( strcmp(ptrSplit2[2],STRING_BLOCK_REDCOV_SEASON) == 0 ) 
+      { OPT_BLOCK = OPT_BLOCK_REDCOV_SEASON; }
+    else {
+      sprintf(c1err,"Invalid REDCOV block option '%s' in '%s'", 
+	      ptrSplit2[2], ITEM_REDCOV);
+      sprintf(c2err,"Valid block options: %s or %s", 
+	      STRING_BLOCK_REDCOV_BAND, STRING_BLOCK_REDCOV_SEASON);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err ); 
+    }
+  }
+
   if ( fabs(REDCOV) > 1.0000001 ) {
     printf(" ERROR: Invalid REDCOV = %f for BAND=%s FIELDGRP=%s\n",
 	   REDCOV, ptr_BANDLIST, ptr_FIELDGRP ); fflush(stdout);
@@ -540,7 +562,8 @@ int load_REDCOV_FLUXERRMODEL(char *ITEM_REDCOV, char *FIELD) {
   sprintf(ptr_FIELDLIST, "%s", ptr_FIELDGRP);
   set_FIELDLIST_FLUXERRMODEL(ptr_FIELDGRP,ptr_FIELDLIST);
 
-  COVINFO_FLUXERRMODEL[NREDCOV].REDCOV = REDCOV ;
+  COVINFO_FLUXERRMODEL[NREDCOV].REDCOV    = REDCOV ;
+  COVINFO_FLUXERRMODEL[NREDCOV].OPT_BLOCK = OPT_BLOCK ;
   COVINFO_FLUXERRMODEL[NREDCOV].ALL_FIELD = 
     ( strcmp(ptr_FIELDGRP,ALL_STRING) == 0 );
 
@@ -562,7 +585,7 @@ int load_REDCOV_FLUXERRMODEL(char *ITEM_REDCOV, char *FIELD) {
   } // end iband
   
 
-  free(ptrSplit2[0]);      free(ptrSplit2[1]);
+  free(ptrSplit2[0]);  free(ptrSplit2[1]);  free(ptrSplit2[2]);
   NREDCOV_FLUXERRMODEL++ ;
 
   return istat ;
@@ -26,6 +26,7 @@ char VARNAMES_FLUXERRMAP[MXPAR_FLUXERRMAP][20];
 #define MASK_APPLY_DATA_FLUXERRMAP  2
 #define MASK_MONITORCOV_FLUXERRMODEL  128 // monitor REDCOV input
 #define MASK_DUMP_MAP_FLUXERRMODEL    256
+#define MASK_DENSECOV_FLUXERRMODEL    512 // force dense Cholesky for REDCOV
 #define MASK_REQUIRE_DOCANA_FLUXERRMAP  1024 // internally set (Aug 26 2020)
 
 char FILENAME_FLUXERRMAP[MXPATHLEN];
@@ -75,6 +76,15 @@ int NROW_DUMP_FLUXERRMAP;
 int NREDCOV_FLUXERRMODEL ;
 int NREDCOV_CPUWARN;
 // xxx mark #define SNRMIN_REDCOV 2.0 
+
+// Oct 2026: optional block structure for REDCOV; obs in different
+// blocks are uncorrelated. Select with 3rd colon item, e.g. gr:0.2:BAND
+#define OPT_BLOCK_REDCOV_NONE    0  // one block: all obs correlated
+#define OPT_BLOCK_REDCOV_BAND    1  // correlated only within each band
+#define OPT_BLOCK_REDCOV_SEASON  2  // correlated only within each season
+#define STRING_BLOCK_REDCOV_BAND    "BAND"
+#define STRING_BLOCK_REDCOV_SEASON  "SEASON"
+
 struct { 
 
   // variables to init
@@ -83,6 +93,7 @@ struct {
   char   BANDSTRING[40]; // e.g., gr:0.2
   char   BANDLIST[20];   // e.g., gr
   double REDCOV ;        // e.g.  0.2
+  int    OPT_BLOCK ;     // OPT_BLOCK_REDCOV_XXX (Oct 2026)
 
   bool   ALL_FIELD ; // flag for FIELD = 'ALL'
   double SNRMIN;     // sNR cut to apply
@@ -24,6 +24,13 @@
   Mar 05 2024: minor refac; rename IDMAP var -> IMAP for sparse index;
                reserve IDMAP as absolute index. Refac is to avoid confusion.
 
+  Oct 2026: GENPDF_OPTMASK += 16 -> getRan_genPDF uses inverse-CDF 
+            along 1st variable instead of rejection sampling; CDF is 
+            built with interp_GRIDMAP_BATCH and re-used while HOSTLIB 
+            inputs are unchanged. Default is still rejection sampling
+            so that random sequences are unchanged, and because the
+            CDF is rebuilt for each new HOSTLIB input on NDIM>1 maps.
+
  ****************************************************/
 
 #ifndef USE_SUBPROCESS
@@ -140,7 +147,10 @@ void init_genPDF(int OPTMASK, FILE *FP, char *fileName, char *ignoreList) {
     OPT_EXTRAP_GENPDF = 1; 
   }
 
-  if ( (OPTMASK & OPTMASK_GENPDF_SLOW) > 0 ) { 
+  if ( (OPTMASK & OPTMASK_GENPDF_CDF) > 0 ) {
+    printf("\t use inverse-CDF sampling. \n");
+  }
+  else if ( (OPTMASK & OPTMASK_GENPDF_SLOW) > 0 ) { 
     printf("\t skip speed-trick: select regardless of PROB. \n");
   }
   else {
@@ -272,6 +282,11 @@ void init_genPDF(int OPTMASK, FILE *FP, char *fileName, char *ignoreList) {
 
   NMAP_GENPDF = NMAP ;
 
+  for(i=0; i < NMAP; i++ ) {
+    GENPDF[i].NNODE_CDF = 0 ;
+    GENPDF[i].VALID_CDF = false ;
+  }
+
 #ifndef USE_SUBPROCESS
   // - - - - - - - -
   // loop thru maps again and check that extra variables (after 1st column)
@@ -412,6 +427,14 @@ void free_memory_genPDF(void) {
 
     malloc_GRIDMAP(-1, &GENPDF[imap].GRIDMAP, NFUN, NDIM, MAPSIZE);
     for(ivar=0; ivar<NVAR; ivar++ )  { free(GENPDF[imap].VARNAMES[ivar]); }
+
+    if ( GENPDF[imap].NNODE_CDF > 0 ) {
+      free(GENPDF[imap].XNODE_CDF);  free(GENPDF[imap].PROB_CDF);
+      free(GENPDF[imap].CUM_CDF);    free(GENPDF[imap].DATA_CDF);
+      free(GENPDF[imap].ISTAT_CDF);
+      GENPDF[imap].NNODE_CDF = 0 ;
+      GENPDF[imap].VALID_CDF = false ;
+    }
   }
 
   return;
@@ -516,6 +539,8 @@ double getRan_genPDF(char *parName, GENGAUSS_ASYM_DEF *GENGAUSS) {
   // If *parName does not match a GENPDF map, use input *GENGAUSS instead.
   // 
   // Dec 2023: implement PROB_EXPON_REWGT
+  // Oct 2026: if OPTMASK_GENPDF_CDF is set, use inverse-CDF sampling
+  //           (getRan_CDF_genPDF) instead of rejection sampling.
 
   int    KEYSOURCE_GENGAUSS = GENGAUSS->KEYSOURCE ;
   int    IGAL               = SNHOSTGAL.IGAL;
@@ -528,6 +553,7 @@ double getRan_genPDF(char *parName, GENGAUSS_ASYM_DEF *GENGAUSS) {
   int    LDMP = 0 ;
   bool   DO_GENGAUSS; 
   bool   IS_LOGPARAM = false ; // true -> param stored as LOGparam
+  bool   USE_CDF = ( (OPTMASK_GENPDF & OPTMASK_GENPDF_CDF) > 0 );
   char   *MAPNAME, *VARNAME ;
   char fnam[] = "getRan_genPDF";
   
@@ -556,7 +582,14 @@ double getRan_genPDF(char *parName, GENGAUSS_ASYM_DEF *GENGAUSS) {
       // get min/max VALUE range for random selection;
       // function here returns VAL_RANGE
 
-      if ( IS_LOGPARAM ) {
+      if ( USE_CDF ) {
+	// one random per call; no rejection loop below
+	VAL_RANGE[0]  = GENPDF[IMAP].GRIDMAP.VALMIN[0] ;
+	VAL_RANGE[1]  = GENPDF[IMAP].GRIDMAP.VALMAX[0] ;
+	r      = getRan_CDF_genPDF(IMAP, val_inputs, ILIST_RAN);
+	N_ITER = 1 ;
+      }
+      else if ( IS_LOGPARAM ) {
 	VAL_RANGE[0]  = GENPDF[IMAP].GRIDMAP.VALMIN[0] ;
 	VAL_RANGE[1]  = GENPDF[IMAP].GRIDMAP.VALMAX[0] ;
       }
@@ -572,7 +605,7 @@ double getRan_genPDF(char *parName, GENGAUSS_ASYM_DEF *GENGAUSS) {
 	       fnam, VAL_RANGE[0], parName, VAL_RANGE[1] );	       
       }
 
-      while ( prob < prob_ref ) {
+      while ( !USE_CDF && prob < prob_ref ) {
 	prob_ref      = getRan_Flat1(ILIST_RAN); 
 	r             = getRan_Flat(ILIST_RAN, VAL_RANGE);
 	val_inputs[0] = r ;  
@@ -761,6 +794,175 @@ void get_VAL_RANGE_genPDF(int IMAP, double *val_inputs,
   return;
 } // end get_VAL_RANGE_genPDF
 
+
+// ========================================================
+double getRan_CDF_genPDF(int IMAP, double *val_inputs, int ILIST_RAN) {
+
+  // Created Oct 2026
+  // Return random value of 1st map variable using inverse-CDF method.
+  // For fixed HOSTLIB values (val_inputs[1:NDIM-1]), the multi-linear 
+  // map interpolation is linear in the 1st variable between nodes,
+  // so the CDF between nodes is quadratic and is inverted exactly.
+  // If PROB_EXPON_REWGT != 1, nodes are sub-divided to approximate
+  // PROB^EXPON_REWGT as piecewise linear.
+  //
+  // The CDF is re-built only when HOSTLIB inputs change; for 1D maps
+  // the CDF is built only once.
+  //
+  // Inputs:
+  //   IMAP       : sparse integer ID of GRIDMAP
+  //   val_inputs : HOSTLIB values in elements 1 to NDIM-1
+  //   ILIST_RAN  : random list index
+  //
+
+  int    NDIM    = GENPDF[IMAP].GRIDMAP.NDIM ;
+  double ran1    = getRan_Flat1(ILIST_RAN);
+  int    ivar, NNODE, inode, ilo, ihi ;
+  double CUM_TARGET, AREA, P0, P1, DX, SLOPE, TMP, DENOM, t, r ;
+  bool   SAME_INPUTS ;
+
+  // ----------- BEGIN ------------
+
+  SAME_INPUTS = GENPDF[IMAP].VALID_CDF ;
+  for(ivar=1; ivar < NDIM && SAME_INPUTS; ivar++ ) {
+    if ( val_inputs[ivar] != GENPDF[IMAP].VAL_INPUTS_CDF[ivar] ) 
+      { SAME_INPUTS = false; }
+  }
+
+  if ( !SAME_INPUTS ) { build_CDF_genPDF(IMAP, val_inputs); }
+
+  NNODE = GENPDF[IMAP].NNODE_CDF ;
+  if ( NNODE == 1 ) { return GENPDF[IMAP].XNODE_CDF[0]; }
+
+  // binary search for node interval containing CUM_TARGET
+  CUM_TARGET = ran1 * GENPDF[IMAP].CUM_CDF[NNODE-1] ;
+  ilo = 0;  ihi = NNODE-1 ;
+  while ( ihi - ilo > 1 ) {
+    inode = (ilo + ihi) / 2 ;
+    if ( GENPDF[IMAP].CUM_CDF[inode] <= CUM_TARGET ) 
+      { ilo = inode; }
+    else
+      { ihi = inode; }
+  }
+
+  // solve AREA = P0*t + 0.5*SLOPE*t^2 for t within interval;
+  // use form that is stable for SLOPE -> 0
+  AREA  = CUM_TARGET - GENPDF[IMAP].CUM_CDF[ilo] ;
+  P0    = GENPDF[IMAP].PROB_CDF[ilo] ;
+  P1    = GENPDF[IMAP].PROB_CDF[ilo+1] ;
+  DX    = GENPDF[IMAP].XNODE_CDF[ilo+1] - GENPDF[IMAP].XNODE_CDF[ilo] ;
+  SLOPE = (P1 - P0) / DX ;
+  TMP   = P0*P0 + 2.0*SLOPE*AREA ;
+  if ( TMP < 0.0 ) { TMP = 0.0 ; }
+  DENOM = P0 + sqrt(TMP) ;
+
+  if ( DENOM > 0.0 ) { t = 2.0*AREA / DENOM ; }
+  else               { t = 0.0 ; }
+
+  if ( t > DX  ) { t = DX ; }
+  if ( t < 0.0 ) { t = 0.0; }
+
+  r = GENPDF[IMAP].XNODE_CDF[ilo] + t ;
+  return r ;
+
+} // end getRan_CDF_genPDF
+
+
+// ========================================================
+void build_CDF_genPDF(int IMAP, double *val_inputs) {
+
+  // Created Oct 2026
+  // Evaluate PROB on nodes along 1st map variable (using
+  // interp_GRIDMAP_BATCH), and store cumulative integral 
+  // (trapezoid rule, exact for linear PROB between nodes).
+  // val_inputs[1:NDIM-1] are the HOSTLIB values.
+
+  GRIDMAP_DEF *GRIDMAP = &GENPDF[IMAP].GRIDMAP ;
+  int    NDIM        = GRIDMAP->NDIM ;
+  int    NBIN        = GRIDMAP->NBIN[0] ;
+  double VALMIN      = GRIDMAP->VALMIN[0] ;
+  double VALMAX      = GRIDMAP->VALMAX[0] ;
+  double EXPON_REWGT = GENPDF[IMAP].PROB_EXPON_REWGT ;
+  int    NSUB        = 1 ;
+  int    NNODE, inode, ivar, NERR, MEMD, MEMI ;
+  double DX, x, prob ;
+  char fnam[] = "build_CDF_genPDF" ;
+
+  // ----------- BEGIN ------------
+
+  if ( EXPON_REWGT != 1.0 ) { NSUB = NSUB_CDF_GENPDF ; }
+  NNODE = (NBIN-1)*NSUB + 1 ;
+
+  if ( GENPDF[IMAP].NNODE_CDF == 0 ) {
+    MEMD = NNODE * sizeof(double);
+    MEMI = NNODE * sizeof(int);
+    GENPDF[IMAP].XNODE_CDF = (double*)malloc(MEMD);
+    GENPDF[IMAP].PROB_CDF  = (double*)malloc(MEMD);
+    GENPDF[IMAP].CUM_CDF   = (double*)malloc(MEMD);
+    GENPDF[IMAP].DATA_CDF  = (double*)malloc(MEMD*NDIM);
+    GENPDF[IMAP].ISTAT_CDF = (int   *)malloc(MEMI);
+  }
+  GENPDF[IMAP].NNODE_CDF = NNODE ;
+
+  DX = 0.0 ;
+  if ( NNODE > 1 ) { DX = (VALMAX - VALMIN) / (double)(NNODE-1) ; }
+
+  for(inode=0; inode < NNODE; inode++ ) {
+    x = VALMIN + DX*(double)inode ;
+    if ( inode == NNODE-1 ) { x = VALMAX; }
+    GENPDF[IMAP].XNODE_CDF[inode]        = x ;
+    GENPDF[IMAP].DATA_CDF[inode*NDIM+0]  = x ;
+    for(ivar=1; ivar < NDIM; ivar++ ) 
+      { GENPDF[IMAP].DATA_CDF[inode*NDIM+ivar] = val_inputs[ivar]; }
+  }
+
+  NERR = interp_GRIDMAP_BATCH(GRIDMAP, NNODE, GENPDF[IMAP].DATA_CDF,
+			      GENPDF[IMAP].PROB_CDF, GENPDF[IMAP].ISTAT_CDF);
+
+  if ( NERR > 0 ) {
+    print_preAbort_banner(fnam);
+    for(ivar=0; ivar < NDIM; ivar++ ) {
+      printf("   %s = %f  [mapRange: %.2f to %.2f]\n", 
+	     GENPDF[IMAP].VARNAMES[ivar], val_inputs[ivar],
+	     GRIDMAP->VALMIN[ivar], GRIDMAP->VALMAX[ivar] );
+    }
+    sprintf(c1err,"interp_GRIDMAP_BATCH returned %d errors (%d nodes)", 
+	    NERR, NNODE);
+    sprintf(c2err,"Value probably outside GENPDF map range");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  GENPDF[IMAP].CUM_CDF[0] = 0.0 ;
+  for(inode=0; inode < NNODE; inode++ ) {
+    prob = GENPDF[IMAP].PROB_CDF[inode] ;
+    if ( prob < 0.0 ) { prob = 0.0 ; } // negative PROB is never selected
+    if ( EXPON_REWGT != 1.0 )  { prob = pow(prob,EXPON_REWGT); }
+    GENPDF[IMAP].PROB_CDF[inode] = prob ;
+    if ( inode > 0 ) {
+      GENPDF[IMAP].CUM_CDF[inode] = GENPDF[IMAP].CUM_CDF[inode-1] + 
+	0.5 * DX * (GENPDF[IMAP].PROB_CDF[inode-1] + prob) ;
+    }
+  }
+
+  if ( NNODE > 1 && GENPDF[IMAP].CUM_CDF[NNODE-1] <= 0.0 ) {
+    print_preAbort_banner(fnam);
+    for(ivar=1; ivar < NDIM; ivar++ ) {
+      printf("   %s = %f \n", GENPDF[IMAP].VARNAMES[ivar], val_inputs[ivar]);
+    }
+    sprintf(c1err,"PROB=0 everywhere for %s (%d nodes)", 
+	    GENPDF[IMAP].MAPNAME, NNODE);
+    sprintf(c2err,"Check map, or consider GENPDF_OPTMASK to extrapolate.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  for(ivar=1; ivar < NDIM; ivar++ ) 
+    { GENPDF[IMAP].VAL_INPUTS_CDF[ivar] = val_inputs[ivar]; }
+  GENPDF[IMAP].VALID_CDF = true ;
+
+  return;
+
+} // end build_CDF_genPDF
+
 // ==========================================================
 int IMAP_GENPDF(char *parName, bool *FOUND_LOGPARAM) {
 
@@ -3,6 +3,7 @@
 
   Oct 22 2020: MXITER_GENPDF -> 1000 (was 200)
   Apr 18 2022: MXVAR_GENPDF -> 20 (was 10)
+  Oct 2026: opt-in inverse-CDF sampling; see OPTMASK_GENPDF_CDF
 
  *******************************/
 
@@ -16,6 +17,9 @@
 #define  OPTMASK_GENPDF_SLOW          2  // use full val range
 #define  OPTMASK_GENPDF_KEYSOURCE_ARG 4  // arg is from command line
 #define  OPTMASK_GENPDF_EXTERNAL_FP   8
+#define  OPTMASK_GENPDF_CDF          16  // inverse-CDF instead of rejection
+
+#define NSUB_CDF_GENPDF  8  // CDF nodes per map bin if PROB_EXPON_REWGT != 1
 
 int      NMAP_GENPDF;
 int      NCALL_GENPDF ;
@@ -37,6 +41,16 @@ struct {
   // option to rewgot PROB -> PROB^PROB_EXPON_REWGT
   double PROB_EXPON_REWGT;
 
+  // Oct 2026: inverse-CDF along 1st variable for current HOSTLIB inputs
+  int    NNODE_CDF ;     // number of nodes along 1st variable
+  double *XNODE_CDF ;    // value of 1st variable at each node
+  double *PROB_CDF ;     // PROB at each node
+  double *CUM_CDF ;      // cumulative integral of PROB at each node
+  double *DATA_CDF ;     // interp inputs [inode*NDIM + idim]
+  int    *ISTAT_CDF ;    // interp status per node
+  double VAL_INPUTS_CDF[MXVAR_GENPDF]; // HOSTLIB inputs used for CDF
+  bool   VALID_CDF ;     // true -> CDF is valid for VAL_INPUTS_CDF
+
 } GENPDF[MXMAP_GENPDF] ;
 
 float TMPSTORE_PROB_REF_GENPDF[MXITER_GENPDF];
@@ -55,6 +69,8 @@ double getRan_genPDF(char *parName, GENGAUSS_ASYM_DEF *GENGAUSS);
 double funVal_genPDF(char *parName, double x, GENGAUSS_ASYM_DEF *GENGAUSS); 
 void   get_VAL_RANGE_genPDF(int IDMAP, double *val_inputs, double *VAL_RANGE, 
 			    int dumpFlag);
+void   build_CDF_genPDF(int IMAP, double *val_inputs);
+double getRan_CDF_genPDF(int IMAP, double *val_inputs, int ILIST_RAN);
 void   free_memory_genPDF(void); // release memory of all genPDF maps
 
 int  IMAP_GENPDF(char *parName, bool *LOGPARAM);
@@ -89,6 +89,12 @@
    + refactor correlated Gauss randoms to use init_Cholesky and
      GaussRanCorr utilities.
 
+ Oct 2026
+   + optional per-event cache of the smear surface on a lambda grid
+     (plus Trest grid for USRFUN); see init_genSmear_cache and
+     sim-input key GENMAG_SMEAR_CACHE: <DLAM> <TOL>.
+   + model dispatch moved from get_genSmear to get_genSmear_model.
+
 **********************************/
 
 #include "fitsio.h"
@@ -103,6 +109,7 @@
 
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
+#include <time.h>
 
 
 // ===========================================================
@@ -167,6 +174,8 @@ void  init_genSmear_FLAGS(int MSKOPT, char *SCALE_STRING) {
   int MEMD = MXLAM_GENSMEAR_SALT2*sizeof(double);
   GENSMEAR.MAGSMEAR_LIST = (double*) malloc(MEMD);
 
+  GENSMEAR_CACHE.USE = 0 ; // Oct 2026
+
 
   init_genSmear_SCALE(SCALE_STRING);
 
@@ -281,6 +290,7 @@ void load_genSmear_randoms(int CID, double gmin, double gmax, double RANFIX) {
   // ------------- BEGIN ------------
 
   GENSMEAR.CID = CID;
+  reset_genSmear_cache(); // new randoms -> new smear surface
 
   // generate Guassian randoms for intrinsic scatter [genSmear] model
   if ( NRANGauss < MXFILTINDX-1 ) { NRANGauss = MXFILTINDX-1; } 
@@ -346,6 +356,9 @@ void get_genSmear(double *parList, int NLam, double *Lam,
   // Nov 30 2019: MAGSMEAR_COH -> MAGSMEAR_COH[2]
   // Feb 17 2020: add c & x1 input args
   // May 31 2021: refactor to pass parList that includes logMass
+  // Oct 2026: 
+  //   + move model dispatch to get_genSmear_model()
+  //   + check GENSMEAR_CACHE option to interpolate from per-event grid
 
   double Trest   = parList[0];
   double x1      = parList[1];
@@ -369,6 +382,43 @@ void get_genSmear(double *parList, int NLam, double *Lam,
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
   }
 
+  if ( GENSMEAR_CACHE.USE ) 
+    { get_genSmear_cache(Trest, NLam, Lam, magSmear); }
+  else
+    { get_genSmear_model(Trest, NLam, Lam, magSmear); }
+
+  // Mar 2020: check option to scale the smearing vs. c & x1
+  if ( GENSMEAR_SCALE.USE ) {    
+    double SCALE = get_genSmear_SCALE(parList);
+    for(ilam=0; ilam < NLam; ilam++ ) { magSmear[ilam] *= SCALE ; }
+  }
+
+
+ SET_LAST:
+  GENSMEAR.CID_LAST    = GENSMEAR.CID ;
+  GENSMEAR.TREST_LAST  = Trest;
+  GENSMEAR.NLAM_LAST   = NLam ;
+  GENSMEAR.LAMMIN_LAST = Lam[0]; 
+  GENSMEAR.LAMMAX_LAST = Lam[NLam-1];
+
+  return ;
+
+} // end of get_genSmear
+
+
+// ********************************
+void get_genSmear_model(double Trest, int NLam, double *Lam, 
+			double *magSmear) {
+
+  // Created Oct 2026 (moved from get_genSmear)
+  // Evaluate initialized smear model at each *Lam; 
+  // GENSMEAR_SCALE is NOT applied here.
+
+  int ilam;
+  char fnam[] = "get_genSmear_model" ;
+
+  // -------------- BEGIN -----------
+
   GENSMEAR.MAGSMEAR_COH[0] = 0.0 ;
   GENSMEAR.MAGSMEAR_COH[1] = 0.0 ;
 
@@ -410,24 +460,9 @@ void get_genSmear(double *parList, int NLam, double *Lam,
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
   }
 
-
-  // Mar 2020: check option to scale the smearing vs. c & x1
-  if ( GENSMEAR_SCALE.USE ) {    
-    double SCALE = get_genSmear_SCALE(parList);
-    for(ilam=0; ilam < NLam; ilam++ ) { magSmear[ilam] *= SCALE ; }
-  }
-
-
- SET_LAST:
-  GENSMEAR.CID_LAST    = GENSMEAR.CID ;
-  GENSMEAR.TREST_LAST  = Trest;
-  GENSMEAR.NLAM_LAST   = NLam ;
-  GENSMEAR.LAMMIN_LAST = Lam[0]; 
-  GENSMEAR.LAMMAX_LAST = Lam[NLam-1];
-
   return ;
 
-} // end of get_genSmear
+} // end of get_genSmear_model
 
 
 // ********************************************************
@@ -478,6 +513,390 @@ int repeat_genSmear(double Trest, int NLam, double *Lam) {
 } // end repeat_genSmear
 
 
+// ********************************************************
+void init_genSmear_cache(double DLAM, double TOL, double *LAMRANGE) {
+
+  // Created Oct 2026
+  // Init optional per-event cache of the smear surface.
+  // Inputs:
+  //   DLAM     : lambda bin size (A) of cache grid; 0 -> no cache
+  //   TOL      : max allowed |cache - exact| (mag)
+  //   LAMRANGE : rest-frame lambda range of cache grid
+  //
+  // Only USRFUN depends on Trest; other models are stored
+  // with a single Trest row.
+
+  int NLAM, NTREST, NFILL, ilam, it ;
+  double LAM ;
+  char fnam[] = "init_genSmear_cache" ;
+
+  // ------------ BEGIN -------------
+
+  GENSMEAR_CACHE.USE = 0 ;
+  if ( DLAM < 1.0E-9      ) { return ; }
+  if ( GENSMEAR.NUSE == 0 ) { return ; }
+
+  // COVSED debug is evaluated only at exact peak; skip cache
+  if ( GENSMEAR_COVSED.USE && GENSMEAR_COVSED.LAMPAIR_DEBUG[0] > 0.0 ) {
+    printf("\t Disable GENMAG_SMEAR_CACHE for COVSED LAMPAIR debug.\n");
+    return ;
+  }
+
+  if ( TOL <= 0.0 ) {
+    sprintf(c1err,"Invalid GENMAG_SMEAR_CACHE TOL = %f", TOL);
+    sprintf(c2err,"TOL must be > 0 (mag)");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
+  // grid stays inside LAMRANGE where the model is defined
+  NLAM   = (int)((LAMRANGE[1] - LAMRANGE[0])/DLAM) + 1 ;
+  if ( NLAM < 2 ) {
+    sprintf(c1err,"GENMAG_SMEAR_CACHE DLAM=%.1f too large for", DLAM);
+    sprintf(c2err,"LAMRANGE = %.1f to %.1f", LAMRANGE[0], LAMRANGE[1]);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+  NTREST = 1 ;
+  GENSMEAR_CACHE.USE_TREST = GENSMEAR_USRFUN.USE ;
+  if ( GENSMEAR_CACHE.USE_TREST ) {
+    NTREST = (int)((TRESTMAX_GENSMEAR_CACHE - TRESTMIN_GENSMEAR_CACHE)/
+		   DTREST_GENSMEAR_CACHE) + 1 ;
+  }
+
+  GENSMEAR_CACHE.USE    = 1 ;
+  GENSMEAR_CACHE.DLAM   = DLAM ;
+  GENSMEAR_CACHE.DTREST = DTREST_GENSMEAR_CACHE ;
+  GENSMEAR_CACHE.TOL    = TOL ;
+  GENSMEAR_CACHE.NLAM   = NLAM ;
+  GENSMEAR_CACHE.NTREST = NTREST ;
+  GENSMEAR_CACHE.LAMMIN = LAMRANGE[0] ;
+  GENSMEAR_CACHE.LAMMAX = LAMRANGE[0] + DLAM*(double)(NLAM-1) ;
+
+  // fill-wavelengths are nodes plus midpoints
+  NFILL = 2*NLAM - 1 ;
+  GENSMEAR_CACHE.LAM_FILL = (double*) malloc(NFILL*sizeof(double));
+  GENSMEAR_CACHE.MAG_FILL = (double*) malloc(NFILL*sizeof(double));
+  for(ilam=0; ilam < NFILL; ilam++ ) {
+    LAM = LAMRANGE[0] + 0.5*DLAM*(double)ilam ;
+    GENSMEAR_CACHE.LAM_FILL[ilam] = LAM ;
+  }
+
+  // rows are allocated when first filled
+  GENSMEAR_CACHE.MAGSMEAR  = (double**) malloc(NTREST*sizeof(double*));
+  GENSMEAR_CACHE.EXACT     = (char  **) malloc(NTREST*sizeof(char*));
+  GENSMEAR_CACHE.STAMP_ROW = (int    *) malloc(NTREST*sizeof(int));
+  for(it=0; it < NTREST; it++ ) {
+    GENSMEAR_CACHE.MAGSMEAR[it]  = NULL ;
+    GENSMEAR_CACHE.EXACT[it]     = NULL ;
+    GENSMEAR_CACHE.STAMP_ROW[it] = 0 ;
+  }
+  GENSMEAR_CACHE.STAMP = 1 ;
+
+  GENSMEAR_CACHE.MXLAM_TMP = 0 ;
+  GENSMEAR_CACHE.ILAM_TMP  = NULL ;
+  GENSMEAR_CACHE.LAM_TMP   = NULL ;
+  GENSMEAR_CACHE.MAG_TMP   = NULL ;
+  GENSMEAR_CACHE.MAG_CHECK = NULL ;
+
+  GENSMEAR_CACHE.NCALL = GENSMEAR_CACHE.NLAM_HIT = 0.0 ;
+  GENSMEAR_CACHE.NLAM_MISS = GENSMEAR_CACHE.NLAM_EXACT = 0.0 ;
+  GENSMEAR_CACHE.NFILL = GENSMEAR_CACHE.NCHECK = 0.0 ;
+  GENSMEAR_CACHE.T_HIT = GENSMEAR_CACHE.T_FILL = 0.0 ;
+  GENSMEAR_CACHE.T_EXACT = GENSMEAR_CACHE.MAXDIF_CHECK = 0.0 ;
+
+  printf("\t GENMAG_SMEAR_CACHE: %d lam bins (%.0f-%.0f A, DLAM=%.1f) x "
+	 "%d Trest bins, TOL=%.4f mag\n",
+	 NLAM, GENSMEAR_CACHE.LAMMIN, GENSMEAR_CACHE.LAMMAX, DLAM, 
+	 NTREST, TOL );
+  fflush(stdout);
+
+  return ;
+
+} // end init_genSmear_cache
+
+
+// ********************************************************
+void reset_genSmear_cache(void) {
+  // Created Oct 2026: invalidate cached smear for new event.
+  if ( GENSMEAR_CACHE.USE ) { GENSMEAR_CACHE.STAMP++ ; }
+} // end reset_genSmear_cache
+
+
+// ********************************************************
+void fill_genSmear_cache(int ITREST) {
+
+  // Created Oct 2026
+  // Evaluate smear model for row ITREST at grid nodes and midpoints.
+  // Flag cells where the linear interpolation misses the midpoint 
+  // by more than TOL/2 (e.g., SALT2 jump at edge of lambda range)
+  // so that get_genSmear_cache evaluates these cells exactly.
+
+  int    NLAM  = GENSMEAR_CACHE.NLAM ;
+  int    NFILL = 2*NLAM - 1 ;
+  double *MAG  = GENSMEAR_CACHE.MAG_FILL ;
+  double Trest = 0.0 ;
+  double t0    = time_genSmear_cache();
+  int    ilam ;
+  double avg, dif;
+
+  // ------------ BEGIN -------------
+
+  if ( GENSMEAR_CACHE.USE_TREST ) {
+    Trest = TRESTMIN_GENSMEAR_CACHE + 
+      GENSMEAR_CACHE.DTREST * (double)ITREST ;
+  }
+
+  if ( GENSMEAR_CACHE.MAGSMEAR[ITREST] == NULL ) {
+    GENSMEAR_CACHE.MAGSMEAR[ITREST] = (double*)malloc(NLAM*sizeof(double));
+    GENSMEAR_CACHE.EXACT[ITREST]    = (char  *)malloc(NLAM*sizeof(char));
+  }
+
+  get_genSmear_model(Trest, NFILL, GENSMEAR_CACHE.LAM_FILL, MAG);
+
+  for(ilam=0; ilam < NLAM; ilam++ ) {
+    GENSMEAR_CACHE.MAGSMEAR[ITREST][ilam] = MAG[2*ilam] ;
+    GENSMEAR_CACHE.EXACT[ITREST][ilam]    = 0 ;
+    if ( ilam == NLAM-1 ) { continue; }
+    avg = 0.5 * ( MAG[2*ilam] + MAG[2*ilam+2] ) ;
+    dif = fabs(MAG[2*ilam+1] - avg);
+    if ( dif > 0.5*GENSMEAR_CACHE.TOL ) 
+      { GENSMEAR_CACHE.EXACT[ITREST][ilam] = 1 ; }
+  }
+
+  GENSMEAR_CACHE.STAMP_ROW[ITREST] = GENSMEAR_CACHE.STAMP ;
+  GENSMEAR_CACHE.NFILL++ ;
+  GENSMEAR_CACHE.T_FILL += ( time_genSmear_cache() - t0 );
+
+  return ;
+
+} // end fill_genSmear_cache
+
+
+// ********************************************************
+void get_genSmear_cache(double Trest, int NLam, double *Lam, 
+			double *magSmear) {
+
+  // Created Oct 2026
+  // Return unscaled magSmear at each *Lam by interpolating the
+  // per-event cache grid. Lambda (or Trest) outside the grid, and
+  // cells flagged in fill_genSmear_cache, are evaluated exactly 
+  // in one call to the smear model.
+
+  int    NLAM   = GENSMEAR_CACHE.NLAM ;
+  int    IT = 0, NROW = 1, NEXACT = 0, ilam, il, MEMI, MEMD ;
+  double DLAM   = GENSMEAR_CACHE.DLAM ;
+  double LAMMIN = GENSMEAR_CACHE.LAMMIN ;
+  double fT = 0.0, x, f, m0, m1 ;
+  double *ROW0, *ROW1 ;
+  char   *EX0,  *EX1 ;
+  double t0, t1;
+
+  // ------------ BEGIN -------------
+
+  GENSMEAR_CACHE.NCALL++ ;
+
+  if ( NLam > GENSMEAR_CACHE.MXLAM_TMP ) {
+    MEMI = NLam * sizeof(int);  MEMD = NLam * sizeof(double);
+    GENSMEAR_CACHE.MXLAM_TMP = NLam ;
+    GENSMEAR_CACHE.ILAM_TMP  = (int   *)realloc(GENSMEAR_CACHE.ILAM_TMP, MEMI);
+    GENSMEAR_CACHE.LAM_TMP   = (double*)realloc(GENSMEAR_CACHE.LAM_TMP,  MEMD);
+    GENSMEAR_CACHE.MAG_TMP   = (double*)realloc(GENSMEAR_CACHE.MAG_TMP,  MEMD);
+    GENSMEAR_CACHE.MAG_CHECK = (double*)realloc(GENSMEAR_CACHE.MAG_CHECK,MEMD);
+  }
+
+  if ( GENSMEAR_CACHE.USE_TREST ) {
+    x  = (Trest - TRESTMIN_GENSMEAR_CACHE) / GENSMEAR_CACHE.DTREST ;
+    IT = (int)x ;
+    if ( x < 0.0 || IT+1 >= GENSMEAR_CACHE.NTREST ) {
+      GENSMEAR_CACHE.NLAM_MISS += (double)NLam ;
+      exact_genSmear_cache(Trest, NLam, Lam, magSmear);
+      return ;
+    }
+    fT = x - (double)IT ;  NROW = 2;
+  }
+
+  if ( GENSMEAR_CACHE.STAMP_ROW[IT] != GENSMEAR_CACHE.STAMP ) 
+    { fill_genSmear_cache(IT); }
+  if ( NROW == 2 && GENSMEAR_CACHE.STAMP_ROW[IT+1] != GENSMEAR_CACHE.STAMP ) 
+    { fill_genSmear_cache(IT+1); }
+
+  t0   = time_genSmear_cache();
+  ROW0 = ROW1 = GENSMEAR_CACHE.MAGSMEAR[IT] ;
+  EX0  = EX1  = GENSMEAR_CACHE.EXACT[IT] ;
+  if ( NROW == 2 ) {
+    ROW1 = GENSMEAR_CACHE.MAGSMEAR[IT+1] ;
+    EX1  = GENSMEAR_CACHE.EXACT[IT+1] ;
+  }
+
+  for(ilam=0; ilam < NLam; ilam++ ) {
+    x  = (Lam[ilam] - LAMMIN) / DLAM ;
+    il = (int)x ;
+    if ( x < 0.0 || il+1 >= NLAM || EX0[il] || EX1[il] ) {
+      GENSMEAR_CACHE.ILAM_TMP[NEXACT] = ilam ;
+      GENSMEAR_CACHE.LAM_TMP[NEXACT]  = Lam[ilam] ;
+      NEXACT++ ;  continue ;
+    }
+    f  = x - (double)il ;
+    m0 = ROW0[il] + f * (ROW0[il+1] - ROW0[il]) ;
+    m1 = ROW1[il] + f * (ROW1[il+1] - ROW1[il]) ;
+    magSmear[ilam] = m0 + fT * (m1 - m0) ;
+  }
+
+  t1 = time_genSmear_cache();
+  GENSMEAR_CACHE.T_HIT     += (t1 - t0) ;
+  GENSMEAR_CACHE.NLAM_HIT  += (double)(NLam - NEXACT) ;
+  GENSMEAR_CACHE.NLAM_MISS += (double)NEXACT ;
+
+  if ( NEXACT > 0 ) {
+    exact_genSmear_cache(Trest, NEXACT, GENSMEAR_CACHE.LAM_TMP, 
+			 GENSMEAR_CACHE.MAG_TMP);
+    for(ilam=0; ilam < NEXACT; ilam++ ) {
+      il = GENSMEAR_CACHE.ILAM_TMP[ilam] ;
+      magSmear[il] = GENSMEAR_CACHE.MAG_TMP[ilam] ;
+    }
+  }
+
+  // periodic comparison with exact calculation
+  if ( ((long long)GENSMEAR_CACHE.NCALL % NHIT_CHECK_GENSMEAR_CACHE) == 1 ) 
+    { check_genSmear_cache(Trest, NLam, Lam, magSmear); }
+
+  return ;
+
+} // end get_genSmear_cache
+
+
+// ********************************************************
+void exact_genSmear_cache(double Trest, int NLam, double *Lam, 
+			  double *magSmear) {
+  // Created Oct 2026: exact smear model, with timing to estimate 
+  //   time saved by the cache.
+  double t0 = time_genSmear_cache();
+  get_genSmear_model(Trest, NLam, Lam, magSmear);
+  GENSMEAR_CACHE.NLAM_EXACT += (double)NLam ;
+  GENSMEAR_CACHE.T_EXACT    += ( time_genSmear_cache() - t0 );
+} // end exact_genSmear_cache
+
+
+// ********************************************************
+void check_genSmear_cache(double Trest, int NLam, double *Lam, 
+			  double *magSmear) {
+
+  // Created Oct 2026
+  // Compare cached *magSmear with exact calculation; 
+  // abort if any difference exceeds TOL.
+
+  double *MAG_CHECK = GENSMEAR_CACHE.MAG_CHECK ;
+  double TOL = GENSMEAR_CACHE.TOL ;
+  double dif, difmax = 0.0 ;
+  int    ilam, ilam_max = 0 ;
+  char fnam[] = "check_genSmear_cache" ;
+
+  // ------------ BEGIN -------------
+
+  exact_genSmear_cache(Trest, NLam, Lam, MAG_CHECK);
+  GENSMEAR_CACHE.NCHECK++ ;
+
+  for(ilam=0; ilam < NLam; ilam++ ) {
+    dif = fabs(magSmear[ilam] - MAG_CHECK[ilam]) ;
+    if ( dif > difmax ) { difmax = dif;  ilam_max = ilam; }
+  }
+
+  if ( difmax > GENSMEAR_CACHE.MAXDIF_CHECK ) 
+    { GENSMEAR_CACHE.MAXDIF_CHECK = difmax ; }
+
+  if ( difmax > TOL ) {
+    print_preAbort_banner(fnam);
+    printf("   CID=%d  Trest=%.2f  Lam=%.1f \n", 
+	   GENSMEAR.CID, Trest, Lam[ilam_max] );
+    printf("   magSmear(cache) = %f \n", magSmear[ilam_max] );
+    printf("   magSmear(exact) = %f \n", MAG_CHECK[ilam_max] );
+    sprintf(c1err,"GENMAG_SMEAR_CACHE |cache-exact| = %.5f > TOL=%.5f",
+	    difmax, TOL);
+    sprintf(c2err,"Reduce DLAM (=%.1f) or increase TOL.", 
+	    GENSMEAR_CACHE.DLAM);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
+  return ;
+
+} // end check_genSmear_cache
+
+
+// ********************************************************
+void summary_genSmear_cache(void) {
+
+  // Created Oct 2026
+  // Print cache hit rate and estimated time saved, where the 
+  // exact cost per lambda bin is measured from exact evaluations.
+
+  double NHIT  = GENSMEAR_CACHE.NLAM_HIT ;
+  double NMISS = GENSMEAR_CACHE.NLAM_MISS ;
+  double T_LAM = 0.0, T_SAVE ;
+
+  // ------------ BEGIN -------------
+
+  if ( !GENSMEAR_CACHE.USE ) { return ; }
+
+  if ( GENSMEAR_CACHE.NLAM_EXACT > 0.0 ) 
+    { T_LAM = GENSMEAR_CACHE.T_EXACT / GENSMEAR_CACHE.NLAM_EXACT ; }
+  T_SAVE = NHIT*T_LAM - GENSMEAR_CACHE.T_HIT - GENSMEAR_CACHE.T_FILL ;
+
+  printf("  GENMAG_SMEAR_CACHE (DLAM=%.1f A, TOL=%.4f mag): \n",
+	 GENSMEAR_CACHE.DLAM, GENSMEAR_CACHE.TOL );
+  printf("    %.0f calls, %.0f lam bins interpolated, %.0f exact "
+	 "(%.2f%% hit)\n",
+	 GENSMEAR_CACHE.NCALL, NHIT, NMISS, 
+	 100.0*NHIT/(NHIT+NMISS+1.0E-9) );
+  printf("    %.0f grid fills (%.3f sec), interpolation %.3f sec \n",
+	 GENSMEAR_CACHE.NFILL, GENSMEAR_CACHE.T_FILL, GENSMEAR_CACHE.T_HIT);
+  printf("    exact model %.3e sec/lam-bin -> est. time saved: %.2f sec\n",
+	 T_LAM, T_SAVE );
+  printf("    max |cache-exact| in %.0f checks: %.2e mag \n",
+	 GENSMEAR_CACHE.NCHECK, GENSMEAR_CACHE.MAXDIF_CHECK );
+  fflush(stdout);
+
+  return ;
+
+} // end summary_genSmear_cache
+
+
+// ********************************************************
+void get_genSmear_cache_stats(double *STATS) {
+  // Created Oct 2026: load cache stats into STATS[NSTAT_GENSMEAR_CACHE]
+  STATS[0] = GENSMEAR_CACHE.NCALL ;
+  STATS[1] = GENSMEAR_CACHE.NLAM_HIT ;
+  STATS[2] = GENSMEAR_CACHE.NLAM_MISS ;
+  STATS[3] = GENSMEAR_CACHE.NLAM_EXACT ;
+  STATS[4] = GENSMEAR_CACHE.NFILL ;
+  STATS[5] = GENSMEAR_CACHE.NCHECK ;
+  STATS[6] = GENSMEAR_CACHE.T_HIT ;
+  STATS[7] = GENSMEAR_CACHE.T_FILL ;
+  STATS[8] = GENSMEAR_CACHE.T_EXACT ;
+  STATS[9] = GENSMEAR_CACHE.MAXDIF_CHECK ;
+} // end get_genSmear_cache_stats
+
+void add_genSmear_cache_stats(double *STATS) {
+  // Created Oct 2026: add stats from another process (e.g., sim worker)
+  GENSMEAR_CACHE.NCALL      += STATS[0] ;
+  GENSMEAR_CACHE.NLAM_HIT   += STATS[1] ;
+  GENSMEAR_CACHE.NLAM_MISS  += STATS[2] ;
+  GENSMEAR_CACHE.NLAM_EXACT += STATS[3] ;
+  GENSMEAR_CACHE.NFILL      += STATS[4] ;
+  GENSMEAR_CACHE.NCHECK     += STATS[5] ;
+  GENSMEAR_CACHE.T_HIT      += STATS[6] ;
+  GENSMEAR_CACHE.T_FILL     += STATS[7] ;
+  GENSMEAR_CACHE.T_EXACT    += STATS[8] ;
+  if ( STATS[9] > GENSMEAR_CACHE.MAXDIF_CHECK ) 
+    { GENSMEAR_CACHE.MAXDIF_CHECK = STATS[9] ; }
+} // end add_genSmear_cache_stats
+
+double time_genSmear_cache(void) {
+  // Created Oct 2026: monotonic wall-clock time (sec) for cache stats
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return( (double)ts.tv_sec + 1.0E-9*(double)ts.tv_nsec );
+} // end time_genSmear_cache
+
+
 // ***********************************
 void init_genSmear_COVLAM_debug(double *lam, double COVMAT[2][2]) {
 
@@ -709,6 +1128,8 @@ void SETSNPAR_genSmear(double shape, double color, double redshift) {
   // do once-per-SN tasks
   if ( GENSMEAR_CCM89.USE )  { GENSMEAR_CCM89.RV = get_CCM89_RV(); }
 
+  reset_genSmear_cache(); // Oct 2026
+
 }  // end of SETSNPAR_genSmear
 
 
@@ -2,6 +2,7 @@
 //
 // Mar 30 2018: MXLAM_GENSMEAR_SALT2 --> 4000 (was 1000)
 // Oct 18 2019: add COVSED model
+// Oct 2026: add GENSMEAR_CACHE (per-event smear grid)
 
 #define MASK_GENSMEAR_APPLY 1 // apply genSmear, old or new
 #define MASK_GENSMEAR_NEW   2 // re-compute genSmear
@@ -58,6 +59,22 @@ void  get_NRAN_genSmear(int *NRANGauss, int *NRANFlat); // returns NRANxxx
 
 void  SETSNPAR_genSmear(double shape, double color, double redshift) ;
 
+void  get_genSmear_model(double Trest, int NLam, double *Lam, 
+			 double *magSmear);
+void  init_genSmear_cache(double DLAM, double TOL, double *LAMRANGE);
+void  reset_genSmear_cache(void);
+void  fill_genSmear_cache(int ITREST);
+void  get_genSmear_cache(double Trest, int NLam, double *Lam, 
+			 double *magSmear);
+void  exact_genSmear_cache(double Trest, int NLam, double *Lam, 
+			   double *magSmear);
+void  check_genSmear_cache(double Trest, int NLam, double *Lam, 
+			   double *magSmear);
+void  summary_genSmear_cache(void);
+void  get_genSmear_cache_stats(double *STATS);
+void  add_genSmear_cache_stats(double *STATS);
+double time_genSmear_cache(void);
+
 void get_genSmear(double *parList, int NLam, double *Lam, double *magSmear) ;
 
 int  repeat_genSmear(double Trest, int NLam, double *Lam);
@@ -393,6 +410,46 @@ struct {
 } GENSMEAR_PHASECOR ;
 
 
+// Oct 2026: optional per-event cache of the smear surface.
+// For each event the smear is evaluated once on a lambda grid
+// (and a Trest grid for Trest-dependent models such as USRFUN);
+// get_genSmear then interpolates. See sim-input key
+//   GENMAG_SMEAR_CACHE: <DLAM> <TOL>
+// Cells where the interpolation misses the exact midpoint value by
+// more than TOL/2 (e.g., SALT2 edge jumps) are evaluated exactly, 
+// and every NHIT_CHECK_GENSMEAR_CACHE calls are compared with the
+// exact calculation; abort if the difference exceeds TOL.
+
+#define DTREST_GENSMEAR_CACHE          1.0   // days, if USE_TREST=1
+#define TRESTMIN_GENSMEAR_CACHE     -100.0
+#define TRESTMAX_GENSMEAR_CACHE      500.0
+#define NHIT_CHECK_GENSMEAR_CACHE    200   // exact re-check every N hits
+#define NSTAT_GENSMEAR_CACHE          10   // size of stats array for threads
+
+struct {
+  int     USE ;
+  int     USE_TREST ;      // 1 -> smear model depends on Trest
+  double  DLAM, DTREST, TOL ;
+  double  LAMMIN, LAMMAX ;
+  int     NLAM, NTREST ;   // number of grid nodes
+
+  double  *LAM_FILL ;      // nodes + midpoints [2*NLAM-1]
+  double  *MAG_FILL ;      // smear at LAM_FILL
+  double **MAGSMEAR ;      // [itrest][ilam] smear at nodes
+  char   **EXACT ;         // [itrest][icell]=1 -> evaluate exact
+  int     *STAMP_ROW ;     // event stamp when row was filled
+  int      STAMP ;         // incremented for each new event
+
+  int      MXLAM_TMP ;     // scratch for exact sub-list
+  int     *ILAM_TMP ;
+  double  *LAM_TMP, *MAG_TMP, *MAG_CHECK ;
+
+  // stats
+  double  NCALL, NLAM_HIT, NLAM_MISS, NLAM_EXACT, NFILL, NCHECK ;
+  double  T_HIT, T_FILL, T_EXACT, MAXDIF_CHECK ;
+} GENSMEAR_CACHE ;
+
+
 // --------- private struct for testing --------------
 struct GENSMEAR_PRIVATE {
   int USE ;
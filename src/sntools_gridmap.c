@@ -7,6 +7,12 @@
   Note: these utils are NOT related to those in sntools_modelgrid_gen.c[h]
         and sntools_modelgrid_read.c[h]
 
+  Oct 2026: interp_GRIDMAP uses fixed-NDIM corner kernels (NDIM=1-4)
+            with precomputed STRIDE; new interp_GRIDMAP_BATCH to
+            interpolate many points with one call, re-using bin lookup
+            and corner weights for dimensions whose value does not
+            change from the previous point.
+
  *****************************************/
 
 #include <stdio.h>
@@ -329,6 +335,7 @@ void init_interp_GRIDMAP(int ID, char *MAPNAME, int MAPSIZE,
   //   + fix bug malloc-ing FUNVAL : I8p -> I8p * NFUN
   //
   // May 26 2021: move malloc calls into malloc_GRIDMAP()
+  // Oct 2026: store gridmap->STRIDE[idim] for interp kernels.
   //
 
   int idim, ifun, i, NBIN, igrid_tmp, igrid_1d[100] ;
@@ -453,12 +460,159 @@ void init_interp_GRIDMAP(int ID, char *MAPNAME, int MAPSIZE,
       gridmap->INVMAP[igrid_tmp] = i ;
 
   } // end loop over MAPSIZE
+
+  // Oct 2026: store 1D-index strides so that interp kernels can
+  //   compute the corner index without calling get_1DINDEX.
+  for ( idim=0; idim < NDIM; idim++ ) 
+    { gridmap->STRIDE[idim] = OFFSET_1DINDEX[ID][idim]; }
   
   return ;
 
 } // end of init_interp_GRIDMAP
 
 
+// ==============================================================
+static inline int get_cell_GRIDMAP(GRIDMAP_DEF *gridmap, int ivar, 
+				   double VAL, int *IGRID, double *GRIDFRAC) {
+
+  // Created Oct 2026 [moved from interp_GRIDMAP]
+  // For value VAL of variable ivar, return lower grid index *IGRID
+  // and relative location in cell, *GRIDFRAC (0-1).
+  // Function returns ERROR if VAL is outside the grid and
+  // extrapolation is not allowed; otherwise returns SUCCESS.
+
+  int    OPT_EXTRAP = gridmap->OPT_EXTRAP ;
+  double TMPVAL     = VAL ;
+  double TMPMIN     = gridmap->VALMIN[ivar] ;
+  double TMPMAX     = gridmap->VALMAX[ivar] ;
+  double TMPBIN     = gridmap->VALBIN[ivar] ;
+  double TMPRANGE   = TMPMAX - TMPMIN ;
+  double EPSILON    = 1.0E-8 ;
+  double TMPDIF, XNBIN ;
+  int    igrid ;
+  bool   outside_bound, too_lo, too_hi ;
+
+  // ---------- BEGIN ------------
+
+  // Mar 15 2020: allow numerical glitches
+  TMPMAX += (1.0E-14*TMPRANGE);
+  TMPMIN -= (1.0E-14*TMPRANGE);
+
+  too_lo        = ( TMPVAL < TMPMIN ) ;
+  too_hi        = ( TMPVAL > TMPMAX ) ;
+  outside_bound = ( too_lo || too_hi );
+
+  if ( outside_bound ) {
+    // check extrap option
+    if ( OPT_EXTRAP > 0 ) {
+      if ( too_lo ) { TMPVAL = TMPMIN + (TMPRANGE*1.0E-12); }
+      if ( too_hi ) { TMPVAL = TMPMAX - (TMPRANGE*1.0E-12); }
+    }
+    else if ( OPT_EXTRAP < 0 ) {
+      // ??
+    }
+    else 
+      { return(ERROR); }
+  } // end outside_bound
+
+  TMPDIF  = TMPVAL - TMPMIN ;
+  if ( TMPBIN == 0.0 )
+    { XNBIN = 0.0 ; igrid = 0; }
+  else if ( (TMPMAX - TMPVAL)/TMPRANGE < EPSILON  )  { 
+    XNBIN = (TMPDIF - TMPRANGE*EPSILON)/TMPBIN ;
+    igrid = (int)(XNBIN) ; 
+  }
+  else {
+    XNBIN = (TMPDIF + TMPRANGE*EPSILON ) / TMPBIN ;
+    igrid = (int)(XNBIN); //  + 1; 
+  }
+
+  // store relative cell location: 0-1
+  if ( TMPBIN > 0.0 ) 
+    {  *GRIDFRAC  = TMPDIF/TMPBIN - (double)igrid ; }
+  else
+    {  *GRIDFRAC  = 1.0 ; }
+
+  *IGRID = igrid ;
+
+  return(SUCCESS);
+
+} // end get_cell_GRIDMAP
+
+
+// ==============================================================
+static inline double interp_GRIDMAP_KERNEL(GRIDMAP_DEF *gridmap, int NVAR,
+					   int INDEX0, double *WGT_LO,
+					   double *WGT_HI, double *WGT_SUM ) {
+
+  // Created Oct 2026
+  // Fixed-NDIM kernel for interp_GRIDMAP: sum weighted function 
+  // values over the 2^NVAR corners of the cell. NVAR is passed as
+  // a literal constant from interp_GRIDMAP, so that after inlining
+  // the compiler unrolls the loops for each NDIM=1-4.
+  // Caller must verify that 0 <= IGRID_VAR < NBIN-1 for each var.
+  //
+  // Inputs:
+  //   gridmap    : map with STRIDE set in init_interp_GRIDMAP
+  //   NVAR       : number of dimensions (1-4)
+  //   INDEX0     : 1D index of lower cell corner = sum IGRID*STRIDE
+  //   WGT_LO[HI] : 1-GRIDFRAC (GRIDFRAC) in each dimension
+  //
+  // Output:
+  //   WGT_SUM[ifun] += sum over corners of CORNER_WGT * FUNVAL
+  //
+  // Functions returns sum of CORNER_WGT.
+
+  int    NFUN    = gridmap->NFUN ;
+  int    NCORNERS = 1 << NVAR ;
+  int    *STRIDE = gridmap->STRIDE ;
+  int    ivar, ifun, icorner, INDEX, irow ;
+  double CORNER_WGT, CORNER_WGTSUM = 0.0 ;
+
+  // ---------- BEGIN ------------
+
+  for ( icorner=0; icorner < NCORNERS; icorner++ ) {
+    CORNER_WGT = 1.0 ;
+    INDEX      = INDEX0 ;
+    for ( ivar=0; ivar < NVAR; ivar++ ) {
+      if ( (icorner >> ivar) & 1 ) 
+	{ CORNER_WGT *= WGT_HI[ivar] ;  INDEX += STRIDE[ivar]; }
+      else
+	{ CORNER_WGT *= WGT_LO[ivar] ; }
+    }
+
+    CORNER_WGTSUM += CORNER_WGT ;
+    irow = gridmap->INVMAP[INDEX] ;
+    for ( ifun=0; ifun < NFUN; ifun++ ) 
+      { WGT_SUM[ifun] += (CORNER_WGT * gridmap->FUNVAL[ifun][irow]) ; }
+  }
+
+  return CORNER_WGTSUM ;
+
+} // end interp_GRIDMAP_KERNEL
+
+
+// ==============================================================
+static inline double interp_GRIDMAP_KERNEL_SWITCH(GRIDMAP_DEF *gridmap,
+						  int INDEX0, double *WGT_LO, 
+						  double *WGT_HI, 
+						  double *WGT_SUM) {
+  // Created Oct 2026
+  // Call interp_GRIDMAP_KERNEL with literal NVAR = NDIM (1-4).
+  switch ( gridmap->NDIM ) {
+  case 1 : 
+    return interp_GRIDMAP_KERNEL(gridmap, 1, INDEX0, WGT_LO, WGT_HI, WGT_SUM);
+  case 2 : 
+    return interp_GRIDMAP_KERNEL(gridmap, 2, INDEX0, WGT_LO, WGT_HI, WGT_SUM);
+  case 3 : 
+    return interp_GRIDMAP_KERNEL(gridmap, 3, INDEX0, WGT_LO, WGT_HI, WGT_SUM);
+  default : 
+    return interp_GRIDMAP_KERNEL(gridmap, 4, INDEX0, WGT_LO, WGT_HI, WGT_SUM);
+  }
+} // end interp_GRIDMAP_KERNEL_SWITCH
+
+
+// ==============================================================
 int interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun ) {
 
   // Created Jul 3, 2011
@@ -485,23 +639,27 @@ int interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun ) {
   //  + return SUCCESS or ERROR instead of hard-coded values.
   //
   // Mar 15 2020: allow numerical glitches in TMPMIN and TMPMAX
+  //
+  // Oct 2026: for NDIM=1-4, sum over cell corners with fixed-NDIM
+  //   kernel (interp_GRIDMAP_KERNEL) using precomputed STRIDE.
+  //   Corner order and weight products are the same as the generic
+  //   loop, so results are identical. Generic loop is still used
+  //   for NDIM>4 and for invalid cells (to preserve abort message).
 
   int 
-    ivar, ifun, NFUN, NVAR, ID, igrid, MSK, NBIN, OPT_EXTRAP
-    ,NCORNERS, icorner, igrid_tmp, igrid_1D, g
+    ivar, ifun, NFUN, NVAR, ID, igrid, MSK, NBIN
+    ,NCORNERS, icorner, igrid_tmp, igrid_1D, g, INDEX0
     ,igrid_cell[100], igrid_var[100], IGRID_VAR[100]
     ;
 
   double  
     WGT_SUM[100], CORNER_WGTSUM, CORNER_WGT
-    ,TMPVAL, TMPDIF, TMPMIN, TMPMAX, TMPBIN, TMPRANGE, xgrid, XNBIN
+    ,TMPVAL, TMPMIN, TMPMAX
     ,GRIDFRAC[100], FUNVAL[100]
+    ,WGT_LO[MXDIM_KERNEL_GRIDMAP], WGT_HI[MXDIM_KERNEL_GRIDMAP]
     ;
 
-  double EPSILON = 1.0E-8 ;
-
   int  LDMP=0 ;
-  bool outside_bound, too_lo, too_hi ;
   char fnam[] = "interp_GRIDMAP" ;
 
   // ---------- BEGIN ------------
@@ -509,7 +667,6 @@ int interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun ) {
   ID   = gridmap->ID ;
   NVAR = gridmap->NDIM ;
   NFUN = gridmap->NFUN ;
-  OPT_EXTRAP = gridmap->OPT_EXTRAP ;
 
   // Mar 27 2021: check trivial case with NDIM=1 and 1 bin
   if ( NFUN==1 && NVAR == 1 && gridmap->NBIN[0]==1 ) {
@@ -531,67 +688,42 @@ int interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun ) {
     { printf(" xxxxx ------------- START DUMP ----------------- \n"); }
 
   // get central index and grid-frac in each dimension
+  // (Oct 2026: moved to get_cell_GRIDMAP)
   for ( ivar=0; ivar < NVAR; ivar++ ) {
-    TMPVAL   = data[ivar] ;
-    TMPMIN   = gridmap->VALMIN[ivar] ;
-    TMPMAX   = gridmap->VALMAX[ivar] ;
-    TMPBIN   = gridmap->VALBIN[ivar] ;
-    TMPRANGE = TMPMAX - TMPMIN ;
-
-    // Mar 15 2020: allow numerical glitches
-    TMPMAX += (1.0E-14*TMPRANGE);
-    TMPMIN -= (1.0E-14*TMPRANGE);
-
-    too_lo        = ( TMPVAL < TMPMIN ) ;
-    too_hi        = ( TMPVAL > TMPMAX ) ;
-    outside_bound = ( too_lo || too_hi );
-
-    if ( outside_bound ) {
-      // check extrap option
-      if ( OPT_EXTRAP > 0 ) {
-	if ( too_lo ) { TMPVAL = TMPMIN + (TMPRANGE*1.0E-12); }
-	if ( too_hi ) { TMPVAL = TMPMAX - (TMPRANGE*1.0E-12); }
-      }
-      else if ( OPT_EXTRAP < 0 ) {
-	// ??
-      }
-      else 
-	{ return(ERROR); }
-	
-    } // end outside_bound
-
-
-    TMPDIF  = TMPVAL - TMPMIN ;
-    if ( TMPBIN == 0.0 )
-      { XNBIN = 0.0 ; igrid = 0; }
-    else if ( (TMPMAX - TMPVAL)/TMPRANGE < EPSILON  )  { 
-      XNBIN = (TMPDIF - TMPRANGE*EPSILON)/TMPBIN ;
-      igrid = (int)(XNBIN) ; 
-    }
-    else {
-      XNBIN = (TMPDIF + TMPRANGE*EPSILON ) / TMPBIN ;
-      igrid = (int)(XNBIN); //  + 1; 
-    }
-
-    xgrid   = (double)igrid ;
-
-    // store relative cell location: 0-1
-    if ( TMPBIN > 0.0 ) 
-      {  GRIDFRAC[ivar]  = TMPDIF/TMPBIN - xgrid ; }
-    else
-      {  GRIDFRAC[ivar]  = 1.0 ; }
-
-    IGRID_VAR[ivar] = igrid ; // store central bin  for each var
+    if ( get_cell_GRIDMAP(gridmap, ivar, data[ivar], 
+			  &IGRID_VAR[ivar], &GRIDFRAC[ivar]) != SUCCESS ) 
+      { return(ERROR); }
 
     if ( LDMP ) {
-      printf(" xxxx VAL=%f  BIN=%f  XNBIN=%f  igrid=%2d GRIDFRAC=%le \n",
-	     TMPVAL, TMPBIN, XNBIN, igrid, GRIDFRAC[ivar] );
+      printf(" xxxx VAL=%f  BIN=%f  igrid=%2d GRIDFRAC=%le \n",
+	     data[ivar], gridmap->VALBIN[ivar], IGRID_VAR[ivar], 
+	     GRIDFRAC[ivar] );
       fflush(stdout);
     }
 
   } // ivar
 
 
+  // Oct 2026: check for fixed-NDIM kernel 
+  bool USE_KERNEL = ( NVAR <= MXDIM_KERNEL_GRIDMAP && !LDMP ) ;
+  for ( ivar=0; ivar < NVAR && USE_KERNEL; ivar++ ) {
+    igrid = IGRID_VAR[ivar] ;
+    if ( igrid < 0 || igrid+1 >= gridmap->NBIN[ivar] ) 
+      { USE_KERNEL = false; }
+  }
+
+  if ( USE_KERNEL ) {
+    INDEX0 = 0 ;
+    for ( ivar=0; ivar < NVAR; ivar++ ) {
+      INDEX0      += IGRID_VAR[ivar] * gridmap->STRIDE[ivar] ;
+      WGT_HI[ivar] = GRIDFRAC[ivar] ;
+      WGT_LO[ivar] = 1.0 - GRIDFRAC[ivar] ;
+    }
+    CORNER_WGTSUM = 
+      interp_GRIDMAP_KERNEL_SWITCH(gridmap, INDEX0, WGT_LO, WGT_HI, WGT_SUM);
+    goto CORNER_DONE ;
+  }
+
   // determine the grid points at the corners of the
   // NVAR-dimentional cell containing *galpar.
   // Then take weighted average of WGTMAP at each corner.
@@ -663,6 +795,7 @@ int interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun ) {
     
   } // corner
 
+ CORNER_DONE:
   if ( CORNER_WGTSUM <= 0.0 ) {
     sprintf(c1err,"Could not compute CORNER_WGT for gridmap ID=%d", 
 	    gridmap->ID );
@@ -690,6 +823,104 @@ int interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun ) {
 } // end of interp_GRIDMAP
 
 
+
+// ==============================================================
+int interp_GRIDMAP_BATCH(GRIDMAP_DEF *gridmap, int NPT, double *data, 
+			 double *interpFun, int *ISTAT ) {
+
+  // Created Oct 2026
+  // Interpolate NPT points with one call, e.g., to evaluate
+  // a PDF on a fine grid. For each dimension, the bin lookup and 
+  // corner weights are re-used from the previous point if the value 
+  // is unchanged; e.g., for a scan along the 1st variable with other 
+  // variables fixed, only the 1st dimension is looked up per point.
+  // Results are identical to calling interp_GRIDMAP for each point,
+  // which is still used for NDIM>4 and for points on the grid edge.
+  //
+  // Inputs:
+  //   gridmap  : map from init_interp_GRIDMAP
+  //   NPT      : number of points
+  //   data     : data[ipt*NDIM + idim] 
+  //
+  // Outputs:
+  //   interpFun : interpFun[ipt*NFUN + ifun]
+  //   ISTAT     : ISTAT[ipt] = SUCCESS or ERROR (see interp_GRIDMAP)
+  //
+  // Function returns number of points with ERROR.
+
+  int    NDIM = gridmap->NDIM ;
+  int    NFUN = gridmap->NFUN ;
+  int    ipt, ivar, ifun, igrid = 0, INDEX0, NERR = 0 ;
+  int    IGRID_VAR[MXDIM_KERNEL_GRIDMAP], ISTAT_VAR[MXDIM_KERNEL_GRIDMAP];
+  double VAL_LAST[MXDIM_KERNEL_GRIDMAP], VAL, GRIDFRAC = 0.0 ;
+  double WGT_LO[MXDIM_KERNEL_GRIDMAP], WGT_HI[MXDIM_KERNEL_GRIDMAP];
+  double WGT_SUM[100], CORNER_WGTSUM ;
+  bool   VALID_CELL[MXDIM_KERNEL_GRIDMAP], USE_KERNEL, NEW_VAL ;
+
+  // ---------- BEGIN ------------
+
+  // check trivial 1-bin map or NDIM beyond fixed kernels
+  bool USE_LOOP = ( NDIM > MXDIM_KERNEL_GRIDMAP || NFUN > 100 ||
+		    (NFUN==1 && NDIM==1 && gridmap->NBIN[0]==1) );
+
+  if ( USE_LOOP ) {
+    for ( ipt=0; ipt < NPT; ipt++ ) {
+      ISTAT[ipt] = interp_GRIDMAP(gridmap, &data[ipt*NDIM], 
+				  &interpFun[ipt*NFUN] );
+      if ( ISTAT[ipt] != SUCCESS ) { NERR++ ; }
+    }
+    return NERR ;
+  }
+
+  for ( ipt=0; ipt < NPT; ipt++ ) {
+
+    ISTAT[ipt] = SUCCESS ;
+    USE_KERNEL = true ;
+    INDEX0     = 0 ;
+
+    for ( ivar=0; ivar < NDIM; ivar++ ) {
+      VAL     = data[ipt*NDIM + ivar] ;
+      NEW_VAL = ( ipt == 0 || VAL != VAL_LAST[ivar] );
+      if ( NEW_VAL ) {
+	ISTAT_VAR[ivar] = get_cell_GRIDMAP(gridmap, ivar, VAL, 
+					   &igrid, &GRIDFRAC);
+	IGRID_VAR[ivar]  = igrid ;
+	WGT_HI[ivar]     = GRIDFRAC ;
+	WGT_LO[ivar]     = 1.0 - GRIDFRAC ;
+	VALID_CELL[ivar] = ( igrid >= 0 && igrid+1 < gridmap->NBIN[ivar] );
+	VAL_LAST[ivar]   = VAL ;
+      }
+      if ( ISTAT_VAR[ivar] != SUCCESS ) { ISTAT[ipt] = ERROR; }
+      if ( !VALID_CELL[ivar] )          { USE_KERNEL = false; }
+      INDEX0 += IGRID_VAR[ivar] * gridmap->STRIDE[ivar] ;
+    }
+
+    if ( ISTAT[ipt] != SUCCESS ) { NERR++ ; continue ; }
+
+    for ( ifun=0; ifun < NFUN; ifun++ ) { WGT_SUM[ifun] = 0.0 ; }
+    CORNER_WGTSUM = 0.0 ;
+    if ( USE_KERNEL ) {
+      CORNER_WGTSUM = 
+	interp_GRIDMAP_KERNEL_SWITCH(gridmap, INDEX0, WGT_LO, WGT_HI, WGT_SUM);
+    }
+
+    // edge cell or zero weight -> interp_GRIDMAP for its abort message
+    if ( CORNER_WGTSUM <= 0.0 ) {
+      ISTAT[ipt] = interp_GRIDMAP(gridmap, &data[ipt*NDIM], 
+				  &interpFun[ipt*NFUN] );
+      if ( ISTAT[ipt] != SUCCESS ) { NERR++ ; }
+      continue ;
+    }
+
+    for ( ifun=0; ifun < NFUN; ifun++ ) 
+      { interpFun[ipt*NFUN + ifun] = WGT_SUM[ifun] / CORNER_WGTSUM ; }
+  }
+
+  return NERR ;
+
+} // end interp_GRIDMAP_BATCH
+
+
 // ================================================
 int  get_1DINDEX(int ID, int NDIM, int *indx ) {
 
@@ -1,9 +1,11 @@
 // Created July 2021 [moved from sntools.h]
 // Apr 2024: change typedef GRIDMAP to GRIDMAP_DEF (follow SNANA convention)
+// Oct 2026: add STRIDE, fixed-NDIM interp kernels and interp_GRIDMAP_BATCH
 
 
 // define prototype for multi-dimensionl grid; used for interpolation
 #define MXDIM_GRIDMAP 20
+#define MXDIM_KERNEL_GRIDMAP 4  // fixed-NDIM interp kernels for NDIM <= 4
 typedef struct GRIDMAP_DEF {
   int     ID;        //    
   int     NDIM;     // Number of dimensions      
@@ -18,6 +20,7 @@ typedef struct GRIDMAP_DEF {
   double  *FUNMIN ;    // min fun-val per function 
   double  *FUNMAX ;    // max fun-val per function 
   int    *INVMAP;      // covert multi-D indices into 1D index
+  int    STRIDE[MXDIM_GRIDMAP]; // 1D-index offset per dimension
   int  NROW;          // number or rows read from file 
   int  OPT_EXTRAP;    // 1=>snap outside values to edge 
   char VARLIST[80];   // comma-sep list of variables (optional to fill)   
@@ -67,6 +70,8 @@ void init_interp_GRIDMAP(int ID, char *MAPNAME, int MAPSIZE, int NDIM, int NFUN,
                          GRIDMAP_DEF *gridmap ); 
                                                                            
 int  interp_GRIDMAP(GRIDMAP_DEF *gridmap, double *data, double *interpFun );
+int  interp_GRIDMAP_BATCH(GRIDMAP_DEF *gridmap, int NPT, double *data, 
+                          double *interpFun, int *ISTAT );
                                                                 
 void read_GRIDMAP(FILE *fp, char *MAPNAME, char *KEY_ROW, char *KEY_STOP,
                   int IDMAP, int NDIM, int NFUN, int OPT_EXTRAP, int MXROW,
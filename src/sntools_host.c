@@ -93,6 +93,17 @@
  Apr 13 2023: implement GROUPID match between SIMLIB and HOSTLIB
               (enable Large-scale structure)
 
+ Oct 2026: new HOSTLIB_MSKOPT += 65536 (FASTSELECT) for large HOSTLIBs:
+           binary search for z-range, binary search of cumulative WGTSUM
+           to select host, and for USEONCE a Fenwick tree of weights so 
+           that used hosts are removed instead of skipped.
+
+ Oct 2026: new HOSTLIB_MSKOPT += 131072 (BINCACHE): after the first
+           text read, write z-sorted columns, IZPTR and WGTMAP sums to
+           a binary cache [HOSTLIB].BINCACHE; later jobs mmap this cache
+           instead of parsing the text HOSTLIB. Cache is rebuilt if the
+           HOSTLIB checksum, row-selection inputs or WGTMAP change.
+
 =========================================================== */
 
 #include <stdio.h>
@@ -102,6 +113,10 @@
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#undef  MAP_FILE  // mman.h flag clashes with INPUTS.GENPDF.MAP_FILE
+#include <sys/stat.h>
 
 #include "sntools.h"
 #include "sntools_cosmology.h"
@@ -171,6 +186,10 @@ void INIT_HOSTLIB(void) {
   // check for match among spec templates and hostlib varnames (Jun 2019)
   match_specTable_HOSTVAR();
 
+  // Oct 2026: check for valid binary cache of z-sorted HOSTLIB
+  if ( read_BINCACHE_HOSTLIB() ) 
+    { goto SUMMARY_SNPAR ; }
+
   // re-open hostlib for GAL keys so that it works for gzipped files.
   // (cannot rewind gzip file, so close and re-open is only way)
   open_HOSTLIB(&fp_hostlib);     // re-open
@@ -179,9 +198,6 @@ void INIT_HOSTLIB(void) {
 
   close_HOSTLIB(fp_hostlib);     // close HOSTLIB
 
-  // summarize SNPARams that were/weren't found
-  summary_snpar_HOSTLIB();
-
   // sort HOSTLIB entries by redshift
   sortz_HOSTLIB();
 
@@ -192,9 +208,18 @@ void INIT_HOSTLIB(void) {
   // set redshift pointers for faster lookup
   zptr_HOSTLIB();
 
+ SUMMARY_SNPAR:
+
+  // summarize SNPARams that were/weren't found
+  summary_snpar_HOSTLIB();
+
   // setup optional wgt-map grid
   int IGAL_START = 0,  IGAL_END = HOSTLIB.NGAL_STORE-1;
-  init_HOSTLIB_WGTMAP(1, IGAL_START, IGAL_END);
+  if ( !HOSTLIB_BINCACHE.USE_WGTMAP ) 
+    { init_HOSTLIB_WGTMAP(1, IGAL_START, IGAL_END); }
+
+  // write binary cache for next job (Oct 2026)
+  write_BINCACHE_HOSTLIB();
   
   // read optional EFF(zPHOT) vs. ZTRUE (Aug 2015)
   init_HOSTLIB_ZPHOTEFF();
@@ -209,6 +234,9 @@ void INIT_HOSTLIB(void) {
   // init options for re-using same host
   init_SAMEHOST();
 
+  // Fenwick tree for FASTSELECT + USEONCE (Oct 2026)
+  init_HOSTLIB_FENWICK();
+
   // init parameters and Gauss2d integrals for galaxy aperture mag
   init_GALMAG_HOSTLIB();
 
@@ -282,6 +310,12 @@ void print_HOSTLIB_MSKOPT(void) {
   print_mask_comment(stdout, MSKOPT, HOSTLIB_MSKOPT_ZPHOT_QGAUSS,
 		     "write Gauss quantiles for zPHOT (for debug)" );
 
+  print_mask_comment(stdout, MSKOPT, HOSTLIB_MSKOPT_FASTSELECT,
+		     "O(logN) host selection for large HOSTLIB" );
+
+  print_mask_comment(stdout, MSKOPT, HOSTLIB_MSKOPT_BINCACHE,
+		     "read/write binary z-sorted HOSTLIB cache (mmap)" );
+
   //   print_mask_comment(stdout, MSKOPT, 0,		     "" );
 
 
@@ -4306,6 +4340,488 @@ void zptr_HOSTLIB(void) {
 
 } // end of zptr_HOSTLIB
 
+// =======================================
+int read_BINCACHE_HOSTLIB(void) {
+
+  // Created Oct 2026
+  // If HOSTLIB_MSKOPT & BINCACHE, look for binary cache written by
+  // a previous job and mmap it. Z-sorted columns, LIBINDEX_ZSORT,
+  // IZPTR and (optionally) the WGTMAP sums then point directly into
+  // the mapped file, so that read_gal, sortz and zptr are skipped.
+  // The map is MAP_PRIVATE: pages are shared read-only between jobs,
+  // and the few in-place updates (e.g., Sersic fixes, lensing) are
+  // copy-on-write so the cache file is never modified.
+  //
+  // Cache is used only if the HOSTLIB checksum, the inputs that select
+  // or modify rows, and the WGTMAP grid all match the cache header.
+  // Functions returns 1 if cache was loaded; 0 otherwise.
+
+  int MSKOPT = INPUTS.HOSTLIB_MSKOPT ;
+  bool DO_CACHE = ( MSKOPT & HOSTLIB_MSKOPT_BINCACHE ) ;
+  int  MSKOPT_NOCACHE = 
+    HOSTLIB_MSKOPT_APPEND + HOSTLIB_MSKOPT_PLUSMAGS + HOSTLIB_MSKOPT_PLUSNBR;
+
+  BINCACHE_HEADER_HOSTLIB_DEF *HEAD ;
+  struct stat statbuf ;
+  int    fd, icand, ivar, NGAL, NVAR_STORE ;
+  bool   FOUND = false ;
+  char   *ptr, cache_file[MXPATHLEN] ;
+  void   *addr ;
+  size_t  MAP_SIZE ;
+  char fnam[] = "read_BINCACHE_HOSTLIB" ;
+
+  // --------------- BEGIN ---------------
+
+  HOSTLIB_BINCACHE.ALLOW        = false ;
+  HOSTLIB_BINCACHE.ALLOW_WGTMAP = false ;
+  HOSTLIB_BINCACHE.USE          = false ;
+  HOSTLIB_BINCACHE.USE_WGTMAP   = false ;
+  HOSTLIB_BINCACHE.MAP_ADDR     = NULL ;
+  HOSTLIB_BINCACHE.MAP_SIZE     = 0 ;
+  HOSTLIB_BINCACHE.FILENAME[0]  = 0 ;
+
+  if ( !DO_CACHE ) { return 0; }
+
+  // options that need unsorted rows or string columns cannot use cache
+  if ( (MSKOPT & MSKOPT_NOCACHE) > 0 || 
+       INPUTS.HOSTLIB_USE == HOSTLIB_FLAG_REWRITE ||
+       HOSTLIB.IVAR_FIELD > 0 || HOSTLIB.IVAR_NBR_LIST > 0 ) {
+    printf("\t %s: BINCACHE disabled (FIELD/NBR_LIST column "
+	   "or APPEND/PLUS option)\n", fnam);
+    fflush(stdout);
+    return 0;
+  }
+
+  HOSTLIB_BINCACHE.ALLOW = true ;
+
+  // WGTMAP sums are cached only if they are deterministic functions 
+  // of the HOSTLIB rows and WGTMAP grid.
+  double GAMMA_GRID_MIN = INPUTS.BIASCOR_SALT2GAMMA_GRID[0]; 
+  double GAMMA_GRID_MAX = INPUTS.BIASCOR_SALT2GAMMA_GRID[1]; 
+  HOSTLIB_BINCACHE.ALLOW_WGTMAP = 
+    ( HOSTLIB_WGTMAP.N_SNVAR    == 0  &&
+      HOSTLIB_WGTMAP.NCHECKLIST == 0  &&
+      GAMMA_GRID_MAX <= GAMMA_GRID_MIN ) ;
+
+  checksum_BINCACHE_HOSTLIB();
+
+  // check cache next to HOSTLIB, then in current directory
+  for(icand=0; icand < 2; icand++ ) {
+    name_BINCACHE_HOSTLIB(icand, cache_file);
+    if ( access(cache_file, R_OK) == 0 ) { FOUND = true; break; }
+  }
+
+  if ( !FOUND ) {
+    printf("\t %s: no cache yet; will write after text read.\n", fnam);
+    fflush(stdout);
+    return 0;
+  }
+
+  fd = open(cache_file, O_RDONLY);
+  if ( fd < 0 || fstat(fd,&statbuf) != 0 ) {
+    if ( fd >= 0 ) { close(fd); }
+    printf("\t %s: cannot open %s; read text HOSTLIB.\n", fnam, cache_file);
+    fflush(stdout);
+    return 0;
+  }
+
+  MAP_SIZE = (size_t)statbuf.st_size ;
+  if ( MAP_SIZE < sizeof(BINCACHE_HEADER_HOSTLIB_DEF) ) 
+    { close(fd);  goto STALE ; }
+
+  addr = mmap(NULL, MAP_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( addr == MAP_FAILED ) {
+    printf("\t %s: mmap failed for %s; read text HOSTLIB.\n", 
+	   fnam, cache_file);
+    fflush(stdout);
+    return 0;
+  }
+
+  // validate header
+  HEAD = (BINCACHE_HEADER_HOSTLIB_DEF*)addr ;
+  if ( HEAD->MAGIC   != MAGIC_BINCACHE_HOSTLIB   ||
+       HEAD->VERSION != VERSION_BINCACHE_HOSTLIB ||
+       HEAD->SIZE_SOURCE     != HOSTLIB_BINCACHE.SIZE_SOURCE     ||
+       HEAD->CHECKSUM_SOURCE != HOSTLIB_BINCACHE.CHECKSUM_SOURCE ||
+       HEAD->CHECKSUM_INPUTS != HOSTLIB_BINCACHE.CHECKSUM_INPUTS ||
+       HEAD->NVAR_STORE      != HOSTLIB.NVAR_STORE               ||
+       size_BINCACHE_HOSTLIB(HEAD) != MAP_SIZE ) {
+    munmap(addr, MAP_SIZE);
+    goto STALE ;
+  }
+
+  for(ivar=0; ivar < HOSTLIB.NVAR_STORE; ivar++ ) {
+    if ( strcmp(HEAD->VARNAME_STORE[ivar],HOSTLIB.VARNAME_STORE[ivar]) != 0 )
+      { munmap(addr, MAP_SIZE);  goto STALE ; }
+  }
+
+  // - - - - - - 
+  // cache is valid: point z-sorted arrays into mapped file
+  NGAL       = HEAD->NGAL_STORE ;
+  NVAR_STORE = HEAD->NVAR_STORE ;
+  ptr        = (char*)addr + sizeof(BINCACHE_HEADER_HOSTLIB_DEF) ;
+
+  for(ivar=0; ivar < NVAR_STORE; ivar++ ) {
+    HOSTLIB.VALUE_ZSORTED[ivar] = (double*)ptr ;
+    ptr += NGAL * sizeof(double) ;
+  }
+
+  // use cached WGTMAP sums only if WGTMAP grid is the same
+  bool USE_WGTMAP = ( HEAD->NGAL_WGTMAP > 0 && 
+		      HOSTLIB_BINCACHE.ALLOW_WGTMAP &&
+		      HEAD->CHECKSUM_WGTMAP == HOSTLIB_BINCACHE.CHECKSUM_WGTMAP);
+  if ( HEAD->NGAL_WGTMAP > 0 ) {
+    if ( USE_WGTMAP ) { HOSTLIB_WGTMAP.WGTSUM = (double*)ptr ; }
+    ptr += NGAL * sizeof(double) ;
+  }
+
+  HOSTLIB.LIBINDEX_ZSORT = (int*)ptr ;
+  ptr += 8 * ((NGAL * sizeof(int) + 7)/8) ;
+
+  HOSTLIB.IZPTR = (int*)ptr ;
+  ptr += 8 * ((HEAD->NZPTR * sizeof(int) + 7)/8) ;
+
+  if ( USE_WGTMAP ) { 
+    HOSTLIB_WGTMAP.I2SNMAGSHIFT = (short int*)ptr ; 
+    HOSTLIB_WGTMAP.MEMTOT_MB    = 0.0 ;
+  }
+
+  // load header info that would be computed by read_gal, sortz, zptr
+  HOSTLIB.NGAL_READ   = HEAD->NGAL_READ ;
+  HOSTLIB.NGAL_STORE  = NGAL ;
+  HOSTLIB.NSTAR       = HEAD->NSTAR ;
+  HOSTLIB.NZPTR       = HEAD->NZPTR ;
+  HOSTLIB.MINiz       = HEAD->MINiz ;
+  HOSTLIB.MAXiz       = HEAD->MAXiz ;
+  HOSTLIB.IGAL_FORCE  = HEAD->IGAL_FORCE ;
+  HOSTLIB.ZMIN        = HEAD->ZMIN ;
+  HOSTLIB.ZMAX        = HEAD->ZMAX ;
+  HOSTLIB.ZGAPMAX     = HEAD->ZGAPMAX ;
+  HOSTLIB.ZGAPAVG     = HEAD->ZGAPAVG ;
+  HOSTLIB.Z_ATGAPMAX[0] = HEAD->Z_ATGAPMAX[0] ;
+  HOSTLIB.Z_ATGAPMAX[1] = HEAD->Z_ATGAPMAX[1] ;
+  HOSTLIB.VPEC_RMS    = HEAD->VPEC_RMS ;
+  HOSTLIB.VPEC_AVG    = HEAD->VPEC_AVG ;
+  HOSTLIB.VPEC_MIN    = HEAD->VPEC_MIN ;
+  HOSTLIB.VPEC_MAX    = HEAD->VPEC_MAX ;
+  for(ivar=0; ivar < NVAR_STORE; ivar++ ) {
+    HOSTLIB.VALMIN[ivar] = HEAD->VALMIN[ivar] ;
+    HOSTLIB.VALMAX[ivar] = HEAD->VALMAX[ivar] ;
+  }
+  HOSTLIB.LIBINDEX_UNSORT = NULL ;
+  HOSTLIB.SORTFLAG        = 1 ;
+
+  HOSTLIB_BINCACHE.USE        = true ;
+  HOSTLIB_BINCACHE.USE_WGTMAP = USE_WGTMAP ;
+  HOSTLIB_BINCACHE.MAP_ADDR   = addr ;
+  HOSTLIB_BINCACHE.MAP_SIZE   = MAP_SIZE ;
+  sprintf(HOSTLIB_BINCACHE.FILENAME, "%s", cache_file);
+
+  printf("\t mmap %d galaxies (%d from file) from binary cache\n"
+	 "\t   %s  (%.2f MB, WGTMAP=%s)\n", 
+	 NGAL, HOSTLIB.NGAL_READ, cache_file, (double)MAP_SIZE*1.0E-6,
+	 (USE_WGTMAP ? "cached" : "compute") );
+
+  // same post-read tasks as in read_gal_HOSTLIB
+  if ( INPUTS.HOSTLIB_GENZPHOT_OUTLIER[0] < 0.0 ) {
+    INPUTS.HOSTLIB_GENZPHOT_OUTLIER[0] = HOSTLIB.ZMIN ;
+    INPUTS.HOSTLIB_GENZPHOT_OUTLIER[1] = HOSTLIB.ZMAX ;
+  }
+
+  if ( HOSTLIB.NSTAR > 0 ) {
+    printf("\n\t *** WARNING: %d entries might be stars (z<%.4f) **** \n\n",
+	   HOSTLIB.NSTAR, ZMAX_STAR);
+  }
+  fflush(stdout);
+
+  check_redshift_HOSTLIB();
+
+  return 1 ;
+
+ STALE:
+  printf("\t %s: %s is stale; will re-read text HOSTLIB and rewrite cache.\n",
+	 fnam, cache_file);
+  fflush(stdout);
+  return 0 ;
+
+} // end read_BINCACHE_HOSTLIB
+
+
+// =======================================
+void write_BINCACHE_HOSTLIB(void) {
+
+  // Created Oct 2026
+  // Write binary cache of z-sorted HOSTLIB for next job; see
+  // column layout in sntools_host.h. Cache is written to a temp file
+  // and then renamed so that parallel jobs never read partial file.
+  // Try HOSTLIB directory first; if not writable, use current dir.
+
+  int  NGAL       = HOSTLIB.NGAL_STORE ;
+  int  NVAR_STORE = HOSTLIB.NVAR_STORE ;
+  bool DO_WGTMAP  = HOSTLIB_BINCACHE.ALLOW_WGTMAP ;
+
+  BINCACHE_HEADER_HOSTLIB_DEF HEAD ;
+  FILE  *fp = NULL ;
+  int    icand, ivar, NPAD ;
+  char   cache_file[MXPATHLEN], tmp_file[MXPATHLEN+40], PAD[8] ;
+  size_t NWR = 0 ;
+  char fnam[] = "write_BINCACHE_HOSTLIB" ;
+
+  // --------------- BEGIN ---------------
+
+  if ( !HOSTLIB_BINCACHE.ALLOW ) { return; }
+  if (  HOSTLIB_BINCACHE.USE   ) { return; }
+  if ( NGAL <= 0 ) { return; }
+
+  memset(&HEAD, 0, sizeof(BINCACHE_HEADER_HOSTLIB_DEF) );
+  memset(PAD,   0, 8);
+
+  HEAD.MAGIC           = MAGIC_BINCACHE_HOSTLIB ;
+  HEAD.VERSION         = VERSION_BINCACHE_HOSTLIB ;
+  HEAD.CHECKSUM_SOURCE = HOSTLIB_BINCACHE.CHECKSUM_SOURCE ;
+  HEAD.CHECKSUM_INPUTS = HOSTLIB_BINCACHE.CHECKSUM_INPUTS ;
+  HEAD.CHECKSUM_WGTMAP = HOSTLIB_BINCACHE.CHECKSUM_WGTMAP ;
+  HEAD.SIZE_SOURCE     = HOSTLIB_BINCACHE.SIZE_SOURCE ;
+  HEAD.NGAL_READ       = HOSTLIB.NGAL_READ ;
+  HEAD.NGAL_STORE      = NGAL ;
+  HEAD.NVAR_STORE      = NVAR_STORE ;
+  HEAD.NSTAR           = HOSTLIB.NSTAR ;
+  HEAD.NZPTR           = HOSTLIB.NZPTR ;
+  HEAD.MINiz           = HOSTLIB.MINiz ;
+  HEAD.MAXiz           = HOSTLIB.MAXiz ;
+  HEAD.IGAL_FORCE      = HOSTLIB.IGAL_FORCE ;
+  HEAD.NGAL_WGTMAP     = ( DO_WGTMAP ? NGAL : 0 ) ;
+  HEAD.ZMIN            = HOSTLIB.ZMIN ;
+  HEAD.ZMAX            = HOSTLIB.ZMAX ;
+  HEAD.ZGAPMAX         = HOSTLIB.ZGAPMAX ;
+  HEAD.ZGAPAVG         = HOSTLIB.ZGAPAVG ;
+  HEAD.Z_ATGAPMAX[0]   = HOSTLIB.Z_ATGAPMAX[0] ;
+  HEAD.Z_ATGAPMAX[1]   = HOSTLIB.Z_ATGAPMAX[1] ;
+  HEAD.VPEC_RMS        = HOSTLIB.VPEC_RMS ;
+  HEAD.VPEC_AVG        = HOSTLIB.VPEC_AVG ;
+  HEAD.VPEC_MIN        = HOSTLIB.VPEC_MIN ;
+  HEAD.VPEC_MAX        = HOSTLIB.VPEC_MAX ;
+  for(ivar=0; ivar < NVAR_STORE; ivar++ ) {
+    HEAD.VALMIN[ivar] = HOSTLIB.VALMIN[ivar] ;
+    HEAD.VALMAX[ivar] = HOSTLIB.VALMAX[ivar] ;
+    sprintf(HEAD.VARNAME_STORE[ivar], "%s", HOSTLIB.VARNAME_STORE[ivar]);
+  }
+
+  for(icand=0; icand < 2; icand++ ) {
+    name_BINCACHE_HOSTLIB(icand, cache_file);
+    sprintf(tmp_file, "%s.tmp%d", cache_file, (int)getpid() );
+    fp = fopen(tmp_file, "wb");
+    if ( fp != NULL ) { break; }
+  }
+
+  if ( fp == NULL ) {
+    printf("\t %s: WARNING: cannot write cache; skip.\n", fnam);
+    fflush(stdout);
+    return ;
+  }
+
+  NWR += fwrite(&HEAD, sizeof(BINCACHE_HEADER_HOSTLIB_DEF), 1, fp) ;
+  for(ivar=0; ivar < NVAR_STORE; ivar++ ) 
+    { NWR += fwrite(HOSTLIB.VALUE_ZSORTED[ivar], sizeof(double), NGAL, fp); }
+
+  if ( DO_WGTMAP ) 
+    { NWR += fwrite(HOSTLIB_WGTMAP.WGTSUM, sizeof(double), NGAL, fp); }
+
+  NWR += fwrite(HOSTLIB.LIBINDEX_ZSORT, sizeof(int), NGAL, fp);
+  NPAD = (8 - (NGAL*sizeof(int))%8 ) % 8 ;
+  fwrite(PAD, 1, NPAD, fp);
+
+  NWR += fwrite(HOSTLIB.IZPTR, sizeof(int), HOSTLIB.NZPTR, fp);
+  NPAD = (8 - (HOSTLIB.NZPTR*sizeof(int))%8 ) % 8 ;
+  fwrite(PAD, 1, NPAD, fp);
+
+  if ( DO_WGTMAP ) 
+    { NWR += fwrite(HOSTLIB_WGTMAP.I2SNMAGSHIFT, sizeof(short), NGAL, fp); }
+
+  fclose(fp);
+
+  // make sure every block was written before exposing the cache
+  size_t NWR_EXPECT = 1 + (size_t)NVAR_STORE*NGAL + NGAL + HOSTLIB.NZPTR ;
+  if ( DO_WGTMAP ) { NWR_EXPECT += 2*NGAL ; }
+  if ( NWR != NWR_EXPECT || rename(tmp_file, cache_file) != 0 ) {
+    remove(tmp_file);
+    printf("\t %s: WARNING: failed writing %s; skip.\n", fnam, cache_file);
+    fflush(stdout);
+    return ;
+  }
+
+  sprintf(HOSTLIB_BINCACHE.FILENAME, "%s", cache_file);
+  printf("\t Wrote HOSTLIB binary cache %s (%.2f MB)\n",
+	 cache_file, (double)size_BINCACHE_HOSTLIB(&HEAD)*1.0E-6 );
+  fflush(stdout);
+
+  return ;
+
+} // end write_BINCACHE_HOSTLIB
+
+
+// =======================================
+void checksum_BINCACHE_HOSTLIB(void) {
+
+  // Created Oct 2026
+  // Compute checksums used to validate HOSTLIB binary cache:
+  //  + SOURCE: FNV-1a hash of all bytes in HOSTLIB file (gzip or not)
+  //  + INPUTS: stored variables and inputs that select/modify rows
+  //  + WGTMAP: WGTMAP grid used to compute WGTSUM & SNMAGSHIFT
+
+  GRIDMAP_DEF *GRIDMAP = &HOSTLIB_WGTMAP.GRIDMAP ;
+  unsigned long long HASH ;
+  FILE   *fp ;
+  size_t  NRD, MEMBUF = 4000000 ;
+  long long SIZE = 0 ;
+  int     ivar, ifun, MSKOPT ;
+  char   *BUF ;
+  char fnam[] = "checksum_BINCACHE_HOSTLIB" ;
+
+  // --------------- BEGIN ---------------
+
+  // - - - source file - - - -
+  fp = fopen(HOSTLIB.FILENAME, "rb");
+  if ( fp == NULL ) {
+    sprintf(c1err,"Cannot open HOSTLIB to compute checksum:");
+    sprintf(c2err,"%s", HOSTLIB.FILENAME);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err); 
+  }
+
+  BUF  = (char*)malloc(MEMBUF);
+  HASH = 0 ;
+  while ( (NRD = fread(BUF, 1, MEMBUF, fp)) > 0 ) {
+    HASH  = fnv1a_BINCACHE_HOSTLIB(HASH, BUF, NRD);
+    SIZE += (long long)NRD ;
+  }
+  fclose(fp);  free(BUF);
+
+  HOSTLIB_BINCACHE.CHECKSUM_SOURCE = HASH ;
+  HOSTLIB_BINCACHE.SIZE_SOURCE     = SIZE ;
+
+  // - - - inputs that select which rows are stored, or modify them
+  MSKOPT = INPUTS.HOSTLIB_MSKOPT & 
+    (HOSTLIB_MSKOPT_SWAPZPHOT + HOSTLIB_MSKOPT_USEVPEC) ;
+
+  HASH = fnv1a_BINCACHE_HOSTLIB(0, &HOSTLIB.NVAR_STORE, sizeof(int));
+  for(ivar=0; ivar < HOSTLIB.NVAR_STORE; ivar++ ) {
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, HOSTLIB.VARNAME_STORE[ivar],
+				  strlen(HOSTLIB.VARNAME_STORE[ivar]) );
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &HOSTLIB.IVAR_ALL[ivar], 
+				  sizeof(int) );
+  }
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &MSKOPT, sizeof(int) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &HOSTLIB.FRAME_ZTRUE, sizeof(int) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &INPUTS.HOSTLIB_MAXREAD, sizeof(int));
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, INPUTS.GENRANGE_REDSHIFT, 
+				2*sizeof(double) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, INPUTS.HOSTLIB_GENRANGE_RA, 
+				2*sizeof(double) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, INPUTS.HOSTLIB_GENRANGE_DEC, 
+				2*sizeof(double) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &INPUTS.VEL_CMBAPEX, sizeof(double));
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &INPUTS.HOSTLIB_GALID_FORCE, 
+				sizeof(long long) );
+  HOSTLIB_BINCACHE.CHECKSUM_INPUTS = HASH ;
+
+  // - - - WGTMAP grid - - - 
+  HASH = fnv1a_BINCACHE_HOSTLIB(0, &GRIDMAP->NDIM, sizeof(int) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &GRIDMAP->NFUN, sizeof(int) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &GRIDMAP->NROW, sizeof(int) );
+  HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &HOSTLIB_WGTMAP.WGTMAX, 
+				sizeof(double) );
+  if ( GRIDMAP->NROW > 0 ) {
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, &GRIDMAP->OPT_EXTRAP, sizeof(int));
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, GRIDMAP->NBIN, 
+				  GRIDMAP->NDIM*sizeof(int) );
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, GRIDMAP->VALMIN, 
+				  GRIDMAP->NDIM*sizeof(double) );
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, GRIDMAP->VALMAX, 
+				  GRIDMAP->NDIM*sizeof(double) );
+    HASH = fnv1a_BINCACHE_HOSTLIB(HASH, HOSTLIB.IVAR_STORE, 
+				  GRIDMAP->NDIM*sizeof(int) );
+    for(ifun=0; ifun < GRIDMAP->NFUN; ifun++ ) {
+      HASH = fnv1a_BINCACHE_HOSTLIB(HASH, GRIDMAP->FUNVAL[ifun], 
+				    GRIDMAP->NROW*sizeof(double) );
+    }
+  }
+  HOSTLIB_BINCACHE.CHECKSUM_WGTMAP = HASH ;
+
+  return ;
+
+} // end checksum_BINCACHE_HOSTLIB
+
+
+// =======================================
+void name_BINCACHE_HOSTLIB(int icand, char *FILENAME) {
+
+  // Created Oct 2026
+  // Return candidate cache file name:
+  //   icand=0 -> [HOSTLIB].BINCACHE (same directory as HOSTLIB)
+  //   icand=1 -> ./[HOSTLIB base name].BINCACHE
+
+  char *base ;
+
+  // ----------- BEGIN ---------
+
+  if ( icand == 0 ) {
+    sprintf(FILENAME, "%s.%s", HOSTLIB.FILENAME, SUFFIX_BINCACHE_HOSTLIB);
+  }
+  else {
+    base = strrchr(HOSTLIB.FILENAME, '/');
+    if ( base == NULL ) { base = HOSTLIB.FILENAME; } else { base++ ; }
+    sprintf(FILENAME, "%s.%s", base, SUFFIX_BINCACHE_HOSTLIB);
+  }
+
+  return ;
+
+} // end name_BINCACHE_HOSTLIB
+
+
+// =======================================
+size_t size_BINCACHE_HOSTLIB(BINCACHE_HEADER_HOSTLIB_DEF *HEAD) {
+
+  // Created Oct 2026
+  // Return expected size (bytes) of cache file described by *HEAD.
+
+  size_t NGAL = (size_t)HEAD->NGAL_STORE ;
+  size_t SIZE = sizeof(BINCACHE_HEADER_HOSTLIB_DEF) ;
+
+  // ----------- BEGIN ---------
+
+  SIZE += (size_t)HEAD->NVAR_STORE * NGAL * sizeof(double) ;
+  SIZE += 8 * ((NGAL * sizeof(int) + 7)/8) ;
+  SIZE += 8 * (((size_t)HEAD->NZPTR * sizeof(int) + 7)/8) ;
+  if ( HEAD->NGAL_WGTMAP > 0 ) 
+    { SIZE += NGAL * (sizeof(double) + sizeof(short int)) ; }
+
+  return SIZE ;
+
+} // end size_BINCACHE_HOSTLIB
+
+
+// =======================================
+unsigned long long fnv1a_BINCACHE_HOSTLIB(unsigned long long HASH,
+					  const void *ptr, size_t NBYTE) {
+
+  // Created Oct 2026
+  // Update 64-bit FNV-1a hash with NBYTE bytes; HASH=0 starts new hash.
+
+  const unsigned char *c = (const unsigned char*)ptr ;
+  size_t i;
+
+  // ----------- BEGIN ---------
+
+  if ( HASH == 0 ) { HASH = 14695981039346656037ULL ; }
+  for(i=0; i < NBYTE; i++ ) {
+    HASH ^= (unsigned long long)c[i] ;
+    HASH *= 1099511628211ULL ;
+  }
+  return HASH ;
+
+} // end fnv1a_BINCACHE_HOSTLIB
+
 // =======================================
 void init_HOSTLIB_WGTMAP(int OPT_INIT, int IGAL_START, int IGAL_END) {
 
@@ -6130,8 +6646,11 @@ void GEN_SNHOST_GALID(double ZGEN) {
   //
   // Nov 23 2019: for MODEL_SIMLIB, force GALID to value in SIMLIB header.
   // Dec 30 2021: minor refactor to make igal loops faster with binary search.
+  // Oct 2026: check FASTSELECT option for binary search of z-range
+  //           and weighted selection without linear search.
 
   bool DO_SN2GAL_Z  = (INPUTS.HOSTLIB_MSKOPT & HOSTLIB_MSKOPT_SN2GAL_Z);
+  bool DO_FASTSELECT = (INPUTS.HOSTLIB_MSKOPT & HOSTLIB_MSKOPT_FASTSELECT);
 
   int  IGAL_JUMP           = 20 ; // spped search for approx start range
   int  IGAL_RANGE_CONVERGE = 5;   // convergence for binary search
@@ -6190,6 +6709,12 @@ void GEN_SNHOST_GALID(double ZGEN) {
   LOGZDIF    = LOGZTOLMAX - MINLOGZ_HOSTLIB;
   IZ_TOLMAX  = (int)( LOGZDIF/DZPTR + 0.5 ) ; 
 
+  if ( DO_FASTSELECT ) {
+    get_zrange_FASTSELECT_HOSTLIB(ZGEN, dztol, &igal_start, &igal_end);
+    igal_start_init = igal_start ;  igal_end_init = igal_end ;
+    goto CHECK_IGAL_RANGE ;
+  }
+
   // - - - - - - -
   // select min GALID using dztol from user
 
@@ -6242,6 +6767,8 @@ void GEN_SNHOST_GALID(double ZGEN) {
   // - - - - - - - - - - - - - - - - - - - - - - - -  -
   // back up one step to stay inside dztol
   igal_start++ ;    igal_end--   ; 
+
+ CHECK_IGAL_RANGE:
   z_start = get_ZTRUE_HOSTLIB(igal_start); 
   z_end   = get_ZTRUE_HOSTLIB(igal_end); 
 
@@ -6301,6 +6828,11 @@ void GEN_SNHOST_GALID(double ZGEN) {
 
   NSKIP_WGT   = NSKIP_USED = NGAL_CHECK = 0 ;
 
+  // store original igal range before any goto DONE_SELECT_GALID,
+  // since abort dump below prints these.
+  int igal_start_orig = igal_start;
+  int igal_end_orig   = igal_end;
+
   if ( ISMODEL_SIMLIB  &&  SIMLIB_HEADER.GALID > 0 ) { 
     INPUTS.HOSTLIB_GALID_PRIORITY[0] = SIMLIB_HEADER.GALID;
     INPUTS.HOSTLIB_GALID_PRIORITY[1] = SIMLIB_HEADER.GALID;
@@ -6332,6 +6864,15 @@ void GEN_SNHOST_GALID(double ZGEN) {
     goto DONE_SELECT_GALID ;
   }
 
+  // Oct 2026: O(logN) weighted selection. GROUPID match and 
+  // re-use with MJD-separation still use search below.
+  if ( DO_FASTSELECT && NGROUPID == 0 && SAMEHOST.REUSE_FLAG < 2 ) {
+    int itree = ( N_SNVAR > 0 ) ? ibin_SNVAR : 0 ;
+    IGAL_SELECT = select_FASTSELECT_HOSTLIB(igal_start, igal_end, ptrWGT,
+					    itree, FlatRan1_GALID);
+    goto DONE_SELECT_GALID ;
+  }
+
   // ---------------------------------------------------
 
   // perform binary search to restrict igal range to within a few galaxies
@@ -6380,9 +6921,6 @@ void GEN_SNHOST_GALID(double ZGEN) {
 
 
   // reset igal_start[end] for brute-force search below.
-  int igal_start_orig = igal_start;
-  int igal_end_orig   = igal_end;
-
   NGAL_CHECK = 0 ;
   igal_start = igal0; // restrict igal search range based on binary search above
   if ( !USEONCE ) { igal_end = igal1; } // idem
@@ -6613,6 +7151,7 @@ int USEHOST_GALID(int IGAL) {
     if ( NUSE_PRIOR == 0 ) {
       SAMEHOST.NUSE[IGAL]++ ;
       retCode = 1 ;
+      if ( HOSTLIB_FENWICK.USE ) { remove_HOSTLIB_FENWICK(IGAL); }
     }
   }
   else if ( SAMEHOST.REUSE_FLAG == 1 ) {
@@ -6760,6 +7299,244 @@ void FREEHOST_GALID(int IGAL) {
 
 } // end UNUSE_HOST_GALID
 
+
+// =========================================
+void get_zrange_FASTSELECT_HOSTLIB(double ZGEN, double dztol,
+				   int *igal_start, int *igal_end) {
+
+  // Created Oct 2026
+  // Use binary search on redshift-sorted HOSTLIB to return 
+  // igal range with ZGEN-dztol < ZTRUE < ZGEN+dztol.
+  // Edge logic is the same as for the IGAL_JUMP search in
+  // GEN_SNHOST_GALID, but without the linear steps.
+
+  int NGAL = HOSTLIB.NGAL_STORE ;
+  int igal ;
+
+  // ----------- BEGIN ------------
+
+  // last galaxy with z <= ZGEN-dztol, then next galaxy
+  igal = igal_below_zsorted_HOSTLIB(ZGEN-dztol, true);
+  if ( igal < 1 ) { igal = 1; }
+  *igal_start = igal + 1 ;
+
+  // first galaxy with z >= ZGEN+dztol, then previous galaxy
+  igal = igal_below_zsorted_HOSTLIB(ZGEN+dztol, false) + 1 ;
+  if ( igal > NGAL-1 ) { igal = NGAL-1; }
+  *igal_end = igal - 1 ;
+
+  return ;
+
+} // end get_zrange_FASTSELECT_HOSTLIB
+
+
+// =========================================
+int igal_below_zsorted_HOSTLIB(double z, bool INCLUDE_EQUAL) {
+
+  // Created Oct 2026
+  // Return largest igal with ZTRUE(igal) < z 
+  // (or <= z if INCLUDE_EQUAL); return -1 if all ZTRUE are above z.
+
+  int    ivar  = IVAR_HOSTLIB(HOSTLIB_VARNAME_ZTRUE,1);
+  double *ZSORT = HOSTLIB.VALUE_ZSORTED[ivar] ;
+  int    lo = -1, hi = HOSTLIB.NGAL_STORE, mid ;
+  bool   BELOW ;
+
+  // ----------- BEGIN ------------
+
+  // invariant: ZSORT[lo] is below, ZSORT[hi] is not below
+  while ( hi - lo > 1 ) {
+    mid = (lo + hi) / 2 ;
+    if ( INCLUDE_EQUAL ) 
+      { BELOW = ( ZSORT[mid] <= z ); }
+    else
+      { BELOW = ( ZSORT[mid] <  z ); }
+
+    if ( BELOW ) { lo = mid; } else { hi = mid; }
+  }
+
+  return lo ;
+
+} // end igal_below_zsorted_HOSTLIB
+
+
+// =========================================
+int select_FASTSELECT_HOSTLIB(int igal_start, int igal_end, 
+			      double *ptrWGT, int itree, double FlatRan) {
+
+  // Created Oct 2026
+  // Return igal in [igal_start,igal_end] selected with probability
+  // proportional to its WGTMAP weight; ptrWGT is cumulative weight.
+  //  + without USEONCE: binary search of cumulative ptrWGT.
+  //  + with USEONCE: search Fenwick tree in which used galaxies 
+  //    have zero weight, so used galaxies are never probed.
+  // Both are O(log NGAL). Returns -9 if all weights are zero.
+
+  double *TREE, WGT_start, WGT_end, WGT_select ;
+  int    igal, lo, hi, mid ;
+
+  // ----------- BEGIN ------------
+
+  if ( HOSTLIB_FENWICK.USE ) {
+    TREE      = HOSTLIB_FENWICK.TREE[itree] ;
+    WGT_start = sum_HOSTLIB_FENWICK(TREE, igal_start-1);
+    WGT_end   = sum_HOSTLIB_FENWICK(TREE, igal_end);
+    if ( WGT_end <= WGT_start ) { return(-9); }
+
+    WGT_select = WGT_start + FlatRan * (WGT_end - WGT_start) ;
+    igal       = search_HOSTLIB_FENWICK(TREE, WGT_select);
+  }
+  else {
+    WGT_start = ( igal_start > 0 ) ? ptrWGT[igal_start-1] : 0.0 ;
+    WGT_end   = ptrWGT[igal_end] ;
+    if ( WGT_end <= WGT_start ) { return(-9); }
+
+    // first igal with cumulative WGT > WGT_select
+    WGT_select = WGT_start + FlatRan * (WGT_end - WGT_start) ;
+    lo = igal_start - 1 ;  hi = igal_end ;
+    while ( hi - lo > 1 ) {
+      mid = (lo + hi) / 2 ;
+      if ( ptrWGT[mid] > WGT_select ) { hi = mid; } else { lo = mid; }
+    }
+    igal = hi ;
+  }
+
+  // protect against round-off
+  if ( igal < igal_start ) { igal = igal_start; }
+  if ( igal > igal_end   ) { igal = igal_end;   }
+
+  if ( USEHOST_GALID(igal) ) { return(igal); }
+
+  // should only get here from round-off landing on used host;
+  // take nearest available host.
+  for ( mid = igal+1; mid <= igal_end; mid++ ) 
+    { if ( USEHOST_GALID(mid) ) { return(mid); } }
+  for ( mid = igal-1; mid >= igal_start; mid-- ) 
+    { if ( USEHOST_GALID(mid) ) { return(mid); } }
+
+  return(-9);
+
+} // end select_FASTSELECT_HOSTLIB
+
+
+// =========================================
+void init_HOSTLIB_FENWICK(void) {
+
+  // Created Oct 2026
+  // For FASTSELECT + USEONCE, build Fenwick tree of galaxy weights 
+  // for each SNVAR bin. Build is O(NGAL) per tree.
+
+  int  MSKOPT  = INPUTS.HOSTLIB_MSKOPT ;
+  bool USEONCE = (MSKOPT & HOSTLIB_MSKOPT_USEONCE) ;
+  bool FAST    = (MSKOPT & HOSTLIB_MSKOPT_FASTSELECT) ;
+  int  NGAL    = HOSTLIB.NGAL_STORE ;
+  int  NTREE, itree, igal, i, j, step ;
+  double *TREE, *ptrWGT, MEM_MB ;
+  char fnam[] = "init_HOSTLIB_FENWICK" ;
+
+  // ----------- BEGIN ------------
+
+  HOSTLIB_FENWICK.USE     = false ;
+  HOSTLIB_FENWICK.NREMOVE = 0 ;
+  if ( !(FAST && USEONCE) ) { return; }
+
+  if ( HOSTLIB_WGTMAP.N_SNVAR > 0 ) 
+    { NTREE = HOSTLIB_WGTMAP.NBTOT_SNVAR; }
+  else
+    { NTREE = 1 ; }
+
+  MEM_MB = 1.0E-6 * (double)NTREE * (double)(NGAL+1) * sizeof(double);
+  printf("\t %s: %d tree(s) for %d hosts (%.1f MB)\n", 
+	 fnam, NTREE, NGAL, MEM_MB);
+  fflush(stdout);
+
+  HOSTLIB_FENWICK.NGAL  = NGAL ;
+  HOSTLIB_FENWICK.NTREE = NTREE ;
+  HOSTLIB_FENWICK.TREE  = (double**) malloc(NTREE*sizeof(double*));
+
+  for(step=1; step*2 <= NGAL; step *= 2 ) { ; }
+  HOSTLIB_FENWICK.STEP_MAX = step ;
+
+  for(itree=0; itree < NTREE; itree++ ) {
+    if ( HOSTLIB_WGTMAP.N_SNVAR > 0 ) 
+      { ptrWGT = HOSTLIB_WGTMAP.WGTSUM_SNVAR[itree]; }
+    else
+      { ptrWGT = HOSTLIB_WGTMAP.WGTSUM; }
+
+    TREE = (double*) malloc( (NGAL+1)*sizeof(double) );
+    TREE[0] = 0.0 ;
+    for(igal=0; igal < NGAL; igal++ ) {
+      TREE[igal+1] = ptrWGT[igal];
+      if ( igal > 0 ) { TREE[igal+1] -= ptrWGT[igal-1]; }
+    }
+
+    // O(N) build: add each node to its parent
+    for(i=1; i <= NGAL; i++ ) {
+      j = i + (i & -i);
+      if ( j <= NGAL ) { TREE[j] += TREE[i]; }
+    }
+    HOSTLIB_FENWICK.TREE[itree] = TREE;
+  }
+
+  HOSTLIB_FENWICK.USE = true ;
+
+  return ;
+
+} // end init_HOSTLIB_FENWICK
+
+
+// =========================================
+void remove_HOSTLIB_FENWICK(int IGAL) {
+
+  // Created Oct 2026
+  // Set weight of IGAL to zero in each Fenwick tree.
+
+  int    NGAL = HOSTLIB_FENWICK.NGAL ;
+  int    itree, i ;
+  double WGT, *TREE ;
+
+  // ----------- BEGIN ------------
+
+  for(itree=0; itree < HOSTLIB_FENWICK.NTREE; itree++ ) {
+    TREE = HOSTLIB_FENWICK.TREE[itree] ;
+    WGT  = sum_HOSTLIB_FENWICK(TREE, IGAL) - 
+      sum_HOSTLIB_FENWICK(TREE, IGAL-1);
+    if ( WGT == 0.0 ) { continue; }
+    for(i=IGAL+1; i <= NGAL; i += (i & -i) ) { TREE[i] -= WGT; }
+  }
+
+  HOSTLIB_FENWICK.NREMOVE++ ;
+
+  return ;
+
+} // end remove_HOSTLIB_FENWICK
+
+
+// =========================================
+double sum_HOSTLIB_FENWICK(double *TREE, int igal) {
+  // Created Oct 2026
+  // Return sum of weights for galaxies 0 to igal (0 if igal<0)
+  double SUM = 0.0 ;
+  int i;
+  for(i=igal+1; i > 0; i -= (i & -i) ) { SUM += TREE[i]; }
+  return SUM ;
+} // end sum_HOSTLIB_FENWICK
+
+
+// =========================================
+int search_HOSTLIB_FENWICK(double *TREE, double WGT) {
+  // Created Oct 2026
+  // Return smallest igal with sum(0:igal) > WGT.
+  int NGAL = HOSTLIB_FENWICK.NGAL ;
+  int pos  = 0, step ;
+  double REM = WGT ;
+  for(step = HOSTLIB_FENWICK.STEP_MAX; step > 0; step /= 2 ) {
+    if ( pos+step <= NGAL && TREE[pos+step] <= REM ) 
+      { pos += step ;  REM -= TREE[pos]; }
+  }
+  return pos ; // pos is 1-based index of last galaxy with sum <= WGT
+} // end search_HOSTLIB_FENWICK
+
 // =========================================
 void GEN_SNHOST_ZPHOT(int IGAL) {
 
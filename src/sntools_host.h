@@ -29,6 +29,8 @@
  Aug 11 2023: MXROW_HOSTLIB -> 40M (was 10M)
  Oct 03 2023: MXROW_HOSTLIB -> 60M
 
+ Oct 2026: add HOSTLIB_BINCACHE struct for binary (mmap) HOSTLIB cache.
+
 ==================================================== */
 
 #define HOSTLIB_MSKOPT_USE           1 // internally set if HOSTLIB_FILE
@@ -49,6 +51,8 @@
 #define HOSTLIB_MSKOPT_PLUSMAGS   8192  // compute & add host mags from SED
 #define HOSTLIB_MSKOPT_PLUSNBR   16384  // append list of nbr to HOSTLIB
 #define HOSTLIB_MSKOPT_ZPHOT_QGAUSS 32768  // write Gauss quantiles for zPHOT
+#define HOSTLIB_MSKOPT_FASTSELECT  65536  // O(logN) z-range & host select
+#define HOSTLIB_MSKOPT_BINCACHE   131072  // read/write binary z-sorted cache
 
 #define HOSTLIB_FLAG_USE      1   // for INPUTS.HOSTLIB_USE
 #define HOSTLIB_FLAG_REWRITE  2   // for INPUTS.HOSTLIB_USE
@@ -340,6 +344,58 @@ struct {
 } HOSTLIB_CUTS;
 
 
+// Oct 2026: Fenwick (binary indexed) trees of galaxy weights for 
+// FASTSELECT + USEONCE; used hosts are removed by setting weight=0.
+struct {
+  bool    USE ;
+  int     NGAL ;
+  int     NTREE ;      // number of SNVAR bins (1 if no SNVAR)
+  int     STEP_MAX ;   // largest power of 2 <= NGAL
+  double **TREE ;      // [itree][1:NGAL]; TREE[itree][0] not used
+  int     NREMOVE ;    // number of removed hosts
+} HOSTLIB_FENWICK ;
+
+// Oct 2026: binary columnar cache of z-sorted HOSTLIB (HOSTLIB_MSKOPT
+// += 131072). Cache file has a fixed header followed by 8-byte aligned
+// column blocks:
+//   VALUE_ZSORTED[ivar][igal]  (double, NVAR_STORE columns)
+//   WGTSUM[igal]               (double, only if NGAL_WGTMAP > 0)
+//   LIBINDEX_ZSORT[igal]       (int)
+//   IZPTR[iz]                  (int)
+//   I2SNMAGSHIFT[igal]         (short, only if NGAL_WGTMAP > 0)
+#define MAGIC_BINCACHE_HOSTLIB    0x4C48534E  // "SNHL"
+#define VERSION_BINCACHE_HOSTLIB  1
+#define SUFFIX_BINCACHE_HOSTLIB   "BINCACHE"
+
+typedef struct {
+  int  MAGIC, VERSION ;
+  unsigned long long CHECKSUM_SOURCE ; // FNV-1a hash of HOSTLIB file
+  unsigned long long CHECKSUM_INPUTS ; // sim-inputs that select/modify rows
+  unsigned long long CHECKSUM_WGTMAP ; // WGTMAP grid (0 -> no WGTMAP block)
+  long long SIZE_SOURCE ;              // HOSTLIB file size (bytes)
+
+  int  NGAL_READ, NGAL_STORE, NVAR_STORE, NSTAR ;
+  int  NZPTR, MINiz, MAXiz, IGAL_FORCE ;
+  int  NGAL_WGTMAP, IDUM ;
+
+  double ZMIN, ZMAX, ZGAPMAX, ZGAPAVG, Z_ATGAPMAX[2] ;
+  double VPEC_RMS, VPEC_AVG, VPEC_MIN, VPEC_MAX ;
+  double VALMIN[MXVAR_HOSTLIB], VALMAX[MXVAR_HOSTLIB] ;
+  char   VARNAME_STORE[MXVAR_HOSTLIB][40] ;
+} BINCACHE_HEADER_HOSTLIB_DEF ;
+
+struct {
+  bool   ALLOW ;        // T -> cache can be used for these inputs
+  bool   ALLOW_WGTMAP ; // T -> WGTMAP sums can be cached too
+  bool   USE ;          // T -> rows were loaded from cache
+  bool   USE_WGTMAP ;   // T -> WGTSUM & I2SNMAGSHIFT loaded from cache
+  char   FILENAME[MXPATHLEN] ;  // cache file that was read or written
+  unsigned long long CHECKSUM_SOURCE, CHECKSUM_INPUTS, CHECKSUM_WGTMAP ;
+  long long SIZE_SOURCE ;
+  void   *MAP_ADDR ;    // mmap address; pointers below point inside
+  size_t  MAP_SIZE ;
+} HOSTLIB_BINCACHE ;
+
 struct SAMEHOST_DEF {
   int REUSE_FLAG ;          // 1-> re-use host
   unsigned short  *NUSE ;     // number of times each host is used.
@@ -678,7 +734,23 @@ void   GEN_SNHOST_LOGMASS(void); // Feb 2020
 void   GEN_SNHOST_PROPERTY(int ivar_property); 
 int    USEHOST_GALID(int IGAL) ;
 void   FREEHOST_GALID(int IGAL) ;
+void   get_zrange_FASTSELECT_HOSTLIB(double ZGEN, double dztol,
+				     int *igal_start, int *igal_end);
+int    igal_below_zsorted_HOSTLIB(double z, bool INCLUDE_EQUAL);
+int    select_FASTSELECT_HOSTLIB(int igal_start, int igal_end, 
+				 double *ptrWGT, int itree, double FlatRan);
+void   init_HOSTLIB_FENWICK(void);
+void   remove_HOSTLIB_FENWICK(int IGAL);
+double sum_HOSTLIB_FENWICK(double *TREE, int igal);
+int    search_HOSTLIB_FENWICK(double *TREE, double WGT);
 void   checkAbort_noHOSTLIB(void) ;
+int    read_BINCACHE_HOSTLIB(void);
+void   write_BINCACHE_HOSTLIB(void);
+void   checksum_BINCACHE_HOSTLIB(void);
+void   name_BINCACHE_HOSTLIB(int icand, char *FILENAME);
+size_t size_BINCACHE_HOSTLIB(BINCACHE_HEADER_HOSTLIB_DEF *HEAD);
+unsigned long long fnv1a_BINCACHE_HOSTLIB(unsigned long long HASH,
+					  const void *ptr, size_t NBYTE);
 void   checkAbort_HOSTLIB(void) ;
 
 void   STORE_SNHOST_MISC(int IGAL, int ibin_SNVAR);
@@ -49,6 +49,14 @@
     + adjust computations in nearnbr_whichType() to account for SCALE_NON1A
     + adjust NEARNBR_GETRESULTS to account for SCALE_NON1A
 
+  Oct 2026: 
+    + build k-d tree of training events in NEARNBR_INIT2, and use
+      range query inside largest SEPMAX ellipsoid to get training
+      subset, instead of looping over all training events.
+      CELLMAP option (NCHOP>1) is still used for APPLY if set.
+    + new NEARNBR_APPLY_BATCH(...) to process many events with
+      pthreads; histograms are filled afterwards in event order.
+
 **********************************************/
 
 #include <stdio.h> 
@@ -56,6 +64,7 @@
 #include <stdlib.h>   
 #include <unistd.h>
 #include <math.h>  
+#include <pthread.h>
 
 #include "sntools.h" 
 
@@ -464,6 +473,9 @@ void NEARNBR_INIT2(int ISPLIT) {
   // init SUBSET to be entire training lib
   nearnbr_init_SUBSET() ;
 
+  // k-d tree for fast lookup of training subset (Oct 2026)
+  nearnbr_kdtree_init();
+
   // init speedup for APPLY mode
   if ( NN_APPLYFLAG ) { NEARNBR_CELLMAP_INIT(0) ; }
 
@@ -1433,17 +1445,25 @@ void nearnbr_apply__( char *CCID) {  NEARNBR_APPLY(CCID) ; }
 float  nearnbr_SQDIST(int isep,int itrain) {
 
   // return NN distance
+  return nearnbr_SQDIST_ARRAY(isep, itrain, NEARNBR_STORE.SQSEP) ;
+
+} // end of nearnbr_SQDIST
+
+// =====================================================
+float  nearnbr_SQDIST_ARRAY(int isep, int itrain, float **SQSEP_ARRAY) {
+
+  // Oct 2026: same as nearnbr_SQDIST, but pass SQSEP_ARRAY[ivar][itrain]
+  //   so that each thread can use its own array.
 
   int ivar ;
   int NVAR   = NEARNBR_INPUTS.NVAR ;
   float SQSEP, SQSEPMAX, SQDIST ;
-  //  char fnam[] = "nearnbr_SQDIST" ;
 
   // --------------- BEGIN ---------------
 
   SQDIST = 0.0 ;
   for(ivar=0; ivar < NVAR; ivar++ ) {
-    SQSEP    = NEARNBR_STORE.SQSEP[ivar][itrain] ;
+    SQSEP    = SQSEP_ARRAY[ivar][itrain] ;
     SQSEPMAX = NEARNBR_LIST_SQSEPMAX[ivar][isep] ;
     if ( SQSEP > SQSEPMAX) { return(99.0); } 
     SQDIST  += (SQSEP/SQSEPMAX);
@@ -1451,7 +1471,442 @@ float  nearnbr_SQDIST(int isep,int itrain) {
 
   return SQDIST ;
 
-} // end of nearnbr_SQDIST
+} // end of nearnbr_SQDIST_ARRAY
+
+// ===================================================
+void nearnbr_kdtree_init(void) {
+
+  // Created Oct 2026
+  // Build k-d tree of training events with valid TRUETYPE.
+  // Each node splits on the variable with largest spread in units
+  // of the largest SEPMAX, so that tree cells are roughly
+  // "round" in the metric used by nearnbr_SQDIST.
+  // Build is N*log(N), and each range query is ~log(N) + NSUBSET.
+
+  int NTRAIN_TOT = NEARNBR_TRAINLIB.NTOT ;
+  int NTRAIN = 0, itrain, MEMI, MEMC ;
+  double t0, t1 ;
+  char fnam[] = "nearnbr_kdtree_init" ;
+
+  // ------------ BEGIN -------------
+
+  // free tree from previous NEARNBR_INIT2 call
+  if ( NEARNBR_KDTREE.MEMTOT > 0 ) {
+    free(NEARNBR_KDTREE.ITRAIN);
+    free(NEARNBR_KDTREE.SPLITDIM);
+    NEARNBR_KDTREE.MEMTOT = 0 ;
+  }
+
+  NEARNBR_KDTREE.USE    = 0 ;
+  NEARNBR_KDTREE.NTRAIN = 0 ;
+  if ( NTRAIN_TOT <= 0 ) { return ; }
+
+  MEMI = NTRAIN_TOT * sizeof(int);
+  MEMC = NTRAIN_TOT * sizeof(char);
+  NEARNBR_KDTREE.ITRAIN   = (int *)malloc(MEMI);
+  NEARNBR_KDTREE.SPLITDIM = (char*)malloc(MEMC);
+  NEARNBR_KDTREE.MEMTOT   = MEMI + MEMC ;
+
+  for(itrain=0; itrain < NTRAIN_TOT; itrain++ ) {
+    if ( NEARNBR_TRAINLIB.TRUETYPE[itrain] < 0 ) { continue; }
+    NEARNBR_KDTREE.ITRAIN[NTRAIN]   = itrain ;
+    NEARNBR_KDTREE.SPLITDIM[NTRAIN] = -1 ;
+    NTRAIN++ ;
+  }
+  NEARNBR_KDTREE.NTRAIN = NTRAIN ;
+
+  t0 = (double)clock();
+  nearnbr_kdtree_build(0, NTRAIN);
+  t1 = (double)clock();
+
+  NEARNBR_KDTREE.USE = 1 ;
+
+  printf("\t %s: %d training events in k-d tree (%.2f sec, %.2f MB)\n",
+	 fnam, NTRAIN, (t1-t0)/(double)CLOCKS_PER_SEC, 
+	 1.0E-6*(double)NEARNBR_KDTREE.MEMTOT );
+  fflush(stdout);
+
+  return ;
+
+} // end nearnbr_kdtree_init
+
+
+// ===================================================
+void nearnbr_kdtree_build(int ILO, int IHI) {
+
+  // Created Oct 2026
+  // Recursively build k-d tree for index range [ILO,IHI)
+  // of NEARNBR_KDTREE.ITRAIN.
+
+  int   NVAR = NEARNBR_INPUTS.NVAR ;
+  int   ISEP = NBINTOT_SEPMAX_NEARNBR - 1 ;  // largest SEPMAX
+  int   IMID, ivar, IDIM, i, itrain ;
+  float VAL, VMIN, VMAX, SPREAD, SPREAD_MAX ;
+  float *VALUES ;
+
+  // ------------ BEGIN -------------
+
+  if ( IHI - ILO <= NLEAF_KDTREE_NEARNBR ) { return ; }
+
+  // pick variable with largest spread relative to SEPMAX
+  IDIM = 0 ;  SPREAD_MAX = -1.0 ;
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    VALUES = NEARNBR_TRAINLIB.FITRES_VALUES[ivar] ;
+    VMIN = VMAX = VALUES[NEARNBR_KDTREE.ITRAIN[ILO]] ;
+    for(i=ILO+1; i < IHI; i++ ) {
+      itrain = NEARNBR_KDTREE.ITRAIN[i] ;
+      VAL    = VALUES[itrain] ;
+      if ( VAL < VMIN ) { VMIN = VAL; }
+      if ( VAL > VMAX ) { VMAX = VAL; }
+    }
+    SPREAD = (VMAX-VMIN) / NEARNBR_LIST_SEPMAX[ivar][ISEP] ;
+    if ( SPREAD > SPREAD_MAX ) { SPREAD_MAX = SPREAD; IDIM = ivar; }
+  }
+
+  IMID = (ILO + IHI) / 2 ;
+  nearnbr_kdtree_select(ILO, IHI, IMID, IDIM);
+  NEARNBR_KDTREE.SPLITDIM[IMID] = (char)IDIM ;
+
+  nearnbr_kdtree_build(ILO,    IMID);
+  nearnbr_kdtree_build(IMID+1, IHI );
+
+  return ;
+
+} // end nearnbr_kdtree_build
+
+
+// ===================================================
+void nearnbr_kdtree_select(int ILO, int IHI, int K, int IDIM) {
+
+  // Created Oct 2026
+  // Partial sort (quickselect) of NEARNBR_KDTREE.ITRAIN[ILO:IHI-1]
+  // so that element K has the median value of variable IDIM,
+  // elements before K are <= and elements after K are >= .
+
+  int   *LIST   = NEARNBR_KDTREE.ITRAIN ;
+  float *VALUES = NEARNBR_TRAINLIB.FITRES_VALUES[IDIM] ;
+  int   LO = ILO, HI = IHI-1, i, j, itmp ;
+  float PIVOT ;
+
+  // ------------ BEGIN -------------
+
+  while ( HI > LO ) {
+    PIVOT = VALUES[LIST[(LO+HI)/2]] ;
+    i = LO ;  j = HI ;
+    while ( i <= j ) {
+      while ( VALUES[LIST[i]] < PIVOT ) { i++ ; }
+      while ( VALUES[LIST[j]] > PIVOT ) { j-- ; }
+      if ( i <= j ) {
+	itmp = LIST[i]; LIST[i] = LIST[j]; LIST[j] = itmp ;
+	i++ ;  j-- ;
+      }
+    }
+    if      ( K <= j ) { HI = j ; }
+    else if ( K >= i ) { LO = i ; }
+    else               { break ; }
+  }
+
+  return ;
+
+} // end nearnbr_kdtree_select
+
+
+// ===================================================
+void nearnbr_kdtree_query(float *VAL, int ISEP, int ILO, int IHI,
+			  int *NSUBSET, int *ITRAIN_SUBSET, float **SQSEP) {
+
+  // Created Oct 2026
+  // Range query for k-d tree nodes in [ILO,IHI):
+  // append to ITRAIN_SUBSET each training event inside the SEPMAX
+  // ellipsoid for ISEP bin, centered at VAL[ivar]. 
+  // SQSEP[ivar][itrain] is filled for each tested itrain.
+  // Caller passes ILO=0 and IHI=NEARNBR_KDTREE.NTRAIN, which
+  // resets *NSUBSET=0.
+  // Subset order is tree order; results (counts) do not depend on order.
+
+  int   IMID, IDIM, itrain, i ;
+  float DIF, SQDIF, SQSEPMAX ;
+
+  // ------------ BEGIN -------------
+
+  if ( ILO == 0 && IHI == NEARNBR_KDTREE.NTRAIN ) { *NSUBSET = 0 ; }
+  if ( IHI <= ILO ) { return ; }
+
+  if ( IHI - ILO <= NLEAF_KDTREE_NEARNBR ) {
+    for(i=ILO; i < IHI; i++ ) {
+      itrain = NEARNBR_KDTREE.ITRAIN[i] ;
+      nearnbr_kdtree_test(VAL, ISEP, itrain, NSUBSET, ITRAIN_SUBSET, SQSEP);
+    }
+    return ;
+  }
+
+  IMID     = (ILO + IHI) / 2 ;
+  IDIM     = (int)NEARNBR_KDTREE.SPLITDIM[IMID] ;
+  itrain   = NEARNBR_KDTREE.ITRAIN[IMID] ;
+  DIF      = VAL[IDIM] - NEARNBR_TRAINLIB.FITRES_VALUES[IDIM][itrain] ;
+  SQDIF    = DIF * DIF ;
+  SQSEPMAX = NEARNBR_LIST_SQSEPMAX[IDIM][ISEP] * 1.0001 ;
+
+  nearnbr_kdtree_test(VAL, ISEP, itrain, NSUBSET, ITRAIN_SUBSET, SQSEP);
+
+  // search side containing VAL, and other side only if split
+  // plane is within SEPMAX
+  if ( DIF <= 0.0 ) {
+    nearnbr_kdtree_query(VAL, ISEP, ILO, IMID, 
+			 NSUBSET, ITRAIN_SUBSET, SQSEP);
+    if ( SQDIF <= SQSEPMAX ) 
+      { nearnbr_kdtree_query(VAL, ISEP, IMID+1, IHI, 
+			     NSUBSET, ITRAIN_SUBSET, SQSEP); }
+  }
+  else {
+    nearnbr_kdtree_query(VAL, ISEP, IMID+1, IHI, 
+			 NSUBSET, ITRAIN_SUBSET, SQSEP);
+    if ( SQDIF <= SQSEPMAX ) 
+      { nearnbr_kdtree_query(VAL, ISEP, ILO, IMID, 
+			     NSUBSET, ITRAIN_SUBSET, SQSEP); }
+  }
+
+  return ;
+
+} // end nearnbr_kdtree_query
+
+
+// ===================================================
+void nearnbr_kdtree_test(float *VAL, int ISEP, int itrain, 
+			 int *NSUBSET, int *ITRAIN_SUBSET, float **SQSEP) {
+
+  // Created Oct 2026
+  // Store SQSEP for itrain, and append itrain to subset if
+  // it is inside SEPMAX ellipsoid.
+
+  int    NVAR = NEARNBR_INPUTS.NVAR ;
+  int    ivar ;
+  double SEP ;
+
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    SEP = (double)VAL[ivar] - 
+      (double)NEARNBR_TRAINLIB.FITRES_VALUES[ivar][itrain] ;
+    SQSEP[ivar][itrain] = (float)(SEP*SEP) ;
+  }
+
+  if ( nearnbr_SQDIST_ARRAY(ISEP, itrain, SQSEP) < 1.0 ) {
+    ITRAIN_SUBSET[*NSUBSET] = itrain ;
+    (*NSUBSET)++ ;
+  }
+
+} // end nearnbr_kdtree_test
+
+
+// =====================================
+void NEARNBR_APPLY_BATCH(int NEVT, float **VALUES, int *TRUETYPE, 
+			 int NTHREAD, int *ITYPE_BEST, int *NCELL_TRAIN) {
+
+  // Created Oct 2026
+  // Batch version of NEARNBR_LOADVAL + NEARNBR_APPLY + NEARNBR_GETRESULTS
+  // for NEVT events, using NTHREAD threads. Intended for training
+  // pass with many events and many SEPMAX bins.
+  //
+  // Inputs:
+  //   NEVT                : number of events
+  //   VALUES[ivar][ievt]  : NN variables, same order as NEARNBR_SET_SEPMAX
+  //   TRUETYPE[ievt]      : true type (needed for training histograms),
+  //                         or NULL
+  //   NTHREAD             : number of threads
+  //
+  // Outputs (either may be NULL):
+  //   ITYPE_BEST[ievt]             : as in NEARNBR_GETRESULTS
+  //   NCELL_TRAIN[ievt*NTYPE+itype]: number of NN per sparse type,
+  //                                  not corrected for SCALE_NON1A
+  //
+  // Events are split into chunks to limit memory for the sparse type
+  // vs. SEPMAX bin. Within each chunk, threads process contiguous
+  // event ranges; then histograms are filled in event order so that
+  // output is identical to calling NEARNBR_APPLY for each event.
+
+  int NBINTOT = NBINTOT_SEPMAX_NEARNBR ;
+  int NVAR    = NEARNBR_INPUTS.NVAR ;
+  int NTRAIN  = NEARNBR_TRAINLIB.NTOT ;
+  int NTYPE   = NEARNBR_TRAINLIB.NTRUETYPE ;
+  int NEVT_CHUNK, IEVT0, NEVT_TMP, ithread, ivar, ievt, isep, ISP ;
+  int NEVT_PER_THREAD, MEMF ;
+  int *ISPARSE_LIST ;
+  NEARNBR_THREAD_DEF THREAD[MXTHREAD_NEARNBR];
+  pthread_t          THREAD_ID[MXTHREAD_NEARNBR];
+  char fnam[] = "NEARNBR_APPLY_BATCH" ;
+
+  // ------------ BEGIN -------------
+
+  if ( NEVT <= 0 ) { return ; }
+
+  if ( NTHREAD < 1 ) { NTHREAD = 1 ; }
+  if ( NTHREAD > MXTHREAD_NEARNBR ) {
+    sprintf(c1err,"NTHREAD=%d exceeds bound", NTHREAD);
+    sprintf(c2err,"MXTHREAD_NEARNBR=%d", MXTHREAD_NEARNBR);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+  }
+  if ( !NEARNBR_KDTREE.USE ) {
+    sprintf(c1err,"k-d tree is not initialized.");
+    sprintf(c2err,"Must call NEARNBR_INIT2 first.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+  }
+
+  NEVT_CHUNK = MXWORD_BATCH_NEARNBR / NBINTOT ;
+  if ( NEVT_CHUNK < NTHREAD ) { NEVT_CHUNK = NTHREAD ; }
+  if ( NEVT_CHUNK > NEVT    ) { NEVT_CHUNK = NEVT ; }
+
+  printf("  %s: apply NN to %d events with %d threads "
+	 "(%d SEPMAX bins)\n", fnam, NEVT, NTHREAD, NBINTOT);
+  fflush(stdout);
+
+  ISPARSE_LIST = (int*)malloc(NEVT_CHUNK * NBINTOT * sizeof(int));
+
+  MEMF = NTRAIN * sizeof(float) ;
+  for(ithread=0; ithread < NTHREAD; ithread++ ) {
+    THREAD[ithread].ID_THREAD    = ithread ;
+    THREAD[ithread].VALUES       = VALUES ;
+    THREAD[ithread].ISPARSE_LIST = ISPARSE_LIST ;
+    THREAD[ithread].ITYPE_BEST   = ITYPE_BEST ;
+    THREAD[ithread].NCELL_TRAIN  = NCELL_TRAIN ;
+    THREAD[ithread].ITRAIN       = (int*)malloc(NTRAIN*sizeof(int));
+    for(ivar=0; ivar < NVAR; ivar++ ) 
+      { THREAD[ithread].SQSEP[ivar] = (float*)malloc(MEMF); }
+  }
+
+  for(IEVT0=0; IEVT0 < NEVT; IEVT0 += NEVT_CHUNK ) {
+
+    NEVT_TMP = NEVT - IEVT0 ;
+    if ( NEVT_TMP > NEVT_CHUNK ) { NEVT_TMP = NEVT_CHUNK; }
+    NEVT_PER_THREAD = (NEVT_TMP + NTHREAD - 1) / NTHREAD ;
+
+    for(ithread=0; ithread < NTHREAD; ithread++ ) {
+      THREAD[ithread].IEVT_OFFSET = IEVT0 ;
+      THREAD[ithread].IEVT_MIN    = IEVT0 + ithread*NEVT_PER_THREAD ;
+      THREAD[ithread].IEVT_MAX    = THREAD[ithread].IEVT_MIN + 
+	NEVT_PER_THREAD - 1 ;
+      if ( THREAD[ithread].IEVT_MAX >= IEVT0 + NEVT_TMP ) 
+	{ THREAD[ithread].IEVT_MAX = IEVT0 + NEVT_TMP - 1 ; }
+    }
+
+    // thread 0 runs in this process
+    for(ithread=1; ithread < NTHREAD; ithread++ ) {
+      pthread_create(&THREAD_ID[ithread], NULL, nearnbr_thread_batch, 
+		     (void*)&THREAD[ithread] );
+    }
+    nearnbr_thread_batch( (void*)&THREAD[0] );
+    for(ithread=1; ithread < NTHREAD; ithread++ ) 
+      { pthread_join(THREAD_ID[ithread], NULL); }
+
+    // fill histograms in event order
+    if ( NEARNBR_INPUTS.FILLHIST == 0 || TRUETYPE == NULL ) { continue; }
+    for(ievt=IEVT0; ievt < IEVT0+NEVT_TMP; ievt++ ) {
+      ISP = -9 ;
+      if ( TRUETYPE[ievt] >= 0 && TRUETYPE[ievt] < MXTRUETYPE ) 
+	{ ISP = NEARNBR_TRAINLIB.TRUETYPE_MAP[TRUETYPE[ievt]] ; }
+      if ( ISP < 0 || ISP >= NTYPE ) {
+	sprintf(c1err,"Could not find sparse TYPE/index");
+	sprintf(c2err,"TRUETYPE=%d for ievt=%d", TRUETYPE[ievt], ievt);
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err );
+      }
+      NEARNBR_STORE.TRUETYPE_SPARSE = ISP ;
+      for(isep=0; isep < NBINTOT; isep++ ) {
+	nearnbr_fillHist(isep, ISPARSE_LIST[(ievt-IEVT0)*NBINTOT + isep]);
+      }
+    }
+
+  } // end IEVT0 chunk loop
+
+  for(ithread=0; ithread < NTHREAD; ithread++ ) {
+    free(THREAD[ithread].ITRAIN);
+    for(ivar=0; ivar < NVAR; ivar++ ) { free(THREAD[ithread].SQSEP[ivar]); }
+  }
+  free(ISPARSE_LIST);
+
+  printf("  %s: Done.\n", fnam);
+  fflush(stdout);
+
+  return ;
+
+} // end NEARNBR_APPLY_BATCH
+
+void nearnbr_apply_batch__(int *NEVT, float *VALUES, int *TRUETYPE, 
+			   int *NTHREAD, int *ITYPE_BEST, int *NCELL_TRAIN) {
+  // VALUES is fortran VALUES(NEVT,NVAR)
+  float *VALUES_PTR[MXVAR_NEARNBR];
+  int ivar;
+  for(ivar=0; ivar < NEARNBR_INPUTS.NVAR; ivar++ ) 
+    { VALUES_PTR[ivar] = &VALUES[ivar * (*NEVT)] ; }
+  NEARNBR_APPLY_BATCH(*NEVT, VALUES_PTR, TRUETYPE, *NTHREAD, 
+		      ITYPE_BEST, NCELL_TRAIN);
+}
+
+
+// =====================================
+void *nearnbr_thread_batch(void *arg) {
+
+  // Created Oct 2026
+  // Thread worker for NEARNBR_APPLY_BATCH: for each event in range,
+  // query k-d tree for subset within largest SEPMAX, then count
+  // NN per type for each SEPMAX bin. Only read-only globals are
+  // used; outputs are stored per event.
+
+  NEARNBR_THREAD_DEF *THREAD = (NEARNBR_THREAD_DEF*)arg ;
+  int NBINTOT = NBINTOT_SEPMAX_NEARNBR ;
+  int NVAR    = NEARNBR_INPUTS.NVAR ;
+  int NTYPE   = NEARNBR_TRAINLIB.NTRUETYPE ;
+  int ISEP_QUERY, ievt, ivar, isep, isub, itrain, i, NSUBSET ;
+  int TYPE_CUTPROB = -9, ISPARSE ;
+  int NCUTDIST[MXTRUETYPE] ;
+  float VAL[MXVAR_NEARNBR] ;
+
+  // ------------ BEGIN -------------
+
+  // same subset choice as NEARNBR_APPLY
+  if ( NN_TRAINFLAG ) 
+    { ISEP_QUERY = NBINTOT - 1 ; }
+  else
+    { ISEP_QUERY = 0 ; }
+
+  for(ievt=THREAD->IEVT_MIN; ievt <= THREAD->IEVT_MAX; ievt++ ) {
+
+    for(ivar=0; ivar < NVAR; ivar++ ) 
+      { VAL[ivar] = THREAD->VALUES[ivar][ievt] ; }
+
+    nearnbr_kdtree_query(VAL, ISEP_QUERY, 0, NEARNBR_KDTREE.NTRAIN,
+			 &NSUBSET, THREAD->ITRAIN, THREAD->SQSEP );
+
+    for(isep=0; isep < NBINTOT; isep++ ) {
+      for(i=0; i < NTYPE; i++ ) { NCUTDIST[i] = 0 ; }
+
+      for(isub=0; isub < NSUBSET; isub++ ) {
+	itrain = THREAD->ITRAIN[isub] ;
+	if ( nearnbr_SQDIST_ARRAY(isep, itrain, THREAD->SQSEP) < 1.0 ) { 
+	  i = NEARNBR_TRAINLIB.TRUETYPE_MAP[NEARNBR_TRAINLIB.TRUETYPE[itrain]];
+	  NCUTDIST[i]++ ;
+	}
+      }
+
+      ISPARSE = nearnbr_whichType(NTYPE, NCUTDIST, &TYPE_CUTPROB);
+      THREAD->ISPARSE_LIST[(ievt-THREAD->IEVT_OFFSET)*NBINTOT+isep] = 
+	ISPARSE ;
+    } // end isep
+
+    if ( THREAD->ITYPE_BEST != NULL ) {
+      if ( NBINTOT == 1 ) 
+	{ THREAD->ITYPE_BEST[ievt] = TYPE_CUTPROB ; }
+      else
+	{ THREAD->ITYPE_BEST[ievt] = -9 ; }
+    }
+    if ( THREAD->NCELL_TRAIN != NULL ) {
+      for(i=0; i < NTYPE; i++ ) 
+	{ THREAD->NCELL_TRAIN[ievt*NTYPE+i] = NCUTDIST[i] ; }
+    }
+
+  } // end ievt
+
+  return (void*)NULL ;
+
+} // end nearnbr_thread_batch
+
 
 // ============================================
 void nearnbr_preAnal_verify(void) {
@@ -1589,6 +2044,14 @@ void nearnbr_fill_SUBSET_TRAIN(char *CCID) {
   NTRAIN  = NEARNBR_TRAINLIB.NTOT; 
   NSUBSET = 0 ;
 
+  if ( NEARNBR_KDTREE.USE ) {
+    nearnbr_kdtree_query(NEARNBR_STORE.VALUE_LOAD, isep,     // (I)
+			 0, NEARNBR_KDTREE.NTRAIN,           // (I)
+			 &NSUBSET, NEARNBR_TRAINLIB.ITRAIN,  // (O)
+			 NEARNBR_STORE.SQSEP );              // (O)
+    goto DONE ;
+  }
+
   for ( itrain=0; itrain < NTRAIN; itrain++ ) {
 
     TRUETYPE  = NEARNBR_TRAINLIB.TRUETYPE[itrain] ;
@@ -1609,7 +2072,7 @@ void nearnbr_fill_SUBSET_TRAIN(char *CCID) {
     }
   }  // end of itrain loop
 
-
+ DONE:
   NEARNBR_TRAINLIB.NSUBSET = NSUBSET ;
 
   f_subset = (double)NSUBSET/(double)NTRAIN ;
@@ -1668,6 +2131,16 @@ void nearnbr_fill_SUBSET_APPLY(char *CCID) {
     return ;
   }
 
+  // Oct 2026: k-d tree range query within SEPMAX ellipsoid
+  if ( NEARNBR_KDTREE.USE ) {
+    nearnbr_kdtree_query(NEARNBR_STORE.VALUE_LOAD, isep,         // (I)
+			 0, NEARNBR_KDTREE.NTRAIN,               // (I)
+			 &NTRAIN_SUBSET, NEARNBR_TRAINLIB.ITRAIN,// (O)
+			 NEARNBR_STORE.SQSEP );                  // (O)
+    NEARNBR_TRAINLIB.NSUBSET = NTRAIN_SUBSET ;
+    return ;
+  }
+
   // slower method; loop over every training event
   // and keep subset withing SEPMAX cube.
 
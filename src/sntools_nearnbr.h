@@ -16,6 +16,10 @@
 #define ID1D_CELLMAP_NEARNBR       10   // for translating to 1D index
 #define BUFFSIZE_CELLMAP_NEARNBR  200   // realloc buf size
 
+#define NLEAF_KDTREE_NEARNBR        8   // max train events per kdtree leaf
+#define MXTHREAD_NEARNBR           64   // max threads for APPLY_BATCH
+#define MXWORD_BATCH_NEARNBR 10000000   // max ints to store per batch-chunk
+
 // define stupid params because HBOOK title limit is 80 chars
 // to hold name of training file
 #define MXCHAR_TITLE 80
@@ -53,6 +57,11 @@ void nearnbr_loadval__(char *ccid, char *varName, double *d_val) ;
 void NEARNBR_APPLY(char *CCID);
 void nearnbr_apply__(char *CCID);
 
+void NEARNBR_APPLY_BATCH(int NEVT, float **VALUES, int *TRUETYPE, 
+			 int NTHREAD, int *ITYPE_BEST, int *NCELL_TRAIN);
+void nearnbr_apply_batch__(int *NEVT, float *VALUES, int *TRUETYPE, 
+			   int *NTHREAD, int *ITYPE_BEST, int *NCELL_TRAIN);
+
 void NEARNBR_GETRESULTS(char *CCID, int *ITYPE, int *NTYPE, int *ITYPE_LIST, 
 			int *NCELL_TRAIN_LIST );
 void nearnbr_getresults__(char *CCID, int *ITYPE, int *NTYPE, int *ITYPE_LIST,
@@ -67,6 +76,15 @@ void  nearnbr_storeTrueTypes(void);
 void  nearnbr_preAnal_verify(void) ;
 void  nearnbr_reset(void) ;
 float nearnbr_SQDIST(int isep, int itrain) ;
+float nearnbr_SQDIST_ARRAY(int isep, int itrain, float **SQSEP) ;
+void  nearnbr_kdtree_init(void);
+void  nearnbr_kdtree_build(int ILO, int IHI);
+void  nearnbr_kdtree_select(int ILO, int IHI, int K, int IDIM);
+void  nearnbr_kdtree_query(float *VAL, int ISEP, int ILO, int IHI,
+			   int *NSUBSET, int *ITRAIN_SUBSET, float **SQSEP);
+void  nearnbr_kdtree_test(float *VAL, int ISEP, int itrain, 
+			  int *NSUBSET, int *ITRAIN_SUBSET, float **SQSEP);
+void *nearnbr_thread_batch(void *arg);
 int   nearnbr_whichType(int NTYPE, int *NCUTDIST, int *TYPE_CUTPROB ) ;
 void  nearnbr_init_SUBSET(void) ;
 void  nearnbr_fill_SUBSET_TRAIN(char *CCID); 
@@ -98,6 +116,30 @@ struct {
 
 } NEARNBR_CELLMAP ;
 
+// Oct 2026: k-d tree over training events with valid TRUETYPE.
+// Implicit balanced tree: node for index range [ILO,IHI) is the
+// median IMID=(ILO+IHI)/2, with left=[ILO,IMID) and right=[IMID+1,IHI).
+struct {
+  int   USE ;
+  int   NTRAIN ;        // number of training events in tree
+  int   *ITRAIN ;       // permuted list of itrain
+  char  *SPLITDIM ;     // split variable for node at each IMID
+  int   MEMTOT ;
+} NEARNBR_KDTREE ;
+
+// per-thread workspace for NEARNBR_APPLY_BATCH
+typedef struct {
+  int    ID_THREAD ;
+  int    IEVT_MIN, IEVT_MAX ;    // event range (inclusive) within chunk
+  int    IEVT_OFFSET ;           // first event of chunk
+  float  **VALUES ;              // VALUES[ivar][ievt]
+  int    *ISPARSE_LIST ;         // sparse type vs. [ievt-chunk][isep]
+  int    *ITYPE_BEST ;           // output, or NULL
+  int    *NCELL_TRAIN ;          // output, or NULL
+  int    *ITRAIN ;               // subset within max SEPMAX
+  float  *SQSEP[MXVAR_NEARNBR] ; // SQSEP[ivar][itrain]
+} NEARNBR_THREAD_DEF ;
+
 struct NEARNBR_INPUTS {
 
   char   TRAINFILE_PATH[200];
@@ -76,6 +76,11 @@
  Nov 04 2023: add VBOSE arg to CDTOPDIR_OUTPUT to enable codes to
               suppress output for long batch jobs.
 
+ Oct 2026: add binary columnar table format (IFILETYPE_BIN); see
+           sntools_output_bin.c. BIN is identified by suffix (.SNBIN)
+           or magic header, and is checked before TEXT.
+
+
 ************************************************/
 
 #include <stdio.h>
@@ -87,6 +92,8 @@
 #include <math.h>
 #include <ctype.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 // #include "sntools.h"
 #include "sndata.h"
@@ -109,6 +116,10 @@
 #include "sntools_output_marz.c"
 #endif
 
+#ifdef USE_BIN
+#include "sntools_output_bin.c"
+#endif
+
 
 // ===============================================
 void SNTABLE_DEBUG_DUMP(char *fnam, int idump) {
@@ -173,6 +184,8 @@ void TABLEFILE_INIT(void) {
   s = STRING_TABLEFILE_TYPE[IFILETYPE_HBOOK] ;  sprintf(s,"HBOOK");
   s = STRING_TABLEFILE_TYPE[IFILETYPE_ROOT]  ;  sprintf(s,"ROOT");
   s = STRING_TABLEFILE_TYPE[IFILETYPE_TEXT]  ;  sprintf(s,"TEXT");
+  s = STRING_TABLEFILE_TYPE[IFILETYPE_MARZ]  ;  sprintf(s,"MARZ");
+  s = STRING_TABLEFILE_TYPE[IFILETYPE_BIN]   ;  sprintf(s,"BIN");
 
   s = STRING_TABLEFILE_OPENFLAG[OPENFLAG_NULL]  ;  sprintf(s,"NULL");
   s = STRING_TABLEFILE_OPENFLAG[OPENFLAG_NEW]   ;  sprintf(s,"NEW" );
@@ -181,10 +194,12 @@ void TABLEFILE_INIT(void) {
   s = STRING_IDTABLE_SNANA[IFILETYPE_HBOOK] ; sprintf(s,"7100");
   s = STRING_IDTABLE_SNANA[IFILETYPE_ROOT]  ; sprintf(s,"SNANA");
   s = STRING_IDTABLE_SNANA[IFILETYPE_TEXT]  ; sprintf(s,"SNANA");
+  s = STRING_IDTABLE_SNANA[IFILETYPE_BIN]   ; sprintf(s,"SNANA");
 
   s = STRING_IDTABLE_FITRES[IFILETYPE_HBOOK] ; sprintf(s,"7788"  );
   s = STRING_IDTABLE_FITRES[IFILETYPE_ROOT]  ; sprintf(s,"FITRES");
   s = STRING_IDTABLE_FITRES[IFILETYPE_TEXT]  ; sprintf(s,"FITRES");
+  s = STRING_IDTABLE_FITRES[IFILETYPE_BIN]   ; sprintf(s,"FITRES");
 
   s = STRING_IDTABLE_OUTLIER[IFILETYPE_HBOOK] ; sprintf(s,"7800"  );
   s = STRING_IDTABLE_OUTLIER[IFILETYPE_ROOT]  ; sprintf(s,"OUTLIER");
@@ -209,6 +224,12 @@ void TABLEFILE_INIT(void) {
   FILEPREFIX_TEXT[0] = 0 ;
 #endif
 
+#ifdef USE_BIN
+  FILEPREFIX_BIN[0]    = 0 ;
+  TABLEINFO_BIN.NTABLE = 0 ;
+  READINFO_BIN.FD      = -9 ;
+#endif
+
 } // end of TABLEFILE_INIT
 
 void tablefile_init__(void) {  TABLEFILE_INIT();  }
@@ -216,6 +237,10 @@ void tablefile_init__(void) {  TABLEFILE_INIT();  }
 // =====================================
 int get_TABLEFILE_TYPE(char *FILENAME) {
 
+#ifdef USE_BIN
+  if ( ISFILE_BIN  (FILENAME) ) { return IFILETYPE_BIN  ; }
+#endif
+
 #ifdef USE_HBOOK
   if ( ISFILE_HBOOK(FILENAME) ) { return IFILETYPE_HBOOK; }
 #endif
@@ -266,6 +291,7 @@ int TABLEFILE_OPEN(char *FILENAME, char *STRINGOPT) {
   //
   // Oct 14 2014: call new function OPEN_TEXTFILE(...) for read-mode
   // Jul 13 2020: declare *ENV and *FMT (used if HBOOK is NOT defined)
+  // Oct 2026: add 'bin' option (binary columnar table)
 
   int  OPEN_FLAG, TYPE_FLAG, OPT_Q, USE_CURRENT, IERR ;
   char *ptrtok, local_STRINGOPT[80], ctmp[20], *FMT, ENV[200] ;
@@ -286,6 +312,7 @@ int TABLEFILE_OPEN(char *FILENAME, char *STRINGOPT) {
   char key_root[]  = "root";
   char key_hbook[] = "hbook" ;
   char key_text[]  = "text" ;
+  char key_bin[]   = "bin" ;
 
   sprintf(local_STRINGOPT,"%s", STRINGOPT);
   ptrtok = strtok(local_STRINGOPT," "); // split string
@@ -311,6 +338,9 @@ int TABLEFILE_OPEN(char *FILENAME, char *STRINGOPT) {
     else if ( strcmp_ignoreCase(ctmp,key_text) == 0 ) 
       { TYPE_FLAG = IFILETYPE_TEXT ; }
 
+    else if ( strcmp_ignoreCase(ctmp,key_bin) == 0 ) 
+      { TYPE_FLAG = IFILETYPE_BIN ; }
+
     else {
       sprintf(MSGERR1,"Invalid option '%s'", ctmp);
       sprintf(MSGERR2,"in STRINGOPT = '%s' ", STRINGOPT);
@@ -339,6 +369,12 @@ int TABLEFILE_OPEN(char *FILENAME, char *STRINGOPT) {
 
 
   if ( TYPE_FLAG == 0 ) {   
+#ifdef USE_BIN
+    // check BIN first since names like x.FITRES.SNBIN match TEXT suffix
+    if ( ISFILE_BIN(FILENAME) )  { TYPE_FLAG = IFILETYPE_BIN ; }
+    if ( TYPE_FLAG > 0 ) { goto ISFILE_DONE ; }
+#endif
+
 #ifdef USE_HBOOK
     if ( ISFILE_HBOOK(FILENAME) )  { TYPE_FLAG = IFILETYPE_HBOOK ; }
     if ( TYPE_FLAG > 0 ) { goto ISFILE_DONE ; }
@@ -483,6 +519,15 @@ int TABLEFILE_OPEN(char *FILENAME, char *STRINGOPT) {
     NOPEN_TABLEFILE++ ;
   }
 #endif
+
+#ifdef USE_BIN
+  if ( TYPE_FLAG == IFILETYPE_BIN ) {
+    if ( OPEN_FLAG == OPENFLAG_NEW ) 
+      { INIT_BINFILE(FILENAME);  NOPEN_TABLEFILE++ ; }
+    else
+      { OPEN_BINFILE(FILENAME); }
+  }
+#endif
   
   // store USE-flag and filename
   sprintf(NAME_TABLEFILE[OPEN_FLAG][TYPE_FLAG], "%s", FILENAME);
@@ -568,6 +613,11 @@ void TABLEFILE_CLOSE(char *FILENAME) {
   if(TYPE_FLAG == IFILETYPE_MARZ ) 
     { CLOSE_MARZFILE(FILENAME); }
 #endif
+
+#ifdef USE_BIN
+  if(TYPE_FLAG == IFILETYPE_BIN ) 
+    { CLOSE_BINFILE(OPEN_FLAG); }
+#endif
  
 
   // ----------------------------------------------
@@ -647,6 +697,11 @@ void SNTABLE_CREATE(int IDTABLE, char *NAME, char *TEXT_FORMAT) {
   if ( USE ) { SNTABLE_CREATE_TEXT(IDTABLE,NAME,TEXT_FORMAT);  } 
 #endif
 
+#ifdef USE_BIN
+  USE = USE_TABLEFILE[OPENFLAG_NEW][IFILETYPE_BIN] ;
+  if ( USE ) { SNTABLE_CREATE_BIN(IDTABLE,NAME);  } 
+#endif
+
  
   fflush(stdout);
 
@@ -687,6 +742,11 @@ void SNTABLE_FILL(int IDTABLE ) {
   if ( USE ) { SNTABLE_FILL_TEXT(IDTABLE); }
 #endif
 
+#ifdef USE_BIN
+  USE = USE_TABLEFILE[OPENFLAG_NEW][IFILETYPE_BIN] ; 
+  if ( USE ) { SNTABLE_FILL_BIN(IDTABLE); }
+#endif
+
 
 } // end of SNTABLE_FILL
 
@@ -763,6 +823,12 @@ void SNTABLE_ADDCOL(int IDTABLE, char *BLOCK, void* PTRVAR,
     { SNTABLE_ADDCOL_TEXT(IDTABLE, PTRVAR, &ADDCOL_VARDEF); }
 #endif
 
+#ifdef USE_BIN
+  USE = USE_TABLEFILE[OPENFLAG_NEW][IFILETYPE_BIN] ; 
+  if ( USE && USE4TEXT ) 
+    { SNTABLE_ADDCOL_BIN(IDTABLE, PTRVAR, &ADDCOL_VARDEF); }
+#endif
+
   return;
 } // end of SNTABLE_ADDCOL
 
@@ -1158,6 +1224,12 @@ int SNTABLE_READPREP(int IFILETYPE, char *TABLENAME) {
   }
 #endif
 
+#ifdef USE_BIN
+  if ( IFILETYPE == IFILETYPE_BIN ) {
+    NVAR = SNTABLE_READPREP_BIN(); 
+  }
+#endif
+
   // store file type and name of table
   READTABLE_POINTERS.NVAR_TOT  = NVAR ;
   READTABLE_POINTERS.IFILETYPE = IFILETYPE ;
@@ -1567,6 +1639,12 @@ int SNTABLE_READ_EXEC(void) {
     NROW = SNTABLE_READ_EXEC_TEXT();
   }
 #endif
+
+#ifdef USE_BIN
+  if ( IFILETYPE == IFILETYPE_BIN ) {
+    NROW = SNTABLE_READ_EXEC_BIN();
+  }
+#endif
   
   // sanity check
   if ( NROW == -777 ) {
@@ -2581,6 +2659,15 @@ int SNTABLE_NEVT(char *FILENAME, char *TABLENAME) {
 
   ISTYPE_HBOOK = ISTYPE_ROOT = ISTYPE_TEXT = 0 ;
 
+#ifdef USE_BIN
+  // Oct 2026: check BIN before TEXT; NROW is read from header
+  ISOPEN_DEJA = USE_TABLEFILE[OPENFLAG_READ][IFILETYPE_BIN] ;
+  if ( ISOPEN_DEJA || ISFILE_BIN(FILENAME) ) {
+    NEVT = SNTABLE_NEVT_BIN(FILENAME); 
+    return(NEVT);
+  }
+#endif
+
 #ifdef USE_HBOOK
   ISOPEN_DEJA = USE_TABLEFILE[OPENFLAG_READ][IFILETYPE_HBOOK] ;
   ISTYPE_HBOOK = ISFILE_HBOOK(FILENAME) ;
@@ -3644,3 +3731,31 @@ int ISFILE_MARZ(char *fileName) {
   return 1 ;
   
 } // end ISFILE_MARZ
+
+// ==============================              
+int ISFILE_BIN(char *fileName) {
+
+  // Created Oct 2026
+  // Returns 1 if fileName has SNBIN suffix, or if it is an existing
+  // file starting with the binary-table magic string.
+  // Returns 0 otherwise (does not abort on missing file).
+
+  FILE *fp ;
+  char magic[8];
+  int  ISBIN = 0 ;
+
+  // --------------- BEGIN ---------------
+
+  if ( strlen(fileName) == 0 ) { return 0; }
+
+  if ( strstr(fileName, ".snbin") != NULL ) { return 1 ; }
+  if ( strstr(fileName, ".SNBIN") != NULL ) { return 1 ; }
+
+  if ( (fp = fopen(fileName,"rb")) == NULL ) { return 0; }
+  if ( fread(magic, 1, 8, fp) == 8 ) 
+    { ISBIN = ( memcmp(magic, MAGIC_BIN, 8) == 0 ) ; }
+  fclose(fp);
+
+  return ISBIN ;
+
+} // end ISFILE_BIN
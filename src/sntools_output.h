@@ -32,6 +32,8 @@
 
  Jan 05 2023: MXCHAR_FILENAME-> 300 (was 240)
 
+ Oct 2026: add binary columnar table format IFILETYPE_BIN (USE_BIN)
+
 *******************************************/
 
 
@@ -42,6 +44,7 @@
 #define USE_ROOT  
 #define USE_TEXT  // always leave this on; same logic as for HBOOK,ROOT, ...
 #define USE_MARZ  // always leave this on
+#define USE_BIN   // binary columnar tables (Oct 2026)
 
 // ---------------------------------------
 // flags to identify TABLEFILE_TYPE 
@@ -51,7 +54,8 @@
 #define IFILETYPE_ROOT   2
 #define IFILETYPE_TEXT   3
 #define IFILETYPE_MARZ   4
-#define MXTABLEFILETYPE  5
+#define IFILETYPE_BIN    5   // Oct 2026
+#define MXTABLEFILETYPE  6
 
 #define MXCHAR_FILENAME  300
 #define MXCHAR_VARLIST   2000  
@@ -75,7 +79,7 @@
 #define TABLEID_MARZ       8100
 
 char STRING_TABLEFILE_TYPE[MXTABLEFILETYPE][12] ;
-  // =  { "NULL", "HBOOK", "ROOT", "TEXT", "MARZ" } ;
+  // =  { "NULL", "HBOOK", "ROOT", "TEXT", "MARZ", "BIN" } ;
 
 char STRING_TABLEFILE_OPENFLAG[MXOPENFLAG][12] ;
  //  = { "NULL", "NEW", "READ" } ;
@@ -605,6 +609,9 @@ extern"C" {
   int ISFILE_ROOT(char *fileName);
   int ISFILE_TEXT(char *fileName);
   int ISFILE_MARZ(char *fileName);
+  int ISFILE_BIN(char *fileName);
+
+  int SNTABLE_CONVERT_BIN(char *inFile, char *TBNAME, char *outFile);
 				 
 #ifdef __cplusplus
 }          
@@ -0,0 +1,906 @@
+// **********************************************
+// Created Oct 2026
+//
+// Functions to write and read binary columnar tables (IFILETYPE_BIN).
+// Intended for large FITRES-like tables such as the BBC biasCor and
+// CCprior simulations, where parsing text tables is slower than the
+// fit itself.
+//
+// File layout (native byte order; not portable across endianness):
+//   BINTABLE_HEADER_DEF                 : magic, version, NVAR, NROW ...
+//   BINTABLE_COLUMN_DEF x NVAR          : name, cast, bytes/elem, offset
+//   NCOMMENT x LEN_COMMENT chars        : global table comments
+//   column data, one contiguous block of NROW values per column;
+//   each block starts on an 8-byte boundary.
+//
+// Writing follows the usual SNTABLE_CREATE/ADDCOL/FILL sequence:
+// each FILL appends one packed row to a temporary spool file, and
+// the spool is transposed into columns (NROW_CHUNK_BIN rows at a
+// time) when the table file is closed. Memory use therefore does
+// not grow with NROW.
+//
+// Reading maps only the columns requested by SNTABLE_READPREP_VARDEF
+// and copies them directly into the user arrays; if the stored cast
+// matches the requested cast, each column is a single memcpy.
+//
+// Text FITRES tables are converted with SNTABLE_CONVERT_BIN,
+// e.g., via  'sntable_dump.exe <file> FITRES -tobin <outFile>' .
+//
+// **********************************************
+
+#define MAGIC_BIN        "SNTBIN01"
+#define VERSION_BIN      1
+#define MXTABLE_BIN      10
+#define NROW_CHUNK_BIN   65536   // rows per transpose chunk on close
+#define SUFFIX_BIN       "SNBIN"
+#define SUFFIX_SPOOL_BIN "SPOOL"
+
+typedef struct {
+  char      MAGIC[8];       // MAGIC_BIN (no null termination)
+  int       VERSION ;
+  int       NVAR ;
+  long long NROW ;
+  int       NCOMMENT ;      // number of global comment lines
+  int       LEN_COMMENT ;   // bytes per comment line
+  char      TBNAME[40] ;
+} BINTABLE_HEADER_DEF ;
+
+typedef struct {
+  char      VARNAME[MXCHAR_VARNAME] ;
+  int       ICAST ;         // ICAST_[D,F,I,S,L,C]
+  int       NBYTE ;         // bytes per element (string length for C)
+  long long OFFSET ;        // file offset of first element
+} BINTABLE_COLUMN_DEF ;
+
+
+// structure for writing table(s)
+struct TABLEINFO_BIN {
+  int    NTABLE ;
+  int    IDTABLE[MXTABLE_BIN] ;
+  char   FILENAME[MXTABLE_BIN][MXCHAR_FILENAME] ;
+  char   FILENAME_SPOOL[MXTABLE_BIN][MXCHAR_FILENAME] ;
+  FILE  *FP_SPOOL[MXTABLE_BIN] ;
+
+  BINTABLE_HEADER_DEF   HEADER[MXTABLE_BIN] ;
+  BINTABLE_COLUMN_DEF  *COLUMN[MXTABLE_BIN] ;   // MXVAR_TABLE columns
+  char                **PTRVAR[MXTABLE_BIN] ;   // user pointer per column
+
+  int    ROWSIZE[MXTABLE_BIN] ;  // bytes per packed row in spool
+  char  *ROWBUF[MXTABLE_BIN] ;
+  int    NSKIP_VECTOR[MXTABLE_BIN] ;
+} TABLEINFO_BIN ;
+
+char FILEPREFIX_BIN[MXCHAR_FILENAME];
+
+// structure for reading table
+struct READINFO_BIN {
+  int   FD ;
+  char  FILENAME[MXCHAR_FILENAME] ;
+  BINTABLE_HEADER_DEF   HEADER ;
+  BINTABLE_COLUMN_DEF  *COLUMN ;
+} READINFO_BIN ;
+
+
+// -----------------------------
+
+#ifdef __cplusplus
+extern"C" {
+#endif
+
+  void INIT_BINFILE(char *PREFIX) ;
+  void OPEN_BINFILE(char *FILENAME) ;
+  void CLOSE_BINFILE(int OPEN_FLAG) ;
+  void write_BINFILE(int ITAB);
+
+  void SNTABLE_CREATE_BIN(int IDTABLE, char *TBNAME);
+  void SNTABLE_ADDCOL_BIN(int IDTABLE, void *PTRVAR,
+			  SNTABLE_ADDCOL_VARDEF *ADDCOL_VARDEF) ;
+  void SNTABLE_FILL_BIN(int IDTABLE);
+  int  ITABLE_BIN(int IDTABLE, char *FUNNAM, int OPT_ABORT) ;
+
+  int  SNTABLE_NEVT_BIN(char *FILENAME);
+  int  SNTABLE_READPREP_BIN(void);
+  int  SNTABLE_READ_EXEC_BIN(void);
+  void copy_column_BIN(char *DATA, BINTABLE_COLUMN_DEF *COL,
+		       int ivar, int nptr, long long NROW);
+  double dval_BIN(char *DATA, int ICAST, int NBYTE, long long irow);
+
+  int  read_header_BIN(int FD, char *FILENAME, BINTABLE_HEADER_DEF *HEADER);
+  int  nbyte_ICAST_BIN(int ICAST, int ISIZE);
+  long long align8_BIN(long long N);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+// =============================================
+//
+//   BEGIN FUNCTIONS
+//
+// =============================================
+
+void INIT_BINFILE(char *PREFIX) {
+
+  // Created Oct 2026
+  // Analog of INIT_TEXTFILES: store prefix; table file(s) are opened
+  // at the SNTABLE_CREATE stage.
+
+  sprintf(FILEPREFIX_BIN,"%s", PREFIX);
+  TABLEINFO_BIN.NTABLE = 0 ;
+
+} // end INIT_BINFILE
+
+
+// ============================================
+void SNTABLE_CREATE_BIN(int IDTABLE, char *TBNAME) {
+
+  // Created Oct 2026
+  // Open spool file for this table; the final binary table file
+  // is written by CLOSE_BINFILE.
+  // File name is [PREFIX].[NAME].SNBIN, or PREFIX if PREFIX
+  // already has a dot (same convention as TEXT).
+
+  int  NTAB = TABLEINFO_BIN.NTABLE ;
+  char *FILENAME, *FILENAME_SPOOL ;
+  BINTABLE_HEADER_DEF *HEADER ;
+  char fnam[] = "SNTABLE_CREATE_BIN" ;
+
+  // --------- BEGIN ---------
+
+  if ( NTAB >= MXTABLE_BIN ) {
+    sprintf(MSGERR1, "NTABLE=%d exceeds bound of MXTABLE_BIN=%d",
+	    NTAB+1, MXTABLE_BIN );
+    sprintf(MSGERR2, "Check IDTABLE=%d (%s)", IDTABLE, TBNAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  TABLEINFO_BIN.NTABLE++ ;
+
+  FILENAME       = TABLEINFO_BIN.FILENAME[NTAB] ;
+  FILENAME_SPOOL = TABLEINFO_BIN.FILENAME_SPOOL[NTAB] ;
+
+  // build spool name from same inputs (not from FILENAME) to avoid
+  // overlapping sprintf args within TABLEINFO_BIN
+  if ( strchr(FILEPREFIX_BIN,'.') == NULL ) { 
+    sprintf(FILENAME, "%s.%s.%s", FILEPREFIX_BIN, TBNAME, SUFFIX_BIN); 
+    sprintf(FILENAME_SPOOL, "%s.%s.%s.%s", 
+	    FILEPREFIX_BIN, TBNAME, SUFFIX_BIN, SUFFIX_SPOOL_BIN); 
+  }
+  else { 
+    sprintf(FILENAME, "%s", FILEPREFIX_BIN); 
+    sprintf(FILENAME_SPOOL, "%s.%s", FILEPREFIX_BIN, SUFFIX_SPOOL_BIN); 
+  }
+
+  printf("  %s: init %s BIN-table in %s \n", fnam, TBNAME, FILENAME);
+  fflush(stdout);
+
+  TABLEINFO_BIN.IDTABLE[NTAB]  = IDTABLE ;
+  TABLEINFO_BIN.ROWSIZE[NTAB]  = 0 ;
+  TABLEINFO_BIN.ROWBUF[NTAB]   = NULL ;
+  TABLEINFO_BIN.NSKIP_VECTOR[NTAB] = 0 ;
+
+  HEADER = &TABLEINFO_BIN.HEADER[NTAB] ;
+  memset(HEADER, 0, sizeof(BINTABLE_HEADER_DEF) );
+  memcpy(HEADER->MAGIC, MAGIC_BIN, 8);
+  HEADER->VERSION     = VERSION_BIN ;
+  HEADER->LEN_COMMENT = MXCHAR_FILENAME ;
+  sprintf(HEADER->TBNAME, "%.39s", TBNAME);
+
+  TABLEINFO_BIN.COLUMN[NTAB] = (BINTABLE_COLUMN_DEF*)
+    calloc(MXVAR_TABLE, sizeof(BINTABLE_COLUMN_DEF) );
+  TABLEINFO_BIN.PTRVAR[NTAB] = (char**)malloc(MXVAR_TABLE*sizeof(char*));
+
+  TABLEINFO_BIN.FP_SPOOL[NTAB] = fopen(FILENAME_SPOOL, "wb");
+  if ( !TABLEINFO_BIN.FP_SPOOL[NTAB] ) {
+    sprintf(MSGERR1, "Could not open BIN spool file = ");
+    sprintf(MSGERR2, "%s", FILENAME_SPOOL);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+} // end of SNTABLE_CREATE_BIN
+
+
+// =============================================
+void SNTABLE_ADDCOL_BIN(int IDTABLE, void *PTRVAR,
+			SNTABLE_ADDCOL_VARDEF *ADDCOL_VARDEF) {
+
+  // Created Oct 2026
+  // Store column name, cast and pointer. Same column subset as TEXT
+  // (USE4TEXT), so that BIN and TEXT tables are interchangeable.
+  // Vector columns are not stored.
+
+  int  ITAB, ivar, IVAR, ICAST, NBYTE ;
+  BINTABLE_COLUMN_DEF *COL ;
+  char fnam[] = "SNTABLE_ADDCOL_BIN" ;
+
+  // ------------- BEGIN --------------
+
+  ITAB = ITABLE_BIN(IDTABLE, fnam, 1);
+
+  if ( TABLEINFO_BIN.HEADER[ITAB].NROW > 0 ) {
+    sprintf(MSGERR1, "Cannot add column '%s' after first fill",
+	    ADDCOL_VARDEF->VARNAME[0] );
+    sprintf(MSGERR2, "IDTABLE = %d", IDTABLE);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  for(ivar=0 ; ivar < ADDCOL_VARDEF->NVAR; ivar++ ) {
+
+    if ( ADDCOL_VARDEF->VECTOR_FLAG[ivar] == 2 )
+      { TABLEINFO_BIN.NSKIP_VECTOR[ITAB]++ ;  continue ; }
+
+    IVAR = TABLEINFO_BIN.HEADER[ITAB].NVAR ;
+    if ( IVAR >= MXVAR_TABLE ) {
+      sprintf(MSGERR1, "NVAR exceeds bound of MXVAR_TABLE=%d", MXVAR_TABLE);
+      sprintf(MSGERR2, "IDTABLE = %d", IDTABLE);
+      errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+    }
+    TABLEINFO_BIN.HEADER[ITAB].NVAR++ ;
+
+    COL   = &TABLEINFO_BIN.COLUMN[ITAB][IVAR] ;
+    ICAST = ADDCOL_VARDEF->ICAST[ivar] ;
+    NBYTE = nbyte_ICAST_BIN(ICAST, ADDCOL_VARDEF->ISIZE[ivar]);
+
+    sprintf(COL->VARNAME, "%s", ADDCOL_VARDEF->VARNAME[ivar] );
+    if ( strcmp(COL->VARNAME,"CCID") == 0 )  { sprintf(COL->VARNAME,"CID"); }
+    COL->ICAST  = ICAST ;
+    COL->NBYTE  = NBYTE ;
+    COL->OFFSET = 0 ;  // set on close
+
+    if ( ICAST == ICAST_C )
+      { TABLEINFO_BIN.PTRVAR[ITAB][IVAR] = (char*)PTRVAR ; }
+    else
+      { TABLEINFO_BIN.PTRVAR[ITAB][IVAR] = (char*)PTRVAR + ivar*NBYTE ; }
+
+    TABLEINFO_BIN.ROWSIZE[ITAB] += NBYTE ;
+  }
+
+} // end of SNTABLE_ADDCOL_BIN
+
+
+// =============================================
+int ITABLE_BIN(int IDTABLE, char *FUNNAM, int OPT_ABORT ) {
+
+  // return sparse table index for IDTABLE
+
+  int i, ITAB = -9 ;
+  char fnam[] = "ITABLE_BIN" ;
+
+  for(i=0; i < TABLEINFO_BIN.NTABLE ; i++ ) {
+    if ( IDTABLE == TABLEINFO_BIN.IDTABLE[i] ) { ITAB = i ; }
+  }
+
+  if ( ITAB < 0 && OPT_ABORT > 0 ) {
+    sprintf(MSGERR1, "%s could not find BIN table with ", FUNNAM );
+    sprintf(MSGERR2, "IDTABLE = %d", IDTABLE );
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  return ITAB ;
+
+} // end of ITABLE_BIN
+
+
+// ==================================================
+void SNTABLE_FILL_BIN(int IDTABLE) {
+
+  // Created Oct 2026
+  // pack current values of all columns into one row and append
+  // to spool file.
+
+  int  ITAB, IVAR, NVAR, NBYTE ;
+  char *ROW, *SRC ;
+  BINTABLE_COLUMN_DEF *COL ;
+  char fnam[] = "SNTABLE_FILL_BIN" ;
+
+  // ------------- BEGIN ------------
+
+  ITAB = ITABLE_BIN(IDTABLE, fnam, 1);
+  NVAR = TABLEINFO_BIN.HEADER[ITAB].NVAR ;
+
+  if ( TABLEINFO_BIN.ROWBUF[ITAB] == NULL ) {
+    TABLEINFO_BIN.ROWBUF[ITAB] =
+      (char*)malloc( TABLEINFO_BIN.ROWSIZE[ITAB] + 8 );
+  }
+
+  ROW = TABLEINFO_BIN.ROWBUF[ITAB] ;
+
+  for(IVAR=0; IVAR < NVAR; IVAR++ ) {
+    COL   = &TABLEINFO_BIN.COLUMN[ITAB][IVAR] ;
+    NBYTE = COL->NBYTE ;
+    SRC   = TABLEINFO_BIN.PTRVAR[ITAB][IVAR] ;
+    if ( COL->ICAST == ICAST_C )
+      { memset(ROW, 0, NBYTE);  strncpy(ROW, SRC, NBYTE); }
+    else
+      { memcpy(ROW, SRC, NBYTE); }
+    ROW += NBYTE ;
+  }
+
+  fwrite(TABLEINFO_BIN.ROWBUF[ITAB], TABLEINFO_BIN.ROWSIZE[ITAB], 1,
+	 TABLEINFO_BIN.FP_SPOOL[ITAB] );
+
+  TABLEINFO_BIN.HEADER[ITAB].NROW++ ;
+
+} // end of SNTABLE_FILL_BIN
+
+
+// ==================================================
+void CLOSE_BINFILE(int OPEN_FLAG) {
+
+  // Created Oct 2026
+  // For output tables, write each binary table file from its spool.
+  // For input table, close file descriptor if still open.
+
+  int itab;
+
+  // ----------- BEGIN -----------
+
+  if ( OPEN_FLAG == OPENFLAG_READ ) {
+    if ( READINFO_BIN.FD >= 0 ) { close(READINFO_BIN.FD); }
+    READINFO_BIN.FD = -9 ;
+    return ;
+  }
+
+  for(itab=0; itab < TABLEINFO_BIN.NTABLE; itab++ )
+    { write_BINFILE(itab); }
+
+  TABLEINFO_BIN.NTABLE = 0 ;
+
+} // end CLOSE_BINFILE
+
+
+// ==================================================
+void write_BINFILE(int ITAB) {
+
+  // Created Oct 2026
+  // Write header, column directory and comments, then transpose
+  // spooled rows into contiguous columns in chunks of NROW_CHUNK_BIN
+  // rows. Spool file is removed at the end.
+
+  BINTABLE_HEADER_DEF *HEADER = &TABLEINFO_BIN.HEADER[ITAB] ;
+  BINTABLE_COLUMN_DEF *COL ;
+  int       NVAR    = HEADER->NVAR ;
+  int       ROWSIZE = TABLEINFO_BIN.ROWSIZE[ITAB] ;
+  long long NROW    = HEADER->NROW ;
+  long long OFFSET, IROW0 ;
+  int       ivar, ic, NRD, irow, NBYTE, OFF_ROW ;
+  char      *FILENAME = TABLEINFO_BIN.FILENAME[ITAB];
+  char      *CHUNK, *COLBUF, *COMMENT ;
+  FILE      *FP, *FP_SPOOL ;
+  char fnam[] = "write_BINFILE" ;
+
+  // ------------ BEGIN -------------
+
+  fclose(TABLEINFO_BIN.FP_SPOOL[ITAB]);
+
+  HEADER->NCOMMENT = NLINE_TABLECOMMENT ;
+
+  // column offsets
+  OFFSET = sizeof(BINTABLE_HEADER_DEF) + NVAR*sizeof(BINTABLE_COLUMN_DEF) +
+    HEADER->NCOMMENT * HEADER->LEN_COMMENT ;
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    COL = &TABLEINFO_BIN.COLUMN[ITAB][ivar] ;
+    OFFSET      = align8_BIN(OFFSET);
+    COL->OFFSET = OFFSET ;
+    OFFSET     += NROW * (long long)COL->NBYTE ;
+  }
+
+  FP = fopen(FILENAME, "wb");
+  if ( !FP ) {
+    sprintf(MSGERR1, "Could not open BIN table file = ");
+    sprintf(MSGERR2, "%s", FILENAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  fwrite(HEADER, sizeof(BINTABLE_HEADER_DEF), 1, FP);
+  fwrite(TABLEINFO_BIN.COLUMN[ITAB], sizeof(BINTABLE_COLUMN_DEF), NVAR, FP);
+
+  COMMENT = (char*)calloc(HEADER->LEN_COMMENT, sizeof(char) );
+  for(ic=0; ic < HEADER->NCOMMENT; ic++ ) {
+    memset(COMMENT, 0, HEADER->LEN_COMMENT);
+    strncpy(COMMENT, LINE_TABLECOMMENT[ic], HEADER->LEN_COMMENT-1);
+    fwrite(COMMENT, HEADER->LEN_COMMENT, 1, FP);
+  }
+  free(COMMENT);
+
+  // - - - - transpose rows -> columns - - - - -
+  FP_SPOOL = fopen(TABLEINFO_BIN.FILENAME_SPOOL[ITAB], "rb");
+  CHUNK    = (char*)malloc( (size_t)ROWSIZE * NROW_CHUNK_BIN + 8 );
+  COLBUF   = (char*)malloc( (size_t)ROWSIZE * NROW_CHUNK_BIN + 8 );
+  IROW0    = 0 ;
+
+  while ( IROW0 < NROW ) {
+    NRD = fread(CHUNK, ROWSIZE, NROW_CHUNK_BIN, FP_SPOOL);
+    if ( NRD <= 0 ) { break; }
+
+    OFF_ROW = 0 ;
+    for(ivar=0; ivar < NVAR; ivar++ ) {
+      COL   = &TABLEINFO_BIN.COLUMN[ITAB][ivar] ;
+      NBYTE = COL->NBYTE ;
+      for(irow=0; irow < NRD; irow++ ) {
+	memcpy(&COLBUF[irow*NBYTE], &CHUNK[irow*ROWSIZE + OFF_ROW], NBYTE);
+      }
+      fseeko(FP, COL->OFFSET + IROW0*NBYTE, SEEK_SET);
+      fwrite(COLBUF, NBYTE, NRD, FP);
+      OFF_ROW += NBYTE ;
+    }
+    IROW0 += NRD ;
+  }
+
+  if ( IROW0 != NROW ) {
+    sprintf(MSGERR1, "Transposed %lld rows, but expected NROW=%lld",
+	    IROW0, NROW);
+    sprintf(MSGERR2, "Check spool file %s",
+	    TABLEINFO_BIN.FILENAME_SPOOL[ITAB]);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  fclose(FP_SPOOL);  fclose(FP);
+  remove(TABLEINFO_BIN.FILENAME_SPOOL[ITAB]);
+
+  free(CHUNK);  free(COLBUF);
+  free(TABLEINFO_BIN.COLUMN[ITAB]);
+  free(TABLEINFO_BIN.PTRVAR[ITAB]);
+  if ( TABLEINFO_BIN.ROWBUF[ITAB] ) { free(TABLEINFO_BIN.ROWBUF[ITAB]); }
+
+  printf("   Close BIN table %s: %lld rows x %d columns -> %s \n",
+	 HEADER->TBNAME, NROW, NVAR, FILENAME );
+  if ( TABLEINFO_BIN.NSKIP_VECTOR[ITAB] > 0 ) {
+    printf("\t (skipped %d vector columns) \n",
+	   TABLEINFO_BIN.NSKIP_VECTOR[ITAB] );
+  }
+  fflush(stdout);
+
+  return ;
+
+} // end write_BINFILE
+
+
+// ==================================================
+void OPEN_BINFILE(char *FILENAME) {
+
+  // Created Oct 2026
+  // Open binary table for reading; read header and column directory,
+  // and check comments for VERSION_PHOTOMETRY (as for TEXT).
+
+  int  NVAR, ic, LEN, MSKOPT, iwd ;
+  char *COMMENT, vtmp[MXCHAR_FILENAME*2], *ptr ;
+  BINTABLE_HEADER_DEF *HEADER = &READINFO_BIN.HEADER ;
+  char fnam[] = "OPEN_BINFILE" ;
+
+  // ------------ BEGIN -----------
+
+  sprintf(READINFO_BIN.FILENAME, "%s", FILENAME);
+  READINFO_BIN.FD = open(FILENAME, O_RDONLY);
+  if ( READINFO_BIN.FD < 0 ) {
+    sprintf(MSGERR1, "Could not open BIN table file: ");
+    sprintf(MSGERR2, "'%s' ", FILENAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  read_header_BIN(READINFO_BIN.FD, FILENAME, HEADER);
+
+  NVAR = HEADER->NVAR ;
+  READINFO_BIN.COLUMN = (BINTABLE_COLUMN_DEF*)
+    malloc( (NVAR+1)*sizeof(BINTABLE_COLUMN_DEF) );
+  read(READINFO_BIN.FD, READINFO_BIN.COLUMN,
+       NVAR*sizeof(BINTABLE_COLUMN_DEF) );
+
+  LEN     = HEADER->LEN_COMMENT ;
+  COMMENT = (char*)malloc(LEN+1);
+  for(ic=0; ic < HEADER->NCOMMENT; ic++ ) {
+    read(READINFO_BIN.FD, COMMENT, LEN);   COMMENT[LEN] = 0 ;
+    ptr = strstr(COMMENT,KEYNAME_VERSION_PHOTOMETRY) ;
+    if ( ptr != NULL ) {
+      MSKOPT = MSKOPT_PARSE_WORDS_STRING + MSKOPT_PARSE_WORDS_IGNORECOMMA;
+      store_PARSE_WORDS(MSKOPT, ptr, fnam);
+      iwd=1;   get_PARSE_WORD(0, iwd, vtmp) ;
+      catVarList_with_comma(SNTABLE_VERSION_PHOTOMETRY,vtmp);
+    }
+  }
+  free(COMMENT);
+
+  printf("   %s: %s \n", fnam, FILENAME);
+  fflush(stdout);
+
+} // end OPEN_BINFILE
+
+
+// ==================================================
+int read_header_BIN(int FD, char *FILENAME, BINTABLE_HEADER_DEF *HEADER) {
+
+  // Created Oct 2026
+  // read and check header; abort on invalid magic or version.
+
+  int NRD ;
+  char fnam[] = "read_header_BIN" ;
+
+  // ------------ BEGIN ------------
+
+  NRD = read(FD, HEADER, sizeof(BINTABLE_HEADER_DEF) );
+
+  if ( NRD != sizeof(BINTABLE_HEADER_DEF) ||
+       memcmp(HEADER->MAGIC, MAGIC_BIN, 8) != 0 ) {
+    sprintf(MSGERR1, "Invalid BIN table header (NRD=%d) for ", NRD);
+    sprintf(MSGERR2, "%s", FILENAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  if ( HEADER->VERSION != VERSION_BIN || HEADER->NVAR > MXVAR_TABLE ) {
+    sprintf(MSGERR1, "Unsupported VERSION=%d or NVAR=%d",
+	    HEADER->VERSION, HEADER->NVAR );
+    sprintf(MSGERR2, "in %s", FILENAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  return (int)HEADER->NROW ;
+
+} // end read_header_BIN
+
+
+// ==================================================
+int SNTABLE_NEVT_BIN(char *FILENAME) {
+
+  // Created Oct 2026
+  // Return number of rows from header; no column data is read.
+  // If FILENAME is blank, use the already-opened file.
+
+  int  FD, NROW ;
+  BINTABLE_HEADER_DEF HEADER ;
+  char fnam[] = "SNTABLE_NEVT_BIN" ;
+
+  // ---------- BEGIN ---------
+
+  if ( strlen(FILENAME) == 0 ) { return (int)READINFO_BIN.HEADER.NROW ; }
+
+  FD = open(FILENAME, O_RDONLY);
+  if ( FD < 0 ) {
+    sprintf(MSGERR1, "Could not open BIN table file: ");
+    sprintf(MSGERR2, "'%s' ", FILENAME);
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+  NROW = read_header_BIN(FD, FILENAME, &HEADER);
+  close(FD);
+
+  return NROW ;
+
+} // end SNTABLE_NEVT_BIN
+
+
+// ==========================================
+int  SNTABLE_READPREP_BIN(void) {
+
+  // Created Oct 2026
+  // Load READTABLE_POINTERS varnames and stored casts from the
+  // column directory. Returns NVAR.
+
+  int  NVAR = READINFO_BIN.HEADER.NVAR ;
+  int  ivar ;
+  BINTABLE_COLUMN_DEF *COL ;
+
+  // ------------ BEGIN ----------
+
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    COL = &READINFO_BIN.COLUMN[ivar] ;
+    sprintf(READTABLE_POINTERS.VARNAME[ivar], "%s", COL->VARNAME);
+    READTABLE_POINTERS.ICAST_READ[ivar]  = COL->ICAST ;
+    READTABLE_POINTERS.ICAST_STORE[ivar] = COL->ICAST ;
+  }
+
+  READTABLE_POINTERS.NVAR_TOT = NVAR ;
+  return NVAR ;
+
+} // end SNTABLE_READPREP_BIN
+
+
+// ==============================================
+int SNTABLE_READ_EXEC_BIN(void) {
+
+  // Created Oct 2026
+  // For each column requested via SNTABLE_READPREP_VARDEF, mmap
+  // only that column and copy into user array(s). Unrequested
+  // columns are never read from disk.
+
+  long long NROW   = READINFO_BIN.HEADER.NROW ;
+  int  NVAR_READ   = READTABLE_POINTERS.NVAR_READ ;
+  int  FD          = READINFO_BIN.FD ;
+  long PAGESIZE    = sysconf(_SC_PAGESIZE);
+  int  i, ivar, nptr ;
+  bool DONE[MXVAR_TABLE];
+  off_t  MAP_OFF ;
+  size_t MAP_LEN ;
+  void  *ADDR ;
+  BINTABLE_COLUMN_DEF *COL ;
+  char fnam[] = "SNTABLE_READ_EXEC_BIN" ;
+
+  // ------------ BEGIN ------------
+
+  if ( NVAR_READ > 0 && NROW > READTABLE_POINTERS.MXLEN ) {
+    sprintf(MSGERR1, "NROW=%lld exceeds user-defined array bound=%d",
+	    NROW, READTABLE_POINTERS.MXLEN);
+    sprintf(MSGERR2, "for %s", READINFO_BIN.FILENAME );
+    errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+  }
+
+  for(ivar=0; ivar < MXVAR_TABLE; ivar++ ) { DONE[ivar] = false; }
+
+  for(i=0; i < NVAR_READ; i++ ) {
+    ivar = READTABLE_POINTERS.PTRINDEX[i] ;
+    if ( DONE[ivar] || NROW == 0 ) { continue; }
+    DONE[ivar] = true ;
+
+    COL     = &READINFO_BIN.COLUMN[ivar] ;
+    MAP_OFF = COL->OFFSET - (COL->OFFSET % PAGESIZE) ;
+    MAP_LEN = (size_t)(COL->OFFSET - MAP_OFF) + NROW*COL->NBYTE ;
+    ADDR    = mmap(NULL, MAP_LEN, PROT_READ, MAP_PRIVATE, FD, MAP_OFF);
+    if ( ADDR == MAP_FAILED ) {
+      sprintf(MSGERR1, "mmap failed for column '%s' (offset=%lld)",
+	      COL->VARNAME, COL->OFFSET );
+      sprintf(MSGERR2, "in %s", READINFO_BIN.FILENAME );
+      errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2);
+    }
+    madvise(ADDR, MAP_LEN, MADV_SEQUENTIAL);
+
+    for(nptr=0; nptr < READTABLE_POINTERS.NPTR[ivar]; nptr++ ) {
+      copy_column_BIN((char*)ADDR + (COL->OFFSET - MAP_OFF), COL,
+		      ivar, nptr, NROW);
+    }
+    munmap(ADDR, MAP_LEN);
+  }
+
+  close(FD);   READINFO_BIN.FD = -9 ;
+  free(READINFO_BIN.COLUMN);
+
+  // reset flags to allow opening another file (as for TEXT)
+  NAME_TABLEFILE[OPENFLAG_READ][IFILETYPE_BIN][0] = 0 ;
+  USE_TABLEFILE[OPENFLAG_READ][IFILETYPE_BIN]     = 0;
+
+  return (int)NROW ;
+
+} // end SNTABLE_READ_EXEC_BIN
+
+
+// ==============================================
+void copy_column_BIN(char *DATA, BINTABLE_COLUMN_DEF *COL,
+		     int ivar, int nptr, long long NROW) {
+
+  // Created Oct 2026
+  // Copy NROW values of stored column *DATA into user pointer
+  // nptr of sparse variable ivar. Same cast -> memcpy; otherwise
+  // convert element by element.
+
+  int    ICAST_READ  = COL->ICAST ;
+  int    ICAST_STORE = READTABLE_POINTERS.ICAST_STORE[ivar] ;
+  int    NBYTE       = COL->NBYTE ;
+  size_t NTOT        = (size_t)NROW * NBYTE ;
+  long long irow, LVAL ;
+  double DVAL ;
+  char   *CVAL ;
+  char fnam[] = "copy_column_BIN" ;
+
+  // ---------- BEGIN -----------
+
+  if ( ICAST_READ == ICAST_STORE && ICAST_STORE != ICAST_C ) {
+    if ( ICAST_STORE == ICAST_D )
+      { memcpy(READTABLE_POINTERS.PTRVAL_D[nptr][ivar], DATA, NTOT); }
+    else if ( ICAST_STORE == ICAST_F )
+      { memcpy(READTABLE_POINTERS.PTRVAL_F[nptr][ivar], DATA, NTOT); }
+    else if ( ICAST_STORE == ICAST_I )
+      { memcpy(READTABLE_POINTERS.PTRVAL_I[nptr][ivar], DATA, NTOT); }
+    else if ( ICAST_STORE == ICAST_S )
+      { memcpy(READTABLE_POINTERS.PTRVAL_S[nptr][ivar], DATA, NTOT); }
+    else if ( ICAST_STORE == ICAST_L )
+      { memcpy(READTABLE_POINTERS.PTRVAL_L[nptr][ivar], DATA, NTOT); }
+    return ;
+  }
+
+  for(irow=0; irow < NROW; irow++ ) {
+
+    if ( ICAST_STORE == ICAST_C ) {
+      CVAL = READTABLE_POINTERS.PTRVAL_C[nptr][ivar][irow] ;
+      if ( ICAST_READ == ICAST_C )
+	{ sprintf(CVAL, "%.*s", NBYTE, &DATA[irow*NBYTE] ); }
+      else {
+	DVAL = dval_BIN(DATA, ICAST_READ, NBYTE, irow);
+	LVAL = (long long)DVAL ;
+	if ( DVAL == (double)LVAL )
+	  { sprintf(CVAL, "%lld", LVAL); }
+	else
+	  { sprintf(CVAL, "%g", DVAL); }
+      }
+      continue ;
+    }
+
+    DVAL = dval_BIN(DATA, ICAST_READ, NBYTE, irow);
+
+    if ( ICAST_STORE == ICAST_D )
+      { READTABLE_POINTERS.PTRVAL_D[nptr][ivar][irow] = DVAL ; }
+    else if ( ICAST_STORE == ICAST_F )
+      { READTABLE_POINTERS.PTRVAL_F[nptr][ivar][irow] = (float)DVAL ; }
+    else if ( ICAST_STORE == ICAST_I )
+      { READTABLE_POINTERS.PTRVAL_I[nptr][ivar][irow] = (int)DVAL ; }
+    else if ( ICAST_STORE == ICAST_S )
+      { READTABLE_POINTERS.PTRVAL_S[nptr][ivar][irow] = (short int)DVAL ; }
+    else if ( ICAST_STORE == ICAST_L )
+      { READTABLE_POINTERS.PTRVAL_L[nptr][ivar][irow] = (long long)DVAL ; }
+    else {
+      sprintf(MSGERR1,"Unknown ICAST=%d  var[%d]=%s  nptr=%d",
+	      ICAST_STORE, ivar, COL->VARNAME, nptr );
+      sprintf(MSGERR2,"See ICAST_  parameters in sntools_output.h");
+      errmsg(SEV_FATAL, 0, fnam, MSGERR1, MSGERR2 );
+    }
+  }
+
+  return ;
+
+} // end copy_column_BIN
+
+
+// ==============================================
+double dval_BIN(char *DATA, int ICAST, int NBYTE, long long irow) {
+
+  // return element irow of stored column as double
+
+  char CTMP[MXCHAR_FILENAME];
+
+  if ( ICAST == ICAST_D ) { return ((double   *)DATA)[irow] ; }
+  if ( ICAST == ICAST_F ) { return (double)((float*)DATA)[irow] ; }
+  if ( ICAST == ICAST_I ) { return (double)((int  *)DATA)[irow] ; }
+  if ( ICAST == ICAST_S ) { return (double)((short int*)DATA)[irow] ; }
+  if ( ICAST == ICAST_L ) { return (double)((long long*)DATA)[irow] ; }
+
+  // string column -> numeric (as sscanf would do for TEXT)
+  sprintf(CTMP, "%.*s", NBYTE, &DATA[irow*NBYTE] );
+  return atof(CTMP);
+
+} // end dval_BIN
+
+
+// ==============================================
+int nbyte_ICAST_BIN(int ICAST, int ISIZE) {
+  if ( ICAST == ICAST_D ) { return sizeof(double); }
+  if ( ICAST == ICAST_F ) { return sizeof(float); }
+  if ( ICAST == ICAST_I ) { return sizeof(int); }
+  if ( ICAST == ICAST_S ) { return sizeof(short int); }
+  if ( ICAST == ICAST_L ) { return sizeof(long long int); }
+  if ( ISIZE > 0 ) { return ISIZE; }
+  return MXCHAR_CCID ;
+} // end nbyte_ICAST_BIN
+
+long long align8_BIN(long long N) { return ( (N+7)/8 ) * 8 ; }
+
+
+// =================================================================
+int SNTABLE_CONVERT_BIN(char *inFile, char *TBNAME, char *outFile) {
+
+  // Created Oct 2026
+  // Convert table TBNAME in *inFile (any readable type, usually
+  // a TEXT FITRES file) to binary table *outFile.
+  // Numeric columns whose values are all integers (within int range)
+  // are stored as int; other numeric columns as double;
+  // string columns keep their max length.
+  // Returns number of rows.
+
+  int   NEVT, NVAR, NROW, IFILETYPE, IDTABLE, ivar, isn, LEN ;
+  int   *ICAST_OUT, *LENSTR ;
+  double **DVAL, DTMP ;
+  char  ***CVAL, *VARNAME, VARLIST[MXCHAR_VARNAME+20] ;
+  char  fnam[] = "SNTABLE_CONVERT_BIN" ;
+
+  // static row buffers passed to SNTABLE_ADDCOL
+  static double ROW_D[MXVAR_TABLE];
+  static int    ROW_I[MXVAR_TABLE];
+  static char   ROW_C[MXVAR_TABLE][MXCHAR_VARNAME+4];
+
+  // ----------- BEGIN -----------
+
+  print_banner(fnam);
+
+  NEVT      = SNTABLE_NEVT(inFile, TBNAME);
+  IFILETYPE = TABLEFILE_OPEN(inFile, "read");
+  NVAR      = SNTABLE_READPREP(IFILETYPE, TBNAME);
+
+  DVAL      = (double**)malloc(NVAR*sizeof(double*));
+  CVAL      = (char ***)malloc(NVAR*sizeof(char**));
+  ICAST_OUT = (int    *)malloc(NVAR*sizeof(int));
+  LENSTR    = (int    *)malloc(NVAR*sizeof(int));
+
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    VARNAME = READTABLE_POINTERS.VARNAME[ivar] ;
+    DVAL[ivar] = NULL;  CVAL[ivar] = NULL;  LENSTR[ivar] = 1 ;
+    if ( READTABLE_POINTERS.ICAST_READ[ivar] == ICAST_C ) {
+      ICAST_OUT[ivar] = ICAST_C ;
+      CVAL[ivar] = (char**)malloc(NEVT*sizeof(char*));
+      for(isn=0; isn < NEVT; isn++ )
+	{ CVAL[ivar][isn] = (char*)malloc((MXCHAR_VARNAME+4)*sizeof(char)); }
+      sprintf(VARLIST,"%s:C", VARNAME);
+      SNTABLE_READPREP_VARDEF(VARLIST, CVAL[ivar], NEVT, 0);
+    }
+    else {
+      ICAST_OUT[ivar] = ICAST_D ;
+      DVAL[ivar] = (double*)malloc(NEVT*sizeof(double));
+      sprintf(VARLIST,"%s:D", VARNAME);
+      SNTABLE_READPREP_VARDEF(VARLIST, DVAL[ivar], NEVT, 0);
+    }
+  }
+
+  NROW = SNTABLE_READ_EXEC();
+
+  if ( IFILETYPE != IFILETYPE_TEXT && IFILETYPE != IFILETYPE_BIN )
+    { TABLEFILE_CLOSE(inFile); }
+
+  // - - - - pick compact cast for output - - - -
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    if ( ICAST_OUT[ivar] == ICAST_C ) {
+      for(isn=0; isn < NROW; isn++ ) {
+	LEN = strlen(CVAL[ivar][isn]);
+	if ( LEN > LENSTR[ivar] ) { LENSTR[ivar] = LEN; }
+      }
+      continue ;
+    }
+    ICAST_OUT[ivar] = ICAST_I ;
+    for(isn=0; isn < NROW; isn++ ) {
+      DTMP = DVAL[ivar][isn] ;
+      // check range before (int) cast; cast of NaN or >INT_MAX is undefined
+      if ( isnan(DTMP) || fabs(DTMP) > 2.0E9 )
+	{ ICAST_OUT[ivar] = ICAST_D ;  break; }
+      if ( DTMP != (double)((int)DTMP) )
+	{ ICAST_OUT[ivar] = ICAST_D ;  break; }
+    }
+  }
+
+  // - - - - write binary table - - - -
+  IDTABLE = TABLEID_FITRES ;
+  if ( strcmp(TBNAME,TABLENAME_SNANA) == 0 ) { IDTABLE = TABLEID_SNANA; }
+
+  TABLEFILE_OPEN(outFile, "new bin");
+  SNTABLE_CREATE(IDTABLE, TBNAME, "key");
+
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    VARNAME = READTABLE_POINTERS.VARNAME[ivar] ;
+    if ( ICAST_OUT[ivar] == ICAST_C ) {
+      sprintf(VARLIST, "%s:C*%d", VARNAME, LENSTR[ivar]);
+      SNTABLE_ADDCOL(IDTABLE, TBNAME, ROW_C[ivar], VARLIST, 1);
+    }
+    else if ( ICAST_OUT[ivar] == ICAST_I ) {
+      sprintf(VARLIST, "%s:I", VARNAME);
+      SNTABLE_ADDCOL(IDTABLE, TBNAME, &ROW_I[ivar], VARLIST, 1);
+    }
+    else {
+      sprintf(VARLIST, "%s:D", VARNAME);
+      SNTABLE_ADDCOL(IDTABLE, TBNAME, &ROW_D[ivar], VARLIST, 1);
+    }
+  }
+
+  for(isn=0; isn < NROW; isn++ ) {
+    for(ivar=0; ivar < NVAR; ivar++ ) {
+      if ( ICAST_OUT[ivar] == ICAST_C )
+	{ sprintf(ROW_C[ivar], "%s", CVAL[ivar][isn]); }
+      else if ( ICAST_OUT[ivar] == ICAST_I )
+	{ ROW_I[ivar] = (int)DVAL[ivar][isn] ; }
+      else
+	{ ROW_D[ivar] = DVAL[ivar][isn] ; }
+    }
+    SNTABLE_FILL(IDTABLE);
+  }
+
+  TABLEFILE_CLOSE(outFile);
+
+  // - - - - free - - - -
+  for(ivar=0; ivar < NVAR; ivar++ ) {
+    if ( DVAL[ivar] ) { free(DVAL[ivar]); }
+    if ( CVAL[ivar] ) {
+      for(isn=0; isn < NEVT; isn++ ) { free(CVAL[ivar][isn]); }
+      free(CVAL[ivar]);
+    }
+  }
+  free(DVAL); free(CVAL); free(ICAST_OUT); free(LENSTR);
+
+  printf("   Converted %d rows x %d columns: %s -> %s \n",
+	 NROW, NVAR, inFile, outFile);
+  fflush(stdout);
+
+  return NROW ;
+
+} // end SNTABLE_CONVERT_BIN
@@ -0,0 +1,507 @@
+/**************************************************
+ Created Oct 2026
+
+ Compile a TEXT SIMLIB into an indexed binary file, and read it back
+ via mmap. See sntools_simlib_bin.h for the file layout.
+
+ The reader hands back the LIBID-record lines one at a time exactly
+ as fgets would for the TEXT file (minus comments), so that the usual
+ SIMLIB_readNextCadence_TEXT parser in snlc_sim.c is used for all
+ header keys. Only the S: rows are different: the caller gets a
+ pointer to the packed row instead of a line to sscanf.
+
+ This file is linked into snlc_sim.exe and simlib_coadd.exe; each
+ of these programs provides parse_SIMLIB_IDplusNEXPOSE.
+
+*********************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "sntools.h"
+#include "sntools_simlib_bin.h"
+
+void parse_SIMLIB_IDplusNEXPOSE(char *inString, int *IDEXPT, int *NEXPOSE);
+
+// growable memory buffer used to assemble each file section
+typedef struct {
+  char    *BUF ;
+  int64_t  LEN, SIZE ;
+} SIMLIB_BIN_BUFFER_DEF ;
+
+static void append_SIMLIB_BIN(SIMLIB_BIN_BUFFER_DEF *B, void *ptr,
+			      int64_t LEN);
+static int64_t pad8_SIMLIB_BIN(int64_t LEN);
+static void parse_row_SIMLIB_BIN(int NEA_PSF_UNIT, int NWD, char **WDLIST,
+				 char *fileName, int LIBID,
+				 SIMLIB_BIN_ROW_DEF *ROW);
+
+
+// =======================================
+void compile_SIMLIB_BIN(char *textFile, char *binFile) {
+
+  // Created Oct 2026
+  // Read TEXT SIMLIB file (textFile) and write compiled binary
+  // SIMLIB (binFile).
+  //  + global header is copied verbatim through the BEGIN line.
+  //  + comment & blank lines are dropped.
+  //  + lines after END_LIBID are kept with the next LIBID record
+  //    so that the TEXT parser sees the same key sequence.
+  //  + each S: row is parsed here and packed; its line is replaced
+  //    by an "S:" stub to mark its position.
+  //  + reading stops at END_OF_SIMLIB (or EOF) as for the sim.
+
+#define MXWDLIST_SIMLIB_BIN 20
+
+  SIMLIB_BIN_BUFFER_DEF GLOBAL, INDEX, TEXT, ROW ;
+  SIMLIB_BIN_HEAD_DEF   HEAD ;
+  SIMLIB_BIN_INDEX_DEF  REC ;
+  SIMLIB_BIN_ROW_DEF    row ;
+  FILE *fp ;
+  int  gzipFlag, NWD, iwd, LEN, NLINE = 0 ;
+  bool IN_GLOBAL = true, IN_REC = false, FOUND_LIBID = false ;
+  char cline[MXCHAR_LINE_SIMLIB_BIN+20], ctmp[MXCHAR_LINE_SIMLIB_BIN+20];
+  char WDLIST[MXWDLIST_SIMLIB_BIN][MXCHAR_LINE_SIMLIB_BIN];
+  char *ptrWDLIST[MXWDLIST_SIMLIB_BIN], *pos ;
+  char stub[] = "S:\n" ;
+  char sepKey[] = " " ;
+  char zero[8] = { 0,0,0,0,0,0,0,0 };
+  char fnam[] = "compile_SIMLIB_BIN" ;
+
+  // ------------- BEGIN -------------
+
+  printf("\n %s: \n\t read  %s \n\t write %s \n", fnam, textFile, binFile);
+  fflush(stdout);
+
+  for(iwd=0; iwd < MXWDLIST_SIMLIB_BIN; iwd++ )
+    { ptrWDLIST[iwd] = WDLIST[iwd]; }
+
+  fp = open_TEXTgz(textFile, "rt", &gzipFlag);
+  if ( fp == NULL ) {
+    sprintf(c1err,"Cannot open TEXT SIMLIB file");
+    sprintf(c2err,"'%s'", textFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  GLOBAL.BUF = INDEX.BUF = TEXT.BUF = ROW.BUF = NULL ;
+  GLOBAL.LEN = INDEX.LEN = TEXT.LEN = ROW.LEN = 0 ;
+  GLOBAL.SIZE= INDEX.SIZE= TEXT.SIZE= ROW.SIZE= 0 ;
+
+  memset(&HEAD, 0, sizeof(SIMLIB_BIN_HEAD_DEF) );
+  memcpy(HEAD.MAGIC, MAGIC_SIMLIB_BIN, 8);
+  HEAD.VERSION   = VERSION_SIMLIB_BIN ;
+  HEAD.LIBID_MIN = 999999999 ;
+  HEAD.LIBID_MAX = -1 ;
+
+  memset(&REC, 0, sizeof(SIMLIB_BIN_INDEX_DEF) );
+
+  while ( fgets(cline, MXCHAR_LINE_SIMLIB_BIN, fp) != NULL ) {
+
+    NLINE++ ;
+    LEN = strlen(cline);
+    if ( cline[LEN-1] != '\n' && !feof(fp) ) {
+      sprintf(c1err,"Line %d exceeds %d chars in",
+	      NLINE, MXCHAR_LINE_SIMLIB_BIN );
+      sprintf(c2err,"%s", textFile);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+
+    // global header: copy verbatim; check PSF_UNIT & BEGIN
+    if ( IN_GLOBAL ) {
+      append_SIMLIB_BIN(&GLOBAL, cline, LEN);
+      sprintf(ctmp, "%s", cline);
+      splitString2(ctmp, sepKey, MXWDLIST_SIMLIB_BIN, &NWD, ptrWDLIST);
+      for(iwd=0; iwd < NWD; iwd++ ) {
+	if ( strcmp(WDLIST[iwd],"PSF_UNIT:") == 0 && iwd < NWD-1 )
+	  { HEAD.NEA_PSF_UNIT = (strncmp(WDLIST[iwd+1],"NEA",3) == 0); }
+	if ( strcmp(WDLIST[iwd],"BEGIN") == 0 )
+	  { IN_GLOBAL = false; }
+      }
+      if ( !IN_GLOBAL && cline[LEN-1] != '\n' )
+	{ append_SIMLIB_BIN(&GLOBAL, "\n", 1); }
+      continue ;
+    }
+
+    if ( (pos=strchr(cline,'\n') ) != NULL )  { *pos = '\0' ; }
+    if ( commentchar(cline) ) { continue; }
+
+    sprintf(ctmp, "%s", cline);
+    splitString2(ctmp, sepKey, MXWDLIST_SIMLIB_BIN, &NWD, ptrWDLIST);
+    if ( NWD == 0 ) { continue; }
+
+    if ( strcmp(WDLIST[0],"END_OF_SIMLIB:") == 0 ) { break; }
+
+    // start new record (after previous END_LIBID)
+    if ( !IN_REC ) {
+      IN_REC = true ;  FOUND_LIBID = false ;
+      REC.LIBID       = -9 ;
+      REC.NROW        = 0 ;
+      REC.OFFSET_TEXT = TEXT.LEN ;
+      REC.IROW        = ROW.LEN / (int64_t)sizeof(SIMLIB_BIN_ROW_DEF) ;
+    }
+
+    if ( strcmp(WDLIST[0],"LIBID:") == 0 && NWD > 1 && !FOUND_LIBID ) {
+      sscanf(WDLIST[1], "%d", &REC.LIBID);
+      FOUND_LIBID = true ;
+    }
+
+    if ( strcmp(WDLIST[0],"S:") == 0 ) {
+      parse_row_SIMLIB_BIN(HEAD.NEA_PSF_UNIT, NWD, ptrWDLIST,
+			   textFile, REC.LIBID, &row);
+      append_SIMLIB_BIN(&ROW, &row, sizeof(SIMLIB_BIN_ROW_DEF) );
+      append_SIMLIB_BIN(&TEXT, stub, strlen(stub) );
+      REC.NROW++ ;
+    }
+    else {
+      append_SIMLIB_BIN(&TEXT, cline, strlen(cline) );
+      append_SIMLIB_BIN(&TEXT, "\n", 1 );
+    }
+
+    if ( strcmp(WDLIST[0],"END_LIBID:") == 0 ) {
+      if ( !FOUND_LIBID ) {
+	sprintf(c1err,"Found END_LIBID without LIBID (line %d) in", NLINE);
+	sprintf(c2err,"%s", textFile);
+	errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+      }
+      REC.LEN_TEXT = TEXT.LEN - REC.OFFSET_TEXT ;
+      append_SIMLIB_BIN(&INDEX, &REC, sizeof(SIMLIB_BIN_INDEX_DEF) );
+      if ( REC.LIBID < HEAD.LIBID_MIN ) { HEAD.LIBID_MIN = REC.LIBID; }
+      if ( REC.LIBID > HEAD.LIBID_MAX ) { HEAD.LIBID_MAX = REC.LIBID; }
+      HEAD.NREC++ ;
+      IN_REC = false ;
+    }
+
+  } // end fgets loop
+
+  fclose(fp);
+
+  if ( HEAD.NREC == 0 ) {
+    sprintf(c1err,"Found no LIBID records in");
+    sprintf(c2err,"%s", textFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  // drop partial record after last END_LIBID
+  if ( IN_REC )
+    { TEXT.LEN = REC.OFFSET_TEXT;  ROW.LEN = REC.IROW*sizeof(row); }
+
+  // - - - - - assign section offsets - - - - -
+  HEAD.NROW          = ROW.LEN / (int64_t)sizeof(SIMLIB_BIN_ROW_DEF) ;
+  HEAD.LEN_GLOBAL    = GLOBAL.LEN ;
+  HEAD.LEN_TEXT      = TEXT.LEN ;
+  HEAD.OFFSET_GLOBAL = pad8_SIMLIB_BIN(sizeof(SIMLIB_BIN_HEAD_DEF)) ;
+  HEAD.OFFSET_INDEX  = HEAD.OFFSET_GLOBAL + pad8_SIMLIB_BIN(GLOBAL.LEN);
+  HEAD.OFFSET_TEXT   = HEAD.OFFSET_INDEX  + pad8_SIMLIB_BIN(INDEX.LEN);
+  HEAD.OFFSET_ROW    = HEAD.OFFSET_TEXT   + pad8_SIMLIB_BIN(TEXT.LEN);
+
+  fp = fopen(binFile, "wb");
+  if ( fp == NULL ) {
+    sprintf(c1err,"Cannot open binary SIMLIB file for writing");
+    sprintf(c2err,"'%s'", binFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  fwrite(&HEAD, sizeof(SIMLIB_BIN_HEAD_DEF), 1, fp);
+  fwrite(zero, 1, HEAD.OFFSET_GLOBAL - sizeof(SIMLIB_BIN_HEAD_DEF), fp);
+  fwrite(GLOBAL.BUF, 1, GLOBAL.LEN, fp);
+  fwrite(zero, 1, pad8_SIMLIB_BIN(GLOBAL.LEN) - GLOBAL.LEN, fp);
+  fwrite(INDEX.BUF,  1, INDEX.LEN,  fp);
+  fwrite(zero, 1, pad8_SIMLIB_BIN(INDEX.LEN) - INDEX.LEN, fp);
+  fwrite(TEXT.BUF,   1, TEXT.LEN,   fp);
+  fwrite(zero, 1, pad8_SIMLIB_BIN(TEXT.LEN) - TEXT.LEN, fp);
+  fwrite(ROW.BUF,    1, ROW.LEN,    fp);
+
+  if ( fclose(fp) != 0 ) {
+    sprintf(c1err,"Error writing binary SIMLIB file");
+    sprintf(c2err,"'%s'", binFile);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  printf("\t Wrote %d LIBID records (LIBID=%d to %d) with %lld S: rows\n",
+	 HEAD.NREC, HEAD.LIBID_MIN, HEAD.LIBID_MAX, (long long)HEAD.NROW);
+  fflush(stdout);
+
+  free(GLOBAL.BUF); free(INDEX.BUF); free(TEXT.BUF); free(ROW.BUF);
+
+  return ;
+
+} // end compile_SIMLIB_BIN
+
+
+// =======================================
+static void parse_row_SIMLIB_BIN(int NEA_PSF_UNIT, int NWD, char **WDLIST,
+				 char *fileName, int LIBID,
+				 SIMLIB_BIN_ROW_DEF *ROW) {
+
+  // Created Oct 2026
+  // Parse S: row words the same way as SIMLIB_readNextCadence_TEXT.
+  // Inputs: NEA_PSF_UNIT, NWD words in WDLIST (WDLIST[0]="S:").
+  // Output: *ROW
+
+  int NWD_EXPECT = ( NEA_PSF_UNIT ? 10 : 12 ) ;
+  int IWD = 0 ;
+  char fnam[] = "parse_row_SIMLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  if ( NWD < NWD_EXPECT ) {
+    sprintf(c1err,"Found %d words in S: row for LIBID=%d (expect %d)",
+	    NWD, LIBID, NWD_EXPECT );
+    sprintf(c2err,"Check %s", fileName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  if ( strlen(WDLIST[3]) >= MXCHAR_BAND_SIMLIB_BIN ) {
+    sprintf(c1err,"BAND='%s' too long for LIBID=%d", WDLIST[3], LIBID);
+    sprintf(c2err,"Check %s", fileName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  memset(ROW, 0, sizeof(SIMLIB_BIN_ROW_DEF) );
+
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->MJD );
+  IWD++; parse_SIMLIB_IDplusNEXPOSE(WDLIST[IWD], &ROW->IDEXPT, &ROW->NEXPOSE);
+  IWD++; sscanf(WDLIST[IWD], "%s" ,  ROW->BAND );
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->CCDGAIN );
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->READNOISE );
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->SKYSIG );
+
+  if ( NEA_PSF_UNIT )
+    { IWD++; sscanf(WDLIST[IWD], "%le", &ROW->NEA ); }
+  else {
+    IWD++; sscanf(WDLIST[IWD], "%le", &ROW->PSFSIG1 );
+    IWD++; sscanf(WDLIST[IWD], "%le", &ROW->PSFSIG2 );
+    IWD++; sscanf(WDLIST[IWD], "%le", &ROW->PSFRATIO );
+  }
+
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->ZPTADU );
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->ZPTERR );
+  IWD++; sscanf(WDLIST[IWD], "%le", &ROW->MAG );
+
+  return ;
+
+} // end parse_row_SIMLIB_BIN
+
+
+// =======================================
+static void append_SIMLIB_BIN(SIMLIB_BIN_BUFFER_DEF *B, void *ptr,
+			      int64_t LEN) {
+
+  // Created Oct 2026
+  // Append LEN bytes to buffer B; double buffer size as needed.
+
+  char fnam[] = "append_SIMLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  if ( B->LEN + LEN > B->SIZE ) {
+    int64_t SIZE = ( B->SIZE > 0 ? 2*B->SIZE : 1000000 );
+    while ( SIZE < B->LEN + LEN ) { SIZE *= 2; }
+    B->BUF = (char*)realloc(B->BUF, SIZE);
+    if ( B->BUF == NULL ) {
+      sprintf(c1err,"Cannot realloc %lld bytes", (long long)SIZE);
+      sprintf(c2err,"for binary SIMLIB section");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    B->SIZE = SIZE;
+  }
+
+  memcpy(&B->BUF[B->LEN], ptr, LEN);
+  B->LEN += LEN ;
+
+} // end append_SIMLIB_BIN
+
+static int64_t pad8_SIMLIB_BIN(int64_t LEN)
+{ return ( (LEN + 7)/8 ) * 8 ; }
+
+
+// =======================================
+FILE *open_SIMLIB_BIN(char *PATH_LIST, char *fileName, char *fullName) {
+
+  // Created Oct 2026
+  // If fileName (searched in pwd, then in space-separated PATH_LIST)
+  // is a compiled SIMLIB, mmap it, fill SIMLIB_BIN struct, and
+  // return a stream over the global-header text so that the usual
+  // TEXT header reader can be used. Cursor is set to first record.
+  //
+  // Returns NULL (and SIMLIB_BIN.USE=0) if file is not found or
+  // does not start with MAGIC_SIMLIB_BIN; caller then reads TEXT.
+  //
+  // Output: fullName = name of opened file
+
+#define MXPATH_SIMLIB_BIN 4
+
+  char *PATH[MXPATH_SIMLIB_BIN], sepKey[] = " " ;
+  char magic[8];
+  int  ipath, NPATH, fd, irec, i, LIBID, NLIBID ;
+  struct stat statbuf ;
+  SIMLIB_BIN_HEAD_DEF *HEAD ;
+  FILE *fp = NULL ;
+  char fnam[] = "open_SIMLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  SIMLIB_BIN.USE = 0 ;
+
+  // check pwd, then each path
+  sprintf(fullName, "%s", fileName );
+  fp = fopen(fullName, "rb");
+  if ( fp == NULL ) {
+    for(ipath=0; ipath < MXPATH_SIMLIB_BIN; ipath++ )
+      { PATH[ipath] = (char*) malloc(MXPATHLEN*sizeof(char) ); }
+    splitString(PATH_LIST, sepKey, fnam, MXPATH_SIMLIB_BIN, &NPATH, PATH);
+    for(ipath=0; ipath < NPATH && fp == NULL; ipath++ ) {
+      sprintf(fullName, "%s/%s", PATH[ipath], fileName );
+      fp = fopen(fullName, "rb");
+    }
+    for(ipath=0; ipath < MXPATH_SIMLIB_BIN; ipath++ )  { free(PATH[ipath]); }
+  }
+
+  if ( fp == NULL ) { return NULL; }
+
+  magic[0] = 0;
+  i = fread(magic, 1, 8, fp);
+  fclose(fp);
+  if ( i != 8 || memcmp(magic, MAGIC_SIMLIB_BIN, 8) != 0 ) { return NULL; }
+
+  // - - - - map entire file - - - -
+  fd = open(fullName, O_RDONLY);
+  if ( fd < 0 || fstat(fd, &statbuf) != 0 ) {
+    sprintf(c1err,"Cannot open/stat binary SIMLIB");
+    sprintf(c2err,"%s", fullName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  SIMLIB_BIN.SIZE = (size_t)statbuf.st_size ;
+  SIMLIB_BIN.MAP  = (char*)mmap(NULL, SIMLIB_BIN.SIZE, PROT_READ,
+				MAP_SHARED, fd, 0);
+  close(fd);
+  if ( SIMLIB_BIN.MAP == MAP_FAILED ) {
+    sprintf(c1err,"Cannot mmap %lld bytes of binary SIMLIB",
+	    (long long)SIMLIB_BIN.SIZE);
+    sprintf(c2err,"%s", fullName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  HEAD = (SIMLIB_BIN_HEAD_DEF*)SIMLIB_BIN.MAP ;
+  if ( HEAD->VERSION != VERSION_SIMLIB_BIN ||
+       HEAD->OFFSET_ROW + HEAD->NROW*(int64_t)sizeof(SIMLIB_BIN_ROW_DEF)
+       > (int64_t)SIMLIB_BIN.SIZE ) {
+    sprintf(c1err,"Invalid binary SIMLIB (VERSION=%d, expect %d) "
+	    "or truncated file", HEAD->VERSION, VERSION_SIMLIB_BIN );
+    sprintf(c2err,"Re-create %s", fullName);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  SIMLIB_BIN.HEAD  = HEAD ;
+  SIMLIB_BIN.INDEX = (SIMLIB_BIN_INDEX_DEF*)(SIMLIB_BIN.MAP+HEAD->OFFSET_INDEX);
+  SIMLIB_BIN.TEXT  = SIMLIB_BIN.MAP + HEAD->OFFSET_TEXT ;
+  SIMLIB_BIN.ROW   = (SIMLIB_BIN_ROW_DEF*)(SIMLIB_BIN.MAP + HEAD->OFFSET_ROW);
+  sprintf(SIMLIB_BIN.FILENAME, "%s", fullName);
+
+  // direct LIBID lookup; missing LIBIDs point to next-higher LIBID
+  NLIBID = HEAD->LIBID_MAX - HEAD->LIBID_MIN + 1 ;
+  SIMLIB_BIN.IREC_vsLIBID = (int*) malloc(NLIBID * sizeof(int) );
+  for(i=0; i < NLIBID; i++ ) { SIMLIB_BIN.IREC_vsLIBID[i] = -1; }
+  for(irec = HEAD->NREC-1; irec >= 0; irec-- ) {
+    LIBID = SIMLIB_BIN.INDEX[irec].LIBID ;
+    SIMLIB_BIN.IREC_vsLIBID[LIBID - HEAD->LIBID_MIN] = irec ;
+  }
+  for(i=NLIBID-2; i >= 0; i-- ) {
+    if ( SIMLIB_BIN.IREC_vsLIBID[i] < 0 )
+      { SIMLIB_BIN.IREC_vsLIBID[i] = SIMLIB_BIN.IREC_vsLIBID[i+1]; }
+  }
+
+  SIMLIB_BIN.USE = 1 ;
+  rewind_SIMLIB_BIN();
+
+  printf("\t Opened : %s \n", fullName );
+  printf("\t (binary SIMLIB: %d LIBIDs, %lld S: rows)\n",
+	 HEAD->NREC, (long long)HEAD->NROW );
+  fflush(stdout);
+
+  fp = fmemopen(SIMLIB_BIN.MAP + HEAD->OFFSET_GLOBAL,
+		(size_t)HEAD->LEN_GLOBAL, "r");
+  return fp ;
+
+} // end open_SIMLIB_BIN
+
+
+// =======================================
+int irec_SIMLIB_BIN(int LIBID) {
+
+  // Created Oct 2026
+  // Return record index for LIBID; if LIBID is not in file, return
+  // record of next-higher LIBID. Return -1 if LIBID > LIBID_MAX.
+
+  int LIBID_MIN = SIMLIB_BIN.HEAD->LIBID_MIN ;
+  int LIBID_MAX = SIMLIB_BIN.HEAD->LIBID_MAX ;
+  if ( LIBID > LIBID_MAX ) { return -1; }
+  if ( LIBID < LIBID_MIN ) { LIBID = LIBID_MIN; }
+  return SIMLIB_BIN.IREC_vsLIBID[LIBID - LIBID_MIN] ;
+
+} // end irec_SIMLIB_BIN
+
+
+// =======================================
+void seek_SIMLIB_BIN(int IREC) {
+
+  // Created Oct 2026
+  // Move read cursor to start of record IREC.
+
+  SIMLIB_BIN_INDEX_DEF *REC = &SIMLIB_BIN.INDEX[IREC] ;
+  char fnam[] = "seek_SIMLIB_BIN" ;
+
+  // ----------- BEGIN ------------
+
+  if ( IREC < 0 || IREC >= SIMLIB_BIN.HEAD->NREC ) {
+    sprintf(c1err,"Invalid IREC=%d (NREC=%d)",
+	    IREC, SIMLIB_BIN.HEAD->NREC);
+    sprintf(c2err,"for %s", SIMLIB_BIN.FILENAME );
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  SIMLIB_BIN.PTR_LINE = SIMLIB_BIN.TEXT + REC->OFFSET_TEXT ;
+  SIMLIB_BIN.PTR_END  = SIMLIB_BIN.TEXT + SIMLIB_BIN.HEAD->LEN_TEXT ;
+  SIMLIB_BIN.IROW     = REC->IROW ;
+
+} // end seek_SIMLIB_BIN
+
+void rewind_SIMLIB_BIN(void) { seek_SIMLIB_BIN(0); }
+
+
+// =======================================
+char *nextLine_SIMLIB_BIN(char *line, SIMLIB_BIN_ROW_DEF **ROW) {
+
+  // Created Oct 2026
+  // fgets-like read of next record line into *line (newline removed).
+  // If line is an S: stub, *ROW points to its packed row; else NULL.
+  // Returns NULL after last record (caller treats as EOF).
+
+  char *ptr = SIMLIB_BIN.PTR_LINE ;
+  char *end = SIMLIB_BIN.PTR_END ;
+  char *eol ;
+  int  LEN ;
+
+  // ----------- BEGIN ------------
+
+  *ROW = NULL ;
+  if ( ptr >= end ) { return NULL; }
+
+  eol = (char*)memchr(ptr, '\n', end-ptr);
+  LEN = ( eol != NULL ) ? (int)(eol-ptr) : (int)(end-ptr) ;
+  memcpy(line, ptr, LEN);  line[LEN] = 0 ;
+  SIMLIB_BIN.PTR_LINE = ptr + LEN + 1 ;
+
+  if ( LEN == 2 && line[0] == 'S' && line[1] == ':' )
+    { *ROW = &SIMLIB_BIN.ROW[SIMLIB_BIN.IROW++] ; }
+
+  return line ;
+
+} // end nextLine_SIMLIB_BIN
+
@@ -0,0 +1,92 @@
+/********************************
+  Created Oct 2026
+
+  Compiled (binary) SIMLIB: each LIBID block of a text SIMLIB is
+  stored as one record so that the simulation can jump to any LIBID
+  without parsing the text file, and the observation (S:) rows are
+  stored as packed numbers so that they are never re-parsed.
+  The file is mapped with mmap; nothing is copied at init.
+
+  File layout (native byte order, each section 8-byte aligned):
+    SIMLIB_BIN_HEAD_DEF            fixed-size file header
+    global header text             verbatim, up to & including BEGIN line
+    SIMLIB_BIN_INDEX_DEF[NREC]     one entry per LIBID record (file order)
+    record text                    non-comment lines of each LIBID block;
+                                   each S: line replaced by "S:" stub
+    SIMLIB_BIN_ROW_DEF[NROW]       packed S: rows in stub order
+
+  Create with
+     simlib_coadd.exe <simlib_file> BINARY
+  and use with sim-input key
+     SIMLIB_FILE: <simlib_file>.COADD.BIN
+
+ *******************************/
+
+#include <stdint.h>
+
+#define MAGIC_SIMLIB_BIN        "SNSIMBIN"
+#define VERSION_SIMLIB_BIN      1
+#define SUFFIX_SIMLIB_BIN       ".BIN"
+#define MXCHAR_LINE_SIMLIB_BIN  380  // same as fgets limit for TEXT SIMLIB
+#define MXCHAR_BAND_SIMLIB_BIN  8
+
+typedef struct {
+  char    MAGIC[8];
+  int     VERSION ;
+  int     NEA_PSF_UNIT ;       // 1 -> NEA column; 0 -> PSFSIG1,2 + RATIO
+  int     NREC ;               // number of LIBID records
+  int     LIBID_MIN, LIBID_MAX ;
+  int     SPARE ;
+  int64_t NROW ;               // total number of packed S: rows
+  int64_t OFFSET_GLOBAL, LEN_GLOBAL ;
+  int64_t OFFSET_INDEX ;
+  int64_t OFFSET_TEXT,   LEN_TEXT ;
+  int64_t OFFSET_ROW ;
+} SIMLIB_BIN_HEAD_DEF ;
+
+typedef struct {
+  int     LIBID ;
+  int     NROW ;               // number of S: rows in this record
+  int64_t OFFSET_TEXT ;        // w.r.t. start of record-text section
+  int64_t LEN_TEXT ;
+  int64_t IROW ;               // index of first packed row
+} SIMLIB_BIN_INDEX_DEF ;
+
+typedef struct {
+  double  MJD, CCDGAIN, READNOISE, SKYSIG ;
+  double  PSFSIG1, PSFSIG2, PSFRATIO, NEA ;
+  double  ZPTADU, ZPTERR, MAG ;
+  int     IDEXPT, NEXPOSE ;
+  char    BAND[MXCHAR_BAND_SIMLIB_BIN] ;
+} SIMLIB_BIN_ROW_DEF ;
+
+
+struct {
+  int     USE ;
+  char    FILENAME[MXPATHLEN] ;
+  size_t  SIZE ;
+  char   *MAP ;
+
+  SIMLIB_BIN_HEAD_DEF  *HEAD ;
+  SIMLIB_BIN_INDEX_DEF *INDEX ;
+  char                 *TEXT ;
+  SIMLIB_BIN_ROW_DEF   *ROW ;
+
+  // LIBID-LIBID_MIN -> record with this LIBID, or next-higher LIBID
+  int    *IREC_vsLIBID ;
+
+  // read cursor (private to each forked process)
+  char    *PTR_LINE, *PTR_END ;
+  int64_t  IROW ;
+} SIMLIB_BIN ;
+
+
+// ---- function prototypes -----
+
+void  compile_SIMLIB_BIN(char *textFile, char *binFile);
+FILE *open_SIMLIB_BIN(char *PATH_LIST, char *fileName, char *fullName);
+int   irec_SIMLIB_BIN(int LIBID);
+void  seek_SIMLIB_BIN(int IREC);
+void  rewind_SIMLIB_BIN(void);
+char *nextLine_SIMLIB_BIN(char *line, SIMLIB_BIN_ROW_DEF **ROW);
+
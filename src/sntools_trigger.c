@@ -48,6 +48,13 @@
     + use new MATCH_SEARCHEFF_FIELD(field_map) function to handle
       overlaps.
 
+  Oct 2026:
+    + DETECT and PHOTPROB map index vs. filter is evaluated once per
+      FIELD (see update_SEARCHEFF_MAPINDEX) instead of string matching
+      for every observation.
+    + DETECT efficiency uses uniform-cell lookup for the map bin
+      instead of binary search.
+
 ************************************/
 
 #include "sntools.h"
@@ -342,7 +349,13 @@ int init_SEARCHEFF_PIPELINE(char *survey) {
 
   // check info for each map and set README comments
   NMAP = INPUTS_SEARCHEFF.NMAP_DETECT;
-  for ( imap=0; imap < NMAP; imap++ )  { check_SEARCHEFF_DETECT(imap); }
+  for ( imap=0; imap < NMAP; imap++ )  { 
+    check_SEARCHEFF_DETECT(imap); 
+    init_LOOKUP_SEARCHEFF_DETECT(imap);
+  }
+
+  // force map-index table to be filled on first event
+  SEARCHEFF_MAPINDEX.NUPDATE = 0 ;
 
   NMAP = INPUTS_SEARCHEFF.NMAP_PHOTPROB;
   for ( imap=0; imap < NMAP; imap++ )  { check_SEARCHEFF_PHOTPROB(imap); }
@@ -1817,6 +1830,9 @@ int gen_SEARCHEFF_PIPELINE(int ID, MJD_DETECT_DEF *MJD_DETECT) {
   }
 
 
+  // check if FIELD changed; if so, update map index vs. filter
+  update_SEARCHEFF_MAPINDEX();
+
   NMJD_DETECT = 0;
   MJD_LAST    = SEARCHEFF_DATA.MJD[0] ;
   NMJD_DETECT = 0 ;
@@ -2043,6 +2059,8 @@ double GETEFF_PIPELINE_DETECT(int obs) {
   // Feb 15 2022: add more info for isnan abort.
   // Jun 15 2022: check opt for single-exposure detections instead of coadd
   // Nov 30 2022: check for FIELD dependence
+  // Oct 2026: get IMAP from SEARCHEFF_MAPINDEX table, and use
+  //           interp_LOOKUP_SEARCHEFF_DETECT.
 
   int NMAP                = INPUTS_SEARCHEFF.NMAP_DETECT ;
   int APPLY_DETECT_SINGLE = INPUTS_SEARCHEFF.APPLY_DETECT_SINGLE ;
@@ -2051,11 +2069,9 @@ double GETEFF_PIPELINE_DETECT(int obs) {
   double EFF_atmax, EFF_atmin, VAL_atmax, VAL_atmin, VAL ;
   double ZERO = 0.0, ONE  = 1.0 ;
 
-  int CID, ifilt_obs, NPE_SAT, NBIN_EFF, imap, IMAP, NMAP_FOUND=0;
-  int OPT_INTERP  = 1;   // 1=linear;  2=quadratic
-  bool MATCH_FILTER, MATCH_FIELD;
+  int CID, ifilt_obs, NPE_SAT, NBIN_EFF, IMAP, NMAP_FOUND=0;
 
-  char cfilt[4], *field_map, *filt_map;
+  char cfilt[4];
   char fnam[] ="GETEFF_PIPELINE_DETECT" ;
 
   // ---------- BEGIN ---------
@@ -2067,21 +2083,9 @@ double GETEFF_PIPELINE_DETECT(int obs) {
   EFF       = 0.0 ;
 
   // find map corresponding to filter and [optional] FIELD
-  ifilt_obs = SEARCHEFF_DATA.IFILTOBS[obs] ;  IMAP=-9;
-  sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
-
-  for(imap=0; imap < NMAP; imap++ ) {
-    field_map     = SEARCHEFF_DETECT[imap].FIELDLIST;
-    filt_map      = SEARCHEFF_DETECT[imap].FILTERLIST ;
-    MATCH_FILTER  = ( strstr(filt_map,cfilt) != NULL );
-    if ( strlen(field_map) > 0 ) 
-      { MATCH_FIELD   = MATCH_SEARCHEFF_FIELD(field_map); }
-    else
-      { MATCH_FIELD = true; }
-
-    if ( MATCH_FILTER && MATCH_FIELD ) 	
-      {  IMAP = imap;   NMAP_FOUND++; }
-  }
+  ifilt_obs  = SEARCHEFF_DATA.IFILTOBS[obs] ;
+  IMAP       = SEARCHEFF_MAPINDEX.IMAP_DETECT[ifilt_obs] ;
+  NMAP_FOUND = SEARCHEFF_MAPINDEX.NMATCH_DETECT[ifilt_obs] ;
 
   // if no maps are found for this filter, there are two possibilities:
   // 1) there are no maps at all --> return EFF=1
@@ -2092,6 +2096,7 @@ double GETEFF_PIPELINE_DETECT(int obs) {
 
 
   if ( NMAP_FOUND > 1 ) {
+    sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
     sprintf(c1err,
 	    "Found %d PIPELINE/DETECT maps for ifilt_obs=%d(%s)",
 	    NMAP_FOUND, ifilt_obs, cfilt);
@@ -2110,6 +2115,7 @@ double GETEFF_PIPELINE_DETECT(int obs) {
 
   if ( isnan(SNR) ) {
     print_preAbort_banner(fnam);
+    sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
 
     double PEAKMJD = SEARCHEFF_DATA.PEAKMJD ;
     double z       = SEARCHEFF_DATA.REDSHIFT ;
@@ -2164,9 +2170,7 @@ double GETEFF_PIPELINE_DETECT(int obs) {
   if ( VAL < VAL_atmin ) { return EFF_atmin ; }
 
   // interpolate
-  EFF = interp_1DFUN (OPT_INTERP, VAL, NBIN_EFF, 
-		      SEARCHEFF_DETECT[IMAP].VAL,
-		      SEARCHEFF_DETECT[IMAP].EFF, fnam);
+  EFF = interp_LOOKUP_SEARCHEFF_DETECT(IMAP, VAL);
 
   // - - - - - 
   if ( APPLY_DETECT_SINGLE && XNEXPOSE > 1.0 ) {
@@ -2185,6 +2189,163 @@ double GETEFF_PIPELINE_DETECT(int obs) {
 } // end of  GETEFF_PIPELINE_DETECT
 
 
+// ***************************************
+void update_SEARCHEFF_MAPINDEX(void) {
+
+  // Created Oct 2026
+  // Fill SEARCHEFF_MAPINDEX table of DETECT and PHOTPROB map index
+  // for each filter, using same FILTER and FIELD matching as before.
+  // Matching depends only on first overlap FIELD, so table is
+  // re-filled only when SEARCHEFF_DATA.FIELDLIST_OVP[0] changes.
+  // NMATCH>1 is stored so that GETEFF_PIPELINE_DETECT and 
+  // setObs_for_PHOTPROB abort only if such filter is used.
+
+  int  NMAP_DETECT   = INPUTS_SEARCHEFF.NMAP_DETECT ;
+  int  NMAP_PHOTPROB = INPUTS_SEARCHEFF.NMAP_PHOTPROB ;
+  char *FIELD        = SEARCHEFF_DATA.FIELDLIST_OVP[0] ;
+  int  ifilt_obs, imap ;
+  bool MATCH_FILTER ;
+  bool MATCH_FIELD_DETECT[MXMAP_SEARCHEFF_DETECT];
+  bool MATCH_FIELD_PHOTPROB[MXMAP_SEARCHEFF_PHOTPROB];
+  char cfilt[4], *field_map, *filt_map ;
+
+  // ----------- BEGIN ------------
+
+  if ( SEARCHEFF_MAPINDEX.NUPDATE > 0 && 
+       strcmp(FIELD,SEARCHEFF_MAPINDEX.FIELD_LAST) == 0 ) { return ; }
+
+  sprintf(SEARCHEFF_MAPINDEX.FIELD_LAST, "%s", FIELD);
+  SEARCHEFF_MAPINDEX.NUPDATE++ ;
+
+  // FIELD match depends only on map
+  for(imap=0; imap < NMAP_DETECT; imap++ ) {
+    field_map = SEARCHEFF_DETECT[imap].FIELDLIST;
+    if ( strlen(field_map) > 0 ) 
+      { MATCH_FIELD_DETECT[imap] = MATCH_SEARCHEFF_FIELD(field_map); }
+    else
+      { MATCH_FIELD_DETECT[imap] = true; }
+  }
+  for(imap=0; imap < NMAP_PHOTPROB; imap++ ) {
+    field_map = SEARCHEFF_PHOTPROB[imap].FIELDLIST;
+    MATCH_FIELD_PHOTPROB[imap] = MATCH_SEARCHEFF_FIELD(field_map);
+  }
+
+  for(ifilt_obs=0; ifilt_obs < MXFILTINDX; ifilt_obs++ ) {
+    SEARCHEFF_MAPINDEX.IMAP_DETECT[ifilt_obs]     = -9 ;
+    SEARCHEFF_MAPINDEX.NMATCH_DETECT[ifilt_obs]   =  0 ;
+    SEARCHEFF_MAPINDEX.IMAP_PHOTPROB[ifilt_obs]   = -9 ;
+    SEARCHEFF_MAPINDEX.NMATCH_PHOTPROB[ifilt_obs] =  0 ;
+    if ( FILTERSTRING[ifilt_obs] == 0 ) { continue; }
+    sprintf(cfilt,"%c", FILTERSTRING[ifilt_obs] );
+
+    for(imap=0; imap < NMAP_DETECT; imap++ ) {
+      filt_map     = SEARCHEFF_DETECT[imap].FILTERLIST ;
+      MATCH_FILTER = ( strstr(filt_map,cfilt) != NULL );
+      if ( MATCH_FILTER && MATCH_FIELD_DETECT[imap] ) {
+	SEARCHEFF_MAPINDEX.IMAP_DETECT[ifilt_obs] = imap ;
+	SEARCHEFF_MAPINDEX.NMATCH_DETECT[ifilt_obs]++ ;
+      }
+    }
+
+    for(imap=0; imap < NMAP_PHOTPROB; imap++ ) {
+      filt_map     = SEARCHEFF_PHOTPROB[imap].FILTERLIST ;
+      MATCH_FILTER = ( strcmp(filt_map,ALL) == 0 || 
+		       strstr(filt_map,cfilt) != NULL );
+      if ( MATCH_FILTER && MATCH_FIELD_PHOTPROB[imap] ) {
+	SEARCHEFF_MAPINDEX.IMAP_PHOTPROB[ifilt_obs] = imap ;
+	SEARCHEFF_MAPINDEX.NMATCH_PHOTPROB[ifilt_obs]++ ;
+      }
+    }
+  } // end ifilt_obs
+
+  return ;
+
+} // end update_SEARCHEFF_MAPINDEX
+
+
+// ***************************************
+void init_LOOKUP_SEARCHEFF_DETECT(int imap) {
+
+  // Created Oct 2026
+  // Prepare uniform cells in VAL (SNR or MAG) for DETECT map imap;
+  // each cell stores the map bin containing the start of the cell,
+  // so that lookup needs no binary search. If VAL is not strictly
+  // increasing, NCELL_LOOKUP=0 and interp_1DFUN is used as before.
+
+  int    NBIN  = SEARCHEFF_DETECT[imap].NBIN ;
+  double *VAL  = SEARCHEFF_DETECT[imap].VAL ;
+  int    NCELL, icell, ibin ;
+  double VALMIN, VALMAX, DVAL, VAL_CELL ;
+
+  // ----------- BEGIN ------------
+
+  SEARCHEFF_DETECT[imap].NCELL_LOOKUP = 0 ;
+  if ( NBIN < 2 ) { return ; }
+
+  for(ibin=1; ibin < NBIN; ibin++ ) 
+    { if ( VAL[ibin] <= VAL[ibin-1] ) { return ; } }
+
+  VALMIN = VAL[0] ;  VALMAX = VAL[NBIN-1] ;
+  NCELL  = NCELL_PER_BIN_SEARCHEFF_LOOKUP * (NBIN-1) ;
+  DVAL   = (VALMAX - VALMIN) / (double)NCELL ;
+
+  SEARCHEFF_DETECT[imap].IBIN_LOOKUP = (int*)malloc(NCELL*sizeof(int));
+
+  ibin = 0 ;
+  for(icell=0; icell < NCELL; icell++ ) {
+    VAL_CELL = VALMIN + DVAL * (double)icell ;
+    while ( ibin < NBIN-2 && VAL[ibin+1] <= VAL_CELL ) { ibin++ ; }
+    SEARCHEFF_DETECT[imap].IBIN_LOOKUP[icell] = ibin ;
+  }
+
+  SEARCHEFF_DETECT[imap].VALMIN_LOOKUP  = VALMIN ;
+  SEARCHEFF_DETECT[imap].DVALINV_LOOKUP = 1.0 / DVAL ;
+  SEARCHEFF_DETECT[imap].NCELL_LOOKUP   = NCELL ;
+
+  return ;
+
+} // end init_LOOKUP_SEARCHEFF_DETECT
+
+
+// ***************************************
+double interp_LOOKUP_SEARCHEFF_DETECT(int imap, double VAL) {
+
+  // Created Oct 2026
+  // Return linear interpolation of DETECT efficiency at VAL,
+  // where VAL is within map range. Uniform cell gives starting map
+  // bin; step forward (rarely needed) if VAL is beyond next map node.
+  // Interpolation is identical to interp_1DFUN.
+
+  int    NCELL = SEARCHEFF_DETECT[imap].NCELL_LOOKUP ;
+  int    NBIN  = SEARCHEFF_DETECT[imap].NBIN ;
+  double *VAL_MAP = SEARCHEFF_DETECT[imap].VAL ;
+  double *EFF_MAP = SEARCHEFF_DETECT[imap].EFF ;
+  double frac ;
+  int    icell, ibin ;
+  int    OPT_INTERP  = 1;   // 1=linear;  2=quadratic
+  char   fnam[] = "interp_LOOKUP_SEARCHEFF_DETECT" ;
+
+  // ----------- BEGIN ------------
+
+  if ( NCELL == 0 ) 
+    { return interp_1DFUN (OPT_INTERP, VAL, NBIN, VAL_MAP, EFF_MAP, fnam); }
+
+  icell = (int)( (VAL - SEARCHEFF_DETECT[imap].VALMIN_LOOKUP) * 
+		 SEARCHEFF_DETECT[imap].DVALINV_LOOKUP );
+  if ( icell < 0      ) { icell = 0; }
+  if ( icell >= NCELL ) { icell = NCELL-1; }
+
+  ibin = SEARCHEFF_DETECT[imap].IBIN_LOOKUP[icell] ;
+  while ( ibin < NBIN-2 && VAL_MAP[ibin+1] <= VAL ) { ibin++ ; }
+  while ( ibin > 0      && VAL_MAP[ibin]   >  VAL ) { ibin-- ; }
+
+  frac = (VAL - VAL_MAP[ibin]) / (VAL_MAP[ibin+1] - VAL_MAP[ibin]) ;
+  return EFF_MAP[ibin] + frac*(EFF_MAP[ibin+1] - EFF_MAP[ibin]) ;
+
+} // end interp_LOOKUP_SEARCHEFF_DETECT
+
+
+
 // *************************************
 void setObs_for_PHOTPROB(int DETECT_FLAG, int obs) {
 
@@ -2202,37 +2363,22 @@ void setObs_for_PHOTPROB(int DETECT_FLAG, int obs) {
   char  *FIELD     = SEARCHEFF_DATA.FIELDNAME ; 
 
   int  NSTORE = OBS_PHOTPROB.NSTORE;
-  int  imap, IMAP, NMATCH;
-  bool MATCH_FIELD, MATCH_FILT ;
-  char FILT[2], *FIELD_TMP, *FILT_TMP;
+  int  IMAP, NMATCH;
+  char FILT[2];
   char fnam[]      = "setObs_for_PHOTPROB" ;
 
   // ------------ BEGIN ------------
 
   if ( NMAP == 0 ) { return ; }
 
-
-  sprintf(FILT, "%c", FILTERSTRING[IFILTOBS] );
-
-  // find map for this filter and field.
-  NMATCH = 0 ;  IMAP=-9;
-  for(imap=0; imap < NMAP; imap++ ) {
-    MATCH_FIELD = MATCH_FILT = false ;
-    FIELD_TMP  = SEARCHEFF_PHOTPROB[imap].FIELDLIST;
-    FILT_TMP   = SEARCHEFF_PHOTPROB[imap].FILTERLIST ;
-
-    MATCH_FIELD = MATCH_SEARCHEFF_FIELD(FIELD_TMP); // Feb 2021
-
-    if ( strcmp(FILT_TMP,ALL) ==0 )        { MATCH_FILT=1; }
-    if ( strstr(FILT_TMP,FILT ) != NULL  ) { MATCH_FILT=1; }
-
-    if ( MATCH_FIELD && MATCH_FILT ) { IMAP = imap;  NMATCH++ ; }
-
-  } // end imap loop
+  // find map for this filter and field (Oct 2026: use table)
+  IMAP   = SEARCHEFF_MAPINDEX.IMAP_PHOTPROB[IFILTOBS] ;
+  NMATCH = SEARCHEFF_MAPINDEX.NMATCH_PHOTPROB[IFILTOBS] ;
 
   if(NMATCH==0 )  { return; }
 
   if(NMATCH > 1 ) {
+    sprintf(FILT, "%c", FILTERSTRING[IFILTOBS] );
     sprintf(c1err,"%d matches to PHOTPROB map invalid.", NMATCH );
     sprintf(c2err,"FIELD='%s'  FILT='%s' ", FIELD, FILT);
     errmsg(SEV_FATAL, 0, fnam, c1err, c2err) ; 
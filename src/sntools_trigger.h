@@ -12,6 +12,9 @@
 
   Feb 05 2021: define FIELDLIST_OVP and NFIELD_OVP
 
+  Oct 2026: define SEARCHEFF_MAPINDEX and uniform-cell lookup for
+            each DETECT map.
+
  **************************************************/
 
 
@@ -147,8 +150,24 @@ struct SEARCHEFF_PIPELINE {
   double *VAL, *EFF ;
   int    NLINE_README;
   char   README[20][MXPATHLEN];
+
+  // Oct 2026: uniform cells in VAL point to map bin for fast lookup;
+  // NCELL_LOOKUP=0 -> use interp_1DFUN.
+  int    NCELL_LOOKUP ;
+  double VALMIN_LOOKUP, DVALINV_LOOKUP ;
+  int    *IBIN_LOOKUP ;   // map bin containing start of each cell
 } SEARCHEFF_DETECT[MXMAP_SEARCHEFF_DETECT+1] ;
 
+// Oct 2026: DETECT and PHOTPROB map index vs. filter, for current FIELD.
+// Re-evaluated only when SEARCHEFF_DATA.FIELDLIST_OVP[0] changes.
+#define NCELL_PER_BIN_SEARCHEFF_LOOKUP  4  // uniform cells per map bin
+struct {
+  int  NUPDATE ;      // number of table updates (FIELD changes)
+  char FIELD_LAST[MXFIELD_OVP*20] ; // field used to fill table
+  int  IMAP_DETECT[MXFILTINDX],   NMATCH_DETECT[MXFILTINDX] ;
+  int  IMAP_PHOTPROB[MXFILTINDX], NMATCH_PHOTPROB[MXFILTINDX] ;
+} SEARCHEFF_MAPINDEX ;
+
 
 int MAPVERSION_SEARCHEFF_PHOTPROB ;
 
@@ -330,6 +349,9 @@ double LOAD_SPECEFF_VAR(int imap, int ivar);
 void   LOAD_PHOTPROB_CDF(int NVAR_CDF, double *WGTLIST );
 double LOAD_PHOTPROB_VAR(int OBS, int IMAP, int IVAR) ;
 double GETEFF_PIPELINE_DETECT(int obs);
+void   init_LOOKUP_SEARCHEFF_DETECT(int imap);
+double interp_LOOKUP_SEARCHEFF_DETECT(int imap, double VAL);
+void   update_SEARCHEFF_MAPINDEX(void);
 
 void   setObs_for_PHOTPROB(int DETECT_FLAG, int obs);
 void   setRan_for_PHOTPROB(void) ;
@@ -169,6 +169,24 @@
     + add -mucovtot_inv_file option to read already inverted cov matrix.
       This goes with create_covariancy.py update to write covtot_inv_[nnn].txt
 
+ Oct 2026:
+    + new -nthread option to distribute chi2-grid evaluation over threads.
+      Each thread has its own scratch arrays (no malloc per grid node),
+      and off-diagonal cov terms are summed for a block of OM nodes 
+      per pass over the inverse-cov matrix (cache blocking). Each node
+      is computed with the same arithmetic as before, and min-chi2 is 
+      found after all threads finish, so results do not depend on nthread.
+    + new -nsig_refine option for coarse-to-fine grid: evaluate every
+      nstep_coarse grid node, then evaluate all nodes only in coarse
+      cells with min chi2 within nsig_refine sigma of min chi2.
+      Skipped nodes are filled with max chi2 of the cell corners.
+    + new -cholesky option: factor COV once (COV = L L^T) and compute
+      chi2 terms from L^-1 dmu with BLAS triangular solve for a block
+      of grid nodes, instead of N^2 loop over explicit inverse.
+    + new -nrank_covsys <k> option: approximate COVsys with its k 
+      largest eigenvectors so that COV = COVstat(diag) + U U^T and 
+      chi2 is computed in O(N*k) per node via Woodbury identity.
+
 *****************************************************************************/
 
 #include <stdlib.h>
@@ -176,6 +194,10 @@
 #include <math.h>
 #include <time.h>
 #include <string.h>
+#include <pthread.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_eigen.h>
 
 #include "fitsio.h"
 #include "longnam.h"
@@ -195,6 +217,19 @@
 
 #define PROBSUM_1SIGMA  0.683
 
+#define MXTHREAD_WFIT     64  // max number of threads for chi2 grid
+#define MXBLOCK_CHI2GRID   8  // number of OM nodes per off-diag pass
+
+#define EVALFLAG_CHI2GRID_SKIP  0  // do not evaluate chi2 at grid node
+#define EVALFLAG_CHI2GRID_TODO  1  // evaluate chi2 at grid node
+#define EVALFLAG_CHI2GRID_DONE  2  // chi2 already evaluated
+#define DEFAULT_nstep_coarse    4  // coarse grid step for -nsig_refine
+
+#define MUCOV_METHOD_INVERSE    0  // explicit inverse of COV (default)
+#define MUCOV_METHOD_CHOLESKY   1  // cached Cholesky factor of COV
+#define MUCOV_METHOD_LOWRANK    2  // COVstat(diag) + low-rank COVsys
+#define MXRANK_COVSYS         500  // max rank for -nrank_covsys
+
 // Define variable names to read in hubble diagram file.
 // VARLIST_DEFAULT_XXX means that any variable is valid for XXX.
 #define  VARLIST_DEFAULT_CID     "CID:C*20 ROW:C*20"
@@ -248,6 +283,11 @@ struct INPUTS {
   char string_muerr_ideal[100];
 
   int   speed_flag_chi2; // default = 1; set to 0 to disable
+  int   nthread;         // number of threads for chi2 grid (default=1)
+  double nsig_refine;    // >0 -> coarse-to-fine grid (Oct 2026)
+  int    nstep_coarse;   // coarse grid uses every nstep_coarse node
+  int    mucov_method;   // MUCOV_METHOD_XXX (Oct 2026)
+  int    nrank_covsys;   // number of COVsys eigenvectors for LOWRANK
   bool  USE_SPEED_OFFDIAG; // internal: skip off-diag calc if chi2(diag)>threshold
   bool  USE_SPEED_INTERP;  // internal: intero r(z) and mu(z)
 
@@ -315,11 +355,9 @@ typedef struct COVMAT {
 struct  {
 
   // define variables interpolate rz for large samples
-  int     n_exec_interp; // number of interpolate calls for r(z) and mu_cos(z)
   int     n_logz_interp; // number of logz bins for interpolation
   double *logz_list_interp, *z_list_interp, logz_bin_interp; 
-  double *rz_list_interp, *mucos_list_interp;
-  double  rz_dif_max ;
+  // rz & mucos lists for interp are in CHI2_SCRATCH (Oct 2026)
 
   // - - - -
   double *omm_val,  *w0_val,  *wa_val;
@@ -351,6 +389,26 @@ struct  {
 
   COVMAT_DEF MUCOV[2]; // up to two cov matrices
   COVMAT_DEF MUCOV_FINAL ;
+
+  // chi2-grid threads (Oct 2026)
+  int  NTHREAD_SCRATCH;   // number of allocated CHI2_SCRATCH
+  int  NROW_CHI2GRID ;    // number of (w0,wa) rows
+  int  NEXTROW_CHI2GRID;  // next row for a thread to grab
+  int  NBDONE_CHI2GRID;   // number of grid nodes done
+  int  NBEVAL_CHI2GRID;   // number of grid nodes to evaluate
+  char *evalflag_chi2grid; // EVALFLAG_CHI2GRID_XXX for each node
+  time_t t0_CHI2GRID ;
+  pthread_mutex_t MUTEX_CHI2GRID;
+
+  // factored COV (Oct 2026); see factor_mucovar
+  double *COVCHOL ;      // lower-triangle Cholesky L, NSN x NSN
+  double *COVCHOL_ONE ;  // L^-1 * 1
+  int     NRANK_COVSYS ; // number of COVsys eigenvectors used
+  double *LOWRANK_DINV ; // 1/COVstat for each SN
+  double *LOWRANK_UTD ;  // (D^-1 U)^T, NRANK x NSN
+  double *LOWRANK_R ;    // Cholesky of I + U^T D^-1 U, NRANK x NRANK
+  double *LOWRANK_RQ ;   // R^-1 U^T D^-1 1
+  double  Csum_COV ;     // 1^T COV^-1 1 (independent of cosmology)
   
   double w0_ran,   wa_ran,   omm_ran;
   double w0_final, wa_final, omm_final, chi2_final ;
@@ -370,6 +428,26 @@ typedef struct  {
   double mushift;  // for HDIBC method only
 } Cosparam ;
 
+// Oct 2026: per-thread scratch arrays for chi2 calculation
+typedef struct {
+  int     ithread ;
+  double *dmu_list[MXBLOCK_CHI2GRID]; // mu_obs-mu_cos per SN, per node
+  double *rz_list_interp, *mucos_list_interp; // r(z) & mu(z) on logz grid
+  double *chol_work ; // NSN x MXBLOCK_CHI2GRID matrix for -cholesky
+
+  // diagnostics for rz-interp
+  int     n_exec_interp; 
+  double  rz_dif_max ;
+} CHI2_SCRATCH_DEF ;
+
+CHI2_SCRATCH_DEF CHI2_SCRATCH[MXTHREAD_WFIT];
+
+// sums for chi2 at one grid node; Eqs A.11,12 of Goliath 2001
+typedef struct {
+  double Bsum, Csum, chi_hat ;
+  bool   do_offdiag ;
+} CHI2_SUMS_DEF ;
+
 
 // define structure to hold hubble diagram (Oct 1 2021)
 typedef struct {
@@ -471,14 +549,25 @@ void sync_HD_LIST(HD_DEF *HD_REF, HD_DEF *HD, COVMAT_DEF *MUCOV);
 void sync_HD_redshifts(HD_DEF *HD0, HD_DEF *HD1) ;
 void compute_MUCOV_FINAL();
 void invert_mucovar(COVMAT_DEF *COV, double sqmurms_add);
+void factor_mucovar(COVMAT_DEF *COV);
+void factor_mucovar_cholesky(COVMAT_DEF *COV);
+void factor_mucovar_lowrank(COVMAT_DEF *COV);
+void free_mucovar_factors(void);
 void check_invertMatrix(int N, double *COV, double *COVINV );
 void set_stepsizes(void);
 void set_Ndof(void);
 void init_rz_interp(HD_DEF *HD);
-void exec_rz_interp(int k, Cosparam *cospar, double *rz, double *dmu);
+void exec_rz_interp(int k, Cosparam *cospar, CHI2_SCRATCH_DEF *SCRATCH,
+		    double *rz, double *dmu);
+void malloc_chi2_scratch(int NTHREAD);
 void check_refit(void);
 
 void wfit_minimize(void);
+void wfit_chi2grid_exec(void);
+void wfit_chi2grid_refine(void);
+int  get_coarse_index(int NSTEP, int *INDEX_LIST);
+void *wfit_chi2grid_thread(void *arg);
+int  wfit_chi2grid_row(int irow, CHI2_SCRATCH_DEF *SCRATCH);
 void prep_speed_offdiag(double extchi_tmp);
 void wfit_normalize(void);
 void wfit_marginalize(void);
@@ -490,6 +579,17 @@ void wfit_FoM(void);
 void wfit_Covariance(void);
 
 
+void get_chi2wOM_diag(Cosparam *cpar, double sqmurms_add, 
+		      CHI2_SCRATCH_DEF *SCRATCH, double *dmu_list, 
+		      CHI2_SUMS_DEF *SUMS);
+void get_chi2wOM_offdiag(int NNODE, CHI2_SCRATCH_DEF *SCRATCH, 
+			 CHI2_SUMS_DEF *SUMS);
+void get_chi2wOM_cholesky(int NUSE, int *ilist, CHI2_SCRATCH_DEF *SCRATCH, 
+			  CHI2_SUMS_DEF *SUMS);
+void get_chi2wOM_lowrank(int NUSE, int *ilist, CHI2_SCRATCH_DEF *SCRATCH, 
+			 CHI2_SUMS_DEF *SUMS);
+void get_chi2wOM_final(Cosparam *cpar, CHI2_SUMS_DEF *SUMS, double *mu_off,
+		       double *chi2sn, double *chi2tot);
 void get_chi2wOM(double w0, double wa, double OM, double sqmurms_add,
 		   double *mu_off, double *chi2sn, double *chi2tot );
 void getname(char *basename, char *tempname, int nrun);
@@ -634,7 +734,10 @@ int main(int argc,char *argv[]){
 
     if ( INPUTS.use_mucov ) {
       compute_MUCOV_FINAL();
-      invert_mucovar(&WORKSPACE.MUCOV_FINAL, INPUTS.sqsnrms);
+      if ( INPUTS.mucov_method == MUCOV_METHOD_INVERSE ) 
+	{ invert_mucovar(&WORKSPACE.MUCOV_FINAL, INPUTS.sqsnrms); }
+      else
+	{ factor_mucovar(&WORKSPACE.MUCOV_FINAL); }
     }
     
     // compute grid step size per floated variable
@@ -718,6 +821,11 @@ void init_stuff(void) {
   INPUTS.string_muerr_ideal[0] = 0 ;
 
   INPUTS.speed_flag_chi2 = SPEED_FLAG_CHI2_DEFAULT ;
+  INPUTS.nthread         = 1 ;
+  INPUTS.nsig_refine     = 0.0 ;
+  INPUTS.nstep_coarse    = DEFAULT_nstep_coarse ;
+  INPUTS.mucov_method    = MUCOV_METHOD_INVERSE ;
+  INPUTS.nrank_covsys    = 0 ;
 
   INPUTS.OMEGA_MATTER_SIM = OMEGA_MATTER_DEFAULT ;
   INPUTS.w0_SIM           = w0_DEFAULT ;
@@ -860,6 +968,11 @@ void print_wfit_help(void) {
     "   -varname_muerr\t column name with distance errors (default=MUERR)",
     "   -refit\tfit once for sigint then refit with snrms=sigint.", 
     "   -speed_flag_chi2   +=1->offdiag trick, +=2->interp trick",
+    "   -nthread\tnumber of threads to compute chi2 grid (default=1)",
+    "   -nsig_refine\tcoarse grid, then refine cells within nsig of chi2min",
+    "   -nstep_coarse\tcoarse grid uses every nstep_coarse node (default=4)",
+    "   -cholesky\tuse Cholesky factor of COV instead of explicit inverse",
+    "   -nrank_covsys\tapprox COVsys with this many eigenvectors",
     "   -debug_flag 91\t compare calc mu(wfit) vs. mu(sim)",
     "   -muerr_ideal  replace all mu with mu_true + Gauss(0,muerr);",
     "                 e.g.,  muerr_ideal 0.1,0.01,0.05 -> "
@@ -1162,6 +1275,21 @@ void parse_args(int argc, char **argv) {
       else if (strcasecmp(argv[iarg]+1,"speed_flag_chi2")==0)
 	{ INPUTS.speed_flag_chi2 = atoi(argv[++iarg]); }      
 
+      else if (strcasecmp(argv[iarg]+1,"nthread")==0)
+	{ INPUTS.nthread = atoi(argv[++iarg]); }      
+
+      else if (strcasecmp(argv[iarg]+1,"nsig_refine")==0)
+	{ INPUTS.nsig_refine = atof(argv[++iarg]); }      
+      else if (strcasecmp(argv[iarg]+1,"nstep_coarse")==0)
+	{ INPUTS.nstep_coarse = atoi(argv[++iarg]); }      
+
+      else if (strcasecmp(argv[iarg]+1,"cholesky")==0)
+	{ INPUTS.mucov_method = MUCOV_METHOD_CHOLESKY; }      
+      else if (strcasecmp(argv[iarg]+1,"nrank_covsys")==0) { 
+	INPUTS.nrank_covsys = atoi(argv[++iarg]); 
+	INPUTS.mucov_method = MUCOV_METHOD_LOWRANK ;
+      }
+
       else {
 	printf("Bad arg: %s\n", argv[iarg]);
 	exit(EXIT_ERRCODE_wfit);
@@ -1175,6 +1303,38 @@ void parse_args(int argc, char **argv) {
 	   
   INPUTS.USE_SPEED_OFFDIAG = (INPUTS.speed_flag_chi2 & SPEED_MASK_OFFDIAG)>0;
 
+  if ( INPUTS.nthread < 1 ) { INPUTS.nthread = 1; }
+  if ( INPUTS.nstep_coarse < 2 ) { INPUTS.nsig_refine = 0.0; }
+
+  // factored COV has no diag-only chi2 -> disable offdiag speed trick
+  if ( INPUTS.mucov_method != MUCOV_METHOD_INVERSE ) {
+    INPUTS.USE_SPEED_OFFDIAG = false ;
+
+    if ( INPUTS.use_mucov == 2 ) {
+      sprintf(c1err,"-cholesky and -nrank_covsys require COV, "
+	      "not inverse COV.");
+      sprintf(c2err,"Use -mucovsys_file instead of -mucovtot_inv_file");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    if ( strlen(INPUTS.outFile_mucovtot_inv) > 0 ) {
+      sprintf(c1err,"Cannot write outfile_mucovtot_inv because");
+      sprintf(c2err,"-cholesky or -nrank_covsys skips inverse COV.");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+  }
+  if ( INPUTS.mucov_method == MUCOV_METHOD_LOWRANK && 
+       (INPUTS.nrank_covsys < 1 || INPUTS.nrank_covsys > MXRANK_COVSYS) ) {
+    sprintf(c1err,"Invalid nrank_covsys = %d", INPUTS.nrank_covsys);
+    sprintf(c2err,"Valid range is 1 to MXRANK_COVSYS=%d", MXRANK_COVSYS);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+  if ( INPUTS.nthread > MXTHREAD_WFIT ) {
+    sprintf(c1err,"nthread=%d exceeds bound", INPUTS.nthread);
+    sprintf(c2err,"Reduce nthread or increase MXTHREAD_WFIT=%d",
+	    MXTHREAD_WFIT);
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
   printf(" ****************************************\n");
   if ( INPUTS.dofit_w0wa )  { 
     printf("   Fit w0waCDM  model:  w(z) = w0 + wa(1-a) \n"); 
@@ -1261,6 +1421,9 @@ void  malloc_workspace(int opt) {
     f_mem += malloc_double3D(+1, INPUTS.w0_steps, INPUTS.wa_steps, 
 			      INPUTS.omm_steps, &WORKSPACE.snprob3d );
 
+    int NBTOT = INPUTS.w0_steps * INPUTS.wa_steps * INPUTS.omm_steps;
+    WORKSPACE.evalflag_chi2grid = (char*)malloc(NBTOT*sizeof(char));
+    
     for(i=0; i < INPUTS.w0_steps; i++ ) {
       for(kk=0; kk < INPUTS.wa_steps; kk ++ ) {
 	for (j=0; j < INPUTS.omm_steps; j++ ) {
@@ -1289,6 +1452,7 @@ void  malloc_workspace(int opt) {
     free(WORKSPACE.omm_sort);
     free(WORKSPACE.w0_sort);
     free(WORKSPACE.wa_sort);    
+    free(WORKSPACE.evalflag_chi2grid);
     
     free(WORKSPACE.extprob);
     free(WORKSPACE.snprob);
@@ -2725,8 +2889,6 @@ void init_rz_interp(HD_DEF *HD) {
 
   // ----------- BEGIN ------------
 
-  WORKSPACE.n_exec_interp = 0;
-
   if ( NSN > 1000 ) 
     { INPUTS.USE_SPEED_INTERP  = (INPUTS.speed_flag_chi2 & SPEED_MASK_INTERP )>0; }
   else
@@ -2748,8 +2910,6 @@ void init_rz_interp(HD_DEF *HD) {
   WORKSPACE.logz_bin_interp   = logz_bin ;
   WORKSPACE.logz_list_interp  = (double*)malloc(MEMD);
   WORKSPACE.z_list_interp     = (double*)malloc(MEMD);
-  WORKSPACE.rz_list_interp    = (double*)malloc(MEMD);
-  WORKSPACE.mucos_list_interp = (double*)malloc(MEMD);
   
   printf("\n# ========================================================= \n");
   printf(" load %d logz bins (%.5f <= z <= %.5f) to interpolate rz(z)\n", 
@@ -2772,11 +2932,15 @@ void init_rz_interp(HD_DEF *HD) {
 
 } // end init_rz_interp
 
-void exec_rz_interp(int k, Cosparam *cparloc, double *rz, double *mucos) {
+void exec_rz_interp(int k, Cosparam *cparloc, CHI2_SCRATCH_DEF *SCRATCH,
+		    double *rz, double *mucos) {
 
   // Created Apr 22 2022
   // return interpolated rz and dmu for SN index k
   // cparloc is used only as a diagnostic for first few chi2 loops.
+  //
+  // Oct 2026: pass SCRATCH with rz & mucos lists for this thread;
+  //           diagnostic only for thread 0.
 
   int    n_logz   = WORKSPACE.n_logz_interp;
   double logz_min = WORKSPACE.logz_list_interp[0];
@@ -2805,37 +2969,39 @@ void exec_rz_interp(int k, Cosparam *cparloc, double *rz, double *mucos) {
   if ( iz < n_logz-1 ) {
     frac = (logz - WORKSPACE.logz_list_interp[iz])/logz_bin;
 
-    rz0    = WORKSPACE.rz_list_interp[iz];
-    rz1    = WORKSPACE.rz_list_interp[iz+1];
+    rz0    = SCRATCH->rz_list_interp[iz];
+    rz1    = SCRATCH->rz_list_interp[iz+1];
     rz_loc = rz0 + frac*(rz1-rz0); 
 
-    mucos0    = WORKSPACE.mucos_list_interp[iz];
-    mucos1    = WORKSPACE.mucos_list_interp[iz+1];
+    mucos0    = SCRATCH->mucos_list_interp[iz];
+    mucos1    = SCRATCH->mucos_list_interp[iz+1];
     mucos_loc = mucos0 + frac*(mucos1-mucos0); 
   }
   else {
-    rz_loc    = WORKSPACE.rz_list_interp[iz];    // last z-bin
-    mucos_loc = WORKSPACE.mucos_list_interp[iz]; // last z-bin
+    rz_loc    = SCRATCH->rz_list_interp[iz];    // last z-bin
+    mucos_loc = SCRATCH->mucos_list_interp[iz]; // last z-bin
   }
   
   // load output function args
   *rz    = rz_loc;
   *mucos = mucos_loc;
 
-  if ( k == HD0->NSN-1 ) { WORKSPACE.n_exec_interp++ ; }
+  if ( SCRATCH->ithread > 0 ) { return; }
+
+  if ( k == HD0->NSN-1 ) { SCRATCH->n_exec_interp++ ; }
 
   // print diagnostic for first few events.
-  int LDMP = (WORKSPACE.n_exec_interp < 5) ;
+  int LDMP = (SCRATCH->n_exec_interp < 5) ;
   if ( LDMP ) {
-    if ( k==0 ) { WORKSPACE.rz_dif_max = 0.0 ; }    
+    if ( k==0 ) { SCRATCH->rz_dif_max = 0.0 ; }    
     rz_exact   = codist(HD0->z[k], cparloc);
     rz_dif     = fabs(rz_loc / rz_exact - 1.0);
-    if ( rz_dif > WORKSPACE.rz_dif_max ) 
-      { WORKSPACE.rz_dif_max = rz_dif; }  
+    if ( rz_dif > SCRATCH->rz_dif_max ) 
+      { SCRATCH->rz_dif_max = rz_dif; }  
 
     if ( k == HD0->NSN-1 ) {
       printf("\t    Diagnostic: max|rz(interp)/rz(exact) - 1| "
-	     "= %8.2le \n",  fnam, WORKSPACE.rz_dif_max); fflush(stdout);
+	     "= %8.2le \n",  fnam, SCRATCH->rz_dif_max); fflush(stdout);
     }
   }
 
@@ -2876,31 +3042,36 @@ void wfit_minimize(void) {
   // Created Oct 2 2021
   // Driver function to minimize chi2 on grid,
   // Outputs loaded to WORKSPACE struct.
+  //
+  // Oct 2026: 
+  //   distribute (w0,wa) rows of grid among INPUTS.nthread threads;
+  //   find min chi2 after all threads are done (same order as before).
 
   int Ndof                 = WORKSPACE.Ndof;
   double sig_chi2min_naive = WORKSPACE.sig_chi2min_naive ;
   bool   USE_SPEED_OFFDIAG = INPUTS.USE_SPEED_OFFDIAG ;
+  int    nthread           = INPUTS.nthread ;
   
   int    use_mucov         = INPUTS.use_mucov;
-  Cosparam cpar;
   Cosparam cpar_fixed;
   double snchi_tmp, extchi_tmp, muoff_tmp;
-  bool UPDATE_STDOUT;
-  int  i, kk, j;
+  int  i, kk, j, ib ;
   int  imin = -9, kmin = -9, jmin = -9;
   char fnam[] = "wfit_minimize" ;
 
   // ---------- BEGIN --------------
 
   int NBTOT = INPUTS.w0_steps * INPUTS.wa_steps * INPUTS.omm_steps;
-  int NB=0;
 
   printf("\n# ======================================= \n");
   printf(" Get prob at %d grid points, and approx mimimized values: \n", 
 	 NBTOT );
   printf("\t USE_SPEED_OFFDIAG = %d \n", INPUTS.USE_SPEED_OFFDIAG);
   printf("\t USE_SPEED_INTERP  = %d \n", INPUTS.USE_SPEED_INTERP);
+  printf("\t nthread           = %d \n", nthread);
   fflush(stdout);
+
+  malloc_chi2_scratch(nthread);
     
   // prep speed trick
   if ( use_mucov && USE_SPEED_OFFDIAG ) {
@@ -2920,25 +3091,29 @@ void wfit_minimize(void) {
   }
 
   // - - - - - - - - 
-  time_t t0 = time(NULL);  // monitor time to build prob grid
+  // monitor time to build prob grid
+  WORKSPACE.t0_CHI2GRID      = time(NULL);  
 
-  cpar.mushift = 0.0;
+  if ( INPUTS.nsig_refine > 0.0 ) {
+    // coarse grid first, then refine cells near chi2 min
+    wfit_chi2grid_refine();
+  }
+  else {
+    // evaluate every grid node
+    for(ib=0; ib < NBTOT; ib++ ) 
+      { WORKSPACE.evalflag_chi2grid[ib] = EVALFLAG_CHI2GRID_TODO; }
+    wfit_chi2grid_exec();
+  }
 
+  // - - - - - - - - 
+  // Keep track of minimum chi2 
   for( i=0; i < INPUTS.w0_steps; i++){
-    cpar.w0 = INPUTS.w0_min + i*INPUTS.w0_stepsize;
     for( kk=0; kk < INPUTS.wa_steps; kk++){    
-      cpar.wa = (INPUTS.wa_min + kk*INPUTS.wa_stepsize);
       for(j=0; j < INPUTS.omm_steps; j++){
-	cpar.omm = INPUTS.omm_min + j*INPUTS.omm_stepsize; 
-	cpar.ome = 1 - cpar.omm;
-	
-	get_chi2wOM ( cpar.w0, cpar.wa, cpar.omm, INPUTS.sqsnrms, 
-		      &muoff_tmp, &snchi_tmp, &extchi_tmp ); 
 
-	WORKSPACE.snchi3d[i][kk][j]  = snchi_tmp ; 
-	WORKSPACE.extchi3d[i][kk][j] = extchi_tmp ;
-	  
-	// Keep track of minimum chi2 
+	snchi_tmp  = WORKSPACE.snchi3d[i][kk][j] ;
+	extchi_tmp = WORKSPACE.extchi3d[i][kk][j] ;
+
 	if(snchi_tmp < WORKSPACE.snchi_min) 
 	  { WORKSPACE.snchi_min = snchi_tmp ; }
 	
@@ -2946,28 +3121,10 @@ void wfit_minimize(void) {
 	  WORKSPACE.extchi_min = extchi_tmp ;  
 	  imin=i; jmin=j; kmin=kk; 
 	}
-
-	// stdout update with timing information
-	NB++;
-	if ( NB < 1000 ) 
-	  { UPDATE_STDOUT = ( NB % 100 == 0 ); }
-	else if ( NB < 10000 ) 
-	  { UPDATE_STDOUT = ( NB % 1000 == 0 ); }
-	else
-	  { UPDATE_STDOUT = ( NB % 10000 == 0 ); }
-
-	if ( UPDATE_STDOUT || NB==NBTOT ) {
-	  char comment[60];
-	  sprintf(comment, "chi2 bin %8d of %8d", NB, NBTOT); 
-	  print_elapsed_time(t0, comment, UNIT_TIME_SECOND);
-	}
-
-
       } // j loop
     }  // end of k-loop
   }  // end of i-loop
 
-
   // get w,OM at min chi2 by using more refined grid
   // Pass approx w,OM,  then return w,OM at true min
   //  printf("  Get minimized w,OM from refined chi2grid \n");
@@ -2989,6 +3146,415 @@ void wfit_minimize(void) {
 } // end wfit_minimize
 
 
+// =============================
+void wfit_chi2grid_exec(void) {
+
+  // Created Oct 2026
+  // Evaluate chi2 at each grid node with 
+  //   evalflag_chi2grid = EVALFLAG_CHI2GRID_TODO ;
+  // (w0,wa) rows are distributed among INPUTS.nthread threads.
+
+  int  nthread = INPUTS.nthread ;
+  int  NBTOT   = INPUTS.w0_steps * INPUTS.wa_steps * INPUTS.omm_steps;
+  int  ib, t, rc, NBEVAL = 0 ;
+  pthread_t thread[MXTHREAD_WFIT];
+  char fnam[] = "wfit_chi2grid_exec" ;
+
+  // ---------- BEGIN --------------
+
+  for(ib=0; ib < NBTOT; ib++ ) {
+    if ( WORKSPACE.evalflag_chi2grid[ib] == EVALFLAG_CHI2GRID_TODO ) 
+      { NBEVAL++ ; }
+  }
+
+  WORKSPACE.NROW_CHI2GRID    = INPUTS.w0_steps * INPUTS.wa_steps ;
+  WORKSPACE.NEXTROW_CHI2GRID = 0 ;
+  WORKSPACE.NBDONE_CHI2GRID  = 0 ;
+  WORKSPACE.NBEVAL_CHI2GRID  = NBEVAL ;
+  if ( NBEVAL == 0 ) { return; }
+
+  pthread_mutex_init(&WORKSPACE.MUTEX_CHI2GRID, NULL);
+
+  // thread 0 is this thread
+  for ( t=1; t < nthread; t++ ) {
+    rc = pthread_create(&thread[t], NULL, wfit_chi2grid_thread, 
+			&CHI2_SCRATCH[t] );
+    if ( rc != 0 ) {
+      sprintf(c1err,"pthread_create returned errcode=%d for t=%d", rc, t);
+      sprintf(c2err,"Try smaller nthread (=%d)", nthread);
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+  }
+  wfit_chi2grid_thread(&CHI2_SCRATCH[0]);
+  for ( t=1; t < nthread; t++ ) { pthread_join(thread[t], NULL); }
+
+  pthread_mutex_destroy(&WORKSPACE.MUTEX_CHI2GRID);
+
+  return ;
+
+} // end wfit_chi2grid_exec
+
+
+// =============================
+void wfit_chi2grid_refine(void) {
+
+  // Created Oct 2026
+  // Coarse-to-fine chi2 grid:
+  //  1) evaluate chi2 on coarse grid using every nstep_coarse node 
+  //     (and last node) along each axis.
+  //  2) for each coarse cell, if min chi2 on cell corners is within
+  //     nsig_refine sigma of coarse chi2min (Dchi2 < nsig^2), 
+  //     flag all nodes inside the cell.
+  //  3) nodes in skipped cells are filled with max chi2 of the cell 
+  //     corners, which is at least nsig^2 above chi2min; these nodes 
+  //     thus have prob < exp(-nsig^2/2) relative to the peak so that
+  //     wfit_marginalize & wfit_uncertainty are not biased.
+  //  4) evaluate flagged nodes.
+
+  int    NW0   = INPUTS.w0_steps ;
+  int    NWA   = INPUTS.wa_steps ;
+  int    NOMM  = INPUTS.omm_steps ;
+  int    NBTOT = NW0 * NWA * NOMM ;
+  double nsig  = INPUTS.nsig_refine ;
+  double dchi2_refine = nsig * nsig ;
+  int    *ilist_w0  = (int*) malloc(NW0  * sizeof(int) );
+  int    *ilist_wa  = (int*) malloc(NWA  * sizeof(int) );
+  int    *ilist_omm = (int*) malloc(NOMM * sizeof(int) );
+  int    NC_w0, NC_wa, NC_omm, NCELL_w0, NCELL_wa, NCELL_omm ;
+  int    i, kk, j, ci, ck, cj, i0,i1, k0,k1, j0,j1, ib, ic,kc,jc ;
+  int    NCELL_REFINE = 0, NCELL_TOT = 0, NBEVAL_TOT = 0 ;
+  double chi2min = 1.0E20, chi2, snchi_max, extchi_max, extchi_min ;
+  char   *evalflag = WORKSPACE.evalflag_chi2grid ;
+  char   fnam[] = "wfit_chi2grid_refine" ;
+
+  // ---------- BEGIN --------------
+
+  NC_w0  = get_coarse_index(NW0,  ilist_w0 );
+  NC_wa  = get_coarse_index(NWA,  ilist_wa );
+  NC_omm = get_coarse_index(NOMM, ilist_omm);
+
+  printf("   %s: coarse grid = %d x %d x %d nodes (nstep_coarse=%d) \n",
+	 fnam, NC_w0, NC_wa, NC_omm, INPUTS.nstep_coarse );
+  printf("   %s: refine cells with chi2 < chi2min + %.2f \n", 
+	 fnam, dchi2_refine);
+  fflush(stdout);
+
+  // - - - - - 
+  // step 1: coarse grid
+  for(ib=0; ib < NBTOT; ib++ ) { evalflag[ib] = EVALFLAG_CHI2GRID_SKIP; }
+  for(ci=0; ci < NC_w0; ci++ ) {
+    for(ck=0; ck < NC_wa; ck++ ) {
+      for(cj=0; cj < NC_omm; cj++ ) {
+	ib = (ilist_w0[ci]*NWA + ilist_wa[ck])*NOMM + ilist_omm[cj];
+	evalflag[ib] = EVALFLAG_CHI2GRID_TODO ;
+      }
+    }
+  }
+  wfit_chi2grid_exec();
+  NBEVAL_TOT += WORKSPACE.NBEVAL_CHI2GRID ;
+
+  for(ci=0; ci < NC_w0; ci++ ) {
+    for(ck=0; ck < NC_wa; ck++ ) {
+      for(cj=0; cj < NC_omm; cj++ ) {
+	chi2 = WORKSPACE.extchi3d[ilist_w0[ci]][ilist_wa[ck]][ilist_omm[cj]];
+	if ( chi2 < chi2min ) { chi2min = chi2; }
+      }
+    }
+  }
+
+  // - - - - - 
+  // step 2: flag nodes in coarse cells near chi2min.
+  // For an axis with 1 coarse node, the cell is that node.
+  NCELL_w0  = ( NC_w0  > 1 ) ? NC_w0 -1 : 1 ;
+  NCELL_wa  = ( NC_wa  > 1 ) ? NC_wa -1 : 1 ;
+  NCELL_omm = ( NC_omm > 1 ) ? NC_omm-1 : 1 ;
+
+  for(ci=0; ci < NCELL_w0; ci++ ) {
+    i0 = ilist_w0[ci];  i1 = ( NC_w0 > 1 ) ? ilist_w0[ci+1] : i0 ;
+    for(ck=0; ck < NCELL_wa; ck++ ) {
+      k0 = ilist_wa[ck];  k1 = ( NC_wa > 1 ) ? ilist_wa[ck+1] : k0 ;
+      for(cj=0; cj < NCELL_omm; cj++ ) {
+	j0 = ilist_omm[cj]; j1 = ( NC_omm > 1 ) ? ilist_omm[cj+1] : j0 ;
+
+	NCELL_TOT++ ;
+	extchi_min = 1.0E20 ;
+	for(ic=0; ic < 2; ic++ ) {
+	  i = ( ic==0 ) ? i0 : i1 ;
+	  for(kc=0; kc < 2; kc++ ) {
+	    kk = ( kc==0 ) ? k0 : k1 ;
+	    for(jc=0; jc < 2; jc++ ) {
+	      j = ( jc==0 ) ? j0 : j1 ;
+	      chi2 = WORKSPACE.extchi3d[i][kk][j] ;
+	      if ( chi2 < extchi_min ) { extchi_min = chi2; }
+	    }
+	  }
+	}
+
+	if ( extchi_min - chi2min > dchi2_refine ) { continue; }
+
+	NCELL_REFINE++ ;
+	for(i=i0; i <= i1; i++ ) {
+	  for(kk=k0; kk <= k1; kk++ ) {
+	    for(j=j0; j <= j1; j++ ) {
+	      ib = (i*NWA + kk)*NOMM + j ;
+	      if ( evalflag[ib] == EVALFLAG_CHI2GRID_SKIP ) 
+		{ evalflag[ib] = EVALFLAG_CHI2GRID_TODO; }
+	    }
+	  }
+	}
+      } // end cj
+    } // end ck
+  } // end ci
+
+  printf("   %s: refine %d of %d coarse cells \n", 
+	 fnam, NCELL_REFINE, NCELL_TOT);
+  fflush(stdout);
+
+  // - - - - - 
+  // step 3: fill nodes that remain skipped with max chi2 on
+  //         corners of skipped cell.
+  for(ci=0; ci < NCELL_w0; ci++ ) {
+    i0 = ilist_w0[ci];  i1 = ( NC_w0 > 1 ) ? ilist_w0[ci+1] : i0 ;
+    for(ck=0; ck < NCELL_wa; ck++ ) {
+      k0 = ilist_wa[ck];  k1 = ( NC_wa > 1 ) ? ilist_wa[ck+1] : k0 ;
+      for(cj=0; cj < NCELL_omm; cj++ ) {
+	j0 = ilist_omm[cj]; j1 = ( NC_omm > 1 ) ? ilist_omm[cj+1] : j0 ;
+
+	snchi_max = extchi_max = -1.0E20 ;
+	for(ic=0; ic < 2; ic++ ) {
+	  i = ( ic==0 ) ? i0 : i1 ;
+	  for(kc=0; kc < 2; kc++ ) {
+	    kk = ( kc==0 ) ? k0 : k1 ;
+	    for(jc=0; jc < 2; jc++ ) {
+	      j = ( jc==0 ) ? j0 : j1 ;
+	      chi2 = WORKSPACE.snchi3d[i][kk][j] ;
+	      if ( chi2 > snchi_max ) { snchi_max = chi2; }
+	      chi2 = WORKSPACE.extchi3d[i][kk][j] ;
+	      if ( chi2 > extchi_max ) { extchi_max = chi2; }
+	    }
+	  }
+	}
+
+	for(i=i0; i <= i1; i++ ) {
+	  for(kk=k0; kk <= k1; kk++ ) {
+	    for(j=j0; j <= j1; j++ ) {
+	      ib = (i*NWA + kk)*NOMM + j ;
+	      if ( evalflag[ib] != EVALFLAG_CHI2GRID_SKIP ) { continue; }
+	      WORKSPACE.snchi3d[i][kk][j]  = snchi_max ;
+	      WORKSPACE.extchi3d[i][kk][j] = extchi_max ;
+	    }
+	  }
+	}
+      } // end cj
+    } // end ck
+  } // end ci
+
+  // - - - - - 
+  // step 4: evaluate nodes in refined cells
+  wfit_chi2grid_exec();
+  NBEVAL_TOT += WORKSPACE.NBEVAL_CHI2GRID ;
+
+  printf("   %s: evaluated chi2 at %d of %d grid nodes (%.1f%%)\n",
+	 fnam, NBEVAL_TOT, NBTOT, 100.0*(double)NBEVAL_TOT/(double)NBTOT);
+  fflush(stdout);
+
+  free(ilist_w0);  free(ilist_wa);  free(ilist_omm);
+
+  return ;
+
+} // end wfit_chi2grid_refine
+
+
+// =============================
+int get_coarse_index(int NSTEP, int *INDEX_LIST) {
+
+  // Created Oct 2026
+  // Load INDEX_LIST with coarse-grid indices 0, nstep_coarse, 
+  // 2*nstep_coarse ... and always include last index NSTEP-1.
+  // Function returns number of coarse indices.
+
+  int nstep_coarse = INPUTS.nstep_coarse ;
+  int index, N = 0 ;
+
+  // ---------- BEGIN --------------
+
+  for(index=0; index < NSTEP; index += nstep_coarse ) 
+    { INDEX_LIST[N] = index;  N++ ; }
+
+  if ( INDEX_LIST[N-1] != NSTEP-1 ) 
+    { INDEX_LIST[N] = NSTEP-1;  N++ ; }
+
+  return N ;
+
+} // end get_coarse_index
+
+
+// =============================
+void *wfit_chi2grid_thread(void *arg) {
+
+  // Created Oct 2026
+  // Grab next (w0,wa) row of chi2 grid and evaluate flagged OM nodes;
+  // repeat until no rows are left. Prints progress with timing.
+
+  CHI2_SCRATCH_DEF *SCRATCH = (CHI2_SCRATCH_DEF *)arg;
+  int NBTOT = WORKSPACE.NBEVAL_CHI2GRID ;
+  int NROW  = WORKSPACE.NROW_CHI2GRID ;
+  int irow, NB_last, NB, NUPD, NEVAL ;
+
+  // ---------- BEGIN --------------
+
+  while ( 1 ) {
+
+    pthread_mutex_lock(&WORKSPACE.MUTEX_CHI2GRID);
+    irow = WORKSPACE.NEXTROW_CHI2GRID++ ;
+    pthread_mutex_unlock(&WORKSPACE.MUTEX_CHI2GRID);
+    if ( irow >= NROW ) { break; }
+
+    NEVAL = wfit_chi2grid_row(irow, SCRATCH);
+    if ( NEVAL == 0 ) { continue; }
+
+    // stdout update with timing information
+    pthread_mutex_lock(&WORKSPACE.MUTEX_CHI2GRID);
+    NB_last = WORKSPACE.NBDONE_CHI2GRID ;
+    NB      = NB_last + NEVAL ;
+    WORKSPACE.NBDONE_CHI2GRID = NB ;
+
+    if ( NB < 1000 ) 
+      { NUPD = 100; }
+    else if ( NB < 10000 ) 
+      { NUPD = 1000; }
+    else
+      { NUPD = 10000; }
+
+    if ( NB/NUPD > NB_last/NUPD || NB==NBTOT ) {
+      char comment[60];
+      sprintf(comment, "chi2 bin %8d of %8d", NB, NBTOT); 
+      print_elapsed_time(WORKSPACE.t0_CHI2GRID, comment, UNIT_TIME_SECOND);
+    }
+    pthread_mutex_unlock(&WORKSPACE.MUTEX_CHI2GRID);
+  }
+
+  return (void*)0 ;
+
+} // end wfit_chi2grid_thread
+
+
+// =============================
+int wfit_chi2grid_row(int irow, CHI2_SCRATCH_DEF *SCRATCH) {
+
+  // Created Oct 2026
+  // Evaluate chi2 for flagged OM nodes at (w0,wa) row index 
+  // irow = i*wa_steps + kk, and store in snchi3d & extchi3d.
+  // OM nodes are processed in blocks of MXBLOCK_CHI2GRID so that 
+  // each pass over the inverse cov matrix serves the whole block.
+  // Function returns number of evaluated nodes.
+
+  int    i  = irow / INPUTS.wa_steps ;
+  int    kk = irow % INPUTS.wa_steps ;
+  int    NOMM = INPUTS.omm_steps ;
+  char   *evalflag = &WORKSPACE.evalflag_chi2grid[irow*NOMM] ;
+  int    j, jj, b, NNODE = 0, NEVAL = 0, jlist[MXBLOCK_CHI2GRID] ;
+  double muoff_tmp, snchi_tmp, extchi_tmp;
+  Cosparam      cpar[MXBLOCK_CHI2GRID];
+  CHI2_SUMS_DEF SUMS[MXBLOCK_CHI2GRID];
+
+  // ---------- BEGIN --------------
+
+  for ( jj=0; jj < NOMM; jj++ ) {
+
+    if ( evalflag[jj] == EVALFLAG_CHI2GRID_TODO ) 
+      { jlist[NNODE] = jj;  NNODE++ ; }
+
+    // process block when full, or at end of row
+    if ( NNODE < MXBLOCK_CHI2GRID && jj < NOMM-1 ) { continue; }
+    if ( NNODE == 0 ) { continue; }
+
+    for ( b=0; b < NNODE; b++ ) {
+      j = jlist[b];
+      cpar[b].w0      = INPUTS.w0_min  + i *INPUTS.w0_stepsize;
+      cpar[b].wa      = INPUTS.wa_min  + kk*INPUTS.wa_stepsize;
+      cpar[b].omm     = INPUTS.omm_min + j *INPUTS.omm_stepsize; 
+      cpar[b].ome     = 1.0 - cpar[b].omm;
+      cpar[b].mushift = 0.0 ;
+      get_chi2wOM_diag(&cpar[b], INPUTS.sqsnrms, SCRATCH, 
+		       SCRATCH->dmu_list[b], &SUMS[b] );
+    }
+
+    get_chi2wOM_offdiag(NNODE, SCRATCH, SUMS);
+
+    for ( b=0; b < NNODE; b++ ) {
+      j = jlist[b];
+      get_chi2wOM_final(&cpar[b], &SUMS[b], 
+			&muoff_tmp, &snchi_tmp, &extchi_tmp);
+      WORKSPACE.snchi3d[i][kk][j]  = snchi_tmp ; 
+      WORKSPACE.extchi3d[i][kk][j] = extchi_tmp ;
+      evalflag[j] = EVALFLAG_CHI2GRID_DONE ;
+    }
+
+    NEVAL += NNODE ;
+    NNODE  = 0 ;
+  }
+
+  return NEVAL ;
+
+} // end wfit_chi2grid_row
+
+
+// =============================
+void malloc_chi2_scratch(int NTHREAD) {
+
+  // Created Oct 2026
+  // malloc per-thread scratch arrays for chi2 calc so that there is 
+  // no malloc per grid node. Previous scratch arrays are freed.
+
+  int  NSN    = HD_LIST[0].NSN ;
+  int  n_logz = WORKSPACE.n_logz_interp ;
+  int  MEMD_SN   = NSN * sizeof(double);
+  int  MEMD_LOGZ = n_logz * sizeof(double);
+  int  t, b ;
+  CHI2_SCRATCH_DEF *SCRATCH;
+
+  // ---------- BEGIN --------------
+
+  for ( t=0; t < WORKSPACE.NTHREAD_SCRATCH; t++ ) {
+    SCRATCH = &CHI2_SCRATCH[t];
+    for(b=0; b < MXBLOCK_CHI2GRID; b++ ) { free(SCRATCH->dmu_list[b]); }
+    if ( SCRATCH->rz_list_interp != NULL ) {
+      free(SCRATCH->rz_list_interp);
+      free(SCRATCH->mucos_list_interp);
+    }
+    if ( SCRATCH->chol_work != NULL ) { free(SCRATCH->chol_work); }
+  }
+
+  for ( t=0; t < NTHREAD; t++ ) {
+    SCRATCH = &CHI2_SCRATCH[t];
+    SCRATCH->ithread = t;
+    for(b=0; b < MXBLOCK_CHI2GRID; b++ ) 
+      { SCRATCH->dmu_list[b] = (double*) malloc(MEMD_SN); }
+
+    SCRATCH->rz_list_interp    = NULL ;
+    SCRATCH->mucos_list_interp = NULL ;
+    if ( INPUTS.USE_SPEED_INTERP ) {
+      SCRATCH->rz_list_interp    = (double*) malloc(MEMD_LOGZ);
+      SCRATCH->mucos_list_interp = (double*) malloc(MEMD_LOGZ);
+    }
+    SCRATCH->chol_work = NULL ;
+    if ( INPUTS.use_mucov && INPUTS.mucov_method==MUCOV_METHOD_CHOLESKY ) {
+      SCRATCH->chol_work = 
+	(double*) malloc(MEMD_SN * MXBLOCK_CHI2GRID);
+    }
+
+    SCRATCH->n_exec_interp = 0 ;
+    SCRATCH->rz_dif_max    = 0.0 ;
+  }
+
+  WORKSPACE.NTHREAD_SCRATCH = NTHREAD;
+
+  return ;
+
+} // end malloc_chi2_scratch
+
+
 // =============================
 void prep_speed_offdiag(double chi2min_approx) {
 
@@ -4015,6 +4581,258 @@ void invert_mucovar(COVMAT_DEF *MUCOV, double sqmurms_add) {
 } // end of invert_mucovar
 
 
+// ==================================
+void factor_mucovar(COVMAT_DEF *MUCOV) {
+
+  // Created Oct 2026
+  // Alternative to invert_mucovar: factor COV once and store
+  // factors in WORKSPACE so that chi2 at each grid node is 
+  // computed without explicit inverse.
+  //   -cholesky       : COV = L L^T
+  //   -nrank_covsys k : COV = D + U U^T with D = diag(COVstat)
+  //                     and U U^T = k-eigenvector approx of COVsys.
+
+  int  NSN    = MUCOV->NDIM ;
+  int  LDMP_MUCOV = INPUTS.ndump_mucov > 0 ;
+  time_t t0;
+  char fnam[] = "factor_mucovar" ;
+
+  // ---------------- BEGIN --------------
+
+  if ( LDMP_MUCOV ) { dump_MUCOV(MUCOV,"MUCOV"); }
+
+  t0 = time(NULL);
+
+  free_mucovar_factors(); // from previous fit (-refit)
+
+  if ( INPUTS.mucov_method == MUCOV_METHOD_CHOLESKY ) {
+    printf("\t Cholesky factor %d x %d mucov matrix \n", NSN, NSN);
+    fflush(stdout);
+    factor_mucovar_cholesky(MUCOV);
+  }
+  else if ( INPUTS.mucov_method == MUCOV_METHOD_LOWRANK ) {
+    printf("\t Low-rank (%d) + diag factor of %d x %d mucov matrix \n", 
+	   INPUTS.nrank_covsys, NSN, NSN);
+    fflush(stdout);
+    factor_mucovar_lowrank(MUCOV);
+  }
+  else {
+    sprintf(c1err,"Invalid mucov_method = %d", INPUTS.mucov_method);
+    sprintf(c2err,"Check -cholesky or -nrank_covsys");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  print_elapsed_time(t0, "factor matrix", UNIT_TIME_SECOND);
+
+  return ;
+
+} // end of factor_mucovar
+
+
+// ==================================
+void free_mucovar_factors(void) {
+
+  // Created Oct 2026
+  // Free COV factors from previous call to factor_mucovar.
+  // Pointers are NULL before first call (global struct).
+
+  free(WORKSPACE.COVCHOL);       WORKSPACE.COVCHOL      = NULL ;
+  free(WORKSPACE.COVCHOL_ONE);   WORKSPACE.COVCHOL_ONE  = NULL ;
+  free(WORKSPACE.LOWRANK_DINV);  WORKSPACE.LOWRANK_DINV = NULL ;
+  free(WORKSPACE.LOWRANK_UTD);   WORKSPACE.LOWRANK_UTD  = NULL ;
+  free(WORKSPACE.LOWRANK_R);     WORKSPACE.LOWRANK_R    = NULL ;
+  free(WORKSPACE.LOWRANK_RQ);    WORKSPACE.LOWRANK_RQ   = NULL ;
+
+} // end free_mucovar_factors
+
+
+// ==================================
+void factor_mucovar_cholesky(COVMAT_DEF *MUCOV) {
+
+  // Created Oct 2026
+  // Store lower-triangle Cholesky factor L of COV (COV = L L^T),
+  // L^-1 * 1 and Csum = 1^T COV^-1 1.
+  // Upper triangle of COVCHOL is not used (CblasLower).
+
+  int    NSN  = MUCOV->NDIM ;
+  size_t MEMD = (size_t)NSN * (size_t)NSN * sizeof(double);
+  int    i, status ;
+  double Csum = 0.0 ;
+  gsl_error_handler_t *handler_orig ;
+  char fnam[] = "factor_mucovar_cholesky" ;
+
+  // ---------------- BEGIN --------------
+
+  WORKSPACE.COVCHOL = (double*) malloc(MEMD);
+  memcpy(WORKSPACE.COVCHOL, MUCOV->ARRAY1D, MEMD);
+
+  gsl_matrix_view L_view = gsl_matrix_view_array(WORKSPACE.COVCHOL,NSN,NSN);
+
+  handler_orig = gsl_set_error_handler_off();
+  status = gsl_linalg_cholesky_decomp(&L_view.matrix);
+  gsl_set_error_handler(handler_orig);
+
+  if ( status != GSL_SUCCESS ) {
+    sprintf(c1err,"Cholesky decomp failed (status=%d) for %d x %d COV", 
+	    status, NSN, NSN);
+    sprintf(c2err,"COV is not positive definite.");
+    errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+  }
+
+  WORKSPACE.COVCHOL_ONE = (double*) malloc(NSN*sizeof(double));
+  for(i=0; i < NSN; i++ ) { WORKSPACE.COVCHOL_ONE[i] = 1.0 ; }
+  gsl_vector_view u_view = gsl_vector_view_array(WORKSPACE.COVCHOL_ONE, NSN);
+  gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, 
+		 &L_view.matrix, &u_view.vector);
+
+  for(i=0; i < NSN; i++ ) 
+    { Csum += WORKSPACE.COVCHOL_ONE[i] * WORKSPACE.COVCHOL_ONE[i]; }
+  WORKSPACE.Csum_COV = Csum ;
+
+  return ;
+
+} // end of factor_mucovar_cholesky
+
+
+// ==================================
+void factor_mucovar_lowrank(COVMAT_DEF *MUCOV) {
+
+  // Created Oct 2026
+  // Split COV = D + COVsys, where D = diag(COVstat) is the 
+  // HD error-squared added in read_mucov. Approximate COVsys with
+  // its NRANK largest eigenvalues; COVsys ~ U U^T where column a
+  // of U is eigenvector_a * sqrt(eigenvalue_a). Woodbury identity:
+  //   COV^-1 = D^-1 - D^-1 U M^-1 U^T D^-1 ,  M = I + U^T D^-1 U
+  // Store D^-1, UTD = (D^-1 U)^T, Cholesky factor R of M (M = R R^T),
+  // RQ = R^-1 U^T D^-1 1, and Csum = 1^T COV^-1 1.
+
+  int  NSN    = MUCOV->NDIM ;
+  int  NMUCOV = INPUTS.NMUCOV ;
+  int  NRANK  = INPUTS.nrank_covsys ;
+  int  i, j, a, c, imat, status ;
+  double fac = 1.0 / (double)NMUCOV ;
+  double covstat, eval, trace_all = 0.0, trace_keep = 0.0 ;
+  double sqeval[MXRANK_COVSYS], sum, Csum ;
+  gsl_error_handler_t *handler_orig ;
+  char fnam[] = "factor_mucovar_lowrank" ;
+
+  // ---------------- BEGIN --------------
+
+  if ( NRANK > NSN ) { NRANK = NSN; }
+
+  // D = average COVstat, same averaging as compute_MUCOV_FINAL
+  WORKSPACE.LOWRANK_DINV = (double*) malloc(NSN*sizeof(double));
+  gsl_matrix *COVSYS = gsl_matrix_alloc(NSN,NSN);
+  for(i=0; i < NSN; i++ ) {
+    covstat = 0.0 ;
+    for(imat=0; imat < NMUCOV; imat++ ) 
+      { covstat += fac * HD_LIST[imat].mu_sqsig[i]; }
+
+    if ( covstat <= 0.0 ) {
+      sprintf(c1err,"Invalid COVstat = %le for SN index %d", covstat, i);
+      sprintf(c2err,"-nrank_covsys requires MUERR > 0 for each SN");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+    WORKSPACE.LOWRANK_DINV[i] = 1.0 / covstat ;
+
+    for(j=0; j < NSN; j++ ) {
+      gsl_matrix_set(COVSYS, i, j, MUCOV->ARRAY1D[i*NSN+j]);
+    }
+    gsl_matrix_set(COVSYS, i, i, MUCOV->ARRAY1D[i*NSN+i] - covstat);
+  }
+
+  // eigen-decomposition of COVsys, sorted by decreasing eigenvalue
+  gsl_vector *EVAL = gsl_vector_alloc(NSN);
+  gsl_matrix *EVEC = gsl_matrix_alloc(NSN,NSN);
+  gsl_eigen_symmv_workspace *EIGWORK = gsl_eigen_symmv_alloc(NSN);
+  gsl_eigen_symmv(COVSYS, EVAL, EVEC, EIGWORK);
+  gsl_eigen_symmv_sort(EVAL, EVEC, GSL_EIGEN_SORT_VAL_DESC);
+  gsl_eigen_symmv_free(EIGWORK);
+  gsl_matrix_free(COVSYS);
+
+  for(i=0; i < NSN; i++ ) { 
+    eval = gsl_vector_get(EVAL,i);
+    if ( eval > 0.0 ) { trace_all += eval; }
+  }
+
+  // keep only positive eigenvalues
+  for(a=0; a < NRANK; a++ ) {
+    eval = gsl_vector_get(EVAL,a);
+    if ( eval <= 0.0 ) { NRANK = a; break; }
+    sqeval[a]   = sqrt(eval);
+    trace_keep += eval ;
+  }
+  WORKSPACE.NRANK_COVSYS = NRANK ;
+
+  printf("\t Keep %d COVsys eigenvectors with %.4f of COVsys trace\n",
+	 NRANK, trace_keep / (trace_all + 1.0E-20) );
+  fflush(stdout);
+
+  // UTD[a][i] = U_ia / D_i
+  WORKSPACE.LOWRANK_UTD = (double*) malloc(NRANK*NSN*sizeof(double));
+  for(a=0; a < NRANK; a++ ) {
+    for(i=0; i < NSN; i++ ) {
+      WORKSPACE.LOWRANK_UTD[a*NSN+i] = 
+	gsl_matrix_get(EVEC,i,a) * sqeval[a] * WORKSPACE.LOWRANK_DINV[i];
+    }
+  }
+
+  // M = I + U^T D^-1 U
+  WORKSPACE.LOWRANK_R  = (double*) malloc(NRANK*NRANK*sizeof(double));
+  WORKSPACE.LOWRANK_RQ = (double*) malloc(NRANK*sizeof(double));
+  for(a=0; a < NRANK; a++ ) {
+    for(c=0; c <= a; c++ ) {
+      sum = 0.0 ;
+      for(i=0; i < NSN; i++ ) 
+	{ sum += WORKSPACE.LOWRANK_UTD[a*NSN+i] * 
+	    gsl_matrix_get(EVEC,i,c) * sqeval[c] ; }
+      if ( a == c ) { sum += 1.0; }
+      WORKSPACE.LOWRANK_R[a*NRANK+c] = sum ;
+      WORKSPACE.LOWRANK_R[c*NRANK+a] = sum ;
+    }
+
+    sum = 0.0 ;
+    for(i=0; i < NSN; i++ ) { sum += WORKSPACE.LOWRANK_UTD[a*NSN+i]; }
+    WORKSPACE.LOWRANK_RQ[a] = sum ;  // q = U^T D^-1 1
+  }
+
+  gsl_vector_free(EVAL);
+  gsl_matrix_free(EVEC);
+
+  Csum = 0.0 ;
+  for(i=0; i < NSN; i++ ) { Csum += WORKSPACE.LOWRANK_DINV[i]; }
+
+  if ( NRANK > 0 ) {
+    // M = R R^T  (M is positive definite by construction)
+    gsl_matrix_view R_view = 
+      gsl_matrix_view_array(WORKSPACE.LOWRANK_R, NRANK, NRANK);
+    handler_orig = gsl_set_error_handler_off();
+    status = gsl_linalg_cholesky_decomp(&R_view.matrix);
+    gsl_set_error_handler(handler_orig);
+    if ( status != GSL_SUCCESS ) {
+      sprintf(c1err,"Cholesky decomp failed (status=%d) for "
+	      "%d x %d low-rank matrix", status, NRANK, NRANK);
+      sprintf(c2err,"Try smaller -nrank_covsys");
+      errmsg(SEV_FATAL, 0, fnam, c1err, c2err);
+    }
+
+    // RQ = R^-1 q
+    gsl_vector_view q_view = 
+      gsl_vector_view_array(WORKSPACE.LOWRANK_RQ, NRANK);
+    gsl_blas_dtrsv(CblasLower, CblasNoTrans, CblasNonUnit, 
+		   &R_view.matrix, &q_view.vector);
+
+    for(a=0; a < NRANK; a++ ) 
+      { Csum -= WORKSPACE.LOWRANK_RQ[a] * WORKSPACE.LOWRANK_RQ[a]; }
+  }
+
+  WORKSPACE.Csum_COV = Csum ;
+
+  return ;
+
+} // end of factor_mucovar_lowrank
+
+
 // =========================================
 void check_invertMatrix(int N, double *COV, double *COVINV ) {
   // compute C*C_inverse and compute maximum deviations from 1 on diagonal 
@@ -4073,25 +4891,62 @@ void get_chi2wOM (
   // Apr 22 2022:
   //   + use dmu_list to avoid redundant log10 calculations in get_DMU_chi2wOM
   //   + implement rz-interpolation option
+  //
+  // Oct 2026: split into diag, offdiag and final parts so that 
+  //   chi2-grid threads can process blocks of grid nodes; this
+  //   function evaluates one node with scratch arrays of thread 0.
+
+  Cosparam cparloc;
+  CHI2_SUMS_DEF SUMS;
+  CHI2_SCRATCH_DEF *SCRATCH = &CHI2_SCRATCH[0];
+
+  // --------- BEGIN --------
+
+  if ( WORKSPACE.NTHREAD_SCRATCH == 0 ) { malloc_chi2_scratch(1); }
+
+  cparloc.omm = OM ;
+  cparloc.ome = 1.0 - OM ;
+  cparloc.w0  = w0 ;
+  cparloc.wa  = wa ;
+  cparloc.mushift = 0.0 ;
+
+  get_chi2wOM_diag(&cparloc, sqmurms_add, SCRATCH, SCRATCH->dmu_list[0], 
+		   &SUMS);
+  get_chi2wOM_offdiag(1, SCRATCH, &SUMS);
+  get_chi2wOM_final(&cparloc, &SUMS, mu_off, chi2sn, chi2tot);
+
+  return ;
+
+}  // end of get_chi2wOM
+
+
+// ===========================
+void get_chi2wOM_diag(Cosparam *cparloc, double sqmurms_add,
+		      CHI2_SCRATCH_DEF *SCRATCH, double *dmu_list, 
+		      CHI2_SUMS_DEF *SUMS) {
+
+  // Created Oct 2026 [code moved from get_chi2wOM]
+  // For cosmology *cparloc, compute diag part of chi2 sums and 
+  // load dmu_list (mu_obs - mu_cos for each SN); then decide if
+  // off-diag cov terms are needed.
 
   bool USE_SPEED_OFFDIAG = INPUTS.USE_SPEED_OFFDIAG ;
   bool USE_SPEED_INTERP  = INPUTS.USE_SPEED_INTERP ;
   int  use_mucov = INPUTS.use_mucov ;
   int  NSN       = HD_LIST[0].NSN;
   int  Ndof      = WORKSPACE.Ndof ;
+  bool USE_COVFAC = use_mucov && 
+    (INPUTS.mucov_method != MUCOV_METHOD_INVERSE) ;
   double sig_chi2min_naive = WORKSPACE.sig_chi2min_naive;
   double nsig_chi2min_skip = WORKSPACE.nsig_chi2min_skip;  
   double chi_hat_naive     = (double)Ndof;
+  double OM = cparloc->omm, OE = cparloc->ome ;
+  double w0 = cparloc->w0,  wa = cparloc->wa ;
 
-  double OE, rz, sqmusig, sqmusiginv, Bsum, Csum ;
+  double rz, sqmusig, sqmusiginv, Bsum, Csum ;
   double nsig_chi2, chi_hat, chi_tmp ;
-  double dmu, dmu0, dmu1, mu_cos, mu_obs  ;
-    
-  double  chi2_prior = 0.0 ;
-  double *rz_list  = (double*) malloc(NSN * sizeof(double) );
-  double *dmu_list = (double*) malloc(NSN * sizeof(double) );
-  Cosparam cparloc;
-  int k, k0, k1, N0, N1, k1min, n_count=0, LDMP=0 ;
+  double dmu, mu_cos, mu_obs  ;
+  int k, LDMP=0 ;
   
   HD_DEF *HD0 = &HD_LIST[0];
   HD_DEF *HD1 = &HD_LIST[1];
@@ -4103,17 +4958,10 @@ void get_chi2wOM (
   int n_logz, iz;
   double z ;
 
-  char fnam[] = "get_chi2wOM";
+  char fnam[] = "get_chi2wOM_diag";
 
   // --------- BEGIN --------
 
-  OE = 1.0 - OM ;
-  cparloc.omm = OM ;
-  cparloc.ome = OE ;
-  cparloc.w0  = w0 ;
-  cparloc.wa  = wa ;
-  cparloc.mushift = 0.0 ;
-
   Bsum = Csum = chi_hat = 0.0 ;
 
   // Apr 2022: check option to interpolate rz(z) [speed trick]
@@ -4121,10 +4969,10 @@ void get_chi2wOM (
     n_logz   = WORKSPACE.n_logz_interp;
     for(iz=0; iz < n_logz; iz++ ) {
       z   = WORKSPACE.z_list_interp[iz];
-      rz  = codist(z, &cparloc); 
+      rz  = codist(z, cparloc); 
       mu_cos = get_mu_cos(z,rz);  // theory mu
-      WORKSPACE.rz_list_interp[iz]    = rz;
-      WORKSPACE.mucos_list_interp[iz] = mu_cos ;
+      SCRATCH->rz_list_interp[iz]    = rz;
+      SCRATCH->mucos_list_interp[iz] = mu_cos ;
     }
   }
 
@@ -4136,16 +4984,14 @@ void get_chi2wOM (
     if ( INPUTS.USE_HDIBC ) { z = 0.5*(HD0->z[k] + HD1->z[k]); }
 
     if ( USE_SPEED_INTERP )  { 
-      exec_rz_interp(k, &cparloc, &rz, &mu_cos); 
+      exec_rz_interp(k, cparloc, SCRATCH, &rz, &mu_cos); 
     }
     else { 
       // brute force calculation of theory distance
-      rz     = codist(z, &cparloc);
+      rz     = codist(z, cparloc);
       mu_cos = get_mu_cos(z, rz) ;
     }
 
-    rz_list[k]  = rz ;
-
     if ( INPUTS.USE_HDIBC ) {
 
       // interpolate two HDs
@@ -4180,7 +5026,9 @@ void get_chi2wOM (
 
     dmu_list[k] = mu_obs - mu_cos; 
 
-    n_count++ ;
+    // factored COV: all chi2 terms are computed in get_chi2wOM_offdiag
+    if ( USE_COVFAC ) { continue; }
+
     if ( use_mucov ) {
       sqmusiginv = WORKSPACE.MUCOV_FINAL.ARRAY1D[k*(NSN+1)]; 
     }
@@ -4207,47 +5055,218 @@ void get_chi2wOM (
       chi_tmp     = chi_hat - Bsum*Bsum/Csum ;
       nsig_chi2  = (chi_tmp - chi_hat_naive ) / sig_chi2min_naive ;
       do_offdiag = nsig_chi2 < nsig_chi2min_skip ;
-
-      /* xxxx
-      if ( fabs(w0+1.0) < 0.06  &&  fabs(OM-0.3)<0.02 ) {
-	printf(" xxx %s: ------------------------------ \n", fnam);
-	printf(" xxx %s: w0=%f  wa=%f  OM=%f \n",
-	       fnam, w0, wa, OM);
-	printf(" xxx %s: nsig=%.1f chi(hat,naive)=%.1f,%.1f  "
-	       "sig_naive=%.1f \n",
-	       fnam, nsig_chi2, chi_tmp, chi_hat_naive, sig_chi2min_naive);
-	debugexit(fnam); // xxxx remove
-	} xxxxx*/
-
     }
     else {
       do_offdiag = true ; 
     }
   }
 
-  // add off-diag elements if using cov matrix
-  if ( do_offdiag ) {
-    for ( k0=0; k0 < NSN-1; k0++) {
-      k1min = k0 + 1;
-      for ( k1=k1min; k1 < NSN; k1++)  {
-	k = k0*NSN + k1;
-	sqmusiginv = WORKSPACE.MUCOV_FINAL.ARRAY1D[k]; // Inverse of the matrix 
+  SUMS->Bsum       = Bsum ;
+  SUMS->Csum       = Csum ;
+  SUMS->chi_hat    = chi_hat ;
+  SUMS->do_offdiag = do_offdiag ;
+
+  return ;
+
+}  // end of get_chi2wOM_diag
+
+
+// ===========================
+void get_chi2wOM_offdiag(int NNODE, CHI2_SCRATCH_DEF *SCRATCH, 
+			 CHI2_SUMS_DEF *SUMS) {
+
+  // Created Oct 2026 [code moved from get_chi2wOM]
+  // Add off-diag cov terms to chi2 sums for NNODE grid nodes.
+  // Each inverse-cov element is read once and used for all nodes
+  // in the block; the sum order for each node is the same as for 
+  // a single node.
+  // For -cholesky or -nrank_covsys, the full chi2 sums are computed
+  // here from the factored COV.
+
+  int    NSN  = HD_LIST[0].NSN;
+  double **dmu_list = SCRATCH->dmu_list ;
+  double *COVINV = WORKSPACE.MUCOV_FINAL.ARRAY1D ;
+  int    k0, k1, b, NUSE = 0 ;
+  int    ilist[MXBLOCK_CHI2GRID];
+  double sqmusiginv, dmu0[MXBLOCK_CHI2GRID], dmu1, chi_tmp ;
+  double *ptr_row, *ptr_dmu ;
+  CHI2_SUMS_DEF *S ;
+
+  // --------- BEGIN --------
+
+  for ( b=0; b < NNODE; b++ ) 
+    { if ( SUMS[b].do_offdiag ) { ilist[NUSE] = b; NUSE++ ; } }
+
+  if ( NUSE == 0 ) { return; }
+
+  if ( INPUTS.mucov_method == MUCOV_METHOD_CHOLESKY ) 
+    { get_chi2wOM_cholesky(NUSE, ilist, SCRATCH, SUMS);  return; }
+  if ( INPUTS.mucov_method == MUCOV_METHOD_LOWRANK ) 
+    { get_chi2wOM_lowrank(NUSE, ilist, SCRATCH, SUMS);  return; }
+
+  for ( k0=0; k0 < NSN-1; k0++) {
+    ptr_row = &COVINV[k0*NSN] ;
+    for ( b=0; b < NUSE; b++ ) { dmu0[b] = dmu_list[ilist[b]][k0]; }
+
+    for ( k1=k0+1; k1 < NSN; k1++)  {
+      sqmusiginv = ptr_row[k1]; // Inverse of the matrix 
+
+      for ( b=0; b < NUSE; b++ ) {
+	S        = &SUMS[ilist[b]];
+	ptr_dmu  = dmu_list[ilist[b]];
+	dmu1     = ptr_dmu[k1];
+
+	chi_tmp  = (sqmusiginv * dmu0[b] * dmu1 );
+
+	S->Bsum    += sqmusiginv*(dmu0[b]+dmu1); // Eq. A.11 of Goliath 2001  
+	S->Csum    += (2.0*sqmusiginv);          // Eq. A.12 of Goliath 2001
+	S->chi_hat += (2.0*chi_tmp);
+      }
+    } // end k1
+  } // end k0
+
+  return ;
+
+}  // end of get_chi2wOM_offdiag
+
+
+// ===========================
+void get_chi2wOM_cholesky(int NUSE, int *ilist, CHI2_SCRATCH_DEF *SCRATCH, 
+			  CHI2_SUMS_DEF *SUMS) {
+
+  // Created Oct 2026
+  // Compute chi2 sums for NUSE grid nodes using COV = L L^T.
+  // Load dmu for each node into columns of NSN x NUSE matrix Y, 
+  // and solve L Y' = Y with one BLAS triangular solve. Then
+  //   chi_hat = dmu^T COV^-1 dmu = y'.y'
+  //   Bsum    = 1^T COV^-1 dmu   = (L^-1 1).y'
+  //   Csum    = 1^T COV^-1 1     = precomputed in factor_mucovar
+
+  int    NSN     = HD_LIST[0].NSN;
+  double *COVCHOL_ONE = WORKSPACE.COVCHOL_ONE ;
+  double *Y      = SCRATCH->chol_work ;
+  double **dmu_list = SCRATCH->dmu_list ;
+  double y, *ptr_Y ;
+  int    k, b ;
+  CHI2_SUMS_DEF *S ;
+
+  // --------- BEGIN --------
+
+  for ( k=0; k < NSN; k++ ) {
+    ptr_Y = &Y[k*NUSE] ;
+    for ( b=0; b < NUSE; b++ ) { ptr_Y[b] = dmu_list[ilist[b]][k]; }
+  }
+
+  gsl_matrix_view L_view = gsl_matrix_view_array(WORKSPACE.COVCHOL,NSN,NSN);
+  gsl_matrix_view Y_view = gsl_matrix_view_array(Y, NSN, NUSE);
+  gsl_blas_dtrsm(CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit, 1.0, 
+		 &L_view.matrix, &Y_view.matrix);
+
+  for ( b=0; b < NUSE; b++ ) {
+    S = &SUMS[ilist[b]];
+    S->Bsum = S->chi_hat = 0.0 ;
+    S->Csum = WORKSPACE.Csum_COV ;
+  }
+
+  for ( k=0; k < NSN; k++ ) {
+    ptr_Y = &Y[k*NUSE] ;
+    for ( b=0; b < NUSE; b++ ) {
+      S  = &SUMS[ilist[b]];
+      y  = ptr_Y[b];
+      S->Bsum    += COVCHOL_ONE[k] * y ;
+      S->chi_hat += y * y ;
+    }
+  }
+
+  return ;
 
-	dmu0     = dmu_list[k0];
-	dmu1     = dmu_list[k1];
+}  // end of get_chi2wOM_cholesky
 
-	chi_tmp  = (sqmusiginv * dmu0 * dmu1 );
 
-	Bsum    += sqmusiginv*(dmu0+dmu1); // Eq. A.11 of Goliath 2001  
-	Csum    += (2.0*sqmusiginv);       // Eq. A.12 of Goliath 2001
-	chi_hat += (2.0*chi_tmp);
-	n_count++ ;
+// ===========================
+void get_chi2wOM_lowrank(int NUSE, int *ilist, CHI2_SCRATCH_DEF *SCRATCH, 
+			 CHI2_SUMS_DEF *SUMS) {
+
+  // Created Oct 2026
+  // Compute chi2 sums for NUSE grid nodes using 
+  //   COV^-1 = D^-1 - D^-1 U (R R^T)^-1 U^T D^-1
+  // (see factor_mucovar_lowrank). With p = U^T D^-1 dmu, 
+  //   chi_hat = dmu^T D^-1 dmu - |R^-1 p|^2
+  //   Bsum    = 1^T D^-1 dmu   - (R^-1 q).(R^-1 p)
+  //   Csum    = precomputed in factor_mucovar_lowrank
+  // Cost per node is O(NSN*NRANK) instead of O(NSN^2).
+
+  int    NSN     = HD_LIST[0].NSN;
+  int    NRANK   = WORKSPACE.NRANK_COVSYS ;
+  double *DINV   = WORKSPACE.LOWRANK_DINV ;
+  double *UTD    = WORKSPACE.LOWRANK_UTD ;
+  double *R      = WORKSPACE.LOWRANK_R ;
+  double *RQ     = WORKSPACE.LOWRANK_RQ ;
+  double **dmu_list = SCRATCH->dmu_list ;
+  double P[MXBLOCK_CHI2GRID][MXRANK_COVSYS];
+  double *ptr_UTD, *ptr_dmu, *ptr_P, w, z ;
+  int    k, a, c, b ;
+  CHI2_SUMS_DEF *S ;
 
-      } // end k1
-    } // end k0
-  }  // end do_offdiag
+  // --------- BEGIN --------
+
+  // diagonal part 
+  for ( b=0; b < NUSE; b++ ) {
+    S       = &SUMS[ilist[b]];
+    ptr_dmu = dmu_list[ilist[b]];
+    S->Bsum = S->chi_hat = 0.0 ;
+    S->Csum = WORKSPACE.Csum_COV ;
+    for ( k=0; k < NSN; k++ ) {
+      w           = DINV[k] * ptr_dmu[k] ;
+      S->Bsum    += w ;
+      S->chi_hat += w * ptr_dmu[k] ;
+    }
+  }
+
+  // p = U^T D^-1 dmu ; each row of UTD is used for all nodes in block
+  for ( a=0; a < NRANK; a++ ) {
+    ptr_UTD = &UTD[a*NSN] ;
+    for ( b=0; b < NUSE; b++ ) {
+      ptr_dmu = dmu_list[ilist[b]];
+      w = 0.0 ;
+      for ( k=0; k < NSN; k++ ) { w += ptr_UTD[k] * ptr_dmu[k]; }
+      P[b][a] = w ;
+    }
+  }
+
+  // forward substitution P <- R^-1 P, and low-rank correction
+  for ( b=0; b < NUSE; b++ ) {
+    S     = &SUMS[ilist[b]];
+    ptr_P = P[b];
+    for ( a=0; a < NRANK; a++ ) {
+      z = ptr_P[a] ;
+      for ( c=0; c < a; c++ ) { z -= R[a*NRANK+c] * ptr_P[c]; }
+      z        /= R[a*NRANK+a] ;
+      ptr_P[a]  = z ;
+      S->chi_hat -= z * z ;
+      S->Bsum    -= RQ[a] * z ;
+    }
+  }
+
+  return ;
+
+}  // end of get_chi2wOM_lowrank
+
+
+// ===========================
+void get_chi2wOM_final(Cosparam *cparloc, CHI2_SUMS_DEF *SUMS, 
+		       double *mu_off, double *chi2sn, double *chi2tot) {
+
+  // Created Oct 2026 [code moved from get_chi2wOM]
+  // Use chi2 sums to return distance offset, SN-only chi2, 
+  // and SN+prior chi2.
+
+  double Bsum    = SUMS->Bsum ;
+  double Csum    = SUMS->Csum ;
+  double chi_hat = SUMS->chi_hat ;
+
+  // --------- BEGIN --------
 
-  //  - - - - - -
   *mu_off  = Bsum/Csum ;  // load function output before adding H0-prior corr
 
   /* Analytic marginalization over H0.  
@@ -4265,16 +5284,13 @@ void get_chi2wOM (
   *chi2tot = *chi2sn ;     // load intermediate function output
 
   double chi2_om, chi2_cmb, chi2_bao, chi2_rd;
-  get_chi2_priors(&cparloc, &chi2_om, &chi2_cmb, &chi2_bao, &chi2_rd);
+  get_chi2_priors(cparloc, &chi2_om, &chi2_cmb, &chi2_bao, &chi2_rd);
   
   *chi2tot += (chi2_om + chi2_cmb + chi2_bao + chi2_rd);
 
-  free(rz_list);
-  free(dmu_list);
-
   return ;
 
-}  // end of get_chi2wOM
+}  // end of get_chi2wOM_final
 
 // =======================
 void get_chi2_priors(Cosparam *cpar, double *chi2_om, double *chi2_cmb,